@@ -0,0 +1,93 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+
+/**
+ * @file
+ *
+ * Benchmarks for block ciphers.
+ *
+ * @ingroup bc
+ */
+
+#include <stdio.h>
+
+#include "relic.h"
+#include "relic_bench.h"
+
+static void aes(void) {
+	uint8_t key[32], iv[RLC_BC_LEN], in[4096], out[4096 + RLC_BC_TAG];
+	int out_len;
+	aes_t k;
+
+	rand_bytes(key, sizeof(key));
+	rand_bytes(iv, sizeof(iv));
+	rand_bytes(in, sizeof(in));
+
+	BENCH_RUN("bc_aes_cbc_enc (4080)") {
+		out_len = sizeof(out);
+		BENCH_ADD(bc_aes_cbc_enc(out, &out_len, in, sizeof(in) - RLC_BC_LEN,
+				key, 16, iv));
+	} BENCH_END;
+
+	BENCH_RUN("bc_aes_cbc_dec (4080)") {
+		out_len = sizeof(out);
+		bc_aes_cbc_enc(out, &out_len, in, sizeof(in) - RLC_BC_LEN, key, 16, iv);
+		BENCH_ADD(bc_aes_cbc_dec(in, &out_len, out, out_len, key, 16, iv));
+	} BENCH_END;
+
+	BENCH_RUN("bc_aes_key") {
+		BENCH_ADD(bc_aes_key(k, key, 16));
+	} BENCH_END;
+
+	BENCH_RUN("bc_aes_ctr_enc (4096)") {
+		out_len = sizeof(out);
+		BENCH_ADD(bc_aes_ctr_enc(out, &out_len, in, sizeof(in), k, iv));
+	} BENCH_END;
+
+	BENCH_RUN("bc_aes_gcm_enc (4096)") {
+		out_len = sizeof(out);
+		BENCH_ADD(bc_aes_gcm_enc(out, &out_len, in, sizeof(in), NULL, 0, k,
+				iv));
+	} BENCH_END;
+
+	BENCH_RUN("bc_aes_gcm_dec (4096)") {
+		out_len = sizeof(out);
+		bc_aes_gcm_enc(out, &out_len, in, sizeof(in), NULL, 0, k, iv);
+		BENCH_ADD(bc_aes_gcm_dec(out, &out_len, out, out_len, NULL, 0, k,
+				iv));
+	} BENCH_END;
+}
+
+int main(void) {
+	if (core_init() != RLC_OK) {
+		core_clean();
+		return 1;
+	}
+
+	conf_print();
+	util_banner("Benchmarks for the BC module:\n", 0);
+	aes();
+	core_clean();
+	return 0;
+}
@@ -97,13 +97,17 @@ static void util(void) {
 	char str[RLC_CEIL(RLC_BN_BITS, 8) * 3 + 1];
 	uint8_t bin[RLC_CEIL(RLC_BN_BITS, 8)];
 	dig_t raw[RLC_BN_DIGS];
-	bn_t a, b;
+	bn_t a, b, t[BENCH];
 
 	bn_null(a);
 	bn_null(b);
 
 	bn_new(a);
 	bn_new(b);
+	for (int i = 0; i < BENCH; i++) {
+		bn_null(t[i]);
+		bn_new(t[i]);
+	}
 
 	bn_rand(b, RLC_POS, RLC_BN_BITS);
 
@@ -202,6 +206,17 @@ static void util(void) {
 	}
 	BENCH_END;
 
+	BENCH_RUN("bn_rand_sim (per integer)") {
+		BENCH_ADD(bn_rand_sim(t, BENCH, RLC_BN_BITS));
+	}
+	BENCH_DIV(BENCH);
+
+	BENCH_RUN("bn_rand_mod_sim (per integer)") {
+		bn_rand(b, RLC_POS, RLC_BN_BITS);
+		BENCH_ADD(bn_rand_mod_sim(t, BENCH, b));
+	}
+	BENCH_DIV(BENCH);
+
 	BENCH_RUN("bn_size_str") {
 		bn_rand(a, RLC_POS, RLC_BN_BITS);
 		BENCH_ADD(bn_size_str(a, 10));
@@ -278,6 +293,9 @@ static void util(void) {
 
 	bn_free(a);
 	bn_free(b);
+	for (int i = 0; i < BENCH; i++) {
+		bn_free(t[i]);
+	}
 }
 
 static void arith(void) {
@@ -864,6 +882,33 @@ static void arith(void) {
 	}
 	BENCH_END;
 
+	{
+		bn_t p[257], x[256], y[256];
+
+		for (int j = 0; j < 256; j++) {
+			bn_null(p[j]);
+			bn_null(x[j]);
+			bn_null(y[j]);
+			bn_new(p[j]);
+			bn_new(x[j]);
+			bn_new(y[j]);
+			bn_rand_mod(x[j], a);
+		}
+		bn_null(p[256]);
+		bn_new(p[256]);
+
+		BENCH_ONE("bn_lag (256)", bn_lag(p, x, a, 256), 1);
+		BENCH_ONE("bn_evl_sim (256)", bn_evl_sim(y, p, x, a, 256, 256), 1);
+		BENCH_ONE("bn_itp (256)", bn_itp(p, x, y, a, 256), 1);
+
+		for (int j = 0; j < 256; j++) {
+			bn_free(p[j]);
+			bn_free(x[j]);
+			bn_free(y[j]);
+		}
+		bn_free(p[256]);
+	}
+
 	bn_rand(a, RLC_POS, RLC_BN_BITS);
 
 	BENCH_ONE("bn_factor", bn_factor(c, a), 1);
@@ -35,6 +35,11 @@
 #include "relic.h"
 #include "relic_bench.h"
 
+/**
+ * Number of signatures verified in a batch.
+ */
+#define BATCH_SIGS	16
+
 #if defined(WITH_BN)
 
 static void rsa(void) {
@@ -333,16 +338,21 @@ static void ecmqv(void) {
 static void ecies(void) {
 	ec_t q, r;
 	bn_t d;
-	uint8_t in[10], out[16 + RLC_MD_LEN];
+	uint8_t in[10], out[16 + RLC_BC_TAG], *buf;
 	int in_len, out_len;
+	size_t len;
+	strm_t s;
 
 	bn_null(d);
 	ec_null(q);
 	ec_null(r);
+	strm_null(s);
 
 	ec_new(q);
 	ec_new(r);
 	bn_new(d);
+	strm_new(s);
+	buf = RLC_ALLOCA(uint8_t, 2 * RLC_CP_CHUNK + RLC_BC_TAG);
 
 	BENCH_RUN("cp_ecies_gen") {
 		BENCH_ADD(cp_ecies_gen(d, q));
@@ -367,15 +377,30 @@ static void ecies(void) {
 	}
 	BENCH_END;
 
+	if (buf != NULL) {
+		cp_ecies_enc_init(r, s, q);
+		BENCH_RUN("cp_strm_update (64 KiB)") {
+			len = RLC_CP_CHUNK + RLC_BC_TAG;
+			BENCH_ADD(cp_strm_update(buf + RLC_CP_CHUNK, &len, buf, RLC_CP_CHUNK,
+					s));
+		}
+		BENCH_END;
+		cp_strm_clean(s);
+	}
+
 	ec_free(q);
 	ec_free(r);
 	bn_free(d);
+	strm_free(s);
+	RLC_FREE(buf);
 }
 
 static void ecdsa(void) {
-	uint8_t msg[5] = { 0, 1, 2, 3, 4 }, h[RLC_MD_LEN];
-	bn_t r, s, d;
-	ec_t p;
+	uint8_t msg[5] = { 0, 1, 2, 3, 4 }, h[RLC_MD_LEN], *ms[BATCH_SIGS];
+	int ls[BATCH_SIGS], vs[BATCH_SIGS];
+	bn_t r, s, d, rs[BATCH_SIGS], ss[BATCH_SIGS];
+	ec_t p, qs[BATCH_SIGS];
+	ecdsa_pre_t pre[BATCH_SIGS];
 
 	bn_null(r);
 	bn_null(s);
@@ -403,6 +428,22 @@ static void ecdsa(void) {
 	}
 	BENCH_END;
 
+	for (int i = 0; i < BATCH_SIGS; i++) {
+		ecdsa_pre_null(pre[i]);
+		ecdsa_pre_new(pre[i]);
+	}
+
+	BENCH_RUN("cp_ecdsa_pre (per nonce)") {
+		BENCH_ADD(cp_ecdsa_pre(pre, BATCH_SIGS));
+	}
+	BENCH_DIV(BATCH_SIGS);
+
+	BENCH_RUN("cp_ecdsa_sig_fast (h = 0)") {
+		cp_ecdsa_pre(pre, 1);
+		BENCH_ADD(cp_ecdsa_sig_fast(r, s, msg, 5, 0, d, pre[0]));
+	}
+	BENCH_END;
+
 	BENCH_RUN("cp_ecdsa_ver (h = 0)") {
 		BENCH_ADD(cp_ecdsa_ver(r, s, msg, 5, 0, p));
 	}
@@ -414,6 +455,30 @@ static void ecdsa(void) {
 	}
 	BENCH_END;
 
+	for (int i = 0; i < BATCH_SIGS; i++) {
+		bn_null(rs[i]);
+		bn_null(ss[i]);
+		ec_null(qs[i]);
+		bn_new(rs[i]);
+		bn_new(ss[i]);
+		ec_new(qs[i]);
+		ms[i] = msg;
+		ls[i] = 5;
+		cp_ecdsa_gen(d, qs[i]);
+		cp_ecdsa_sig_ext(rs[i], ss[i], &vs[i], ms[i], ls[i], 0, d);
+	}
+
+	BENCH_RUN("cp_ecdsa_ver_batch (h = 0, per signature)") {
+		BENCH_ADD(cp_ecdsa_ver_batch(rs, ss, vs, ms, ls, 0, qs, BATCH_SIGS));
+	}
+	BENCH_DIV(BATCH_SIGS);
+
+	for (int i = 0; i < BATCH_SIGS; i++) {
+		bn_free(rs[i]);
+		bn_free(ss[i]);
+		ec_free(qs[i]);
+		ecdsa_pre_free(pre[i]);
+	}
 	bn_free(r);
 	bn_free(s);
 	bn_free(d);
@@ -421,9 +486,10 @@ static void ecdsa(void) {
 }
 
 static void ecss(void) {
-	uint8_t msg[5] = { 0, 1, 2, 3, 4 };
-	bn_t r, s, d;
-	ec_t p;
+	uint8_t msg[5] = { 0, 1, 2, 3, 4 }, *ms[BATCH_SIGS];
+	int ls[BATCH_SIGS];
+	bn_t r, s, d, ss[BATCH_SIGS];
+	ec_t p, rs[BATCH_SIGS], qs[BATCH_SIGS];
 
 	bn_null(r);
 	bn_null(s);
@@ -450,6 +516,40 @@ static void ecss(void) {
 	}
 	BENCH_END;
 
+	for (int i = 0; i < BATCH_SIGS; i++) {
+		bn_null(ss[i]);
+		ec_null(rs[i]);
+		ec_null(qs[i]);
+		bn_new(ss[i]);
+		ec_new(rs[i]);
+		ec_new(qs[i]);
+		ms[i] = msg;
+		ls[i] = 5;
+		cp_ecss_gen(d, qs[i]);
+		cp_ecss_sig_ext(rs[i], ss[i], ms[i], ls[i], d, qs[i]);
+	}
+
+	BENCH_RUN("cp_ecss_sig_ext") {
+		BENCH_ADD(cp_ecss_sig_ext(rs[0], ss[0], msg, 5, d, qs[0]));
+	}
+	BENCH_END;
+
+	BENCH_RUN("cp_ecss_ver_ext") {
+		BENCH_ADD(cp_ecss_ver_ext(rs[0], ss[0], msg, 5, qs[0]));
+	}
+	BENCH_END;
+
+	BENCH_RUN("cp_ecss_ver_batch (per signature)") {
+		BENCH_ADD(cp_ecss_ver_batch(rs, ss, ms, ls, qs, BATCH_SIGS));
+	}
+	BENCH_DIV(BATCH_SIGS);
+
+	for (int i = 0; i < BATCH_SIGS; i++) {
+		bn_free(ss[i]);
+		ec_free(rs[i]);
+		ec_free(qs[i]);
+	}
+
 	bn_free(r);
 	bn_free(s);
 	bn_free(d);
@@ -696,6 +796,67 @@ static void etrs(void) {
 
 #endif /* WITH_EC */
 
+#if defined(WITH_ED)
+
+static void eddsa(void) {
+	uint8_t msg[5] = { 0, 1, 2, 3, 4 }, sk[RLC_FP_BYTES], *ms[BATCH_SIGS];
+	int ls[BATCH_SIGS];
+	bn_t s[BATCH_SIGS];
+	ed_t r[BATCH_SIGS], q[BATCH_SIGS];
+
+	for (int i = 0; i < BATCH_SIGS; i++) {
+		bn_null(s[i]);
+		ed_null(r[i]);
+		ed_null(q[i]);
+		bn_new(s[i]);
+		ed_new(r[i]);
+		ed_new(q[i]);
+	}
+
+	BENCH_RUN("cp_eddsa_gen") {
+		BENCH_ADD(cp_eddsa_gen(sk, q[0]));
+	}
+	BENCH_END;
+
+	BENCH_RUN("cp_eddsa_sig") {
+		BENCH_ADD(cp_eddsa_sig(r[0], s[0], msg, 5, sk, q[0]));
+	}
+	BENCH_END;
+
+	BENCH_RUN("cp_eddsa_ver") {
+		BENCH_ADD(cp_eddsa_ver(r[0], s[0], msg, 5, q[0]));
+	}
+	BENCH_END;
+
+	for (int i = 0; i < BATCH_SIGS; i++) {
+		ms[i] = msg;
+		ls[i] = 5;
+		cp_eddsa_gen(sk, q[i]);
+		cp_eddsa_sig(r[i], s[i], msg, 5, sk, q[i]);
+	}
+
+	/* Same signatures checked one at a time, for comparison with the batch. */
+	BENCH_RUN("cp_eddsa_ver (16 individually)") {
+		for (int i = 0; i < BATCH_SIGS; i++) {
+			BENCH_ADD(cp_eddsa_ver(r[i], s[i], ms[i], ls[i], q[i]));
+		}
+	}
+	BENCH_DIV(BATCH_SIGS);
+
+	BENCH_RUN("cp_eddsa_ver_batch (16)") {
+		BENCH_ADD(cp_eddsa_ver_batch(r, s, ms, ls, q, BATCH_SIGS));
+	}
+	BENCH_DIV(BATCH_SIGS);
+
+	for (int i = 0; i < BATCH_SIGS; i++) {
+		bn_free(s[i]);
+		ed_free(r[i]);
+		ed_free(q[i]);
+	}
+}
+
+#endif /* WITH_ED */
+
 #if defined(WITH_PC)
 
 static void pdpub(void) {
@@ -948,7 +1109,7 @@ static void ibe(void) {
 	bn_t s;
 	g1_t pub;
 	g2_t prv;
-	uint8_t in[10], out[10 + 2 * RLC_FP_BYTES + 1];
+	uint8_t in[10], out[10 + 2 * RLC_FP_BYTES + 1 + RLC_BC_TAG];
 	char *id = "Alice";
 	int in_len, out_len;
 
@@ -974,7 +1135,7 @@ static void ibe(void) {
 
 	BENCH_RUN("cp_ibe_enc") {
 		in_len = sizeof(in);
-		out_len = in_len + 2 * RLC_FP_BYTES + 1;
+		out_len = in_len + 2 * RLC_FP_BYTES + 1 + RLC_BC_TAG;
 		rand_bytes(in, sizeof(in));
 		BENCH_ADD(cp_ibe_enc(out, &out_len, in, in_len, id, pub));
 		cp_ibe_dec(out, &out_len, out, out_len, prv);
@@ -983,7 +1144,7 @@ static void ibe(void) {
 
 	BENCH_RUN("cp_ibe_dec") {
 		in_len = sizeof(in);
-		out_len = in_len + 2 * RLC_FP_BYTES + 1;
+		out_len = in_len + 2 * RLC_FP_BYTES + 1 + RLC_BC_TAG;
 		rand_bytes(in, sizeof(in));
 		cp_ibe_enc(out, &out_len, in, in_len, id, pub);
 		BENCH_ADD(cp_ibe_dec(out, &out_len, out, out_len, prv));
@@ -1000,6 +1161,7 @@ static void bgn(void) {
 	g2_t d[2];
 	gt_t e[4];
 	bgn_t pub, prv;
+	dlog_tab_t tab;
 	dig_t in;
 
 	g1_null(c[0]);
@@ -1008,6 +1170,7 @@ static void bgn(void) {
 	g2_null(d[1]);
 	bgn_null(pub);
 	bgn_null(prv);
+	dlog_tab_null(tab);
 
 	g1_new(c[0]);
 	g1_new(c[1]);
@@ -1015,6 +1178,7 @@ static void bgn(void) {
 	g2_new(d[1]);
 	bgn_new(pub);
 	bgn_new(prv);
+	dlog_tab_new(tab);
 	for (int i = 0; i < 4; i++) {
 		gt_null(e[i]);
 		gt_new(e[i]);
@@ -1058,12 +1222,22 @@ static void bgn(void) {
 		BENCH_ADD(cp_bgn_add(e, e, e));
 	} BENCH_END;
 
+	BENCH_ONE("cp_bgn_tab1 (2^16)", cp_bgn_tab1(tab, 1 << 16, prv), 1);
+
+	BENCH_RUN("cp_bgn_dec1_tab (2^32)") {
+		rand_bytes((uint8_t *)&in, sizeof(in));
+		in = (uint32_t)in;
+		cp_bgn_enc1(c, in, pub);
+		BENCH_ADD(cp_bgn_dec1_tab(&in, c, (dig_t)1 << 32, tab, prv));
+	} BENCH_END;
+
 	g1_free(c[0]);
 	g1_free(c[1]);
 	g2_free(d[0]);
 	g2_free(d[1]);
 	bgn_free(pub);
 	bgn_free(prv);
+	dlog_tab_free(tab);
 	for (int i = 0; i < 4; i++) {
 		gt_free(e[i]);
 	}
@@ -1667,6 +1841,17 @@ static void lhs(void) {
 			pk, S));
 	} BENCH_DIV(S);
 
+	uint8_t key[RLC_MD_LEN], bin[RLC_MD_LEN + 48 * RLC_FP_BYTES];
+
+	BENCH_RUN("cp_cmlhs_off_key") {
+		BENCH_ADD(cp_cmlhs_off_key(key, label, f, flen, pk, S));
+	} BENCH_END;
+
+	BENCH_RUN("cp_cmlhs_off_read") {
+		cp_cmlhs_off_write(bin, cp_cmlhs_off_size(vk), vk, key);
+		BENCH_ADD(cp_cmlhs_off_read(vk, bin, cp_cmlhs_off_size(vk), key));
+	} BENCH_END;
+
 #ifdef BENCH_LHS
 	for (int t = 1; t <= S; t++) {
 		util_print("(%2d ids) ", t);
@@ -1770,6 +1955,34 @@ static void lhs(void) {
 		BENCH_ADD(cp_mklhs_onv(_r, m, d, data, id, cs, ft, pk, S));
 	} BENCH_DIV(S);
 
+	BENCH_RUN("cp_mklhs_off_key") {
+		BENCH_ADD(cp_mklhs_off_key(key, id, ls, f, flen, S));
+	} BENCH_END;
+
+	BENCH_RUN("cp_mklhs_off_read") {
+		cp_mklhs_off_write(bin, cp_mklhs_off_size(S), cs, ft, key, S);
+		BENCH_ADD(cp_mklhs_off_read(cs, ft, bin, cp_mklhs_off_size(S), key,
+			S));
+	} BENCH_END;
+
+	g1_t hl[S * L];
+	for (int i = 0; i < S * L; i++) {
+		g1_null(hl[i]);
+		g1_new(hl[i]);
+	}
+
+	BENCH_RUN("cp_mklhs_lab") {
+		BENCH_ADD(cp_mklhs_lab(hl, id, ls, flen, S));
+	} BENCH_DIV(S);
+
+	BENCH_RUN("cp_mklhs_ver_lab") {
+		BENCH_ADD(cp_mklhs_ver_lab(_r, m, d, data, id, hl, f, flen, pk, S));
+	} BENCH_DIV(S);
+
+	for (int i = 0; i < S * L; i++) {
+		g1_free(hl[i]);
+	}
+
 #ifdef BENCH_LHS
 	for (int t = 1; t <= S; t++) {
 		util_print("(%2d ids) ", t);
@@ -1994,6 +2207,13 @@ int main(void) {
 	}
 #endif
 
+#if defined(WITH_ED)
+	if (ed_param_set_any() == RLC_OK) {
+		util_banner("Protocols based on Edwards curves:\n", 0);
+		eddsa();
+	}
+#endif
+
 #if defined(WITH_PC)
 	if (pc_param_set_any() == RLC_OK) {
 		util_banner("Protocols based on pairings:\n", 0);
@@ -575,6 +575,24 @@ static void arith(void) {
 		BENCH_ADD(ep_map(p, msg, 5));
 	} BENCH_END;
 
+	BENCH_RUN("ep_map_sim (RLC_TERMS)") {
+		ep_t s[RLC_TERMS];
+		uint8_t msg[RLC_TERMS][5];
+		const uint8_t *ptr[RLC_TERMS];
+		int len[RLC_TERMS];
+		for (int i = 0; i < RLC_TERMS; i++) {
+			ep_null(s[i]);
+			ep_new(s[i]);
+			rand_bytes(msg[i], 5);
+			ptr[i] = msg[i];
+			len[i] = 5;
+		}
+		BENCH_ADD(ep_map_sim(s, ptr, len, RLC_TERMS));
+		for (int i = 0; i < RLC_TERMS; i++) {
+			ep_free(s[i]);
+		}
+	} BENCH_END;
+
 	BENCH_RUN("ep_pck") {
 		ep_rand(p);
 		BENCH_ADD(ep_pck(q, p));
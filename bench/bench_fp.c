@@ -633,6 +633,13 @@ static void arith(void) {
 	}
 	BENCH_END;
 
+	BENCH_RUN("fp_srt_div") {
+		fp_rand(a);
+		fp_rand(b);
+		BENCH_ADD(fp_srt_div(c, a, b));
+	}
+	BENCH_END;
+
 	BENCH_RUN("fp_prime_conv") {
 		bn_rand(e, RLC_POS, RLC_FP_BITS);
 		BENCH_ADD(fp_prime_conv(a, e));
@@ -35,7 +35,7 @@
 #include "relic_bench.h"
 
 static void hash(void) {
-	uint8_t hash[RLC_MD_LEN], buf[256];
+	uint8_t hash[RLC_MD_LEN_SH512], buf[256], *big = RLC_ALLOCA(uint8_t, 65536);
 	const uint8_t *dst = (const uint8_t *)"RELIC";
 
 	BENCH_RUN("md_map (256)") {
@@ -47,6 +47,29 @@ static void hash(void) {
 		rand_bytes(buf, sizeof(buf));
 		BENCH_ADD(md_xmd(buf, sizeof(buf), buf, sizeof(buf), dst, 5));
 	} BENCH_END;
+
+	if (big == NULL) {
+		return;
+	}
+	rand_bytes(big, 65536);
+
+	BENCH_RUN("md_map (64 KiB)") {
+		BENCH_ADD(md_map(hash, big, 65536));
+	} BENCH_END;
+
+#if MD_MAP == B2B512 || !defined(STRIP)
+	BENCH_RUN("md_map_b2b512 (64 KiB)") {
+		BENCH_ADD(md_map_b2b512(hash, big, 65536));
+	} BENCH_END;
+#endif
+
+#if MD_MAP == BLAKE3 || !defined(STRIP)
+	BENCH_RUN("md_map_blake3 (64 KiB)") {
+		BENCH_ADD(md_map_blake3(hash, big, 65536));
+	} BENCH_END;
+#endif
+
+	RLC_FREE(big);
 }
 
 int main(void) {
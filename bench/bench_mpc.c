@@ -87,6 +87,57 @@ static void mul_triple(void) {
 	}
 }
 
+static void shamir(void) {
+	bn_t order, s[RLC_TERMS], x[16], y[16 * RLC_TERMS];
+
+	bn_null(order);
+	bn_new(order);
+	for (int j = 0; j < RLC_TERMS; j++) {
+		bn_null(s[j]);
+		bn_new(s[j]);
+	}
+	for (int j = 0; j < 16; j++) {
+		bn_null(x[j]);
+		bn_new(x[j]);
+	}
+	for (int j = 0; j < 16 * RLC_TERMS; j++) {
+		bn_null(y[j]);
+		bn_new(y[j]);
+	}
+
+	bn_gen_prime(order, RLC_BN_BITS);
+	for (int j = 0; j < RLC_TERMS; j++) {
+		bn_rand_mod(s[j], order);
+	}
+
+	BENCH_RUN("mpc_sss_gen (8, 16)") {
+		BENCH_ADD(mpc_sss_gen(x, y, s[0], order, 8, 16));
+	} BENCH_END;
+
+	BENCH_RUN("mpc_sss_key (8)") {
+		BENCH_ADD(mpc_sss_key(s[0], x, y, order, 8));
+	} BENCH_END;
+
+	BENCH_RUN("mpc_sss_gen_sim (8, 16)") {
+		BENCH_ADD(mpc_sss_gen_sim(x, y, s, order, 8, 16, RLC_TERMS));
+	} BENCH_DIV(RLC_TERMS);
+
+	BENCH_RUN("mpc_sss_key_sim (8)") {
+		BENCH_ADD(mpc_sss_key_sim(s, x, y, order, 8, RLC_TERMS));
+	} BENCH_DIV(RLC_TERMS);
+
+	bn_free(order);
+	for (int j = 0; j < RLC_TERMS; j++) {
+		bn_free(s[j]);
+	}
+	for (int j = 0; j < 16; j++) {
+		bn_free(x[j]);
+	}
+	for (int j = 0; j < 16 * RLC_TERMS; j++) {
+		bn_free(y[j]);
+	}
+}
+
 static void pair_triple(void) {
 	g1_t d[2], p[2], _p;
 	g2_t e[2], q[2], _q;
@@ -290,6 +341,7 @@ int main(void) {
 
 #if defined(WITH_BN)
 	mul_triple();
+	shamir();
 #endif
 
 #if defined(WITH_PC)
@@ -650,8 +650,9 @@ static void util(void) {
 }
 
 static void arith(void) {
-	gt_t a, b, c;
-	bn_t d, e, f;
+	gt_t a, b, c, t[RLC_TERMS];
+	bn_t d, e, f, k[RLC_TERMS];
+	dig_t g[RLC_TERMS];
 
 	gt_new(a);
 	gt_new(b);
@@ -659,6 +660,10 @@ static void arith(void) {
 	bn_new(d);
 	bn_new(e);
 	bn_new(f);
+	for (int i = 0; i < RLC_TERMS; i++) {
+		gt_new(t[i]);
+		bn_new(k[i]);
+	}
 
 	BENCH_RUN("gt_mul") {
 		gt_rand(a);
@@ -713,12 +718,35 @@ static void arith(void) {
 	}
 	BENCH_END;
 
+	BENCH_RUN("gt_exp_sim_lot (RLC_TERMS)") {
+		gt_get_ord(d);
+		for (int i = 0; i < RLC_TERMS; i++) {
+			gt_rand(t[i]);
+			bn_rand_mod(k[i], d);
+		}
+		BENCH_ADD(gt_exp_sim_lot(c, t, k, RLC_TERMS));
+	}
+	BENCH_END;
+
+	BENCH_RUN("gt_exp_sim_dig (RLC_TERMS)") {
+		for (int i = 0; i < RLC_TERMS; i++) {
+			gt_rand(t[i]);
+			rand_bytes((uint8_t *)&g[i], sizeof(dig_t));
+		}
+		BENCH_ADD(gt_exp_sim_dig(c, t, g, RLC_TERMS));
+	}
+	BENCH_END;
+
 	gt_free(a);
 	gt_free(b);
 	gt_free(c);
 	bn_free(d);
 	bn_free(e);
 	bn_free(f);
+	for (int i = 0; i < RLC_TERMS; i++) {
+		gt_free(t[i]);
+		bn_free(k[i]);
+	}
 }
 
 static void pairing(void) {
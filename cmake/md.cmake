@@ -6,7 +6,10 @@ message("      MD_METHD=SH256        SHA-256 hash function.")
 message("      MD_METHD=SH384        SHA-384 hash function.")
 message("      MD_METHD=SH512        SHA-512 hash function.")
 message("      MD_METHD=B2S160       BLAKE2s-160 hash function.")
-message("      MD_METHD=B2S256       BLAKE2s-256 hash function.\n")
+message("      MD_METHD=B2S256       BLAKE2s-256 hash function.")
+message("      MD_METHD=B2B256       BLAKE2b-256 hash function.")
+message("      MD_METHD=B2B512       BLAKE2b-512 hash function.")
+message("      MD_METHD=BLAKE3       BLAKE3 hash function.\n")
 
 # Choose the arithmetic methods.
 if (NOT MD_METHD)
@@ -1,6 +1,7 @@
 message(STATUS "Available pseudo-random number generators (default = HASHD):\n")
 
 message("   RAND=HASHD     Use the HASH-DRBG generator. (recommended)")
+message("   RAND=CHACHA    Use the fast-key-erasure ChaCha20 generator.")
 message("   RAND=RDRND     Use Intel RdRand instruction directly.")
 message("   RAND=UDEV      Use the operating system underlying generator.")
 message("   RAND=CALL      Override the generator with a callback.\n")
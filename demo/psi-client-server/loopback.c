@@ -0,0 +1,201 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <time.h>
+#include <pthread.h>
+
+#include "relic.h"
+#include "params.h"
+
+/* End-to-end throughput of the streaming PB-PSI protocol over loopback TCP. */
+
+typedef struct {
+	int socket;
+	int count, total;
+	size_t bytes;
+	bn_t q;
+	g1_t ss;
+	in_port_t port;
+} stream_t;
+
+static int get_set(bn_t *y, int n, void *arg) {
+	stream_t *st = (stream_t *)arg;
+	int i;
+
+	for (i = 0; i < n && st->count < st->total; i++, st->count++) {
+		if (st->count == 0) {
+			bn_set_dig(y[i], 1);
+		} else {
+			bn_rand_mod(y[i], st->q);
+		}
+	}
+	return i;
+}
+
+static int put_all(const uint8_t *buf, size_t len, void *arg) {
+	stream_t *st = (stream_t *)arg;
+	ssize_t r;
+
+	st->bytes += len;
+	while (len > 0) {
+		r = send(st->socket, buf, len, 0);
+		if (r <= 0) {
+			return RLC_ERR;
+		}
+		buf += r;
+		len -= r;
+	}
+	return RLC_OK;
+}
+
+static int get_all(uint8_t *buf, size_t len, void *arg) {
+	int socket = *(int *)arg;
+	ssize_t r;
+
+	while (len > 0) {
+		r = recv(socket, buf, len, 0);
+		if (r <= 0) {
+			return RLC_ERR;
+		}
+		buf += r;
+		len -= r;
+	}
+	return RLC_OK;
+}
+
+static void *sender(void *arg) {
+	stream_t *st = (stream_t *)arg;
+	struct sockaddr_in addr;
+	uint8_t buffer[2 * RLC_PC_BYTES + 1];
+	g2_t d;
+
+	/* Parameters are shared with the main thread. */
+	if (core_init() != RLC_OK) {
+		pthread_exit(NULL);
+	}
+
+	g2_null(d);
+	g2_new(d);
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = st->port;
+	addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+	st->socket = socket(PF_INET, SOCK_STREAM, 0);
+	if (connect(st->socket, (struct sockaddr *)&addr, sizeof(addr)) == 0 &&
+			get_all(buffer, sizeof(buffer), &st->socket) == RLC_OK) {
+		g2_read_bin(d, buffer, sizeof(buffer));
+		if (cp_pbpsi_ans_strm(st->ss, d, get_set, put_all, st) != RLC_OK) {
+			printf("Send failed\n");
+		}
+	}
+	close(st->socket);
+
+	g2_free(d);
+	core_clean();
+	pthread_exit(NULL);
+}
+
+int main(int argc, char *argv[]) {
+	int server, client, len;
+	struct sockaddr_in addr;
+	socklen_t addr_len = sizeof(addr);
+	struct timespec start, stop;
+	uint8_t buffer[2 * RLC_PC_BYTES + 1];
+	stream_t st;
+	pthread_t tid;
+	bn_t sk, r, x[M], z[M];
+	g2_t d[M + 1], s[M + 1];
+	double secs;
+
+	if (core_init() != RLC_OK || pc_param_set_any() != RLC_OK) {
+		core_clean();
+		return 1;
+	}
+
+	bn_new(sk);
+	bn_new(r);
+	bn_new(st.q);
+	g1_new(st.ss);
+	for (int i = 0; i < M; i++) {
+		bn_new(x[i]);
+		bn_new(z[i]);
+	}
+	for (int i = 0; i <= M; i++) {
+		g2_new(d[i]);
+		g2_new(s[i]);
+	}
+
+	/* Compute the CRS explicitly. */
+	bn_read_str(sk, SK, strlen(SK), 16);
+	g1_mul_gen(st.ss, sk);
+	g2_get_gen(s[0]);
+	for (int i = 1; i <= M; i++) {
+		g2_mul(s[i], s[i - 1], sk);
+	}
+
+	pc_get_ord(st.q);
+	bn_set_dig(x[0], 1);
+	for (int j = 1; j < M; j++) {
+		bn_rand_mod(x[j], st.q);
+	}
+	cp_pbpsi_ask(d, r, x, s, M);
+
+	st.count = 0;
+	st.total = (argc > 1 ? atoi(argv[1]) : N);
+	st.bytes = 0;
+
+	/* Listen on an ephemeral loopback port. */
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = 0;
+	addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+	server = socket(PF_INET, SOCK_STREAM, 0);
+	if (bind(server, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+			listen(server, 1) != 0 ||
+			getsockname(server, (struct sockaddr *)&addr, &addr_len) != 0) {
+		printf("Error\n");
+		return 1;
+	}
+	st.port = addr.sin_port;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pthread_create(&tid, NULL, sender, &st);
+	client = accept(server, NULL, NULL);
+
+	g2_write_bin(buffer, sizeof(buffer), d[0], 1);
+	send(client, buffer, sizeof(buffer), 0);
+	if (cp_pbpsi_int_strm(z, &len, d, x, M, get_all, &client) != RLC_OK) {
+		printf("Receive failed\n");
+	}
+	pthread_join(tid, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &stop);
+
+	secs = (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) / 1e9;
+	printf("Intersection: %d\n", len);
+	printf("Elements: %d (M = %d) in %.3f s: %.1f elements/s, %.2f MiB/s\n",
+			st.total, M, secs, st.total / secs,
+			st.bytes / secs / (1024.0 * 1024.0));
+
+	close(client);
+	close(server);
+
+	bn_free(sk);
+	bn_free(r);
+	bn_free(st.q);
+	g1_free(st.ss);
+	for (int i = 0; i < M; i++) {
+		bn_free(x[i]);
+		bn_free(z[i]);
+	}
+	for (int i = 0; i <= M; i++) {
+		g2_free(d[i]);
+		g2_free(s[i]);
+	}
+	core_clean();
+	return 0;
+}
@@ -13,40 +13,20 @@
 
 pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 
-static int cp_pbpsi_inth(bn_t z[], int *len, g2_t d[], bn_t x[], int m,
-		uint8_t *t, g1_t u[], int n) {
-	int j, k, result = RLC_OK;
-	gt_t e;
-	uint8_t h[RLC_MD_LEN], buffer[12 * RLC_PC_BYTES];
-
-	gt_null(e);
-
-	RLC_TRY {
-		gt_new(e);
-
-		*len = 0;
-		if (m > 0) {
-			for (k = 0; k < m; k++) {
-				for (j = 0; j < n; j++) {
-					pc_map(e, u[j], d[k + 1]);
-					gt_write_bin(buffer, 12 * RLC_PC_BYTES, e, 0);
-					md_map(h, buffer, sizeof(buffer));
-					if (memcmp(h, t + j * RLC_MD_LEN, RLC_MD_LEN) == RLC_EQ &&
-							!gt_is_unity(e)) {
-						bn_copy(z[*len], x[k]);
-						(*len)++;
-					}
-				}
-			}
+/* Receives exactly len bytes of the streamed answer. */
+static int get_all(uint8_t *buf, size_t len, void *arg) {
+	int socket = *(int *)arg;
+	ssize_t r;
+
+	while (len > 0) {
+		r = recv(socket, buf, len, 0);
+		if (r <= 0) {
+			return RLC_ERR;
 		}
+		buf += r;
+		len -= r;
 	}
-	RLC_CATCH_ANY {
-		result = RLC_ERR;
-	}
-	RLC_FINALLY {
-		gt_free(e);
-	}
-	return result;
+	return RLC_OK;
 }
 
 bn_t sk;
@@ -54,7 +34,7 @@ g1_t ss;
 g2_t *s;
 
 void *socketThread(void *arg) {
-	uint8_t buffer[4 * RLC_PC_BYTES + 1];
+	uint8_t buffer[2 * RLC_PC_BYTES + 1];
 
 	if (core_init() != RLC_OK) {
 		goto end;
@@ -65,9 +45,8 @@ void *socketThread(void *arg) {
 	}
 
 	bn_t q, r, *x = (bn_t *)RLC_ALLOCA(bn_t, M);
-	g1_t *u = (g1_t *) RLC_ALLOCA(g1_t, N);
+	bn_t *z = (bn_t *)RLC_ALLOCA(bn_t, M);
 	g2_t *d = (g2_t *) RLC_ALLOCA(g2_t, (M + 1));
-	uint8_t *t = (uint8_t *)RLC_ALLOCA(uint8_t, N * RLC_MD_LEN);
 	int len = 0;
 
 	bn_null(q);
@@ -75,14 +54,12 @@ void *socketThread(void *arg) {
 
 	bn_new(q);
 	bn_new(r);
-	for (int i = 0; i < N; i++) {
-		g1_null(u[i]);
-		g1_new(u[i]);
-	}
 	for (int i = 0; i < M; i++) {
 		bn_null(x[i]);
+		bn_null(z[i]);
 		g2_null(d[i]);
 		bn_new(x[i]);
+		bn_new(z[i]);
 		g2_new(d[i]);
 	}
 	g2_null(d[M]);
@@ -103,17 +80,14 @@ void *socketThread(void *arg) {
 
 	send(newSocket, "Hello", strlen("Hello"), 0);
 
-	// Send accumulator to the client socket
-	g2_write_bin(buffer, 4 * RLC_PC_BYTES + 1, d[0], 0);
-	send(newSocket, buffer, 4 * RLC_PC_BYTES + 1, 0);
+	// Send compressed accumulator to the client socket
+	g2_write_bin(buffer, sizeof(buffer), d[0], 1);
+	send(newSocket, buffer, sizeof(buffer), 0);
 
-	for (int i = 0; i < N; i++) {
-		recv(newSocket, buffer, RLC_MD_LEN + 2 * RLC_PC_BYTES + 1, 0);
-		memcpy(t + i * RLC_MD_LEN, buffer, RLC_MD_LEN);
-		g1_read_bin(u[i], buffer + RLC_MD_LEN, 2 * RLC_PC_BYTES + 1);
+	// Intersect chunk by chunk while the answer is still arriving
+	if (cp_pbpsi_int_strm(z, &len, d, x, M, get_all, &newSocket) != RLC_OK) {
+		printf("Receive failed\n");
 	}
-
-	cp_pbpsi_inth(x, &len, d, x, M, t, u, N);
 	printf("%d\n", len);
 
 	bench_after();
@@ -126,13 +100,16 @@ void *socketThread(void *arg) {
 
 	bn_free(q);
 	bn_free(r);
+	for (int i = 0; i < M; i++) {
+		bn_free(x[i]);
+		bn_free(z[i]);
+	}
 	for (int i = 0; i <= M; i++) {
 		g2_free(d[i]);
 	}
 	RLC_FREE(x);
-	RLC_FREE(u);
+	RLC_FREE(z);
 	RLC_FREE(d);
-	RLC_FREE(t);
 	core_clean();
 
 	pthread_exit(NULL);
@@ -13,18 +13,55 @@
 
 #define INSTANCES 1
 
+/* State of the streaming answer: the socket and the set generator. */
+typedef struct {
+	int socket;
+	int count;
+	bn_t q;
+} stream_t;
+
+/* Produces the next elements of the sender set, never holding all of them. */
+static int get_set(bn_t *y, int n, void *arg) {
+	stream_t *st = (stream_t *)arg;
+	int i;
+
+	for (i = 0; i < n && st->count < N; i++, st->count++) {
+		if (st->count == 0) {
+			bn_set_dig(y[i], 1);
+		} else {
+			bn_rand_mod(y[i], st->q);
+		}
+	}
+	return i;
+}
+
+/* Sends a whole chunk, which the kernel transfers while the next is computed. */
+static int put_all(const uint8_t *buf, size_t len, void *arg) {
+	stream_t *st = (stream_t *)arg;
+	ssize_t r;
+
+	while (len > 0) {
+		r = send(st->socket, buf, len, 0);
+		if (r <= 0) {
+			return RLC_ERR;
+		}
+		buf += r;
+		len -= r;
+	}
+	return RLC_OK;
+}
+
 void *clientThread(void *arg) {
 	printf("In thread\n");
 	int clientSocket;
 	struct sockaddr_in serverAddr;
 	socklen_t addr_size;
 
-	uint8_t buffer[4 * RLC_PC_BYTES + 1];
-	uint8_t tmp[12 * RLC_PC_BYTES];
-	bn_t q, *y = (bn_t *)RLC_ALLOCA(bn_t, N);
-	g1_t ss, *u = (g1_t *) RLC_ALLOCA(g1_t, N);
+	uint8_t buffer[2 * RLC_PC_BYTES + 1];
+	stream_t st;
+	bn_t q;
+	g1_t ss;
 	g2_t d, *s = (g2_t *) RLC_ALLOCA(g2_t, (M + 1));
-	gt_t *t = (gt_t *) RLC_ALLOCA(gt_t, N);
 
 	// Create the socket.
 	clientSocket = socket(PF_INET, SOCK_STREAM, 0);
@@ -54,14 +91,8 @@ void *clientThread(void *arg) {
 	g1_new(ss);
 	g2_null(d);
 	g2_new(d);
-	for (int i = 0; i < N; i++) {
-		bn_null(y[i]);
-		g1_null(u[i]);
-		gt_null(t[i]);
-		bn_new(y[i]);
-		g1_new(u[i]);
-		gt_new(t[i]);
-	}
+	bn_null(st.q);
+	bn_new(st.q);
 	for (int i = 0; i <= M; i++) {
 		g2_null(s[i]);
 		g2_new(s[i]);
@@ -75,40 +106,30 @@ void *clientThread(void *arg) {
 		g2_mul(s[i], s[i - 1], q);
 	}
 
-	pc_get_ord(q);
-	bn_set_dig(y[0], 1);
-	for (int j = 1; j < N; j++) {
-		bn_rand_mod(y[j], q);
-	}
+	pc_get_ord(st.q);
+	st.socket = clientSocket;
+	st.count = 0;
 
 	//Connect the socket to the server using the address
 	addr_size = sizeof serverAddr;
 	connect(clientSocket, (struct sockaddr *)&serverAddr, addr_size);
 
 	//Read the message from the server into the buffer
-	if (recv(clientSocket, buffer, strlen("Hello"), 0) < 0) {
+	if (recv(clientSocket, buffer, strlen("Hello"), MSG_WAITALL) < 0) {
 		printf("Receive failed\n");
 	}
 
 	bench_reset();
 	bench_before();
 
-	//Read the message from the server into the buffer
-	if (recv(clientSocket, buffer, 4 * RLC_PC_BYTES + 1, 0) < 0) {
+	//Read the compressed accumulator from the server
+	if (recv(clientSocket, buffer, sizeof(buffer), MSG_WAITALL) < 0) {
 		printf("Receive failed\n");
 	}
-	g2_read_bin(d, buffer, 4 * RLC_PC_BYTES + 1);
+	g2_read_bin(d, buffer, sizeof(buffer));
 
-	cp_pbpsi_ans(t, u, ss, d, y, N);
-
-	for (int i = 0; i < N; i++) {
-		gt_write_bin(tmp, 12 * RLC_PC_BYTES, t[i], 0);
-		md_map(buffer, tmp, 12 * RLC_PC_BYTES);
-		g1_write_bin(buffer + RLC_MD_LEN, 2 * RLC_PC_BYTES + 1, u[i], 0);
-		if (send(clientSocket, buffer, RLC_MD_LEN + 2 * RLC_PC_BYTES + 1,
-						0) < 0) {
-			printf("Send failed\n");
-		}
+	if (cp_pbpsi_ans_strm(ss, d, get_set, put_all, &st) != RLC_OK) {
+		printf("Send failed\n");
 	}
 
 	bench_after();
@@ -120,20 +141,14 @@ void *clientThread(void *arg) {
 	close(clientSocket);
 
 	bn_free(q);
+	bn_free(st.q);
 	g1_free(ss);
-	for (int i = 0; i < N; i++) {
-		bn_free(y[i]);
-		g1_free(u[i]);
-		gt_free(t[i]);
-	}
+	g2_free(d);
 	for (int i = 0; i <= M; i++) {
 		g2_free(s[i]);
 	}
 	core_clean();
-	RLC_FREE(y);
-	RLC_FREE(u);
 	RLC_FREE(s);
-	RLC_FREE(t);
 
 	pthread_exit(NULL);
 }
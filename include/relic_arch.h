@@ -43,6 +43,34 @@
 #include <avr/pgmspace.h>
 #endif
 
+/*============================================================================*/
+/* Constant definitions                                                       */
+/*============================================================================*/
+
+#if ARCH == X64
+
+/**
+ * Flag for the AES-NI and carry-less multiplication extensions with SSSE3.
+ */
+#define RLC_X64_AES				0x01
+
+/**
+ * Flag for the vector AES and carry-less multiplication extensions with AVX2.
+ */
+#define RLC_X64_VAES			0x02
+
+/**
+ * Flag for the SHA extensions with SSE4.1.
+ */
+#define RLC_X64_SHA				0x04
+
+/**
+ * Flag for the AVX2 and BMI2 extensions.
+ */
+#define RLC_X64_AVX2			0x08
+
+#endif
+
 /*============================================================================*/
 /* Macro definitions                                                          */
 /*============================================================================*/
@@ -113,4 +141,17 @@ void arch_copy_rom(char *dest, const char *src, int len);
 
 #endif
 
+#if ARCH == X64
+
+/**
+ * Tests if the processor supports a set of instruction set extensions, as
+ * detected during architecture-dependent initialization.
+ *
+ * @param[in] ext		- the bitwise OR of the extension flags.
+ * @return a boolean value indicating if all extensions are supported.
+ */
+int arch_has(int ext);
+
+#endif
+
 #endif /* !RLC_ARCH_H */
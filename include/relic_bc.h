@@ -49,6 +49,47 @@
  */
 #define RLC_BC_LEN					16
 
+/**
+ * Length in bytes of the nonce used in authenticated encryption.
+ */
+#define RLC_BC_IV					12
+
+/**
+ * Length in bytes of the authentication tag.
+ */
+#define RLC_BC_TAG					16
+
+/*============================================================================*/
+/* Type definitions                                                           */
+/*============================================================================*/
+
+/**
+ * Represents an AES key expanded for encryption. The backend is chosen when
+ * the key is expanded, according to the instructions supported by the
+ * processor.
+ */
+typedef struct {
+	/** The round keys as big-endian words, for up to 14 rounds. */
+	uint32_t rk[60];
+	/** The round keys as bytes, in the layout of the AES instructions. */
+	uint8_t rb[15][RLC_BC_LEN];
+	/** The number of rounds. */
+	int rounds;
+	/** The powers of the GHASH key from H^16 down to H, byte-reflected. */
+	uint8_t h[16][RLC_BC_LEN];
+	/** The lower halves of the multiples of H in the GHASH table. */
+	uint64_t hl[16];
+	/** The upper halves of the multiples of H in the GHASH table. */
+	uint64_t hh[16];
+	/** The backend used with this key. */
+	int ni;
+} aes_st;
+
+/**
+ * Pointer to an expanded AES key.
+ */
+typedef aes_st aes_t[1];
+
 /*============================================================================*/
 /* Function prototypes                                                        */
 /*============================================================================*/
@@ -81,4 +122,77 @@ int bc_aes_cbc_enc(uint8_t *out, int *out_len, uint8_t *in,
 int bc_aes_cbc_dec(uint8_t *out, int *out_len, uint8_t *in,
 		int in_len, uint8_t *key, int key_len, uint8_t *iv);
 
+/**
+ * Expands an AES key for encryption in CTR and GCM modes.
+ *
+ * @param[out] k			- the expanded key.
+ * @param[in] key			- the key.
+ * @param[in] key_len		- the key size in bytes.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int bc_aes_key(aes_t k, const uint8_t *key, int key_len);
+
+/**
+ * Encrypts with AES in CTR mode. The last 32 bits of the counter block are
+ * incremented as a big-endian integer after each block.
+ *
+ * @param[out] out			- the resulting ciphertext.
+ * @param[in,out] out_len	- the buffer capacity and number of bytes written.
+ * @param[in] in			- the bytes to be encrypted.
+ * @param[in] in_len		- the number of bytes to encrypt.
+ * @param[in] k				- the expanded key.
+ * @param[in] iv			- the initial counter block.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int bc_aes_ctr_enc(uint8_t *out, int *out_len, const uint8_t *in, int in_len,
+		const aes_t k, const uint8_t *iv);
+
+/**
+ * Decrypts with AES in CTR mode.
+ *
+ * @param[out] out			- the resulting plaintext.
+ * @param[in,out] out_len	- the buffer capacity and number of bytes written.
+ * @param[in] in			- the bytes to be decrypted.
+ * @param[in] in_len		- the number of bytes to decrypt.
+ * @param[in] k				- the expanded key.
+ * @param[in] iv			- the initial counter block.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int bc_aes_ctr_dec(uint8_t *out, int *out_len, const uint8_t *in, int in_len,
+		const aes_t k, const uint8_t *iv);
+
+/**
+ * Encrypts and authenticates with AES in GCM mode. The authentication tag is
+ * appended to the ciphertext.
+ *
+ * @param[out] out			- the resulting ciphertext and tag.
+ * @param[in,out] out_len	- the buffer capacity and number of bytes written.
+ * @param[in] in			- the bytes to be encrypted.
+ * @param[in] in_len		- the number of bytes to encrypt.
+ * @param[in] ad			- the associated data.
+ * @param[in] ad_len		- the number of bytes of associated data.
+ * @param[in] k				- the expanded key.
+ * @param[in] iv			- the nonce of RLC_BC_IV bytes.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int bc_aes_gcm_enc(uint8_t *out, int *out_len, const uint8_t *in, int in_len,
+		const uint8_t *ad, int ad_len, const aes_t k, const uint8_t *iv);
+
+/**
+ * Decrypts and verifies with AES in GCM mode. The output is erased if the
+ * authentication tag is invalid.
+ *
+ * @param[out] out			- the resulting plaintext.
+ * @param[in,out] out_len	- the buffer capacity and number of bytes written.
+ * @param[in] in			- the ciphertext followed by the tag.
+ * @param[in] in_len		- the number of bytes to decrypt, including the tag.
+ * @param[in] ad			- the associated data.
+ * @param[in] ad_len		- the number of bytes of associated data.
+ * @param[in] k				- the expanded key.
+ * @param[in] iv			- the nonce of RLC_BC_IV bytes.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int bc_aes_gcm_dec(uint8_t *out, int *out_len, const uint8_t *in, int in_len,
+		const uint8_t *ad, int ad_len, const aes_t k, const uint8_t *iv);
+
 #endif /* !RLC_BC_H */
@@ -617,7 +617,28 @@ void bn_rand(bn_t a, int sign, int bits);
  * @param[out] a			- the multiple precision integer to assign.
  * @param[in] b				- the modulus.
  */
-void bn_rand_mod(bn_t a, bn_t b);
+void bn_rand_mod(bn_t a, const bn_t b);
+
+/**
+ * Assigns random values to multiple precision integers simultaneously, drawing
+ * all the required bytes from the pseudo-random number generator at once.
+ *
+ * @param[out] a			- the multiple precision integers to assign.
+ * @param[in] n				- the number of integers.
+ * @param[in] bits			- the number of bits.
+ */
+void bn_rand_sim(bn_t *a, int n, int bits);
+
+/**
+ * Assigns non-zero random values smaller than a given modulus to multiple
+ * precision integers simultaneously. The modulus must not be one of the
+ * outputs.
+ *
+ * @param[out] a			- the multiple precision integers to assign.
+ * @param[in] n				- the number of integers.
+ * @param[in] b				- the modulus.
+ */
+void bn_rand_mod_sim(bn_t *a, int n, const bn_t b);
 
 /**
  * Prints a multiple precision integer to standard output.
@@ -1535,4 +1556,34 @@ void bn_lag(bn_t *c, const bn_t *a, const bn_t b, int n);
  */
 void bn_evl(bn_t c, const bn_t *a, const bn_t x, const bn_t b, int n);
 
+/**
+ * Evaluates a polynomial over several values in a modular way, given the n
+ * coefficients of the polynomial and the modulus. Uses subproduct trees and
+ * fast polynomial multiplication for large inputs.
+ * Computes c_i = a(x_i) mod q for 0 <= i < m.
+ *
+ * @param[out] c 			- the results of the evaluations.
+ * @param[in] a 			- the coefficients of the polynomial.
+ * @param[in] x				- the values to evaluate.
+ * @param[in] b				- the modulus.
+ * @param[in] n				- the number of coefficients.
+ * @param[in] m				- the number of values.
+ */
+void bn_evl_sim(bn_t *c, const bn_t *a, const bn_t *x, const bn_t b, int n,
+		int m);
+
+/**
+ * Computes the coefficients of the polynomial of degree smaller than n that
+ * interpolates n points with distinct abscissae modulo a prime.
+ * Computes c(x) such that c(x_i) = y_i mod q for 0 <= i < n.
+ *
+ * @param[out] c 			- the n coefficients of the polynomial.
+ * @param[in] x				- the abscissae of the points.
+ * @param[in] y				- the ordinates of the points.
+ * @param[in] b				- the prime modulus.
+ * @param[in] n				- the number of points.
+ * @throw ERR_NO_VALID		- if the abscissae are not distinct.
+ */
+void bn_itp(bn_t *c, const bn_t *x, const bn_t *y, const bn_t b, int n);
+
 #endif /* !RLC_BN_H */
@@ -130,24 +130,13 @@
 /*============================================================================*/
 
 /**
- * Library context.
+ * Library parameters and precomputed tables. These are read-only after
+ * configuration and can be shared by several library contexts, such as the
+ * ones belonging to different threads.
  */
-typedef struct _ctx_t {
-	/** The value returned by the last call, can be RLC_OK or RLC_ERR. */
-	int code;
-
-#ifdef CHECK
-	/** The state of the last error caught. */
-	sts_t *last;
-	/** Error state to be used outside try-catch blocks. */
-	sts_t error;
-	/** Error number to be used outside try-catch blocks. */
-	err_t number;
-	/** The error message respective to the last error. */
-	char *reason[ERR_MAX];
-	/** A flag to indicate if the last error was already caught. */
-	int caught;
-#endif /* CHECK */
+typedef struct _params_t {
+	/** Number of library contexts currently referencing these parameters. */
+	int refs;
 
 #ifdef WITH_FB
 	/** Identifier of the currently configured binary field. */
@@ -242,6 +231,14 @@ typedef struct _ctx_t {
 	int cnr;
 	/** 2-adicity. */
 	int ad2;
+	/** Exponent (q - 1)/2 for square roots, where p - 1 = 2^ad2 * q. */
+	bn_st srt;
+	/** Power (1/qnr)^((q + 1)/2) for square roots of non-residues. */
+	fp_st srt_r;
+	/** Powers of a root of unity of order 2^RLC_FP_SRT_WIN for lookups. */
+	fp_st srt_g[1 << RLC_FP_SRT_WIN];
+	/** Powers z^(-2^i) of the 2^ad2-th root of unity z = qnr^q. */
+	fp_st srt_z[RLC_FP_SRT_MAX];
 #if FP_RDC == QUICK || !defined(STRIP)
 	/** Sparse representation of prime modulus. */
 	int sps[RLC_TERMS + 1];
@@ -406,6 +403,30 @@ typedef struct _ctx_t {
 #if defined(WITH_PC)
 	gt_t gt_g;
 #endif
+} params_t;
+
+/**
+ * Library context.
+ */
+typedef struct _ctx_t {
+	/** The value returned by the last call, can be RLC_OK or RLC_ERR. */
+	int code;
+
+#ifdef CHECK
+	/** The state of the last error caught. */
+	sts_t *last;
+	/** Error state to be used outside try-catch blocks. */
+	sts_t error;
+	/** Error number to be used outside try-catch blocks. */
+	err_t number;
+	/** The error message respective to the last error. */
+	char *reason[ERR_MAX];
+	/** A flag to indicate if the last error was already caught. */
+	int caught;
+#endif /* CHECK */
+
+	/** Parameters and precomputed tables shared by this context. */
+	params_t *params;
 
 #if BENCH > 0
 	/** Stores the time measured before the execution of the benchmark. */
@@ -444,6 +465,8 @@ typedef struct _ctx_t {
 	unsigned int (*lzcnt_ptr)(unsigned int);
 #elif ARCH == X64
 	unsigned int (*lzcnt_ptr)(ull_t);
+	/** Instruction set extensions supported by the processor. */
+	int ext;
 #endif
 } ctx_t;
 
@@ -479,6 +502,26 @@ ctx_t *core_get(void);
  */
 void core_set(ctx_t *ctx);
 
+/**
+ * Returns a pointer to the parameters and precomputed tables referenced by
+ * the current library context. Contexts initialized in the same process share
+ * a single copy until one of them changes parameters.
+ *
+ * @return a pointer to the library parameters.
+ */
+params_t *core_par_get(void);
+
+/**
+ * Gives the current library context a private copy of the parameters it
+ * shares with other contexts, so that changing them does not affect the
+ * others. Must be called before writing to the parameters, which should be
+ * chosen before creating the contexts that will share them.
+ *
+ * @return a pointer to the library parameters owned by the current context.
+ * @throw ERR_NO_MEMORY		- if there is not enough memory for the copy.
+ */
+params_t *core_par_own(void);
+
 #if defined(MULTI)
 
 #include "relic_multi.h"
@@ -42,8 +42,23 @@
 #include "relic_bn.h"
 #include "relic_ec.h"
 #include "relic_pc.h"
+#include "relic_bc.h"
 #include "relic_mpc.h"
 
+/*============================================================================*/
+/* Constant definitions                                                       */
+/*============================================================================*/
+
+/**
+ * Number of plaintext bytes sealed in each chunk of an encrypted stream.
+ */
+#define RLC_CP_CHUNK		65536
+
+/**
+ * Maximum number of set elements sent in each chunk of a streaming PSI answer.
+ */
+#define RLC_CP_BATCH		256
+
 /*============================================================================*/
 /* Type definitions.                                                          */
 /*============================================================================*/
@@ -261,6 +276,64 @@ typedef etrs_st etrs_t[1];
 typedef etrs_st *etrs_t;
 #endif
 
+/**
+ * Represents a precomputed ECDSA nonce used for online signing.
+ */
+typedef struct _ecdsa_pre_st {
+	/** The inverse of the nonce modulo the group order. */
+	bn_t k;
+	/** The first component of the signature, x([k]G) mod n. */
+	bn_t r;
+} ecdsa_pre_st;
+
+/**
+ * Pointer to a precomputed ECDSA nonce.
+ */
+#if ALLOC == AUTO
+typedef ecdsa_pre_st ecdsa_pre_t[1];
+#else
+typedef ecdsa_pre_st *ecdsa_pre_t;
+#endif
+
+/**
+ * Represents an encrypted stream, sealed with AES-GCM in chunks of
+ * RLC_CP_CHUNK bytes. The last chunk is marked in its nonce, so truncation
+ * is detected.
+ */
+typedef struct _strm_st {
+	/** The expanded symmetric key. */
+	aes_t key;
+	/** The buffer holding the current chunk. */
+	uint8_t *buf;
+	/** The number of bytes in the buffer. */
+	size_t len;
+	/** The index of the next chunk. */
+	uint32_t seq;
+	/** The flag indicating if the stream decrypts. */
+	int dec;
+	/** The flag indicating if the stream was finished or failed. */
+	int end;
+} strm_st;
+
+/**
+ * Pointer to an encrypted stream.
+ */
+#if ALLOC == AUTO
+typedef strm_st strm_t[1];
+#else
+typedef strm_st *strm_t;
+#endif
+
+/**
+ * Represents an output buffer in a list of buffers.
+ */
+typedef struct {
+	/** The start of the buffer. */
+	uint8_t *buf;
+	/** The capacity of the buffer in bytes. */
+	size_t len;
+} strm_iov_t;
+
 
 /*============================================================================*/
 /* Macro definitions                                                          */
@@ -727,6 +800,110 @@ typedef etrs_st *etrs_t;
 #define etrs_free(A)		/* empty */
 #endif
 
+/**
+ * Initializes a precomputed ECDSA nonce with a null value.
+ *
+ * @param[out] A			- the precomputed nonce to initialize.
+ */
+#define ecdsa_pre_null(A)		RLC_NULL(A)
+
+/**
+ * Calls a function to allocate and initialize a precomputed ECDSA nonce.
+ *
+ * @param[out] A			- the new precomputed nonce.
+ */
+#if ALLOC == DYNAMIC
+#define ecdsa_pre_new(A)													\
+	A = (ecdsa_pre_t)calloc(1, sizeof(ecdsa_pre_st));						\
+	if (A == NULL) {														\
+		RLC_THROW(ERR_NO_MEMORY);											\
+	}																		\
+	bn_new((A)->k);															\
+	bn_new((A)->r);															\
+
+#elif ALLOC == AUTO
+#define ecdsa_pre_new(A)													\
+	bn_new((A)->k);															\
+	bn_new((A)->r);															\
+
+#endif
+
+/**
+ * Calls a function to clean and free a precomputed ECDSA nonce.
+ *
+ * @param[out] A			- the precomputed nonce to clean and free.
+ */
+#if ALLOC == DYNAMIC
+#define ecdsa_pre_free(A)													\
+	if (A != NULL) {														\
+		bn_free((A)->k);													\
+		bn_free((A)->r);													\
+		free(A);															\
+		A = NULL;															\
+	}
+
+#elif ALLOC == AUTO
+#define ecdsa_pre_free(A)		/* empty */
+#endif
+
+/**
+ * Initializes an encrypted stream with a null value.
+ *
+ * @param[out] A			- the stream to initialize.
+ */
+#define strm_null(A)			RLC_NULL(A)
+
+/**
+ * Calls a function to allocate and initialize an encrypted stream, including
+ * its buffer of one chunk.
+ *
+ * @param[out] A			- the new stream.
+ */
+#if ALLOC == DYNAMIC
+#define strm_new(A)															\
+	A = (strm_t)calloc(1, sizeof(strm_st));									\
+	if (A == NULL) {														\
+		RLC_THROW(ERR_NO_MEMORY);											\
+	}																		\
+	(A)->buf = (uint8_t *)malloc(RLC_CP_CHUNK + RLC_BC_TAG);				\
+	if ((A)->buf == NULL) {													\
+		RLC_THROW(ERR_NO_MEMORY);											\
+	}																		\
+	(A)->end = 1;															\
+
+#elif ALLOC == AUTO
+#define strm_new(A)															\
+	(A)->buf = (uint8_t *)malloc(RLC_CP_CHUNK + RLC_BC_TAG);				\
+	if ((A)->buf == NULL) {													\
+		RLC_THROW(ERR_NO_MEMORY);											\
+	}																		\
+	(A)->len = (A)->seq = 0;												\
+	(A)->end = 1;															\
+
+#endif
+
+/**
+ * Calls a function to clean and free an encrypted stream.
+ *
+ * @param[out] A			- the stream to clean and free.
+ */
+#if ALLOC == DYNAMIC
+#define strm_free(A)														\
+	if (A != NULL) {														\
+		cp_strm_clean(A);													\
+		free((A)->buf);														\
+		free(A);															\
+		A = NULL;															\
+	}
+
+#elif ALLOC == AUTO
+#define strm_free(A)														\
+	cp_strm_clean(A);														\
+	free((A)->buf);															\
+	(A)->buf = NULL;														\
+
+#endif
+
 /*============================================================================*/
 /* Function prototypes                                                        */
 /*============================================================================*/
@@ -1038,14 +1215,15 @@ int cp_ecmqv_key(uint8_t *key, int key_len, bn_t d1, bn_t d2, ec_t q2u,
 int cp_ecies_gen(bn_t d, ec_t q);
 
 /**
- * Encrypts using the ECIES cryptosystem.
+ * Encrypts using the ECIES cryptosystem. The message is encrypted with
+ * AES-GCM under a key derived from the shared secret, so the output is
+ * RLC_BC_TAG bytes longer than the input.
  *
  * @param[out] r			- the resulting elliptic curve point.
  * @param[out] out			- the output buffer.
  * @param[in, out] out_len	- the buffer capacity and number of bytes written.
  * @param[in] in			- the input buffer.
  * @param[in] in_len		- the number of bytes to encrypt.
- * @param[in] iv			- the block cipher initialization vector.
  * @param[in] q				- the public key.
  * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
  */
@@ -1057,15 +1235,107 @@ int cp_ecies_enc(ec_t r, uint8_t *out, int *out_len, uint8_t *in, int in_len,
  *
  * @param[out] out			- the output buffer.
  * @param[in, out] out_len	- the buffer capacity and number of bytes written.
+ * @param[in] r				- the elliptic curve point.
  * @param[in] in			- the input buffer.
- * @param[in] in_len		- the number of bytes to encrypt.
- * @param[in] iv			- the block cipher initialization vector.
+ * @param[in] in_len		- the number of bytes to decrypt.
  * @param[in] d				- the private key.
  * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
  */
 int cp_ecies_dec(uint8_t *out, int *out_len, ec_t r, uint8_t *in, int in_len,
 		bn_t d);
 
+/**
+ * Starts encrypting a stream using the ECIES cryptosystem. The key agreement
+ * is done once, and the stream is then sealed chunk by chunk.
+ *
+ * @param[out] r			- the resulting elliptic curve point.
+ * @param[out] s			- the stream to initialize.
+ * @param[in] q				- the public key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_ecies_enc_init(ec_t r, strm_t s, ec_t q);
+
+/**
+ * Starts decrypting a stream using the ECIES cryptosystem.
+ *
+ * @param[out] s			- the stream to initialize.
+ * @param[in] r				- the elliptic curve point.
+ * @param[in] d				- the private key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_ecies_dec_init(strm_t s, ec_t r, bn_t d);
+
+/**
+ * Starts an encrypted stream under a symmetric key. A key must never be used
+ * for more than one stream.
+ *
+ * @param[out] s			- the stream to initialize.
+ * @param[in] key			- the key.
+ * @param[in] key_len		- the key size in bytes.
+ * @param[in] dec			- the flag indicating if the stream decrypts.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_strm_init(strm_t s, const uint8_t *key, int key_len, int dec);
+
+/**
+ * Returns the number of bytes written by the next update of a stream.
+ *
+ * @param[in] s				- the stream.
+ * @param[in] in_len		- the number of input bytes of the update.
+ * @return the number of output bytes.
+ */
+size_t cp_strm_size(const strm_t s, size_t in_len);
+
+/**
+ * Encrypts or decrypts the next part of a stream. Only complete chunks are
+ * written, and at most one chunk is kept in the stream. Decrypted bytes are
+ * written only after their chunk is authenticated.
+ *
+ * @param[out] out			- the output buffer.
+ * @param[in, out] out_len	- the buffer capacity and number of bytes written.
+ * @param[in] in			- the input buffer.
+ * @param[in] in_len		- the number of input bytes.
+ * @param[in,out] s			- the stream.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_strm_update(uint8_t *out, size_t *out_len, const uint8_t *in,
+		size_t in_len, strm_t s);
+
+/**
+ * Encrypts or decrypts the next part of a stream into a list of buffers.
+ * Chunks that fit in a buffer are written there directly.
+ *
+ * @param[out] out			- the output buffers.
+ * @param[in] out_cnt		- the number of output buffers.
+ * @param[out] out_len		- the number of bytes written.
+ * @param[in] in			- the input buffer.
+ * @param[in] in_len		- the number of input bytes.
+ * @param[in,out] s			- the stream.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_strm_updatev(const strm_iov_t *out, int out_cnt, size_t *out_len,
+		const uint8_t *in, size_t in_len, strm_t s);
+
+/**
+ * Finishes a stream, writing or authenticating the last chunk. Decryption
+ * fails if the stream was truncated. The stream is erased afterwards, except
+ * when the output buffer is too short: then the required length is returned
+ * in out_len and the call can be retried with a larger buffer.
+ *
+ * @param[out] out			- the output buffer.
+ * @param[in, out] out_len	- the buffer capacity and number of bytes written.
+ * @param[in,out] s			- the stream.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_strm_final(uint8_t *out, size_t *out_len, strm_t s);
+
+/**
+ * Erases the key and buffered data of a stream.
+ *
+ * @param[in,out] s			- the stream.
+ */
+void cp_strm_clean(strm_t s);
+
 /**
  * Generates an ECDSA key pair.
  *
@@ -1088,6 +1358,50 @@ int cp_ecdsa_gen(bn_t d, ec_t q);
  */
 int cp_ecdsa_sig(bn_t r, bn_t s, uint8_t *msg, int len, int hash, bn_t d);
 
+/**
+ * Signs a message using ECDSA and outputs a hint for recovering the point R
+ * during batch verification. The hint stores the parity bit of the
+ * y-coordinate of R and the quotient of its x-coordinate by the group order,
+ * or is negative if the quotient does not fit.
+ *
+ * @param[out] r			- the first component of the signature.
+ * @param[out] s			- the second component of the signature.
+ * @param[out] v			- the recovery hint.
+ * @param[in] msg			- the message to sign.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] hash			- the flag to indicate the message format.
+ * @param[in] d				- the private key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_ecdsa_sig_ext(bn_t r, bn_t s, int *v, uint8_t *msg, int len, int hash,
+		bn_t d);
+
+/**
+ * Fills a pool of precomputed ECDSA nonces for online signing. The nonce
+ * points are normalized and the nonces inverted simultaneously.
+ *
+ * @param[out] pool			- the precomputed nonces.
+ * @param[in] n				- the number of nonces to compute.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_ecdsa_pre(ecdsa_pre_t *pool, int n);
+
+/**
+ * Signs a message using ECDSA and a precomputed nonce. The nonce is erased
+ * after use and cannot be used to sign another message.
+ *
+ * @param[out] r			- the first component of the signature.
+ * @param[out] s			- the second component of the signature.
+ * @param[in] msg			- the message to sign.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] hash			- the flag to indicate the message format.
+ * @param[in] d				- the private key.
+ * @param[in,out] pre		- the precomputed nonce.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_ecdsa_sig_fast(bn_t r, bn_t s, uint8_t *msg, int len, int hash,
+		bn_t d, ecdsa_pre_t pre);
+
 /**
  * Verifies a message signed with ECDSA using the basic method.
  *
@@ -1101,6 +1415,29 @@ int cp_ecdsa_sig(bn_t r, bn_t s, uint8_t *msg, int len, int hash, bn_t d);
  */
 int cp_ecdsa_ver(bn_t r, bn_t s, uint8_t *msg, int len, int hash, ec_t q);
 
+/**
+ * Verifies a batch of messages signed with ECDSA. The points R are recovered
+ * from the hints and checked together with a single simultaneous
+ * multiplication with random 128-bit weights. Signatures with a negative hint
+ * are verified individually. This happens when the quotient of x(R) by the
+ * group order does not fit in the hint, as on B12-P381. On curves with a
+ * non-trivial cofactor, including B12-P381, all signatures are verified
+ * individually, because neither the recovered points nor the public keys are
+ * checked for membership in the prime-order subgroup.
+ *
+ * @param[in] r				- the first components of the signatures.
+ * @param[in] s				- the second components of the signatures.
+ * @param[in] v				- the recovery hints.
+ * @param[in] msg			- the signed messages.
+ * @param[in] len			- the message lengths in bytes.
+ * @param[in] hash			- the flag to indicate the message format.
+ * @param[in] q				- the public keys.
+ * @param[in] n				- the number of signatures.
+ * @return a boolean value indicating if all signatures are valid.
+ */
+int cp_ecdsa_ver_batch(bn_t r[], bn_t s[], int v[], uint8_t *msg[], int len[],
+		int hash, ec_t q[], int n);
+
 /**
  * Generates an Elliptic Curve Schnorr Signature key pair.
  *
@@ -1135,6 +1472,129 @@ int cp_ecss_sig(bn_t e, bn_t s, uint8_t *msg, int len, bn_t d);
  */
 int cp_ecss_ver(bn_t e, bn_t s, uint8_t *msg, int len, ec_t q);
 
+/**
+ * Signs a message using the Elliptic Curve Schnorr Signature variant that
+ * outputs the commitment point R, binding the public key to the challenge.
+ *
+ * @param[out] r			- the first component of the signature.
+ * @param[out] s			- the second component of the signature.
+ * @param[in] msg			- the message to sign.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] d				- the private key.
+ * @param[in] q				- the public key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_ecss_sig_ext(ec_t r, bn_t s, uint8_t *msg, int len, bn_t d, ec_t q);
+
+/**
+ * Verifies a message signed with the Elliptic Curve Schnorr Signature variant
+ * that outputs the commitment point R.
+ *
+ * @param[in] r				- the first component of the signature.
+ * @param[in] s				- the second component of the signature.
+ * @param[in] msg			- the message to verify.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] q				- the public key.
+ * @return a boolean value indicating if the signature is valid.
+ */
+int cp_ecss_ver_ext(ec_t r, bn_t s, uint8_t *msg, int len, ec_t q);
+
+/**
+ * Verifies a batch of messages signed with the Elliptic Curve Schnorr
+ * Signature variant that outputs the commitment point R, using a single
+ * simultaneous multiplication with random 128-bit weights. On curves with a
+ * non-trivial cofactor, the signatures are verified individually instead.
+ *
+ * @param[in] r				- the first components of the signatures.
+ * @param[in] s				- the second components of the signatures.
+ * @param[in] msg			- the signed messages.
+ * @param[in] len			- the message lengths in bytes.
+ * @param[in] q				- the public keys.
+ * @param[in] n				- the number of signatures.
+ * @return a boolean value indicating if all signatures are valid.
+ */
+int cp_ecss_ver_batch(ec_t r[], bn_t s[], uint8_t *msg[], int len[], ec_t q[],
+		int n);
+
+/**
+ * Generates an EdDSA key pair over the currently configured Edwards curve.
+ *
+ * @param[out] sk			- the private key, a seed of RLC_FP_BYTES bytes.
+ * @param[out] q			- the public key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_eddsa_gen(uint8_t *sk, ed_t q);
+
+/**
+ * Derives the EdDSA public key matching a private key.
+ *
+ * @param[out] q			- the public key.
+ * @param[in] sk			- the private key, a seed of RLC_FP_BYTES bytes.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_eddsa_pub(ed_t q, const uint8_t *sk);
+
+/**
+ * Encodes an EdDSA public key in RLC_FP_BYTES bytes as in RFC 8032.
+ *
+ * @param[out] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @param[in] q				- the public key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_eddsa_pub_write(uint8_t *bin, int len, const ed_t q);
+
+/**
+ * Encodes an EdDSA signature in 2 * RLC_FP_BYTES bytes as in RFC 8032.
+ *
+ * @param[out] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @param[in] r				- the first component of the signature.
+ * @param[in] s				- the second component of the signature.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_eddsa_sig_write(uint8_t *bin, int len, const ed_t r, const bn_t s);
+
+/**
+ * Signs a message using EdDSA as specified in RFC 8032.
+ *
+ * @param[out] r			- the first component of the signature.
+ * @param[out] s			- the second component of the signature.
+ * @param[in] msg			- the message to sign.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] sk			- the private key.
+ * @param[in] q				- the public key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_eddsa_sig(ed_t r, bn_t s, uint8_t *msg, int len, uint8_t *sk, ed_t q);
+
+/**
+ * Verifies a message signed with EdDSA.
+ *
+ * @param[in] r				- the first component of the signature.
+ * @param[in] s				- the second component of the signature.
+ * @param[in] msg			- the signed message.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] q				- the public key.
+ * @return a boolean value indicating if the signature is valid.
+ */
+int cp_eddsa_ver(ed_t r, bn_t s, uint8_t *msg, int len, ed_t q);
+
+/**
+ * Verifies a batch of messages signed with EdDSA using a single simultaneous
+ * multiplication with random 128-bit weights.
+ *
+ * @param[in] r				- the first components of the signatures.
+ * @param[in] s				- the second components of the signatures.
+ * @param[in] msg			- the signed messages.
+ * @param[in] len			- the message lengths in bytes.
+ * @param[in] q				- the public keys.
+ * @param[in] n				- the number of signatures.
+ * @return a boolean value indicating if all signatures are valid.
+ */
+int cp_eddsa_ver_batch(ed_t r[], bn_t s[], uint8_t *msg[], int len[], ed_t q[],
+		int n);
+
 /**
  * Generate parameters for the DCKKS pairing delegation protocol described at
  * "Secure and Efficient Delegationof Pairings with Online Inputs" (CARDIS 2020)
@@ -1418,6 +1878,32 @@ int cp_bgn_enc1(g1_t out[2], dig_t in, bgn_t pub);
  */
 int cp_bgn_dec1(dig_t *out, g1_t in[2], bgn_t prv);
 
+/**
+ * Builds a table of m baby steps for decrypting in G_1 with the BGN
+ * cryptosystem. Larger tables trade memory for faster decryption.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] m				- the number of baby steps.
+ * @param[in] prv			- the private key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_bgn_tab1(dlog_tab_t tab, int m, bgn_t prv);
+
+/**
+ * Decrypts in G_1 using the BGN cryptosystem and a table of m baby steps.
+ * Plaintexts below m^2 are found with giant steps, and larger plaintexts
+ * below the bound with Pollard's kangaroo method.
+ *
+ * @param[out] out			- the decrypted small integer.
+ * @param[in] in			- the ciphertext.
+ * @param[in] bound			- the upper bound on the plaintext.
+ * @param[in] tab			- the table of baby steps.
+ * @param[in] prv			- the private key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_bgn_dec1_tab(dig_t *out, g1_t in[2], dig_t bound, dlog_tab_t tab,
+		bgn_t prv);
+
 /**
  * Encrypts in G_2 using the BGN cryptosystem.
  *
@@ -1438,6 +1924,30 @@ int cp_bgn_enc2(g2_t out[2], dig_t in, bgn_t pub);
  */
 int cp_bgn_dec2(dig_t *out, g2_t in[2], bgn_t prv);
 
+/**
+ * Builds a table of m baby steps for decrypting in G_2 with the BGN
+ * cryptosystem.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] m				- the number of baby steps.
+ * @param[in] prv			- the private key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_bgn_tab2(dlog_tab_t tab, int m, bgn_t prv);
+
+/**
+ * Decrypts in G_2 using the BGN cryptosystem and a table of baby steps.
+ *
+ * @param[out] out			- the decrypted small integer.
+ * @param[in] in			- the ciphertext.
+ * @param[in] bound			- the upper bound on the plaintext.
+ * @param[in] tab			- the table of baby steps.
+ * @param[in] prv			- the private key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_bgn_dec2_tab(dig_t *out, g2_t in[2], dig_t bound, dlog_tab_t tab,
+		bgn_t prv);
+
 /**
  * Adds homomorphically two BGN ciphertexts in G_T.
  *
@@ -1468,6 +1978,30 @@ int cp_bgn_mul(gt_t e[4], g1_t c[2], g2_t d[2]);
  */
 int cp_bgn_dec(dig_t *out, gt_t in[4], bgn_t prv);
 
+/**
+ * Builds a table of m baby steps for decrypting in G_T with the BGN
+ * cryptosystem.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] m				- the number of baby steps.
+ * @param[in] prv			- the private key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_bgn_tab(dlog_tab_t tab, int m, bgn_t prv);
+
+/**
+ * Decrypts in G_T using the BGN cryptosystem and a table of baby steps.
+ *
+ * @param[out] out			- the decrypted small integer.
+ * @param[in] in			- the ciphertext.
+ * @param[in] bound			- the upper bound on the plaintext.
+ * @param[in] tab			- the table of baby steps.
+ * @param[in] prv			- the private key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_bgn_dec_tab(dig_t *out, gt_t in[4], dig_t bound, dlog_tab_t tab,
+		bgn_t prv);
+
 /**
  * Generates a master key for a Private Key Generator (PKG) in the
  * Boneh-Franklin Identity-Based Encryption (BF-IBE).
@@ -1489,7 +2023,9 @@ int cp_ibe_gen(bn_t master, g1_t pub);
 int cp_ibe_gen_prv(g2_t prv, char *id, bn_t master);
 
 /**
- * Encrypts a message using the BF-IBE protocol.
+ * Encrypts a message using the BF-IBE protocol. The message is encrypted with
+ * AES-GCM under a key derived from the pairing value, so the output has an
+ * encoded point and RLC_BC_TAG bytes besides the ciphertext.
  *
  * @param[out] out			- the output buffer.
  * @param[in, out] out_len	- the buffer capacity and number of bytes written.
@@ -1509,11 +2045,36 @@ int cp_ibe_enc(uint8_t *out, int *out_len, uint8_t *in, int in_len, char *id,
  * @param[in, out] out_len	- the buffer capacity and number of bytes written.
  * @param[in] in			- the input buffer.
  * @param[in] in_len		- the number of bytes to decrypt.
- * @param[in] pub			- the private key of the user.
+ * @param[in] prv			- the private key of the user.
  * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
  */
 int cp_ibe_dec(uint8_t *out, int *out_len, uint8_t *in, int in_len, g2_t prv);
 
+/**
+ * Starts encrypting a stream using the BF-IBE protocol. The encoded
+ * ephemeral point is written to the output and must precede the stream.
+ *
+ * @param[out] out			- the output buffer.
+ * @param[in, out] out_len	- the buffer capacity and number of bytes written.
+ * @param[out] s			- the stream to initialize.
+ * @param[in] id			- the identity.
+ * @param[in] pub			- the public key of the PKG.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_ibe_enc_init(uint8_t *out, int *out_len, strm_t s, char *id,
+		g1_t pub);
+
+/**
+ * Starts decrypting a stream using the BF-IBE protocol.
+ *
+ * @param[out] s			- the stream to initialize.
+ * @param[in] in			- the encoded ephemeral point.
+ * @param[in] in_len		- the number of bytes in the encoding.
+ * @param[in] prv			- the private key of the user.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_ibe_dec_init(strm_t s, uint8_t *in, int in_len, g2_t prv);
+
 /**
  * Generates a key pair for the Boneh-Lynn-Schacham (BLS) signature protocol.
  *
@@ -2111,6 +2672,24 @@ int cp_sokor_sig(bn_t c[2], bn_t r[2], uint8_t *msg, int len, ec_t y[2],
 int cp_sokor_ver(bn_t c[2], bn_t r[2], uint8_t *msg, int len, ec_t y[2],
 		ec_t g[2]);
 
+/**
+ * Verifies many proofs of knowledge of a discrete logarithm of an elliptic
+ * curve point to a generator over the same message and generators. The message
+ * is hashed only once.
+ *
+ * @param[in] c				- the pairs of challenges.
+ * @param[in] r				- the pairs of responses.
+ * @param[in] msg			- the message to sign.
+ * @param[in] len			- the length of the message.
+ * @param[in] y				- the pairs of elliptic curve points, stored
+ *							  consecutively.
+ * @param[in] g				- the elliptic curve generators.
+ * @param[in] n				- the number of proofs.
+ * @return a boolean value indicating if all proofs are valid.
+ */
+int cp_sokor_ver_sim(bn_t *c[], bn_t *r[], uint8_t *msg, int len, ec_t y[],
+		ec_t g[2], int n);
+
 /**
  * Generates the public parameters of the extendable ring signature.
  *
@@ -2407,6 +2986,57 @@ void cp_cmlhs_off(gt_t vk, g1_t h, int label[], gt_t * hs[], dig_t *f[],
  */
 int cp_cmlhs_onv(g1_t r, g2_t s, g1_t sig[], g2_t z[], g1_t a[], g1_t c[],
 		bn_t msg, char *data, g1_t h, gt_t vk, g2_t y[], g2_t pk[], int slen);
+
+/**
+ * Computes the key that identifies a CMLHS offline verification key in a
+ * cache. The key depends on the linear function, the labels and the public
+ * keys of the users.
+ *
+ * @param[out] key			- the cache key, with RLC_MD_LEN bytes.
+ * @param[in] label			- the integer labels.
+ * @param[in] f				- the linear coefficients in the function.
+ * @param[in] flen			- the number of coefficients.
+ * @param[in] pk			- the public keys of the users.
+ * @param[in] slen			- the number of signatures.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_cmlhs_off_key(uint8_t *key, int label[], dig_t *f[], int flen[],
+		g2_t pk[], int slen);
+
+/**
+ * Returns the number of bytes necessary to store a CMLHS offline verification
+ * key in a cache.
+ *
+ * @param[in] vk			- the verification key.
+ * @return the number of bytes.
+ */
+int cp_cmlhs_off_size(gt_t vk);
+
+/**
+ * Writes a CMLHS offline verification key and its cache key to a byte vector.
+ *
+ * @param[out] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @param[in] vk			- the verification key.
+ * @param[in] key			- the cache key.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_cmlhs_off_write(uint8_t *bin, int len, gt_t vk, const uint8_t *key);
+
+/**
+ * Reads a CMLHS offline verification key from a byte vector. The stored cache
+ * key must match the given one, so that stale entries are rejected. The byte
+ * vector must come from trusted storage.
+ *
+ * @param[out] vk			- the verification key.
+ * @param[in] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @param[in] key			- the expected cache key.
+ * @return RLC_OK if the entry is valid, RLC_ERR otherwise.
+ */
+int cp_cmlhs_off_read(gt_t vk, const uint8_t *bin, int len,
+		const uint8_t *key);
+
 /**
  * Generates a key pair for the Multi-Key Homomorphic Signature (MKLHS) scheme.
  *
@@ -2469,6 +3099,39 @@ int cp_mklhs_evl(g1_t sig, g1_t s[], dig_t f[], int len);
 int cp_mklhs_ver(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[],
 		char *tag[], dig_t *f[], int flen[], g2_t pk[], int slen);
 
+/**
+ * Hashes the labels of a MKLHS signature over a set of messages, so that they
+ * can be reused across verifications. The hashes of the labels of the i-th
+ * user are stored consecutively, after those of the previous users.
+ *
+ * @param[out] h			- the hashes of labels.
+ * @param[in] id			- the vector of identities.
+ * @param[in] tag			- the vector of tags.
+ * @param[in] flen			- the number of coefficients.
+ * @param[in] slen			- the number of signatures.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_mklhs_lab(g1_t h[], char *id[], char *tag[], int flen[], int slen);
+
+/**
+ * Verifies a MKLHS signature over a set of messages using hashes of labels
+ * previously computed with cp_mklhs_lab().
+ *
+ * @param[in] sig			- the homomorphic signature to verify.
+ * @param[in] m				- the signed message.
+ * @param[in] mu			- the vector of signed messages per user.
+ * @param[in] data			- the dataset identifier.
+ * @param[in] id			- the vector of identities.
+ * @param[in] h				- the hashes of labels.
+ * @param[in] f				- the linear coefficients in the function.
+ * @param[in] flen			- the number of coefficients.
+ * @param[in] pk			- the public keys of the users.
+ * @param[in] slen			- the number of signatures.
+ * @return a boolean value indicating the verification result.
+ */
+int cp_mklhs_ver_lab(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[],
+		g1_t h[], dig_t *f[], int flen[], g2_t pk[], int slen);
+
 /**
  * Computes the offline part of veryfying a MKLHS signature over a set of
  * messages.
@@ -2503,6 +3166,62 @@ int cp_mklhs_off(g1_t h[], dig_t ft[], char *id[], char *tag[], dig_t *f[],
 int cp_mklhs_onv(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[], g1_t h[],
 		dig_t ft[], g2_t pk[], int slen);
 
+/**
+ * Computes the key that identifies the offline part of verifying a MKLHS
+ * signature in a cache. The key depends on the curve, the identities, the
+ * tags and the linear function.
+ *
+ * @param[out] key			- the cache key, with RLC_MD_LEN bytes.
+ * @param[in] id			- the vector of identities.
+ * @param[in] tag			- the vector of tags.
+ * @param[in] f				- the linear coefficients in the function.
+ * @param[in] flen			- the number of coefficients.
+ * @param[in] slen			- the number of signatures.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_mklhs_off_key(uint8_t *key, char *id[], char *tag[], dig_t *f[],
+		int flen[], int slen);
+
+/**
+ * Returns the number of bytes necessary to store the offline part of verifying
+ * a MKLHS signature in a cache.
+ *
+ * @param[in] slen			- the number of signatures.
+ * @return the number of bytes.
+ */
+int cp_mklhs_off_size(int slen);
+
+/**
+ * Writes the offline part of verifying a MKLHS signature and its cache key to
+ * a byte vector.
+ *
+ * @param[out] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @param[in] h				- the hashes of labels.
+ * @param[in] ft			- the precomputed linear coefficients.
+ * @param[in] key			- the cache key.
+ * @param[in] slen			- the number of signatures.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_mklhs_off_write(uint8_t *bin, int len, g1_t h[], dig_t ft[],
+		const uint8_t *key, int slen);
+
+/**
+ * Reads the offline part of verifying a MKLHS signature from a byte vector.
+ * The stored cache key must match the given one, so that stale entries are
+ * rejected. The byte vector must come from trusted storage.
+ *
+ * @param[out] h			- the hashes of labels.
+ * @param[out] ft			- the precomputed linear coefficients.
+ * @param[in] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @param[in] key			- the expected cache key.
+ * @param[in] slen			- the number of signatures.
+ * @return RLC_OK if the entry is valid, RLC_ERR otherwise.
+ */
+int cp_mklhs_off_read(g1_t h[], dig_t ft[], const uint8_t *bin, int len,
+		const uint8_t *key, int slen);
+
 /**
  * Generates the trusted setup parameters for the factoring-based laconic
  * Private Set Intersection (RSA-PSI) protocol.
@@ -2659,4 +3378,39 @@ int cp_pbpsi_ans(gt_t t[], g1_t u[], g1_t ss, g2_t d, bn_t y[], int n);
 int cp_pbpsi_int(bn_t z[], int *len, g2_t d[], bn_t x[], int m, gt_t t[],
 		g1_t u[], int n);
 
+/**
+ * Computes the sender part of the PB-PSI protocol over a stream. The input set
+ * is pulled in chunks of at most RLC_CP_BATCH elements and each chunk is
+ * answered with a 4-byte big-endian element count followed by that many
+ * compressed (GT, G1) pairs; an empty chunk ends the stream. Elements are only
+ * shuffled within a chunk, so the set should be supplied in random order.
+ *
+ * @param[in] ss			- the secret power.
+ * @param[in] d				- the polynomial interpolations in the exponent.
+ * @param[in] get			- reads up to the given number of set elements and
+ * 							returns how many were read, zero at the end.
+ * @param[in] put			- writes the given bytes and returns RLC_OK.
+ * @param[in] arg			- the argument passed to both callbacks.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_pbpsi_ans_strm(g1_t ss, g2_t d, int (*get)(bn_t *, int, void *),
+		int (*put)(const uint8_t *, size_t, void *), void *arg);
+
+/**
+ * Computes the intersection as the final part of the PB-PSI protocol while
+ * the answer produced by cp_pbpsi_ans_strm() is being received.
+ *
+ * @param[out] z			- the elements in the intersection, not aliasing x.
+ * @param[out] len			- the cardinality of the resulting intersection.
+ * @param[in] d				- the polynomial interpolations in the exponent.
+ * @param[in] x				- the receiver's input set.
+ * @param[in] m				- the receiver's input set size.
+ * @param[in] get			- reads exactly the given number of bytes and
+ * 							returns RLC_OK.
+ * @param[in] arg			- the argument passed to the callback.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+int cp_pbpsi_int_strm(bn_t z[], int *len, g2_t d[], bn_t x[], int m,
+		int (*get)(uint8_t *, size_t, void *), void *arg);
+
 #endif /* !RLC_CP_H */
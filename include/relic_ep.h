@@ -1231,6 +1231,18 @@ void ep_map(ep_t p, const uint8_t *msg, int len);
 void ep_map_dst(ep_t p, const uint8_t *msg, int len, const uint8_t *dst,
 		int dst_len);
 
+/**
+ * Maps several byte arrays to points in a prime elliptic curve, sharing the
+ * final normalization among all of them. The result is the same as calling
+ * ep_map() on each array.
+ *
+ * @param[out] p			- the resulting points.
+ * @param[in] msg			- the byte arrays to map.
+ * @param[in] len			- the array lengths in bytes.
+ * @param[in] n				- the number of arrays.
+ */
+void ep_map_sim(ep_t p[], const uint8_t *msg[], const int len[], int n);
+
 /**
  * Compresses a point.
  *
@@ -160,6 +160,18 @@ enum {
 #undef RLC_FP_ROOM
 #endif
 
+/**
+ * Width in bits of the digits recovered by table lookup during square root
+ * extraction.
+ */
+#define RLC_FP_SRT_WIN	4
+
+/**
+ * Maximum 2-adicity of the prime modulus handled by the precomputed tables for
+ * square root extraction. Larger 2-adicities fall back to Tonelli-Shanks.
+ */
+#define RLC_FP_SRT_MAX	128
+
 /*============================================================================*/
 /* Type definitions                                                           */
 /*============================================================================*/
@@ -1159,4 +1171,17 @@ void fp_exp_monty(fp_t c, const fp_t a, const bn_t b);
  */
 int fp_srt(fp_t c, const fp_t a);
 
+/**
+ * Extracts the square root of a quotient of prime field elements without
+ * computing an inversion. Computes c = sqrt(a/b) if a/b is a square, or
+ * c = sqrt(a/(n * b)) otherwise, for the quadratic non-residue n returned by
+ * fp_prime_get_qnr(). The other square root is the negation of c.
+ *
+ * @param[out] c			- the result.
+ * @param[in] a				- the numerator.
+ * @param[in] b				- the denominator.
+ * @return					- 1 if a/b is a square, 0 otherwise.
+ */
+int fp_srt_div(fp_t c, const fp_t a, const fp_t b);
+
 #endif /* !RLC_FP_H */
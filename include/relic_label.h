@@ -287,6 +287,8 @@
 #undef bn_rec_frb
 #undef bn_lag
 #undef bn_evl
+#undef bn_evl_sim
+#undef bn_itp
 
 #define bn_make 	RLC_PREFIX(bn_make)
 #define bn_clean 	RLC_PREFIX(bn_clean)
@@ -395,6 +397,8 @@
 #define bn_rec_frb 	RLC_PREFIX(bn_rec_frb)
 #define bn_lag 	RLC_PREFIX(bn_lag)
 #define bn_evl 	RLC_PREFIX(bn_evl)
+#define bn_evl_sim 	RLC_PREFIX(bn_evl_sim)
+#define bn_itp 	RLC_PREFIX(bn_itp)
 
 #undef bn_add1_low
 #undef bn_addn_low
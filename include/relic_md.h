@@ -36,6 +36,8 @@
 #ifndef RLC_MD_H
 #define RLC_MD_H
 
+#include <stddef.h>
+
 #include "relic_conf.h"
 #include "relic_types.h"
 #include "relic_label.h"
@@ -56,9 +58,20 @@ enum {
 	/** Hash length for BLAKE2s-160 function. */
 	RLC_MD_LEN_B2S160 = 20,
 	/** Hash length for BLAKE2s-256 function. */
-	RLC_MD_LEN_B2S256 = 32
+	RLC_MD_LEN_B2S256 = 32,
+	/** Hash length for BLAKE2b-256 function. */
+	RLC_MD_LEN_B2B256 = 32,
+	/** Hash length for BLAKE2b-512 function. */
+	RLC_MD_LEN_B2B512 = 64,
+	/** Hash length for BLAKE3 function. */
+	RLC_MD_LEN_BLAKE3 = 32
 };
 
+/**
+ * Maximum depth of the tree of chaining values in a BLAKE3 computation.
+ */
+#define RLC_MD_B3_DEPTH				54
+
 /**
  * Length in bytes of default hash function output.
  */
@@ -74,6 +87,92 @@ enum {
 #define RLC_MD_LEN					RLC_MD_LEN_B2S160
 #elif MD_MAP == B2S256
 #define RLC_MD_LEN					RLC_MD_LEN_B2S256
+#elif MD_MAP == B2B256
+#define RLC_MD_LEN					RLC_MD_LEN_B2B256
+#elif MD_MAP == B2B512
+#define RLC_MD_LEN					RLC_MD_LEN_B2B512
+#elif MD_MAP == BLAKE3
+#define RLC_MD_LEN					RLC_MD_LEN_BLAKE3
+#endif
+
+/*============================================================================*/
+/* Type definitions                                                           */
+/*============================================================================*/
+
+/**
+ * Represents the state of an incremental SHA-224 or SHA-256 computation.
+ */
+typedef struct {
+	/** Storage for the state of the underlying implementation. */
+	uint64_t state[16];
+} md_sh256_st;
+
+/**
+ * Represents the state of an incremental SHA-384 or SHA-512 computation.
+ */
+typedef struct {
+	/** Storage for the state of the underlying implementation. */
+	uint64_t state[32];
+} md_sh512_st;
+
+/**
+ * Represents the state of an incremental BLAKE2s computation.
+ */
+typedef struct {
+	/** Storage for the state of the underlying implementation. */
+	uint64_t state[18];
+} md_b2s_st;
+
+/**
+ * Represents the state of an incremental BLAKE2b computation.
+ */
+typedef struct {
+	/** Storage for the state of the underlying implementation. */
+	uint64_t state[31];
+} md_b2b_st;
+
+/**
+ * Represents the state of an incremental BLAKE3 computation.
+ */
+typedef struct {
+	/** The chaining values of the complete subtrees, left to right. */
+	uint32_t stack[RLC_MD_B3_DEPTH][8];
+	/** The chaining value of the current chunk. */
+	uint32_t cv[8];
+	/** The index of the current chunk. */
+	uint64_t chunk;
+	/** The last input block, not compressed yet. */
+	uint8_t buf[64];
+	/** The number of bytes in the last input block. */
+	uint8_t len;
+	/** The number of compressed blocks in the current chunk. */
+	uint8_t blocks;
+	/** The number of chaining values in the stack. */
+	uint8_t depth;
+} md_blake3_st;
+
+/**
+ * Pointer aliases to the incremental hash states, allocated in the stack.
+ */
+typedef md_sh256_st md_sh256_t[1];
+typedef md_sh512_st md_sh512_t[1];
+typedef md_b2s_st md_b2s_t[1];
+typedef md_b2b_st md_b2b_t[1];
+typedef md_blake3_st md_blake3_t[1];
+
+/**
+ * State of an incremental computation of the chosen hash function.
+ */
+#if MD_MAP == SH224 || MD_MAP == SH256
+typedef md_sh256_t md_t;
+#elif MD_MAP == SH384 || MD_MAP == SH512
+typedef md_sh512_t md_t;
+#elif MD_MAP == B2S160 || MD_MAP == B2S256
+typedef md_b2s_t md_t;
+#elif MD_MAP == B2B256 || MD_MAP == B2B512
+typedef md_b2b_t md_t;
+#elif MD_MAP == BLAKE3
+typedef md_blake3_t md_t;
 #endif
 
 /*============================================================================*/
@@ -100,6 +199,91 @@ enum {
 #define md_map(H, M, L)			md_map_b2s160(H, M, L)
 #elif MD_MAP == B2S256
 #define md_map(H, M, L)			md_map_b2s256(H, M, L)
+#elif MD_MAP == B2B256
+#define md_map(H, M, L)			md_map_b2b256(H, M, L)
+#elif MD_MAP == B2B512
+#define md_map(H, M, L)			md_map_b2b512(H, M, L)
+#elif MD_MAP == BLAKE3
+#define md_map(H, M, L)			md_map_blake3(H, M, L)
+#endif
+
+/**
+ * Starts an incremental computation of the chosen hash function.
+ *
+ * @param[out] C				- the hash state.
+ */
+#if MD_MAP == SH224
+#define md_init(C)				md_sh224_init(C)
+#elif MD_MAP == SH256
+#define md_init(C)				md_sh256_init(C)
+#elif MD_MAP == SH384
+#define md_init(C)				md_sh384_init(C)
+#elif MD_MAP == SH512
+#define md_init(C)				md_sh512_init(C)
+#elif MD_MAP == B2S160
+#define md_init(C)				md_b2s160_init(C)
+#elif MD_MAP == B2S256
+#define md_init(C)				md_b2s256_init(C)
+#elif MD_MAP == B2B256
+#define md_init(C)				md_b2b256_init(C)
+#elif MD_MAP == B2B512
+#define md_init(C)				md_b2b512_init(C)
+#elif MD_MAP == BLAKE3
+#define md_init(C)				md_blake3_init(C)
+#endif
+
+/**
+ * Absorbs a byte vector into an incremental computation of the chosen hash
+ * function.
+ *
+ * @param[in,out] C				- the hash state.
+ * @param[in] M					- the bytes to hash.
+ * @param[in] L					- the number of bytes.
+ */
+#if MD_MAP == SH224
+#define md_update(C, M, L)		md_sh224_update(C, M, L)
+#elif MD_MAP == SH256
+#define md_update(C, M, L)		md_sh256_update(C, M, L)
+#elif MD_MAP == SH384
+#define md_update(C, M, L)		md_sh384_update(C, M, L)
+#elif MD_MAP == SH512
+#define md_update(C, M, L)		md_sh512_update(C, M, L)
+#elif MD_MAP == B2S160
+#define md_update(C, M, L)		md_b2s160_update(C, M, L)
+#elif MD_MAP == B2S256
+#define md_update(C, M, L)		md_b2s256_update(C, M, L)
+#elif MD_MAP == B2B256
+#define md_update(C, M, L)		md_b2b256_update(C, M, L)
+#elif MD_MAP == B2B512
+#define md_update(C, M, L)		md_b2b512_update(C, M, L)
+#elif MD_MAP == BLAKE3
+#define md_update(C, M, L)		md_blake3_update(C, M, L)
+#endif
+
+/**
+ * Finishes an incremental computation of the chosen hash function.
+ *
+ * @param[out] H				- the digest.
+ * @param[in,out] C				- the hash state, erased afterwards.
+ */
+#if MD_MAP == SH224
+#define md_final(H, C)			md_sh224_final(H, C)
+#elif MD_MAP == SH256
+#define md_final(H, C)			md_sh256_final(H, C)
+#elif MD_MAP == SH384
+#define md_final(H, C)			md_sh384_final(H, C)
+#elif MD_MAP == SH512
+#define md_final(H, C)			md_sh512_final(H, C)
+#elif MD_MAP == B2S160
+#define md_final(H, C)			md_b2s160_final(H, C)
+#elif MD_MAP == B2S256
+#define md_final(H, C)			md_b2s256_final(H, C)
+#elif MD_MAP == B2B256
+#define md_final(H, C)			md_b2b256_final(H, C)
+#elif MD_MAP == B2B512
+#define md_final(H, C)			md_b2b512_final(H, C)
+#elif MD_MAP == BLAKE3
+#define md_final(H, C)			md_blake3_final(H, C)
 #endif
 
 /**
@@ -121,6 +305,16 @@ enum {
 #define md_xmd(B, BL, I, IL, D, DL) 	md_xmd_sh384(B, BL, I, IL, D, DL)
 #elif MD_MAP == SH512
 #define md_xmd(B, BL, I, IL, D, DL) 	md_xmd_sh512(B, BL, I, IL, D, DL)
+#elif MD_MAP == B2S160
+#define md_xmd(B, BL, I, IL, D, DL) 	md_xmd_b2s160(B, BL, I, IL, D, DL)
+#elif MD_MAP == B2S256
+#define md_xmd(B, BL, I, IL, D, DL) 	md_xmd_b2s256(B, BL, I, IL, D, DL)
+#elif MD_MAP == B2B256
+#define md_xmd(B, BL, I, IL, D, DL) 	md_xmd_b2b256(B, BL, I, IL, D, DL)
+#elif MD_MAP == B2B512
+#define md_xmd(B, BL, I, IL, D, DL) 	md_xmd_b2b512(B, BL, I, IL, D, DL)
+#elif MD_MAP == BLAKE3
+#define md_xmd(B, BL, I, IL, D, DL) 	md_xmd_blake3(B, BL, I, IL, D, DL)
 #endif
 
 /*============================================================================*/
@@ -136,6 +330,31 @@ enum {
  */
 void md_map_sh224(uint8_t *hash, const uint8_t *msg, int len);
 
+/**
+ * Starts an incremental computation of the SHA-224 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_sh224_init(md_sh256_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the SHA-224 hash
+ * function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_sh224_update(md_sh256_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the SHA-224 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_sh224_final(uint8_t *hash, md_sh256_t ctx);
+
 /**
  * Computes the SHA-256 hash function.
  *
@@ -145,6 +364,31 @@ void md_map_sh224(uint8_t *hash, const uint8_t *msg, int len);
  */
 void md_map_sh256(uint8_t *hash, const uint8_t *msg, int len);
 
+/**
+ * Starts an incremental computation of the SHA-256 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_sh256_init(md_sh256_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the SHA-256 hash
+ * function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_sh256_update(md_sh256_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the SHA-256 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_sh256_final(uint8_t *hash, md_sh256_t ctx);
+
 /**
  * Computes the SHA-384 hash function.
  *
@@ -154,6 +398,31 @@ void md_map_sh256(uint8_t *hash, const uint8_t *msg, int len);
  */
 void md_map_sh384(uint8_t *hash, const uint8_t *msg, int len);
 
+/**
+ * Starts an incremental computation of the SHA-384 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_sh384_init(md_sh512_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the SHA-384 hash
+ * function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_sh384_update(md_sh512_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the SHA-384 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_sh384_final(uint8_t *hash, md_sh512_t ctx);
+
 /**
  * Computes the SHA-512 hash function.
  *
@@ -163,6 +432,31 @@ void md_map_sh384(uint8_t *hash, const uint8_t *msg, int len);
  */
 void md_map_sh512(uint8_t *hash, const uint8_t *msg, int len);
 
+/**
+ * Starts an incremental computation of the SHA-512 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_sh512_init(md_sh512_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the SHA-512 hash
+ * function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_sh512_update(md_sh512_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the SHA-512 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_sh512_final(uint8_t *hash, md_sh512_t ctx);
+
 /**
  * Computes the BLAKE2s-160 hash function.
  *
@@ -172,6 +466,31 @@ void md_map_sh512(uint8_t *hash, const uint8_t *msg, int len);
  */
 void md_map_b2s160(uint8_t *hash, const uint8_t *msg, int len);
 
+/**
+ * Starts an incremental computation of the BLAKE2s-160 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_b2s160_init(md_b2s_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the BLAKE2s-160
+ * hash function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_b2s160_update(md_b2s_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the BLAKE2s-160 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_b2s160_final(uint8_t *hash, md_b2s_t ctx);
+
 /**
  * Computes the BLAKE2s-256 hash function.
  *
@@ -181,6 +500,133 @@ void md_map_b2s160(uint8_t *hash, const uint8_t *msg, int len);
  */
 void md_map_b2s256(uint8_t *hash, const uint8_t *msg, int len);
 
+/**
+ * Starts an incremental computation of the BLAKE2s-256 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_b2s256_init(md_b2s_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the BLAKE2s-256
+ * hash function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_b2s256_update(md_b2s_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the BLAKE2s-256 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_b2s256_final(uint8_t *hash, md_b2s_t ctx);
+
+/**
+ * Computes the BLAKE2b-256 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in] msg				- the message to hash.
+ * @param[in] len				- the message length in bytes.
+ */
+void md_map_b2b256(uint8_t *hash, const uint8_t *msg, int len);
+
+/**
+ * Starts an incremental computation of the BLAKE2b-256 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_b2b256_init(md_b2b_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the BLAKE2b-256
+ * hash function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_b2b256_update(md_b2b_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the BLAKE2b-256 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_b2b256_final(uint8_t *hash, md_b2b_t ctx);
+
+/**
+ * Computes the BLAKE2b-512 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in] msg				- the message to hash.
+ * @param[in] len				- the message length in bytes.
+ */
+void md_map_b2b512(uint8_t *hash, const uint8_t *msg, int len);
+
+/**
+ * Starts an incremental computation of the BLAKE2b-512 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_b2b512_init(md_b2b_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the BLAKE2b-512
+ * hash function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_b2b512_update(md_b2b_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the BLAKE2b-512 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_b2b512_final(uint8_t *hash, md_b2b_t ctx);
+
+/**
+ * Computes the BLAKE3 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in] msg				- the message to hash.
+ * @param[in] len				- the message length in bytes.
+ */
+void md_map_blake3(uint8_t *hash, const uint8_t *msg, int len);
+
+/**
+ * Starts an incremental computation of the BLAKE3 hash function.
+ *
+ * @param[out] ctx				- the hash state.
+ */
+void md_blake3_init(md_blake3_t ctx);
+
+/**
+ * Absorbs a byte vector into an incremental computation of the BLAKE3
+ * hash function.
+ *
+ * @param[in,out] ctx			- the hash state.
+ * @param[in] msg				- the bytes to hash.
+ * @param[in] len				- the number of bytes.
+ */
+void md_blake3_update(md_blake3_t ctx, const uint8_t *msg, size_t len);
+
+/**
+ * Finishes an incremental computation of the BLAKE3 hash function.
+ *
+ * @param[out] hash				- the digest.
+ * @param[in,out] ctx			- the hash state, erased afterwards.
+ */
+void md_blake3_final(uint8_t *hash, md_blake3_t ctx);
+
 /**
  * Derives a key from shared secret material through the standardized KDF2
  * function.
@@ -271,4 +717,84 @@ void md_xmd_sh384(uint8_t *buf, int buf_len, const uint8_t *in, int in_len,
 void md_xmd_sh512(uint8_t *buf, int buf_len, const uint8_t *in, int in_len,
 		const uint8_t *dst, int dst_len);
 
+/**
+ * Map a byte vector and optional domain separation tag to an arbitrary-length
+ * pseudorandom output using the BLAKE2s-160 hash function.
+ *
+ * @param[out] buf					- the output buffer.
+ * @param[in] buf_len				- the requested size of the output.
+ * @param[in] in					- the message to hash.
+ * @param[in] in_len				- the message length in bytes.
+ * @param[in] dst					- the domain separation tag.
+ * @param[in] dst_len				- the domain separation tag length in bytes.
+ */
+void md_xmd_b2s160(uint8_t *buf, int buf_len, const uint8_t *in, int in_len,
+		const uint8_t *dst, int dst_len);
+
+/**
+ * Map a byte vector and optional domain separation tag to an arbitrary-length
+ * pseudorandom output using the BLAKE2s-256 hash function.
+ *
+ * @param[out] buf					- the output buffer.
+ * @param[in] buf_len				- the requested size of the output.
+ * @param[in] in					- the message to hash.
+ * @param[in] in_len				- the message length in bytes.
+ * @param[in] dst					- the domain separation tag.
+ * @param[in] dst_len				- the domain separation tag length in bytes.
+ */
+void md_xmd_b2s256(uint8_t *buf, int buf_len, const uint8_t *in, int in_len,
+		const uint8_t *dst, int dst_len);
+
+/**
+ * Map a byte vector and optional domain separation tag to an arbitrary-length
+ * pseudorandom output using the BLAKE2b-256 hash function.
+ *
+ * @param[out] buf					- the output buffer.
+ * @param[in] buf_len				- the requested size of the output.
+ * @param[in] in					- the message to hash.
+ * @param[in] in_len				- the message length in bytes.
+ * @param[in] dst					- the domain separation tag.
+ * @param[in] dst_len				- the domain separation tag length in bytes.
+ */
+void md_xmd_b2b256(uint8_t *buf, int buf_len, const uint8_t *in, int in_len,
+		const uint8_t *dst, int dst_len);
+
+/**
+ * Map a byte vector and optional domain separation tag to an arbitrary-length
+ * pseudorandom output using the BLAKE2b-512 hash function.
+ *
+ * @param[out] buf					- the output buffer.
+ * @param[in] buf_len				- the requested size of the output.
+ * @param[in] in					- the message to hash.
+ * @param[in] in_len				- the message length in bytes.
+ * @param[in] dst					- the domain separation tag.
+ * @param[in] dst_len				- the domain separation tag length in bytes.
+ */
+void md_xmd_b2b512(uint8_t *buf, int buf_len, const uint8_t *in, int in_len,
+		const uint8_t *dst, int dst_len);
+
+/**
+ * Map a byte vector and optional domain separation tag to an arbitrary-length
+ * pseudorandom output using the BLAKE3 hash function.
+ *
+ * @param[out] buf					- the output buffer.
+ * @param[in] buf_len				- the requested size of the output.
+ * @param[in] in					- the message to hash.
+ * @param[in] in_len				- the message length in bytes.
+ * @param[in] dst					- the domain separation tag.
+ * @param[in] dst_len				- the domain separation tag length in bytes.
+ */
+void md_xmd_blake3(uint8_t *buf, int buf_len, const uint8_t *in, int in_len,
+		const uint8_t *dst, int dst_len);
+
+/**
+ * Absorbs a 64-bit integer into an incremental computation of the chosen hash
+ * function, as a big-endian string of eight bytes. Absorbing lengths before
+ * contents keeps the encoding of a sequence of byte vectors unique.
+ *
+ * @param[in,out] ctx				- the hash state.
+ * @param[in] a						- the integer to absorb.
+ */
+void md_update_int(md_t ctx, uint64_t a);
+
 #endif /* !RLC_MD_H */
@@ -280,6 +280,37 @@ int mpc_sss_gen(bn_t *x, bn_t *y, const bn_t key, const bn_t order,
 int mpc_sss_key(bn_t key, const bn_t *x, const bn_t *y, const bn_t order,
         size_t k);
 
+/**
+ * Generates shares (x, y) of several secret keys using a (k, n)-threshold
+ * Shamir's Secret Sharing over a given finite field. The powers of the indexes
+ * are computed once and each sharing is a matrix-vector product.
+ *
+ * @param[out] x			- the indexes of the parties receiving shares.
+ * @param[out] y			- the evaluation points, n for each secret.
+ * @param[in] key 			- the secrets to share.
+ * @param[in] order			- the order of the finite field.
+ * @param[in] k				- the threshold.
+ * @param[in] n				- the number of parties.
+ * @param[in] m				- the number of secrets.
+ */
+int mpc_sss_gen_sim(bn_t *x, bn_t *y, const bn_t *key, const bn_t order,
+        size_t k, size_t n, size_t m);
+
+/**
+ * Recovers several secret keys from k shares (x, y) each over a given finite
+ * field, with the same indexes for every secret. The Lagrange coefficients are
+ * computed once with a single inversion.
+ *
+ * @param[out] key 			- the recovered secrets.
+ * @param[in] x				- the indexes of the parties contributing shares.
+ * @param[in] y				- the evaluation points, k for each secret.
+ * @param[in] order			- the order of the finite field.
+ * @param[in] k				- the threshold.
+ * @param[in] m				- the number of secrets.
+ */
+int mpc_sss_key_sim(bn_t *key, const bn_t *x, const bn_t *y, const bn_t order,
+        size_t k, size_t m);
+
 /**
  * Performs the local work for a MPC scalar multiplication in G1.
  *
@@ -128,6 +128,27 @@ typedef RLC_CAT(RLC_G2_LOWER, st) g2_st;
  */
 typedef RLC_CAT(RLC_GT_LOWER, t) gt_t;
 
+/**
+ * Represents a table of baby steps for computing bounded discrete logarithms.
+ */
+typedef struct {
+	/** The number of baby steps. */
+	int m;
+	/** The sorted fingerprints of the baby steps, each followed by its log. */
+	uint64_t *t;
+	/** Flag to indicate that the entries are mapped from an external buffer. */
+	int map;
+} dlog_tab_st;
+
+/**
+ * Pointer to a table of baby steps.
+ */
+#if ALLOC == AUTO
+typedef dlog_tab_st dlog_tab_t[1];
+#else
+typedef dlog_tab_st *dlog_tab_t;
+#endif
+
 /*============================================================================*/
 /* Macro definitions                                                          */
 /*============================================================================*/
@@ -831,6 +852,16 @@ typedef RLC_CAT(RLC_GT_LOWER, t) gt_t;
  */
 #define g1_map(P, M, L);	RLC_CAT(RLC_G1_LOWER, map)(P, M, L)
 
+/**
+ * Maps several byte arrays to elements in G_1.
+ *
+ * @param[out] P			- the results.
+ * @param[in] M				- the byte arrays to map.
+ * @param[in] L				- the array lengths in bytes.
+ * @param[in] N				- the number of arrays.
+ */
+#define g1_map_sim(P, M, L, N)	RLC_CAT(RLC_G1_LOWER, map_sim)(P, M, L, N)
+
 /**
  * Maps a byte array to an element in G_2.
  *
@@ -901,6 +932,58 @@ typedef RLC_CAT(RLC_GT_LOWER, t) gt_t;
 #define pc_exp(C, A);			RLC_CAT(RLC_PC_LOWER, exp_k2)(C, A)
 #endif
 
+/**
+ * Initializes a table of baby steps with a null value.
+ *
+ * @param[out] A			- the table to initialize.
+ */
+#define dlog_tab_null(A)	RLC_NULL(A)
+
+/**
+ * Calls a function to allocate and initialize an empty table of baby steps.
+ *
+ * @param[out] A			- the new table.
+ */
+#if ALLOC == DYNAMIC
+#define dlog_tab_new(A)														\
+	A = (dlog_tab_t)calloc(1, sizeof(dlog_tab_st));							\
+	if (A == NULL) {														\
+		RLC_THROW(ERR_NO_MEMORY);											\
+	}																		\
+
+#elif ALLOC == AUTO
+#define dlog_tab_new(A)														\
+	(A)->m = 0;																\
+	(A)->t = NULL;															\
+	(A)->map = 0;															\
+
+#endif
+
+/**
+ * Calls a function to clean and free a table of baby steps. Mapped entries
+ * are left untouched.
+ *
+ * @param[out] A			- the table to clean and free.
+ */
+#if ALLOC == DYNAMIC
+#define dlog_tab_free(A)													\
+	if (A != NULL) {														\
+		if (!(A)->map) {													\
+			free((A)->t);													\
+		}																	\
+		free(A);															\
+		A = NULL;															\
+	}
+
+#elif ALLOC == AUTO
+#define dlog_tab_free(A)													\
+	if (!(A)->map) {														\
+		free((A)->t);														\
+	}																		\
+	(A)->t = NULL;															\
+
+#endif
+
 /*============================================================================*/
 /* Function prototypes                                                        */
 /*============================================================================*/
@@ -992,6 +1075,28 @@ void gt_exp_dig(gt_t c, gt_t a, dig_t b);
  */
 void gt_exp_sim(gt_t e, gt_t a, bn_t b, gt_t c, bn_t d);
 
+/**
+ * Exponentiates several elements from G_T by integers simultaneously.
+ * Computes c = \prod_i a_i^{b_i}.
+ *
+ * @param[out] c			- the result.
+ * @param[in] a				- the elements to exponentiate.
+ * @param[in] b				- the integer exponents.
+ * @param[in] n				- the number of elements.
+ */
+void gt_exp_sim_lot(gt_t c, gt_t a[], bn_t b[], int n);
+
+/**
+ * Exponentiates several elements from G_T by small integers simultaneously.
+ * Computes c = \prod_i a_i^{b_i}.
+ *
+ * @param[out] c			- the result.
+ * @param[in] a				- the elements to exponentiate.
+ * @param[in] b				- the small integer exponents.
+ * @param[in] n				- the number of elements.
+ */
+void gt_exp_sim_dig(gt_t c, gt_t a[], dig_t b[], int n);
+
 /**
  * Exponentiates a generator from G_T by an integer. Computes c = a^b.
  *
@@ -1028,4 +1133,117 @@ int g2_is_valid(g2_t a);
  */
 int gt_is_valid(gt_t a);
 
+/**
+ * Builds a table of m baby steps for computing discrete logarithms in G_1.
+ * Larger tables trade memory for faster logarithms. The table is built in
+ * parallel when OpenMP is enabled.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] g				- the base element.
+ * @param[in] m				- the number of baby steps.
+ */
+void g1_dlog_tab(dlog_tab_t tab, g1_t g, int m);
+
+/**
+ * Builds a table of m baby steps for computing discrete logarithms in G_2.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] g				- the base element.
+ * @param[in] m				- the number of baby steps.
+ */
+void g2_dlog_tab(dlog_tab_t tab, g2_t g, int m);
+
+/**
+ * Builds a table of m baby steps for computing discrete logarithms in G_T.
+ * Elements are identified by the coordinates kept by compression.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] g				- the base element.
+ * @param[in] m				- the number of baby steps.
+ */
+void gt_dlog_tab(dlog_tab_t tab, gt_t g, int m);
+
+/**
+ * Computes the discrete logarithm x < bound of an element from G_1, such that
+ * a = [x]g. Logarithms below m^2 are found with the m baby steps in the
+ * table, and larger ones with Pollard's kangaroo method. If the table is NULL
+ * or empty, a temporary table of about sqrt(bound) baby steps is used instead.
+ *
+ * @param[out] out			- the discrete logarithm.
+ * @param[in] a				- the element.
+ * @param[in] g				- the base element.
+ * @param[in] bound			- the upper bound on the logarithm.
+ * @param[in] tab			- the table of baby steps for g, or NULL.
+ * @return RLC_OK if the logarithm was found, RLC_ERR otherwise.
+ */
+int g1_dlog_bounded(dig_t *out, g1_t a, g1_t g, dig_t bound, dlog_tab_t tab);
+
+/**
+ * Computes the discrete logarithm x < bound of an element from G_2, such that
+ * a = [x]g.
+ *
+ * @param[out] out			- the discrete logarithm.
+ * @param[in] a				- the element.
+ * @param[in] g				- the base element.
+ * @param[in] bound			- the upper bound on the logarithm.
+ * @param[in] tab			- the table of baby steps for g, or NULL.
+ * @return RLC_OK if the logarithm was found, RLC_ERR otherwise.
+ */
+int g2_dlog_bounded(dig_t *out, g2_t a, g2_t g, dig_t bound, dlog_tab_t tab);
+
+/**
+ * Computes the discrete logarithm x < bound of an element from G_T, such that
+ * a = g^x.
+ *
+ * @param[out] out			- the discrete logarithm.
+ * @param[in] a				- the element.
+ * @param[in] g				- the base element.
+ * @param[in] bound			- the upper bound on the logarithm.
+ * @param[in] tab			- the table of baby steps for g, or NULL.
+ * @return RLC_OK if the logarithm was found, RLC_ERR otherwise.
+ */
+int gt_dlog_bounded(dig_t *out, gt_t a, gt_t g, dig_t bound, dlog_tab_t tab);
+
+/**
+ * Returns the number of bytes necessary to store a table of baby steps.
+ *
+ * @param[in] tab			- the table.
+ * @return the number of bytes.
+ */
+int pc_dlog_size_bin(dlog_tab_t tab);
+
+/**
+ * Writes a table of baby steps to a byte vector. Entries are stored in the
+ * native byte order of the platform, so that they can be mapped in place.
+ *
+ * @param[out] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @param[in] tab			- the table.
+ * @throw ERR_NO_BUFFER		- if the buffer capacity is not correct.
+ */
+void pc_dlog_write_bin(uint8_t *bin, int len, dlog_tab_t tab);
+
+/**
+ * Reads a table of baby steps from a byte vector.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @throw ERR_NO_BUFFER		- if the buffer capacity is not correct.
+ */
+void pc_dlog_read_bin(dlog_tab_t tab, const uint8_t *bin, int len);
+
+/**
+ * Maps a table of baby steps from a byte vector without copying it, as when
+ * sharing a memory-mapped file between processes. The byte vector must be
+ * 8-byte aligned and outlive the table.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @throw ERR_NO_BUFFER		- if the buffer capacity is not correct.
+ * @throw ERR_NO_VALID		- if the byte vector is not aligned.
+ */
+void pc_dlog_map_bin(dlog_tab_t tab, const uint8_t *bin, int len);
+
 #endif /* !RLC_PC_H */
@@ -47,12 +47,15 @@
  */
 #if RAND == HASHD
 
-#if MD_MAP == SH224 || MD_MAP == SH256 || MD_MAP == B2S160 || MD_MAP == B2S256
+#if MD_MAP == SH224 || MD_MAP == SH256 || MD_MAP == B2S160 || MD_MAP == B2S256 || MD_MAP == B2B256 || MD_MAP == BLAKE3
 #define RLC_RAND_SIZE		(1 + 2*440/8)
-#elif MD_MAP == SH384 || MD_MAP == SH512
+#elif MD_MAP == SH384 || MD_MAP == SH512 || MD_MAP == B2B512
 #define RLC_RAND_SIZE		(1 + 2*888/8)
 #endif
 
+#elif RAND == CHACHA
+/* A 256-bit key followed by 16 blocks of buffered keystream. */
+#define RLC_RAND_SIZE		(32 + 16 * 64)
 #elif RAND == UDEV
 #define RLC_RAND_SIZE		(sizeof(int))
 #elif RAND == CALL
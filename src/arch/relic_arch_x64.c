@@ -46,6 +46,26 @@ void arch_init(void) {
 	if (ctx != NULL) {
 		core_get()->lzcnt_ptr =
 			(has_lzcnt_hard() ? lzcnt64_hard : lzcnt64_soft);
+		core_get()->ext = 0;
+#ifdef __GNUC__
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("aes") && __builtin_cpu_supports("pclmul")
+				&& __builtin_cpu_supports("ssse3")) {
+			core_get()->ext |= RLC_X64_AES;
+		}
+		if (__builtin_cpu_supports("vaes") &&
+				__builtin_cpu_supports("vpclmulqdq") &&
+				__builtin_cpu_supports("avx2")) {
+			core_get()->ext |= RLC_X64_VAES;
+		}
+		if (__builtin_cpu_supports("sha") &&
+				__builtin_cpu_supports("sse4.1")) {
+			core_get()->ext |= RLC_X64_SHA;
+		}
+		if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2")) {
+			core_get()->ext |= RLC_X64_AVX2;
+		}
+#endif
 	}
 }
 
@@ -53,6 +73,7 @@ void arch_clean(void) {
 	ctx_t *ctx = core_get();
 	if (ctx != NULL) {
 		core_get()->lzcnt_ptr = NULL;
+		core_get()->ext = 0;
 	}
 }
 
@@ -98,3 +119,7 @@ ull_t arch_cycles(void) {
 unsigned int arch_lzcnt(dig_t x) {
 	return core_get()->lzcnt_ptr((ull_t)x) - (8 * sizeof(ull_t) - WSIZE);
 }
+
+int arch_has(int ext) {
+	return (core_get()->ext & ext) == ext;
+}
@@ -21,21 +21,700 @@
  * or <https://www.apache.org/licenses/>.
  */
 
+
 /**
  * @file
  *
  * Implementation of the AES block cipher.
  *
+ * The CBC mode uses the table-based reference code. The CTR and GCM modes
+ * work on an expanded key and select at key expansion the fastest backend
+ * supported by the processor: VAES and VPCLMULQDQ on 256-bit registers, AES-NI
+ * and PCLMULQDQ, or the reference code with a 4-bit table for GHASH.
+ *
  * @ingroup bc
  */
 
+#include <limits.h>
 #include <string.h>
 
 #include "relic_core.h"
 #include "relic_err.h"
+#include "relic_util.h"
 #include "relic_bc.h"
 #include "rijndael-api-fst.h"
 
+#if ARCH == X64 && defined(__GNUC__)
+#define AES_X64
+#include <immintrin.h>
+#endif
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Backend using the table-based reference code.
+ */
+#define AES_SOFT			0
+
+/**
+ * Backend using the AES-NI and PCLMULQDQ instructions.
+ */
+#define AES_NI				1
+
+/**
+ * Backend using the VAES and VPCLMULQDQ instructions on 256-bit registers.
+ */
+#define AES_VAES			2
+
+/**
+ * Number of blocks processed in parallel by the AES-NI backend. The VAES
+ * backend processes twice as many.
+ */
+#define AES_WAY				8
+
+/**
+ * Reduction constants for the 4-bit GHASH table.
+ */
+static const uint64_t ghash_last[16] = {
+	0x0000, 0x1C20, 0x3840, 0x2460, 0x7080, 0x6CA0, 0x48C0, 0x54E0,
+	0xE100, 0xFD20, 0xD940, 0xC560, 0x9180, 0x8DA0, 0xA9C0, 0xB5E0
+};
+
+/**
+ * Increments the last 32 bits of a counter block.
+ *
+ * @param[in,out] ctr		- the counter block.
+ * @param[in] n				- the increment.
+ */
+static void aes_inc(uint8_t *ctr, uint32_t n) {
+	uint32_t c = ((uint32_t)ctr[12] << 24) | ((uint32_t)ctr[13] << 16) |
+			((uint32_t)ctr[14] << 8) | ctr[15];
+
+	c += n;
+	for (int i = 0; i < 4; i++) {
+		ctr[15 - i] = (uint8_t)(c >> (8 * i));
+	}
+}
+
+/**
+ * Builds the 4-bit multiplication table of the GHASH key.
+ *
+ * @param[in,out] k			- the expanded key.
+ * @param[in] h				- the GHASH key.
+ */
+static void ghash_table(aes_st *k, const uint8_t *h) {
+	uint64_t vh = 0, vl = 0, t;
+	int i, j;
+
+	for (i = 0; i < 8; i++) {
+		vh = (vh << 8) | h[i];
+		vl = (vl << 8) | h[i + 8];
+	}
+	k->hh[0] = k->hl[0] = 0;
+	k->hh[8] = vh;
+	k->hl[8] = vl;
+	for (i = 4; i > 0; i >>= 1) {
+		t = (vl & 1) * 0xE1000000;
+		vl = (vh << 63) | (vl >> 1);
+		vh = (vh >> 1) ^ (t << 32);
+		k->hh[i] = vh;
+		k->hl[i] = vl;
+	}
+	for (i = 2; i <= 8; i *= 2) {
+		for (j = 1; j < i; j++) {
+			k->hh[i + j] = k->hh[i] ^ k->hh[j];
+			k->hl[i + j] = k->hl[i] ^ k->hl[j];
+		}
+	}
+}
+
+/**
+ * Multiplies the GHASH state by the GHASH key.
+ *
+ * @param[in,out] x			- the GHASH state.
+ * @param[in] k				- the expanded key.
+ */
+static void ghash_mul(uint8_t *x, const aes_st *k) {
+	uint64_t zh, zl;
+	int i, r, lo, hi;
+
+	lo = x[15] & 0xF;
+	zh = k->hh[lo];
+	zl = k->hl[lo];
+	for (i = 15; i >= 0; i--) {
+		lo = x[i] & 0xF;
+		hi = x[i] >> 4;
+		if (i != 15) {
+			r = (int)(zl & 0xF);
+			zl = (zh << 60) | (zl >> 4);
+			zh = (zh >> 4) ^ (ghash_last[r] << 48);
+			zh ^= k->hh[lo];
+			zl ^= k->hl[lo];
+		}
+		r = (int)(zl & 0xF);
+		zl = (zh << 60) | (zl >> 4);
+		zh = (zh >> 4) ^ (ghash_last[r] << 48);
+		zh ^= k->hh[hi];
+		zl ^= k->hl[hi];
+	}
+	for (i = 0; i < 8; i++) {
+		x[i] = (uint8_t)(zh >> (56 - 8 * i));
+		x[i + 8] = (uint8_t)(zl >> (56 - 8 * i));
+	}
+}
+
+/**
+ * Absorbs data into the GHASH state with the reference code, padding the last
+ * block with zeros.
+ *
+ * @param[in,out] x			- the GHASH state.
+ * @param[in] in			- the data.
+ * @param[in] len			- the number of bytes.
+ * @param[in] k				- the expanded key.
+ */
+static void soft_ghash(uint8_t *x, const uint8_t *in, int len,
+		const aes_st *k) {
+	int i, l;
+
+	while (len > 0) {
+		l = RLC_MIN(len, RLC_BC_LEN);
+		for (i = 0; i < l; i++) {
+			x[i] ^= in[i];
+		}
+		ghash_mul(x, k);
+		in += l;
+		len -= l;
+	}
+}
+
+/**
+ * Encrypts in CTR mode with the reference code.
+ *
+ * @param[out] out			- the output.
+ * @param[in] in			- the input.
+ * @param[in] len			- the number of bytes.
+ * @param[in] k				- the expanded key.
+ * @param[in,out] ctr		- the counter block.
+ */
+static void soft_ctr(uint8_t *out, const uint8_t *in, int len,
+		const aes_st *k, uint8_t *ctr) {
+	uint8_t s[RLC_BC_LEN];
+	int i, l;
+
+	while (len > 0) {
+		rijndaelEncrypt(k->rk, k->rounds, ctr, s);
+		aes_inc(ctr, 1);
+		l = RLC_MIN(len, RLC_BC_LEN);
+		for (i = 0; i < l; i++) {
+			out[i] = in[i] ^ s[i];
+		}
+		out += l;
+		in += l;
+		len -= l;
+	}
+	memset(s, 0, sizeof(s));
+}
+
+#ifdef AES_X64
+
+/**
+ * Reverses the bytes of a 128-bit register.
+ */
+#define NI_SWAP(X)		_mm_shuffle_epi8(X, _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,\
+		8, 9, 10, 11, 12, 13, 14, 15))
+
+/**
+ * Accumulates the unreduced product of two byte-reflected field elements.
+ *
+ * @param[in,out] lo		- the lower half of the accumulator.
+ * @param[in,out] md		- the middle terms of the accumulator.
+ * @param[in,out] hi		- the upper half of the accumulator.
+ * @param[in] a				- the first element.
+ * @param[in] b				- the second element.
+ */
+__attribute__((target("aes,pclmul,ssse3")))
+static inline void ni_clmul(__m128i *lo, __m128i *md, __m128i *hi, __m128i a,
+		__m128i b) {
+	*lo = _mm_xor_si128(*lo, _mm_clmulepi64_si128(a, b, 0x00));
+	*hi = _mm_xor_si128(*hi, _mm_clmulepi64_si128(a, b, 0x11));
+	*md = _mm_xor_si128(*md, _mm_clmulepi64_si128(a, b, 0x10));
+	*md = _mm_xor_si128(*md, _mm_clmulepi64_si128(a, b, 0x01));
+}
+
+/**
+ * Reduces an accumulated product modulo the GCM polynomial.
+ *
+ * @param[in] lo			- the lower half of the accumulator.
+ * @param[in] md			- the middle terms of the accumulator.
+ * @param[in] hi			- the upper half of the accumulator.
+ * @return the reduced element.
+ */
+__attribute__((target("aes,pclmul,ssse3")))
+static inline __m128i ni_red(__m128i lo, __m128i md, __m128i hi) {
+	__m128i t, u, v;
+
+	lo = _mm_xor_si128(lo, _mm_slli_si128(md, 8));
+	hi = _mm_xor_si128(hi, _mm_srli_si128(md, 8));
+	/* Shift the 256-bit product left by one bit, as operands are reflected. */
+	t = _mm_srli_epi32(lo, 31);
+	u = _mm_srli_epi32(hi, 31);
+	lo = _mm_slli_epi32(lo, 1);
+	hi = _mm_slli_epi32(hi, 1);
+	v = _mm_srli_si128(t, 12);
+	u = _mm_slli_si128(u, 4);
+	t = _mm_slli_si128(t, 4);
+	lo = _mm_or_si128(lo, t);
+	hi = _mm_or_si128(hi, u);
+	hi = _mm_or_si128(hi, v);
+	/* Reduce modulo x^128 + x^7 + x^2 + x + 1. */
+	t = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+	t = _mm_xor_si128(t, _mm_slli_epi32(lo, 25));
+	u = _mm_srli_si128(t, 4);
+	lo = _mm_xor_si128(lo, _mm_slli_si128(t, 12));
+	t = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+	t = _mm_xor_si128(t, _mm_srli_epi32(lo, 7));
+	t = _mm_xor_si128(t, u);
+	lo = _mm_xor_si128(lo, t);
+	return _mm_xor_si128(hi, lo);
+}
+
+/**
+ * Computes the powers of the GHASH key.
+ *
+ * @param[in,out] k			- the expanded key.
+ * @param[in] h				- the GHASH key.
+ */
+__attribute__((target("aes,pclmul,ssse3")))
+static void ni_powers(aes_st *k, const uint8_t *h) {
+	__m128i lo, md, hi, a, p;
+
+	a = NI_SWAP(_mm_loadu_si128((const __m128i *)h));
+	p = a;
+	_mm_storeu_si128((__m128i *)k->h[15], p);
+	for (int i = 14; i >= 0; i--) {
+		lo = md = hi = _mm_setzero_si128();
+		ni_clmul(&lo, &md, &hi, p, a);
+		p = ni_red(lo, md, hi);
+		_mm_storeu_si128((__m128i *)k->h[i], p);
+	}
+}
+
+/**
+ * Encrypts a number of blocks in parallel with AES-NI.
+ *
+ * @param[in,out] b			- the blocks.
+ * @param[in] n				- the number of blocks.
+ * @param[in] k				- the expanded key.
+ */
+__attribute__((target("aes,pclmul,ssse3")))
+static inline void ni_enc(__m128i *b, int n, const aes_st *k) {
+	__m128i r = _mm_loadu_si128((const __m128i *)k->rb[0]);
+	int i, j;
+
+	for (i = 0; i < n; i++) {
+		b[i] = _mm_xor_si128(b[i], r);
+	}
+	for (j = 1; j < k->rounds; j++) {
+		r = _mm_loadu_si128((const __m128i *)k->rb[j]);
+		for (i = 0; i < n; i++) {
+			b[i] = _mm_aesenc_si128(b[i], r);
+		}
+	}
+	r = _mm_loadu_si128((const __m128i *)k->rb[k->rounds]);
+	for (i = 0; i < n; i++) {
+		b[i] = _mm_aesenclast_si128(b[i], r);
+	}
+}
+
+/**
+ * Absorbs data into the GHASH state with PCLMULQDQ, aggregating the
+ * reduction over AES_WAY blocks and padding the last block with zeros.
+ *
+ * @param[in,out] x			- the GHASH state.
+ * @param[in] in			- the data.
+ * @param[in] len			- the number of bytes.
+ * @param[in] k				- the expanded key.
+ */
+__attribute__((target("aes,pclmul,ssse3")))
+static void ni_ghash(uint8_t *x, const uint8_t *in, int len, const aes_st *k) {
+	__m128i lo, md, hi, b, y = NI_SWAP(_mm_loadu_si128((const __m128i *)x));
+	uint8_t t[RLC_BC_LEN];
+	int i, l;
+
+	while (len >= AES_WAY * RLC_BC_LEN) {
+		lo = md = hi = _mm_setzero_si128();
+		for (i = 0; i < AES_WAY; i++) {
+			b = NI_SWAP(_mm_loadu_si128((const __m128i *)in + i));
+			if (i == 0) {
+				b = _mm_xor_si128(b, y);
+			}
+			ni_clmul(&lo, &md, &hi, b,
+					_mm_loadu_si128((const __m128i *)k->h[8 + i]));
+		}
+		y = ni_red(lo, md, hi);
+		in += AES_WAY * RLC_BC_LEN;
+		len -= AES_WAY * RLC_BC_LEN;
+	}
+	while (len > 0) {
+		l = RLC_MIN(len, RLC_BC_LEN);
+		memset(t, 0, sizeof(t));
+		memcpy(t, in, l);
+		b = _mm_xor_si128(y, NI_SWAP(_mm_loadu_si128((const __m128i *)t)));
+		lo = md = hi = _mm_setzero_si128();
+		ni_clmul(&lo, &md, &hi, b, _mm_loadu_si128((const __m128i *)k->h[15]));
+		y = ni_red(lo, md, hi);
+		in += l;
+		len -= l;
+	}
+	_mm_storeu_si128((__m128i *)x, NI_SWAP(y));
+}
+
+/**
+ * Encrypts in CTR mode with AES-NI, optionally absorbing groups of AES_WAY
+ * blocks of ciphertext into a GHASH state. Only full groups are processed
+ * when hashing.
+ *
+ * @param[out] out			- the output.
+ * @param[in] in			- the input.
+ * @param[in] len			- the number of bytes.
+ * @param[in] k				- the expanded key.
+ * @param[in,out] ctr		- the counter block.
+ * @param[in,out] x			- the GHASH state, or NULL.
+ * @param[in] enc			- the flag indicating if the output is hashed.
+ * @return the number of bytes processed.
+ */
+__attribute__((target("aes,pclmul,ssse3")))
+static int ni_ctr(uint8_t *out, const uint8_t *in, int len, const aes_st *k,
+		uint8_t *ctr, uint8_t *x, int enc) {
+	__m128i b[AES_WAY], lo, md, hi, c, y = _mm_setzero_si128();
+	uint8_t s[RLC_BC_LEN];
+	int i, l, done = 0;
+
+	c = NI_SWAP(_mm_loadu_si128((const __m128i *)ctr));
+	if (x != NULL) {
+		y = NI_SWAP(_mm_loadu_si128((const __m128i *)x));
+	}
+	while (len - done >= AES_WAY * RLC_BC_LEN) {
+		for (i = 0; i < AES_WAY; i++) {
+			b[i] = NI_SWAP(_mm_add_epi32(c, _mm_set_epi32(0, 0, 0, i)));
+		}
+		c = _mm_add_epi32(c, _mm_set_epi32(0, 0, 0, AES_WAY));
+		if (x != NULL && !enc) {
+			lo = md = hi = _mm_setzero_si128();
+			for (i = 0; i < AES_WAY; i++) {
+				ni_clmul(&lo, &md, &hi, _mm_xor_si128(i == 0 ? y :
+						_mm_setzero_si128(), NI_SWAP(_mm_loadu_si128(
+						(const __m128i *)in + i))),
+						_mm_loadu_si128((const __m128i *)k->h[8 + i]));
+			}
+			y = ni_red(lo, md, hi);
+		}
+		ni_enc(b, AES_WAY, k);
+		for (i = 0; i < AES_WAY; i++) {
+			b[i] = _mm_xor_si128(b[i],
+					_mm_loadu_si128((const __m128i *)in + i));
+			_mm_storeu_si128((__m128i *)out + i, b[i]);
+		}
+		if (x != NULL && enc) {
+			lo = md = hi = _mm_setzero_si128();
+			for (i = 0; i < AES_WAY; i++) {
+				ni_clmul(&lo, &md, &hi, _mm_xor_si128(i == 0 ? y :
+						_mm_setzero_si128(), NI_SWAP(b[i])),
+						_mm_loadu_si128((const __m128i *)k->h[8 + i]));
+			}
+			y = ni_red(lo, md, hi);
+		}
+		in += AES_WAY * RLC_BC_LEN;
+		out += AES_WAY * RLC_BC_LEN;
+		done += AES_WAY * RLC_BC_LEN;
+	}
+	while (x == NULL && done < len) {
+		b[0] = NI_SWAP(c);
+		c = _mm_add_epi32(c, _mm_set_epi32(0, 0, 0, 1));
+		ni_enc(b, 1, k);
+		l = RLC_MIN(len - done, RLC_BC_LEN);
+		if (l == RLC_BC_LEN) {
+			b[0] = _mm_xor_si128(b[0], _mm_loadu_si128((const __m128i *)in));
+			_mm_storeu_si128((__m128i *)out, b[0]);
+		} else {
+			_mm_storeu_si128((__m128i *)s, b[0]);
+			for (i = 0; i < l; i++) {
+				out[i] = in[i] ^ s[i];
+			}
+			memset(s, 0, sizeof(s));
+		}
+		in += l;
+		out += l;
+		done += l;
+	}
+	_mm_storeu_si128((__m128i *)ctr, NI_SWAP(c));
+	if (x != NULL) {
+		_mm_storeu_si128((__m128i *)x, NI_SWAP(y));
+	}
+	for (i = 0; i < AES_WAY; i++) {
+		b[i] = _mm_setzero_si128();
+	}
+	return done;
+}
+
+/**
+ * Reverses the bytes of each lane of a 256-bit register.
+ */
+#define VA_SWAP(X)		_mm256_shuffle_epi8(X, _mm256_set_epi8(0, 1, 2, 3, 4,\
+		5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9,	\
+		10, 11, 12, 13, 14, 15))
+
+/**
+ * Accumulates the unreduced products of two pairs of byte-reflected field
+ * elements.
+ *
+ * @param[in,out] lo		- the lower halves of the accumulator.
+ * @param[in,out] md		- the middle terms of the accumulator.
+ * @param[in,out] hi		- the upper halves of the accumulator.
+ * @param[in] a				- the first elements.
+ * @param[in] b				- the second elements.
+ */
+__attribute__((target("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3")))
+static inline void va_clmul(__m256i *lo, __m256i *md, __m256i *hi, __m256i a,
+		__m256i b) {
+	*lo = _mm256_xor_si256(*lo, _mm256_clmulepi64_epi128(a, b, 0x00));
+	*hi = _mm256_xor_si256(*hi, _mm256_clmulepi64_epi128(a, b, 0x11));
+	*md = _mm256_xor_si256(*md, _mm256_clmulepi64_epi128(a, b, 0x10));
+	*md = _mm256_xor_si256(*md, _mm256_clmulepi64_epi128(a, b, 0x01));
+}
+
+/**
+ * Absorbs 2 * AES_WAY blocks into a byte-reflected GHASH state with
+ * VPCLMULQDQ and a single reduction.
+ *
+ * @param[in] y				- the GHASH state.
+ * @param[in] b				- the blocks, byte-reflected.
+ * @param[in] k				- the expanded key.
+ * @return the new GHASH state.
+ */
+__attribute__((target("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3")))
+static inline __m128i va_ghash(__m128i y, const __m256i *b, const aes_st *k) {
+	__m256i lo, md, hi, a;
+
+	lo = md = hi = _mm256_setzero_si256();
+	for (int i = 0; i < AES_WAY; i++) {
+		a = b[i];
+		if (i == 0) {
+			a = _mm256_xor_si256(a, _mm256_zextsi128_si256(y));
+		}
+		va_clmul(&lo, &md, &hi, a,
+				_mm256_loadu_si256((const __m256i *)k->h[2 * i]));
+	}
+	return ni_red(_mm_xor_si128(_mm256_castsi256_si128(lo),
+			_mm256_extracti128_si256(lo, 1)),
+			_mm_xor_si128(_mm256_castsi256_si128(md),
+			_mm256_extracti128_si256(md, 1)),
+			_mm_xor_si128(_mm256_castsi256_si128(hi),
+			_mm256_extracti128_si256(hi, 1)));
+}
+
+/**
+ * Encrypts groups of 2 * AES_WAY blocks in CTR mode with VAES, optionally
+ * absorbing the ciphertext into a GHASH state.
+ *
+ * @param[out] out			- the output.
+ * @param[in] in			- the input.
+ * @param[in] len			- the number of bytes.
+ * @param[in] k				- the expanded key.
+ * @param[in,out] ctr		- the counter block.
+ * @param[in,out] x			- the GHASH state, or NULL.
+ * @param[in] enc			- the flag indicating if the output is hashed.
+ * @return the number of bytes processed.
+ */
+__attribute__((target("vaes,vpclmulqdq,avx2,aes,pclmul,ssse3")))
+static int va_ctr(uint8_t *out, const uint8_t *in, int len, const aes_st *k,
+		uint8_t *ctr, uint8_t *x, int enc) {
+	__m256i b[AES_WAY], d[AES_WAY], c, r;
+	__m128i y = _mm_setzero_si128();
+	int i, j, done = 0;
+
+	c = _mm256_broadcastsi128_si256(NI_SWAP(
+			_mm_loadu_si128((const __m128i *)ctr)));
+	c = _mm256_add_epi32(c, _mm256_set_epi32(0, 0, 0, 1, 0, 0, 0, 0));
+	if (x != NULL) {
+		y = NI_SWAP(_mm_loadu_si128((const __m128i *)x));
+	}
+	while (len - done >= 2 * AES_WAY * RLC_BC_LEN) {
+		for (i = 0; i < AES_WAY; i++) {
+			b[i] = VA_SWAP(_mm256_add_epi32(c,
+					_mm256_set_epi32(0, 0, 0, 2 * i, 0, 0, 0, 2 * i)));
+			d[i] = _mm256_loadu_si256((const __m256i *)in + i);
+		}
+		c = _mm256_add_epi32(c, _mm256_set_epi32(0, 0, 0, 2 * AES_WAY,
+				0, 0, 0, 2 * AES_WAY));
+		if (x != NULL && !enc) {
+			for (i = 0; i < AES_WAY; i++) {
+				d[i] = VA_SWAP(d[i]);
+			}
+			y = va_ghash(y, d, k);
+			for (i = 0; i < AES_WAY; i++) {
+				d[i] = VA_SWAP(d[i]);
+			}
+		}
+		r = _mm256_broadcastsi128_si256(
+				_mm_loadu_si128((const __m128i *)k->rb[0]));
+		for (i = 0; i < AES_WAY; i++) {
+			b[i] = _mm256_xor_si256(b[i], r);
+		}
+		for (j = 1; j < k->rounds; j++) {
+			r = _mm256_broadcastsi128_si256(
+					_mm_loadu_si128((const __m128i *)k->rb[j]));
+			for (i = 0; i < AES_WAY; i++) {
+				b[i] = _mm256_aesenc_epi128(b[i], r);
+			}
+		}
+		r = _mm256_broadcastsi128_si256(
+				_mm_loadu_si128((const __m128i *)k->rb[k->rounds]));
+		for (i = 0; i < AES_WAY; i++) {
+			b[i] = _mm256_aesenclast_epi128(b[i], r);
+			b[i] = _mm256_xor_si256(b[i], d[i]);
+			_mm256_storeu_si256((__m256i *)out + i, b[i]);
+		}
+		if (x != NULL && enc) {
+			for (i = 0; i < AES_WAY; i++) {
+				b[i] = VA_SWAP(b[i]);
+			}
+			y = va_ghash(y, b, k);
+		}
+		in += 2 * AES_WAY * RLC_BC_LEN;
+		out += 2 * AES_WAY * RLC_BC_LEN;
+		done += 2 * AES_WAY * RLC_BC_LEN;
+	}
+	if (done > 0) {
+		aes_inc(ctr, done / RLC_BC_LEN);
+	}
+	if (x != NULL) {
+		_mm_storeu_si128((__m128i *)x, NI_SWAP(y));
+	}
+	for (i = 0; i < AES_WAY; i++) {
+		b[i] = _mm256_setzero_si256();
+	}
+	_mm256_zeroupper();
+	return done;
+}
+
+#endif /* AES_X64 */
+
+/**
+ * Selects the fastest backend supported by the processor.
+ *
+ * @return the backend.
+ */
+static int aes_backend(void) {
+#ifdef AES_X64
+	if (arch_has(RLC_X64_VAES | RLC_X64_AES)) {
+		return AES_VAES;
+	}
+	if (arch_has(RLC_X64_AES)) {
+		return AES_NI;
+	}
+#endif
+	return AES_SOFT;
+}
+
+/**
+ * Absorbs data into the GHASH state, padding the last block with zeros.
+ *
+ * @param[in,out] x			- the GHASH state.
+ * @param[in] in			- the data.
+ * @param[in] len			- the number of bytes.
+ * @param[in] k				- the expanded key.
+ */
+static void aes_ghash(uint8_t *x, const uint8_t *in, int len, const aes_st *k) {
+#ifdef AES_X64
+	if (k->ni >= AES_NI) {
+		ni_ghash(x, in, len, k);
+		return;
+	}
+#endif
+	soft_ghash(x, in, len, k);
+}
+
+/**
+ * Encrypts in CTR mode, optionally absorbing the ciphertext into a GHASH
+ * state.
+ *
+ * @param[out] out			- the output.
+ * @param[in] in			- the input.
+ * @param[in] len			- the number of bytes.
+ * @param[in] k				- the expanded key.
+ * @param[in,out] ctr		- the counter block.
+ * @param[in,out] x			- the GHASH state, or NULL.
+ * @param[in] enc			- the flag indicating if the output is hashed.
+ */
+static void aes_ctr(uint8_t *out, const uint8_t *in, int len, const aes_st *k,
+		uint8_t *ctr, uint8_t *x, int enc) {
+	int l = 0;
+
+#ifdef AES_X64
+	/* Full groups of blocks are encrypted and hashed in a single pass. */
+	if (k->ni == AES_VAES) {
+		l = va_ctr(out, in, len, k, ctr, x, enc);
+	}
+	if (k->ni >= AES_NI) {
+		l += ni_ctr(out + l, in + l, len - l, k, ctr, x, enc);
+	}
+#endif
+	if (x == NULL) {
+		soft_ctr(out + l, in + l, len - l, k, ctr);
+		return;
+	}
+	if (!enc) {
+		aes_ghash(x, in + l, len - l, k);
+	}
+	aes_ctr(out + l, in + l, len - l, k, ctr, NULL, 0);
+	if (enc) {
+		aes_ghash(x, out + l, len - l, k);
+	}
+}
+
+/**
+ * Encrypts or decrypts with AES in GCM mode and computes the tag.
+ *
+ * @param[out] out			- the output.
+ * @param[out] tag			- the authentication tag.
+ * @param[in] in			- the input.
+ * @param[in] len			- the number of bytes.
+ * @param[in] ad			- the associated data.
+ * @param[in] ad_len		- the number of bytes of associated data.
+ * @param[in] k				- the expanded key.
+ * @param[in] iv			- the nonce.
+ * @param[in] enc			- the flag indicating encryption.
+ */
+static void aes_gcm(uint8_t *out, uint8_t *tag, const uint8_t *in, int len,
+		const uint8_t *ad, int ad_len, const aes_st *k, const uint8_t *iv,
+		int enc) {
+	uint8_t j[RLC_BC_LEN], ctr[RLC_BC_LEN], x[RLC_BC_LEN] = { 0 };
+	uint64_t bits;
+	int i;
+
+	/* J0 = IV || 0^31 || 1. */
+	memcpy(j, iv, RLC_BC_IV);
+	memset(j + RLC_BC_IV, 0, RLC_BC_LEN - RLC_BC_IV);
+	j[RLC_BC_LEN - 1] = 1;
+	memcpy(ctr, j, RLC_BC_LEN);
+	aes_inc(ctr, 1);
+
+	aes_ghash(x, ad, ad_len, k);
+	aes_ctr(out, in, len, k, ctr, x, enc);
+	for (i = 0; i < 2; i++) {
+		bits = 8 * (uint64_t)(i == 0 ? ad_len : len);
+		for (int b = 0; b < 8; b++) {
+			ctr[8 * i + b] = (uint8_t)(bits >> (56 - 8 * b));
+		}
+	}
+	aes_ghash(x, ctr, RLC_BC_LEN, k);
+	aes_ctr(tag, x, RLC_BC_LEN, k, j, NULL, 0);
+	memset(x, 0, sizeof(x));
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -85,3 +764,80 @@ int bc_aes_cbc_dec(uint8_t *out, int *out_len, uint8_t *in,
 	}
 	return RLC_OK;
 }
+
+int bc_aes_key(aes_t k, const uint8_t *key, int key_len) {
+	uint8_t h[RLC_BC_LEN] = { 0 };
+	int i;
+
+	if (key_len != 16 && key_len != 24 && key_len != 32) {
+		return RLC_ERR;
+	}
+
+	memset(k, 0, sizeof(aes_st));
+	k->rounds = rijndaelKeySetupEnc(k->rk, key, 8 * key_len);
+	for (i = 0; i < 4 * (k->rounds + 1); i++) {
+		for (int j = 0; j < 4; j++) {
+			k->rb[i / 4][4 * (i % 4) + j] = (uint8_t)(k->rk[i] >> (24 - 8 * j));
+		}
+	}
+	k->ni = aes_backend();
+
+	/* H = E(K, 0^128). */
+	rijndaelEncrypt(k->rk, k->rounds, h, h);
+	ghash_table(k, h);
+#ifdef AES_X64
+	if (k->ni >= AES_NI) {
+		ni_powers(k, h);
+	}
+#endif
+	memset(h, 0, sizeof(h));
+	return RLC_OK;
+}
+
+int bc_aes_ctr_enc(uint8_t *out, int *out_len, const uint8_t *in, int in_len,
+		const aes_t k, const uint8_t *iv) {
+	uint8_t ctr[RLC_BC_LEN];
+
+	if (in_len < 0 || *out_len < in_len) {
+		return RLC_ERR;
+	}
+	memcpy(ctr, iv, RLC_BC_LEN);
+	aes_ctr(out, in, in_len, k, ctr, NULL, 0);
+	*out_len = in_len;
+	return RLC_OK;
+}
+
+int bc_aes_ctr_dec(uint8_t *out, int *out_len, const uint8_t *in, int in_len,
+		const aes_t k, const uint8_t *iv) {
+	return bc_aes_ctr_enc(out, out_len, in, in_len, k, iv);
+}
+
+int bc_aes_gcm_enc(uint8_t *out, int *out_len, const uint8_t *in, int in_len,
+		const uint8_t *ad, int ad_len, const aes_t k, const uint8_t *iv) {
+	if (in_len < 0 || ad_len < 0 || in_len > INT_MAX - RLC_BC_TAG ||
+			*out_len < in_len + RLC_BC_TAG) {
+		return RLC_ERR;
+	}
+	aes_gcm(out, out + in_len, in, in_len, ad, ad_len, k, iv, 1);
+	*out_len = in_len + RLC_BC_TAG;
+	return RLC_OK;
+}
+
+int bc_aes_gcm_dec(uint8_t *out, int *out_len, const uint8_t *in, int in_len,
+		const uint8_t *ad, int ad_len, const aes_t k, const uint8_t *iv) {
+	uint8_t tag[RLC_BC_TAG], t[RLC_BC_TAG];
+	int len = in_len - RLC_BC_TAG;
+
+	if (len < 0 || ad_len < 0 || *out_len < len) {
+		return RLC_ERR;
+	}
+	/* Keep the tag, as decryption may happen in place. */
+	memcpy(t, in + len, RLC_BC_TAG);
+	aes_gcm(out, tag, in, len, ad, ad_len, k, iv, 0);
+	if (util_cmp_const(tag, t, RLC_BC_TAG) != RLC_EQ) {
+		memset(out, 0, len);
+		return RLC_ERR;
+	}
+	*out_len = len;
+	return RLC_OK;
+}
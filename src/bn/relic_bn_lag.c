@@ -32,56 +32,801 @@
 #include "relic_core.h"
 #include "relic_bn.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Number of coefficients below which quadratic algorithms are used.
+ */
+#define POL_BASIC	16
+
+/**
+ * Number of coefficients above which products are computed with the NTT.
+ */
+#define POL_NTT		512
+
+/**
+ * Largest two-adicity exploited by the NTT.
+ */
+#define POL_ADIC	30
+
+/**
+ * Allocates and initializes a polynomial with n coefficients. Polynomial
+ * buffers grow with O(n log n) coefficients in the subproduct trees, so they
+ * are taken from the heap even when ALLOC = AUTO.
+ *
+ * @param[in] n				- the number of coefficients.
+ * @return the allocated polynomial.
+ */
+static bn_t *pol_new(int n) {
+	bn_t *a = (bn_t *)malloc(RLC_MAX(n, 1) * sizeof(bn_t));
+
+	if (a == NULL) {
+		RLC_THROW(ERR_NO_MEMORY);
+		return NULL;
+	}
+	for (int i = 0; i < n; i++) {
+		bn_null(a[i]);
+		bn_new(a[i]);
+		bn_zero(a[i]);
+	}
+	return a;
+}
+
+/**
+ * Frees a polynomial allocated with pol_new().
+ *
+ * @param[in] a				- the polynomial to free.
+ * @param[in] n				- the number of coefficients.
+ */
+static void pol_free(bn_t *a, int n) {
+	if (a != NULL) {
+		for (int i = 0; i < n; i++) {
+			bn_free(a[i]);
+		}
+		free(a);
+	}
+}
+
+/**
+ * Adds two reduced integers modulo q.
+ *
+ * @param[out] c			- the result.
+ * @param[in] a				- the first integer.
+ * @param[in] b				- the second integer.
+ * @param[in] q				- the modulus.
+ */
+static void pol_add(bn_t c, const bn_t a, const bn_t b, const bn_t q) {
+	bn_add(c, a, b);
+	if (bn_cmp(c, q) != RLC_LT) {
+		bn_sub(c, c, q);
+	}
+}
+
+/**
+ * Subtracts two reduced integers modulo q.
+ *
+ * @param[out] c			- the result.
+ * @param[in] a				- the first integer.
+ * @param[in] b				- the second integer.
+ * @param[in] q				- the modulus.
+ */
+static void pol_sub(bn_t c, const bn_t a, const bn_t b, const bn_t q) {
+	bn_sub(c, a, b);
+	if (bn_sign(c) == RLC_NEG) {
+		bn_add(c, c, q);
+	}
+}
+
+/**
+ * Finds a primitive root of unity of order 2^s modulo a prime q, where 2^s is
+ * the largest power of two dividing q - 1, capped at 2^POL_ADIC.
+ *
+ * @param[out] w			- the root of unity.
+ * @param[in] q				- the modulus.
+ * @return the exponent s, or zero if the NTT cannot be used.
+ */
+static int pol_root(bn_t w, const bn_t q) {
+	bn_t e, g;
+	int s = 0;
+
+	bn_null(e);
+	bn_null(g);
+
+	RLC_TRY {
+		bn_new(e);
+		bn_new(g);
+
+		bn_sub_dig(e, q, 1);
+		while (!bn_is_zero(e) && bn_is_even(e)) {
+			bn_hlv(e, e);
+			s++;
+		}
+		if (s > 1 && bn_is_prime(q)) {
+			/* A quadratic non-residue raised to (q - 1)/2^s has order 2^s. */
+			for (dig_t d = 2; ; d++) {
+				bn_set_dig(g, d);
+				if (bn_smb_leg(g, q) == -1) {
+					break;
+				}
+			}
+			bn_mxp(w, g, e, q);
+			for (; s > POL_ADIC; s--) {
+				bn_sqr(w, w);
+				bn_mod(w, w, q);
+			}
+		} else {
+			s = 0;
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(e);
+		bn_free(g);
+	}
+	return s;
+}
+
+/**
+ * Multiplies two polynomials with schoolbook multiplication. Products are
+ * accumulated and reduced once every POL_BASIC terms.
+ *
+ * @param[out] c			- the na + nb - 1 coefficients of the result.
+ * @param[in] a				- the first polynomial.
+ * @param[in] na			- the number of coefficients of the first polynomial.
+ * @param[in] b				- the second polynomial.
+ * @param[in] nb			- the number of coefficients of the second polynomial.
+ * @param[in] q				- the modulus.
+ */
+static void pol_mul_basic(bn_t *c, const bn_t *a, int na, const bn_t *b,
+		int nb, const bn_t q) {
+	bn_t t;
+	int i, j, k;
+
+	bn_null(t);
+
+	RLC_TRY {
+		bn_new(t);
+
+		for (k = 0; k < na + nb - 1; k++) {
+			bn_zero(c[k]);
+			i = RLC_MAX(0, k - nb + 1);
+			for (j = 0; i < na && i <= k; i++, j++) {
+				bn_mul(t, a[i], b[k - i]);
+				bn_add(c[k], c[k], t);
+				if (j == POL_BASIC - 1) {
+					bn_mod(c[k], c[k], q);
+					j = -1;
+				}
+			}
+			bn_mod(c[k], c[k], q);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(t);
+	}
+}
+
+/**
+ * Computes the scratch space needed by pol_mul_karat().
+ *
+ * @param[in] n				- the number of coefficients of the operands.
+ * @return the number of scratch coefficients.
+ */
+static int pol_karat_size(int n) {
+	int size = 0;
+
+	for (; n > POL_BASIC; n = (n + 1) / 2) {
+		size += 4 * ((n + 1) / 2);
+	}
+	return size;
+}
+
+/**
+ * Multiplies two polynomials with the same number of coefficients using
+ * Karatsuba multiplication.
+ *
+ * @param[out] c			- the 2n - 1 coefficients of the result.
+ * @param[in] a				- the first polynomial.
+ * @param[in] b				- the second polynomial.
+ * @param[in] n				- the number of coefficients of each operand.
+ * @param[in] t				- the scratch space.
+ * @param[in] q				- the modulus.
+ */
+static void pol_mul_karat(bn_t *c, const bn_t *a, const bn_t *b, int n,
+		bn_t *t, const bn_t q) {
+	int i, h = (n + 1) / 2, l = n - h;
+
+	if (n <= POL_BASIC) {
+		pol_mul_basic(c, a, n, b, n, q);
+		return;
+	}
+
+	/* Compute a0 * b0 and a1 * b1 directly in the result. */
+	pol_mul_karat(c, a, b, h, t, q);
+	pol_mul_karat(c + 2 * h, a + h, b + h, l, t, q);
+	bn_zero(c[2 * h - 1]);
+
+	/* Compute (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1. */
+	for (i = 0; i < h; i++) {
+		bn_copy(t[i], a[i]);
+		bn_copy(t[h + i], b[i]);
+		if (i < l) {
+			pol_add(t[i], t[i], a[h + i], q);
+			pol_add(t[h + i], t[h + i], b[h + i], q);
+		}
+	}
+	pol_mul_karat(t + 2 * h, t, t + h, h, t + 4 * h, q);
+	for (i = 0; i < 2 * h - 1; i++) {
+		pol_sub(t[2 * h + i], t[2 * h + i], c[i], q);
+		if (i < 2 * l - 1) {
+			pol_sub(t[2 * h + i], t[2 * h + i], c[2 * h + i], q);
+		}
+	}
+	for (i = 0; i < 2 * h - 1; i++) {
+		pol_add(c[h + i], c[h + i], t[2 * h + i], q);
+	}
+}
+
+/**
+ * Computes the number theoretic transform of a polynomial in place.
+ *
+ * @param[in,out] a			- the polynomial.
+ * @param[in] n				- the number of coefficients, a power of two.
+ * @param[in] w				- the table of powers of the root of unity.
+ * @param[in] q				- the modulus.
+ */
+static void pol_ntt(bn_t *a, int n, const bn_t *w, const bn_t q) {
+	bn_t u, v;
+	int i, j, k, l;
+
+	bn_null(u);
+	bn_null(v);
+
+	RLC_TRY {
+		bn_new(u);
+		bn_new(v);
+
+		/* Apply the bit-reversal permutation. */
+		for (i = 1, j = 0; i < n; i++) {
+			for (k = n >> 1; j & k; k >>= 1) {
+				j ^= k;
+			}
+			j ^= k;
+			if (i < j) {
+				bn_copy(u, a[i]);
+				bn_copy(a[i], a[j]);
+				bn_copy(a[j], u);
+			}
+		}
+
+		for (l = 1; l < n; l <<= 1) {
+			for (i = 0; i < n; i += 2 * l) {
+				for (j = 0; j < l; j++) {
+					bn_copy(u, a[i + j]);
+					bn_mul(v, a[i + j + l], w[j * (n / (2 * l))]);
+					bn_mod(v, v, q);
+					pol_add(a[i + j], u, v, q);
+					pol_sub(a[i + j + l], u, v, q);
+				}
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(u);
+		bn_free(v);
+	}
+}
+
+/**
+ * Multiplies two polynomials using the number theoretic transform.
+ *
+ * @param[out] c			- the na + nb - 1 coefficients of the result.
+ * @param[in] a				- the first polynomial.
+ * @param[in] na			- the number of coefficients of the first polynomial.
+ * @param[in] b				- the second polynomial.
+ * @param[in] nb			- the number of coefficients of the second polynomial.
+ * @param[in] w				- the primitive root of unity of order 2^s.
+ * @param[in] s				- the two-adicity of the root of unity.
+ * @param[in] q				- the modulus.
+ */
+static void pol_mul_ntt(bn_t *c, const bn_t *a, int na, const bn_t *b, int nb,
+		const bn_t w, int s, const bn_t q) {
+	bn_t r, *t = NULL, *u = NULL, *v = NULL;
+	int i, k = 0, n = 1;
+
+	while (n < na + nb - 1) {
+		n <<= 1;
+		k++;
+	}
+
+	bn_null(r);
+
+	RLC_TRY {
+		bn_new(r);
+		t = pol_new(n / 2);
+		u = pol_new(n);
+		v = pol_new(n);
+
+		/* Compute a root of order n and its powers. */
+		bn_copy(r, w);
+		for (i = k; i < s; i++) {
+			bn_sqr(r, r);
+			bn_mod(r, r, q);
+		}
+		bn_set_dig(t[0], 1);
+		for (i = 1; i < n / 2; i++) {
+			bn_mul(t[i], t[i - 1], r);
+			bn_mod(t[i], t[i], q);
+		}
+
+		for (i = 0; i < na; i++) {
+			bn_copy(u[i], a[i]);
+		}
+		for (i = 0; i < nb; i++) {
+			bn_copy(v[i], b[i]);
+		}
+		pol_ntt(u, n, (const bn_t *)t, q);
+		pol_ntt(v, n, (const bn_t *)t, q);
+		for (i = 0; i < n; i++) {
+			bn_mul(u[i], u[i], v[i]);
+			bn_mod(u[i], u[i], q);
+		}
+		/* The inverse transform is the forward one with reversed outputs. */
+		pol_ntt(u, n, (const bn_t *)t, q);
+		bn_set_dig(r, n);
+		bn_mod_inv(r, r, q);
+		for (i = 0; i < na + nb - 1; i++) {
+			bn_mul(c[i], u[(n - i) & (n - 1)], r);
+			bn_mod(c[i], c[i], q);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(r);
+		pol_free(t, n / 2);
+		pol_free(u, n);
+		pol_free(v, n);
+	}
+}
+
+/**
+ * Multiplies two polynomials, choosing the best algorithm for their sizes.
+ * The result must not overlap with the operands.
+ *
+ * @param[out] c			- the na + nb - 1 coefficients of the result.
+ * @param[in] a				- the first polynomial.
+ * @param[in] na			- the number of coefficients of the first polynomial.
+ * @param[in] b				- the second polynomial.
+ * @param[in] nb			- the number of coefficients of the second polynomial.
+ * @param[in] w				- the primitive root of unity of order 2^s.
+ * @param[in] s				- the two-adicity of the root, or zero.
+ * @param[in] q				- the modulus.
+ */
+static void pol_mul(bn_t *c, const bn_t *a, int na, const bn_t *b, int nb,
+		const bn_t w, int s, const bn_t q) {
+	bn_t *p = NULL, *t = NULL, *u = NULL;
+	int i, j, l, size;
+
+	if (na < nb) {
+		pol_mul(c, b, nb, a, na, w, s, q);
+		return;
+	}
+	if (nb <= POL_BASIC) {
+		pol_mul_basic(c, a, na, b, nb, q);
+		return;
+	}
+	if (s > 0 && na + nb - 1 >= POL_NTT && na + nb - 1 <= (1 << s)) {
+		pol_mul_ntt(c, a, na, b, nb, w, s, q);
+		return;
+	}
+
+	/* Split the longer operand in blocks and multiply them with Karatsuba. */
+	size = pol_karat_size(nb);
+	RLC_TRY {
+		p = pol_new(2 * nb - 1);
+		t = pol_new(size);
+		u = pol_new(nb);
+
+		for (i = 0; i < na + nb - 1; i++) {
+			bn_zero(c[i]);
+		}
+		for (i = 0; i < na; i += nb) {
+			l = RLC_MIN(nb, na - i);
+			for (j = 0; j < nb; j++) {
+				if (j < l) {
+					bn_copy(u[j], a[i + j]);
+				} else {
+					bn_zero(u[j]);
+				}
+			}
+			pol_mul_karat(p, (const bn_t *)u, b, nb, t, q);
+			for (j = 0; j < 2 * nb - 1 && i + j < na + nb - 1; j++) {
+				pol_add(c[i + j], c[i + j], p[j], q);
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		pol_free(p, 2 * nb - 1);
+		pol_free(t, size);
+		pol_free(u, nb);
+	}
+}
+
+/**
+ * Computes the inverse of a power series with unit constant term using Newton
+ * iteration.
+ *
+ * @param[out] c			- the m coefficients of the inverse.
+ * @param[in] a				- the first m coefficients of the power series.
+ * @param[in] m				- the precision.
+ * @param[in] w				- the primitive root of unity of order 2^s.
+ * @param[in] s				- the two-adicity of the root, or zero.
+ * @param[in] q				- the modulus.
+ */
+static void pol_inv(bn_t *c, const bn_t *a, int m, const bn_t w, int s,
+		const bn_t q) {
+	bn_t *e = NULL, *f = NULL;
+	int i, k, l;
+
+	RLC_TRY {
+		e = pol_new(2 * m);
+		f = pol_new(2 * m);
+
+		bn_set_dig(c[0], 1);
+		for (k = 1; k < m; k = l) {
+			l = RLC_MIN(2 * k, m);
+			/* Compute c = c * (2 - a * c) mod x^l. */
+			pol_mul(e, a, l, (const bn_t *)c, k, w, s, q);
+			for (i = 0; i < l; i++) {
+				bn_neg(e[i], e[i]);
+				bn_mod(e[i], e[i], q);
+			}
+			bn_add_dig(e[0], e[0], 2);
+			bn_mod(e[0], e[0], q);
+			pol_mul(f, (const bn_t *)c, k, (const bn_t *)e, l, w, s, q);
+			for (i = 0; i < l; i++) {
+				bn_copy(c[i], f[i]);
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		pol_free(e, 2 * m);
+		pol_free(f, 2 * m);
+	}
+}
+
+/**
+ * Computes the leading coefficients of the power series f / g in 1/x, which
+ * determine the remainder of f modulo a monic polynomial g. The coefficients
+ * of x^-d, ..., x^-1 are written in this order.
+ *
+ * @param[out] c			- the d coefficients of the scaled remainder.
+ * @param[in] f				- the polynomial to reduce.
+ * @param[in] nf			- the number of coefficients of the polynomial.
+ * @param[in] g				- the d non-leading coefficients of the modulus.
+ * @param[in] d				- the degree of the modulus.
+ * @param[in] w				- the primitive root of unity of order 2^s.
+ * @param[in] s				- the two-adicity of the root, or zero.
+ * @param[in] q				- the modulus.
+ */
+static void pol_sig(bn_t *c, const bn_t *f, int nf, const bn_t *g, int d,
+		const bn_t w, int s, const bn_t q) {
+	bn_t *h = NULL, *u = NULL, *v = NULL;
+	int i, m = RLC_MAX(nf, d);
+
+	RLC_TRY {
+		h = pol_new(m);
+		u = pol_new(2 * m);
+		v = pol_new(m);
+
+		/* Compute f(x) / g(x) = x^(-d) f(x) / rev(g)(1/x). */
+		bn_set_dig(u[0], 1);
+		for (i = 1; i < m && i <= d; i++) {
+			bn_copy(u[i], g[d - i]);
+		}
+		pol_inv(h, (const bn_t *)u, m, w, s, q);
+		for (i = 0; i < nf; i++) {
+			bn_copy(v[m - 1 - i], f[i]);
+		}
+		pol_mul(u, (const bn_t *)v, m, (const bn_t *)h, m, w, s, q);
+		for (i = 0; i < d; i++) {
+			bn_copy(c[i], u[m - 1 - i]);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		pol_free(h, m);
+		pol_free(u, 2 * m);
+		pol_free(v, m);
+	}
+}
+
+/**
+ * Computes the depth of the subproduct tree built over n points.
+ *
+ * @param[in] n				- the number of points.
+ * @return the number of levels in the tree.
+ */
+static int pol_depth(int n) {
+	int d = 1;
+
+	for (; n > POL_BASIC; n = (n + 1) / 2) {
+		d++;
+	}
+	return d;
+}
+
+/**
+ * Builds the subproduct tree of the monic polynomials vanishing at a range of
+ * points. Each node is stored without its leading coefficient at the offset of
+ * its first point, so that every level of the tree takes n coefficients.
+ *
+ * @param[out] t			- the levels of the tree, starting at this node.
+ * @param[in] a				- the points.
+ * @param[in] lo			- the first point of the range.
+ * @param[in] hi			- the point past the end of the range.
+ * @param[in] n				- the number of coefficients in each level.
+ * @param[in] w				- the primitive root of unity of order 2^s.
+ * @param[in] s				- the two-adicity of the root, or zero.
+ * @param[in] q				- the modulus.
+ */
+static void pol_tree(bn_t *t, const bn_t *a, int lo, int hi, int n,
+		const bn_t w, int s, const bn_t q) {
+	bn_t u, *c = t + lo, *l = t + n + lo, *p = NULL;
+	int i, j, mid = lo + (hi - lo) / 2, dl = mid - lo, dr = hi - mid;
+
+	bn_null(u);
+
+	RLC_TRY {
+		bn_new(u);
+
+		if (hi - lo <= POL_BASIC) {
+			/* Multiply the linear factors incrementally. */
+			for (i = 0; i < hi - lo; i++) {
+				bn_sub(c[i], q, a[lo + i]);
+				bn_mod(c[i], c[i], q);
+				if (i > 0) {
+					pol_add(c[i], c[i], c[i - 1], q);
+				}
+				for (j = i - 1; j >= 0; j--) {
+					bn_mul(u, c[j], a[lo + i]);
+					bn_mod(u, u, q);
+					if (j > 0) {
+						pol_sub(c[j], c[j - 1], u, q);
+					} else {
+						bn_sub(c[j], q, u);
+						bn_mod(c[j], c[j], q);
+					}
+				}
+			}
+		} else {
+			pol_tree(t + n, a, lo, mid, n, w, s, q);
+			pol_tree(t + n, a, mid, hi, n, w, s, q);
+			/* (x^dl + l)(x^dr + r) = l * r + x^dl * r + x^dr * l + x^(dl+dr). */
+			p = pol_new(dl + dr);
+			pol_mul(p, (const bn_t *)l, dl, (const bn_t *)l + dl, dr, w, s, q);
+			bn_zero(p[dl + dr - 1]);
+			for (i = 0; i < dr; i++) {
+				pol_add(p[dl + i], p[dl + i], l[dl + i], q);
+			}
+			for (i = 0; i < dl; i++) {
+				pol_add(p[dr + i], p[dr + i], l[i], q);
+			}
+			for (i = 0; i < dl + dr; i++) {
+				bn_copy(c[i], p[i]);
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(u);
+		pol_free(p, dl + dr);
+	}
+}
+
+/**
+ * Evaluates a polynomial at a range of points by descending the subproduct
+ * tree with scaled remainders. If f / M has leading coefficients s for the
+ * node M = A * B, then those of f / A are the leading coefficients of s * B,
+ * so each child costs a single multiplication and no division.
+ *
+ * @param[out] c			- the evaluations, indexed by point.
+ * @param[in] f				- the scaled remainder of the polynomial at the node.
+ * @param[in] t				- the levels of the tree, starting at this node.
+ * @param[in] a				- the points.
+ * @param[in] lo			- the first point of the range.
+ * @param[in] hi			- the point past the end of the range.
+ * @param[in] n				- the number of coefficients in each level.
+ * @param[in] w				- the primitive root of unity of order 2^s.
+ * @param[in] s				- the two-adicity of the root, or zero.
+ * @param[in] q				- the modulus.
+ */
+static void pol_down(bn_t *c, const bn_t *f, const bn_t *t, const bn_t *a,
+		int lo, int hi, int n, const bn_t w, int s, const bn_t q) {
+	bn_t u, *r = NULL, *p = NULL;
+	int i, j, mid = lo + (hi - lo) / 2, d = hi - lo, dl = mid - lo;
+
+	bn_null(u);
+
+	RLC_TRY {
+		bn_new(u);
+		r = pol_new(d);
+
+		if (d <= POL_BASIC) {
+			/* Recover the remainder as the polynomial part of M * f / M. */
+			for (i = 0; i < d; i++) {
+				bn_copy(r[i], f[i]);
+				for (j = i + 1; j < d; j++) {
+					bn_mul(u, t[lo + j], f[d - j + i]);
+					bn_add(r[i], r[i], u);
+					bn_mod(r[i], r[i], q);
+				}
+			}
+			for (i = lo; i < hi; i++) {
+				bn_evl(c[i], (const bn_t *)r, a[i], q, d);
+			}
+		} else {
+			p = pol_new(2 * d);
+			pol_mul(p, f, d, t + n + mid, d - dl, w, s, q);
+			for (i = 0; i < dl; i++) {
+				pol_add(r[i], p[d - dl + i], f[i], q);
+			}
+			pol_mul(p, f, d, t + n + lo, dl, w, s, q);
+			for (i = 0; i < d - dl; i++) {
+				pol_add(r[dl + i], p[dl + i], f[i], q);
+			}
+			pol_down(c, (const bn_t *)r, t + n, a, lo, mid, n, w, s, q);
+			pol_down(c, (const bn_t *)r + dl, t + n, a, mid, hi, n, w, s, q);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(u);
+		pol_free(r, d);
+		pol_free(p, 2 * d);
+	}
+}
+
+/**
+ * Combines weighted Lagrange basis polynomials by ascending the subproduct
+ * tree, computing sum_i v_i * M(x) / (x - a_i) for the node polynomial M.
+ *
+ * @param[out] c			- the hi - lo coefficients of the result.
+ * @param[in] v				- the weights, indexed by point.
+ * @param[in] t				- the levels of the tree, starting at this node.
+ * @param[in] a				- the points.
+ * @param[in] lo			- the first point of the range.
+ * @param[in] hi			- the point past the end of the range.
+ * @param[in] n				- the number of coefficients in each level.
+ * @param[in] w				- the primitive root of unity of order 2^s.
+ * @param[in] s				- the two-adicity of the root, or zero.
+ * @param[in] q				- the modulus.
+ */
+static void pol_up(bn_t *c, const bn_t *v, const bn_t *t, const bn_t *a,
+		int lo, int hi, int n, const bn_t w, int s, const bn_t q) {
+	bn_t u, r, *l = NULL, *p = NULL;
+	int i, j, mid = lo + (hi - lo) / 2, dl = mid - lo, dr = hi - mid;
+
+	bn_null(u);
+	bn_null(r);
+
+	RLC_TRY {
+		bn_new(u);
+		bn_new(r);
+
+		for (j = 0; j < hi - lo; j++) {
+			bn_zero(c[j]);
+		}
+		if (hi - lo <= POL_BASIC) {
+			for (i = lo; i < hi; i++) {
+				/* Divide the node by (x - a_i) with synthetic division. */
+				bn_set_dig(u, 1);
+				for (j = hi - lo - 1; j >= 0; j--) {
+					bn_mul(r, u, v[i]);
+					bn_mod(r, r, q);
+					pol_add(c[j], c[j], r, q);
+					if (j > 0) {
+						bn_mul(u, u, a[i]);
+						bn_add(u, u, t[lo + j]);
+						bn_mod(u, u, q);
+					}
+				}
+			}
+		} else {
+			l = pol_new(dl + dr);
+			p = pol_new(dl + dr);
+			pol_up(l, v, t + n, a, lo, mid, n, w, s, q);
+			pol_up(l + dl, v, t + n, a, mid, hi, n, w, s, q);
+			/* Compute l * (x^dr + t_r) + r * (x^dl + t_l). */
+			pol_mul(p, (const bn_t *)l, dl, t + n + mid, dr, w, s, q);
+			for (i = 0; i < dl + dr - 1; i++) {
+				bn_copy(c[i], p[i]);
+			}
+			pol_mul(p, (const bn_t *)l + dl, dr, t + n + lo, dl, w, s, q);
+			for (i = 0; i < dl + dr - 1; i++) {
+				pol_add(c[i], c[i], p[i], q);
+			}
+			for (i = 0; i < dl; i++) {
+				pol_add(c[dr + i], c[dr + i], l[i], q);
+			}
+			for (i = 0; i < dr; i++) {
+				pol_add(c[dl + i], c[dl + i], l[dl + i], q);
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(u);
+		bn_free(r);
+		pol_free(l, dl + dr);
+		pol_free(p, dl + dr);
+	}
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
 
 void bn_lag(bn_t *c, const bn_t *a, const bn_t b, int n) {
-    int i, j;
-	bn_t *t = RLC_ALLOCA(bn_t, n + 1);
+	bn_t w, *t = NULL;
+	int i, s = 0, d = pol_depth(n);
 
-    if (n == 0) {
-        bn_zero(c[0]);
-        return;
-    }
+	if (n == 0) {
+		bn_zero(c[0]);
+		return;
+	}
+
+	bn_null(w);
 
 	RLC_TRY {
-		if (t == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
-		for (i = 0; i <= n; i++) {
-			bn_null(t[i]);
-			bn_new(t[i]);
-		}
-
-        for (i = 0; i < n; i++) {
-            bn_zero(t[0]);
-            if (i == 0) {
-		        bn_set_dig(t[1], 1);
-                bn_neg(c[0], a[i]);
-                bn_mod(c[0], c[0], b);
-            } else {
-                for (j = 0; j <= i; j++) {
-                    bn_copy(t[j + 1], c[j]);
-                }
-                for (j = 0; j <= i; j++) {
-                    bn_mul(c[j], c[j], a[i]);
-                    bn_mod(c[j], c[j], b);
-                    bn_sub(c[j], t[j], c[j]);
-                    bn_mod(c[j], c[j], b);
-                }
-            }
-            bn_copy(c[i + 1], t[i + 1]);
-        }
+		bn_new(w);
+		/* Store the reduced roots after the levels of the tree. */
+		t = pol_new((d + 1) * n);
+
+		if (n > POL_NTT) {
+			s = pol_root(w, b);
+		}
+		for (i = 0; i < n; i++) {
+			bn_mod(t[d * n + i], a[i], b);
+		}
+		pol_tree(t, (const bn_t *)t + d * n, 0, n, n, w, s, b);
+		for (i = 0; i < n; i++) {
+			bn_copy(c[i], t[i]);
+		}
+		bn_set_dig(c[n], 1);
 	}
 	RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	}
 	RLC_FINALLY {
-		for (i = 0; i <= n; i++) {
-			bn_free(t[i]);
-		}
-		RLC_FREE(t);
+		bn_free(w);
+		pol_free(t, (d + 1) * n);
 	}
 }
 
@@ -94,3 +839,122 @@ void bn_evl(bn_t c, const bn_t *a, const bn_t x, const bn_t b, int n) {
         bn_mod(c, c, b);
     }
 }
+
+void bn_evl_sim(bn_t *c, const bn_t *a, const bn_t *x, const bn_t b, int n,
+		int m) {
+	bn_t w, *f = NULL, *t = NULL, *u = NULL;
+	int i, j, l, s = 0, d = 0;
+
+	if (m <= 0) {
+		return;
+	}
+	if (n <= POL_BASIC || m <= POL_BASIC) {
+		for (i = 0; i < m; i++) {
+			bn_evl(c[i], a, x[i], b, n);
+		}
+		return;
+	}
+
+	/* Process the points in blocks of n, so the cost is O(m log^2 n). */
+	l = RLC_MIN(n, m);
+	d = pol_depth(l);
+
+	bn_null(w);
+
+	RLC_TRY {
+		bn_new(w);
+		f = pol_new(n);
+		u = pol_new(l);
+		t = pol_new((d + 1) * l);
+
+		if (l > POL_NTT) {
+			s = pol_root(w, b);
+		}
+		for (i = 0; i < n; i++) {
+			bn_mod(f[i], a[i], b);
+		}
+		for (i = 0; i < m; i += l) {
+			j = RLC_MIN(l, m - i);
+			for (int k = 0; k < j; k++) {
+				bn_mod(t[d * l + k], x[i + k], b);
+			}
+			pol_tree(t, (const bn_t *)t + d * l, 0, j, l, w, s, b);
+			pol_sig(u, (const bn_t *)f, n, (const bn_t *)t, j, w, s, b);
+			pol_down(c + i, (const bn_t *)u, (const bn_t *)t,
+					(const bn_t *)t + d * l, 0, j, l, w, s, b);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(w);
+		pol_free(f, n);
+		pol_free(u, l);
+		pol_free(t, (d + 1) * l);
+	}
+}
+
+void bn_itp(bn_t *c, const bn_t *x, const bn_t *y, const bn_t b, int n) {
+	bn_t w, *t = NULL, *u = NULL, *v = NULL;
+	int i, s = 0, d = pol_depth(n);
+
+	if (n <= 0) {
+		return;
+	}
+
+	bn_null(w);
+
+	RLC_TRY {
+		bn_new(w);
+		t = pol_new((d + 1) * n);
+		u = pol_new(n);
+		v = pol_new(n);
+
+		if (n > POL_NTT) {
+			s = pol_root(w, b);
+		}
+		for (i = 0; i < n; i++) {
+			bn_mod(t[d * n + i], x[i], b);
+		}
+		pol_tree(t, (const bn_t *)t + d * n, 0, n, n, w, s, b);
+
+		/* Compute the weights v_i = y_i / M'(x_i) for M = prod (x - x_i). */
+		for (i = 0; i < n - 1; i++) {
+			bn_mul_dig(u[i], t[i + 1], i + 1);
+			bn_mod(u[i], u[i], b);
+		}
+		bn_set_dig(u[n - 1], n);
+		bn_mod(u[n - 1], u[n - 1], b);
+		pol_sig(u, (const bn_t *)u, n, (const bn_t *)t, n, w, s, b);
+		pol_down(v, (const bn_t *)u, (const bn_t *)t, (const bn_t *)t + d * n,
+				0, n, n, w, s, b);
+		for (i = 0; i < n; i++) {
+			if (bn_is_zero(v[i])) {
+				RLC_THROW(ERR_NO_VALID);
+				break;
+			}
+		}
+		if (i == n) {
+			bn_mod_inv_sim(v, (const bn_t *)v, b, n);
+			for (i = 0; i < n; i++) {
+				bn_mul(v[i], v[i], y[i]);
+				bn_mod(v[i], v[i], b);
+			}
+			pol_up(u, (const bn_t *)v, (const bn_t *)t,
+					(const bn_t *)t + d * n, 0, n, n, w, s, b);
+			for (i = 0; i < n; i++) {
+				bn_copy(c[i], u[i]);
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(w);
+		pol_free(t, (d + 1) * n);
+		pol_free(u, n);
+		pol_free(v, n);
+	}
+}
@@ -42,6 +42,12 @@
  */
 #define RAND_DIST		40
 
+/**
+ * Largest number of bytes requested from the generator at once, which is the
+ * limit imposed by the HASH-DRBG generator.
+ */
+#define RAND_BULK		(1 << 16)
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -220,7 +226,7 @@ void bn_rand(bn_t a, int sign, int bits) {
 	bn_trim(a);
 }
 
-void bn_rand_mod(bn_t a, bn_t b) {
+void bn_rand_mod(bn_t a, const bn_t b) {
 	bn_t t;
 
 	bn_null(t);
@@ -240,6 +246,70 @@ void bn_rand_mod(bn_t a, bn_t b) {
 	}
 }
 
+void bn_rand_sim(bn_t *a, int n, int bits) {
+	int i, j, digits, size;
+	dig_t mask = 0, *t;
+
+	if (n <= 0) {
+		return;
+	}
+
+	RLC_RIP(bits, digits, bits);
+	digits += (bits > 0 ? 1 : 0);
+	if (bits > 0) {
+		mask = ((dig_t)1 << (dig_t)bits) - 1;
+	}
+
+	t = RLC_ALLOCA(dig_t, n * digits);
+	if (t == NULL) {
+		RLC_THROW(ERR_NO_MEMORY);
+		return;
+	}
+
+	/* Draw all the digits at once, in chunks the generator accepts. */
+	size = n * digits * sizeof(dig_t);
+	for (j = 0; j < size; j += RAND_BULK) {
+		rand_bytes((uint8_t *)t + j, RLC_MIN(RAND_BULK, size - j));
+	}
+
+	for (i = 0; i < n; i++) {
+		bn_grow(a[i], digits);
+		dv_copy(a[i]->dp, t + i * digits, digits);
+		a[i]->used = digits;
+		a[i]->sign = RLC_POS;
+		if (bits > 0) {
+			a[i]->dp[digits - 1] &= mask;
+		}
+		bn_trim(a[i]);
+	}
+
+	memset(t, 0, n * digits * sizeof(dig_t));
+	RLC_FREE(t);
+}
+
+void bn_rand_mod_sim(bn_t *a, int n, const bn_t b) {
+	int i;
+
+	if (n <= 0) {
+		return;
+	}
+
+	RLC_TRY {
+		/* Reduce wide samples, so that no rejection is needed. */
+		bn_rand_sim(a, n, bn_bits(b) + RAND_DIST);
+		for (i = 0; i < n; i++) {
+			a[i]->sign = bn_sign(b);
+			bn_mod(a[i], a[i], b);
+			/* Zero is only drawn with negligible probability. */
+			if (bn_is_zero(a[i]) || bn_cmp_abs(a[i], b) != RLC_LT) {
+				bn_rand_mod(a[i], b);
+			}
+		}
+	} RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+}
+
 void bn_print(const bn_t a) {
 	int i;
 
@@ -31,10 +31,170 @@
  * @ingroup cp
  */
 
-#include <limits.h>
-
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Upper bound on plaintexts decrypted without a table.
+ */
+#define BGN_BOUND			((dig_t)UINT32_MAX)
+
+/**
+ * Computes the base element S = (xy - z)G used for decryption in G_1.
+ *
+ * @param[out] s			- the base element.
+ * @param[in] prv			- the private key.
+ */
+static void bgn_base1(g1_t s, bgn_t prv) {
+	bn_t n, r;
+
+	bn_null(n);
+	bn_null(r);
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(r);
+
+		pc_get_ord(n);
+		bn_mul(r, prv->x, prv->y);
+		bn_sub(r, r, prv->z);
+		bn_mod(r, r, n);
+		g1_mul_gen(s, r);
+		g1_norm(s, s);
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(n);
+		bn_free(r);
+	}
+}
+
+/**
+ * Computes the base element S = (xy - z)H used for decryption in G_2.
+ *
+ * @param[out] s			- the base element.
+ * @param[in] prv			- the private key.
+ */
+static void bgn_base2(g2_t s, bgn_t prv) {
+	bn_t n, r;
+
+	bn_null(n);
+	bn_null(r);
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(r);
+
+		pc_get_ord(n);
+		bn_mul(r, prv->x, prv->y);
+		bn_sub(r, r, prv->z);
+		bn_mod(r, r, n);
+		g2_mul_gen(s, r);
+		g2_norm(s, s);
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(n);
+		bn_free(r);
+	}
+}
+
+/**
+ * Computes the base element S = e(G, H)^{(xy - z)^2} used for decryption in
+ * G_T.
+ *
+ * @param[out] s			- the base element.
+ * @param[in] prv			- the private key.
+ */
+static void bgn_baset(gt_t s, bgn_t prv) {
+	bn_t n, r;
+	g1_t g;
+	g2_t h;
+
+	bn_null(n);
+	bn_null(r);
+	g1_null(g);
+	g2_null(h);
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(r);
+		g1_new(g);
+		g2_new(h);
+
+		pc_get_ord(n);
+		bn_mul(r, prv->x, prv->y);
+		bn_sub(r, r, prv->z);
+		bn_sqr(r, r);
+		bn_mod(r, r, n);
+		g1_get_gen(g);
+		g2_get_gen(h);
+		pc_map(s, g, h);
+		gt_exp(s, s, r);
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(n);
+		bn_free(r);
+		g1_free(g);
+		g2_free(h);
+	}
+}
+
+/**
+ * Recovers the element T = e(G, H)^{m(xy - z)^2} from a BGN ciphertext in G_T.
+ *
+ * @param[out] t			- the element T.
+ * @param[in] in			- the ciphertext.
+ * @param[in] prv			- the private key.
+ */
+static void bgn_elemt(gt_t t, gt_t in[4], bgn_t prv) {
+	bn_t n, x, y;
+	gt_t u, v;
+
+	bn_null(n);
+	bn_null(x);
+	bn_null(y);
+	gt_null(u);
+	gt_null(v);
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(x);
+		bn_new(y);
+		gt_new(u);
+		gt_new(v);
+
+		/* Compute T = in[0]^(x^2) * (in[1] * in[2])^(-x) * in[3]. */
+		gt_get_ord(n);
+		bn_sqr(x, prv->x);
+		bn_mod(x, x, n);
+		bn_sub(y, n, prv->x);
+		gt_mul(v, in[1], in[2]);
+		gt_exp_sim(u, in[0], x, v, y);
+		gt_mul(t, in[3], u);
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(n);
+		bn_free(x);
+		bn_free(y);
+		gt_free(u);
+		gt_free(v);
+	}
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -115,58 +275,83 @@ int cp_bgn_enc1(g1_t out[2], dig_t in, bgn_t pub) {
 }
 
 int cp_bgn_dec1(dig_t *out, g1_t in[2], bgn_t prv) {
-	bn_t r, n;
-	g1_t s, t, u;
-	int i, result = RLC_ERR;
+	g1_t s, t;
+	int result = RLC_ERR;
 
-	bn_null(n);
-	bn_null(r);
 	g1_null(s);
 	g1_null(t);
-	g1_null(u);
 
 	RLC_TRY {
-		bn_new(n);
-		bn_new(r);
 		g1_new(s);
 		g1_new(t);
-		g1_new(u);
 
-		pc_get_ord(n);
 		/* Compute T = x(ym + r)G - (zm + xr)G = m(xy - z)G. */
 		g1_mul(t, in[0], prv->x);
 		g1_sub(t, t, in[1]);
 		g1_norm(t, t);
-		/* Compute U = (xy - z)G and find m. */
-		bn_mul(r, prv->x, prv->y);
-		bn_sub(r, r, prv->z);
-		bn_mod(r, r, n);
-		g1_mul_gen(s, r);
-		g1_copy(u, s);
-
-		if (g1_is_infty(t) == 1){
-			*out = 0;
-			result = RLC_OK;
-		} else {
-			for (i = 0; i < INT_MAX; i++) {
-				if (g1_cmp(t, u) == RLC_EQ) {
-					*out = i + 1;
-					result = RLC_OK;
-					break;
-				}
-				g1_add(u, u, s);
-				g1_norm(u, u);
-			}
-		}
+		/* Compute S = (xy - z)G and find m. */
+		bgn_base1(s, prv);
+		result = g1_dlog_bounded(out, t, s, BGN_BOUND, NULL);
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		g1_free(s);
+		g1_free(t);
+	}
+
+	return result;
+}
+
+int cp_bgn_tab1(dlog_tab_t tab, int m, bgn_t prv) {
+	g1_t s;
+	int result = RLC_OK;
+
+	g1_null(s);
+
+	if (m < 2) {
+		RLC_THROW(ERR_NO_VALID);
+		return RLC_ERR;
+	}
+
+	RLC_TRY {
+		g1_new(s);
+
+		bgn_base1(s, prv);
+		g1_dlog_tab(tab, s, m);
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		g1_free(s);
+	}
+
+	return result;
+}
+
+int cp_bgn_dec1_tab(dig_t *out, g1_t in[2], dig_t bound, dlog_tab_t tab,
+		bgn_t prv) {
+	g1_t s, t;
+	int result = RLC_ERR;
+
+	g1_null(s);
+	g1_null(t);
+
+	RLC_TRY {
+		g1_new(s);
+		g1_new(t);
+
+		g1_mul(t, in[0], prv->x);
+		g1_sub(t, t, in[1]);
+		g1_norm(t, t);
+		bgn_base1(s, prv);
+		result = g1_dlog_bounded(out, t, s, bound, tab);
 	} RLC_CATCH_ANY {
 		result = RLC_ERR;
 	}
 	RLC_FINALLY {
-		bn_free(n);
-		bn_free(r);
 		g1_free(s);
 		g1_free(t);
-		g1_free(u);
 	}
 
 	return result;
@@ -214,58 +399,83 @@ int cp_bgn_enc2(g2_t out[2], dig_t in, bgn_t pub) {
 }
 
 int cp_bgn_dec2(dig_t *out, g2_t in[2], bgn_t prv) {
-	bn_t r, n;
-	g2_t s, t, u;
-	int i, result = RLC_ERR;
+	g2_t s, t;
+	int result = RLC_ERR;
 
-	bn_null(n);
-	bn_null(r);
 	g2_null(s);
 	g2_null(t);
-	g2_null(u);
 
 	RLC_TRY {
-		bn_new(n);
-		bn_new(r);
 		g2_new(s);
 		g2_new(t);
-		g2_new(u);
 
-		pc_get_ord(n);
-		/* Compute T = x(ym + r)G - (zm + xr)G = m(xy - z)G. */
+		/* Compute T = x(ym + r)H - (zm + xr)H = m(xy - z)H. */
 		g2_mul(t, in[0], prv->x);
 		g2_sub(t, t, in[1]);
 		g2_norm(t, t);
-		/* Compute U = (xy - z)G and find m. */
-		bn_mul(r, prv->x, prv->y);
-		bn_sub(r, r, prv->z);
-		bn_mod(r, r, n);
-		g2_mul_gen(s, r);
-		g2_copy(u, s);
-
-		if (g2_is_infty(t) == 1) {
-			*out = 0;
-			result = RLC_OK;
-		} else {
-			for (i = 0; i < INT_MAX; i++) {
-				if (g2_cmp(t, u) == RLC_EQ) {
-					*out = i + 1;
-					result = RLC_OK;
-					break;
-				}
-				g2_add(u, u, s);
-				g2_norm(u, u);
-			}
-		}
+		/* Compute S = (xy - z)H and find m. */
+		bgn_base2(s, prv);
+		result = g2_dlog_bounded(out, t, s, BGN_BOUND, NULL);
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		g2_free(s);
+		g2_free(t);
+	}
+
+	return result;
+}
+
+int cp_bgn_tab2(dlog_tab_t tab, int m, bgn_t prv) {
+	g2_t s;
+	int result = RLC_OK;
+
+	g2_null(s);
+
+	if (m < 2) {
+		RLC_THROW(ERR_NO_VALID);
+		return RLC_ERR;
+	}
+
+	RLC_TRY {
+		g2_new(s);
+
+		bgn_base2(s, prv);
+		g2_dlog_tab(tab, s, m);
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		g2_free(s);
+	}
+
+	return result;
+}
+
+int cp_bgn_dec2_tab(dig_t *out, g2_t in[2], dig_t bound, dlog_tab_t tab,
+		bgn_t prv) {
+	g2_t s, t;
+	int result = RLC_ERR;
+
+	g2_null(s);
+	g2_null(t);
+
+	RLC_TRY {
+		g2_new(s);
+		g2_new(t);
+
+		g2_mul(t, in[0], prv->x);
+		g2_sub(t, t, in[1]);
+		g2_norm(t, t);
+		bgn_base2(s, prv);
+		result = g2_dlog_bounded(out, t, s, bound, tab);
 	} RLC_CATCH_ANY {
 		result = RLC_ERR;
 	}
 	RLC_FINALLY {
-		bn_free(n);
-		bn_free(r);
 		g2_free(s);
 		g2_free(t);
-		g2_free(u);
 	}
 
 	return result;
@@ -288,83 +498,76 @@ int cp_bgn_mul(gt_t e[4], g1_t c[2], g2_t d[2]) {
 }
 
 int cp_bgn_dec(dig_t *out, gt_t in[4], bgn_t prv) {
-	int i, result = RLC_ERR;
-	g1_t g;
-	g2_t h;
-	gt_t t[4];
-	bn_t n, r, s;
+	gt_t s, t;
+	int result = RLC_ERR;
 
-	bn_null(n);
-	bn_null(r);
-	bn_null(s);
-	g1_null(g);
-	g2_null(h);
+	gt_null(s);
+	gt_null(t);
 
 	RLC_TRY {
-		bn_new(n);
-		bn_new(r);
-		bn_new(s);
-		g1_new(g);
-		g2_new(h);
-		for (i = 0; i < 4; i++) {
-			gt_null(t[i]);
-			gt_new(t[i]);
-		}
+		gt_new(s);
+		gt_new(t);
+
+		bgn_elemt(t, in, prv);
+		bgn_baset(s, prv);
+		result = gt_dlog_bounded(out, t, s, BGN_BOUND, NULL);
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	} RLC_FINALLY {
+		gt_free(s);
+		gt_free(t);
+	}
 
-		gt_exp(t[0], in[0], prv->x);
-		gt_exp(t[0], t[0], prv->x);
+	return result;
+}
 
-		gt_mul(t[1], in[1], in[2]);
-		gt_exp(t[1], t[1], prv->x);
-		gt_inv(t[1], t[1]);
+int cp_bgn_tab(dlog_tab_t tab, int m, bgn_t prv) {
+	gt_t s;
+	int result = RLC_OK;
 
-		gt_mul(t[3], in[3], t[1]);
-		gt_mul(t[3], t[3], t[0]);
+	gt_null(s);
 
-		pc_get_ord(n);
-		g1_get_gen(g);
-		g2_get_gen(h);
+	if (m < 2) {
+		RLC_THROW(ERR_NO_VALID);
+		return RLC_ERR;
+	}
 
-		bn_mul(r, prv->x, prv->y);
-		bn_sqr(r, r);
+	RLC_TRY {
+		gt_new(s);
 
-		bn_mul(s, prv->x, prv->y);
-		bn_mul(s, s, prv->z);
-		bn_sub(r, r, s);
-		bn_sub(r, r, s);
+		bgn_baset(s, prv);
+		gt_dlog_tab(tab, s, m);
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		gt_free(s);
+	}
 
-		bn_sqr(s, prv->z);
-		bn_add(r, r, s);
-		bn_mod(r, r, n);
-		pc_map(t[1], g, h);
-		gt_exp(t[1], t[1], r);
-
-		gt_copy(t[2], t[1]);
-
-		if (gt_is_unity(t[3]) == 1) {
-			*out = 0;
-			result = RLC_OK;
-		} else {
-			for (i = 0; i < INT_MAX; i++) {
-				if (gt_cmp(t[2], t[3]) == RLC_EQ) {
-					*out = i + 1;
-					result = RLC_OK;
-					break;
-				}
-				gt_mul(t[2], t[2], t[1]);
-			}
-		}
+	return result;
+}
+
+int cp_bgn_dec_tab(dig_t *out, gt_t in[4], dig_t bound, dlog_tab_t tab,
+		bgn_t prv) {
+	gt_t s, t;
+	int result = RLC_ERR;
+
+	gt_null(s);
+	gt_null(t);
+
+	RLC_TRY {
+		gt_new(s);
+		gt_new(t);
+
+		bgn_elemt(t, in, prv);
+		bgn_baset(s, prv);
+		result = gt_dlog_bounded(out, t, s, bound, tab);
 	} RLC_CATCH_ANY {
 		result = RLC_ERR;
-	} RLC_FINALLY {
-		bn_free(n);
-		bn_free(r);
-		bn_free(s);
-		g1_free(g);
-		g2_free(h);
-		for (i = 0; i < 4; i++) {
-			gt_free(t[i]);
-		}
+	}
+	RLC_FINALLY {
+		gt_free(s);
+		gt_free(t);
 	}
 
 	return result;
@@ -31,6 +31,58 @@
 
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Evaluates the linear function over the tags of all signers with a single
+ * multi-exponentiation. Computes c = \prod_i \prod_j hs_i[label_j]^f_i[j].
+ *
+ * @param[out] c			- the result.
+ * @param[in] label			- the integer labels.
+ * @param[in] hs			- the hashes of the labels for each signer.
+ * @param[in] f				- the linear coefficients for each signer.
+ * @param[in] flen			- the number of coefficients for each signer.
+ * @param[in] slen			- the number of signers.
+ */
+static void cmlhs_exp(gt_t c, int label[], gt_t *hs[], dig_t *f[],
+		int flen[], int slen) {
+	int i, j, n = 0;
+	gt_t *t;
+	dig_t *k;
+
+	for (i = 0; i < slen; i++) {
+		n += flen[i];
+	}
+	t = RLC_ALLOCA(gt_t, n);
+	k = RLC_ALLOCA(dig_t, n);
+
+	RLC_TRY {
+		if (n > 0 && (t == NULL || k == NULL)) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		n = 0;
+		for (i = 0; i < slen; i++) {
+			for (j = 0; j < flen[i]; j++, n++) {
+				gt_null(t[n]);
+				gt_new(t[n]);
+				gt_copy(t[n], hs[i][label[j]]);
+				k[n] = f[i][j];
+			}
+		}
+		gt_exp_sim_dig(c, t, k, n);
+	} RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	} RLC_FINALLY {
+		for (i = 0; t != NULL && i < n; i++) {
+			gt_free(t[i]);
+		}
+		RLC_FREE(t);
+		RLC_FREE(k);
+	}
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -235,12 +287,8 @@ int cp_cmlhs_ver(g1_t r, g2_t s, g1_t sig[], g2_t z[], g1_t a[], g1_t c[],
 		pc_map(v, r, g2);
 		gt_mul(u, u, v);
 
-		for (int i = 0; i < slen; i++) {
-			for (int j = 0; j < flen[i]; j++) {
-				gt_exp_dig(v, hs[i][label[j]], f[i][j]);
-				gt_mul(u, u, v);
-			}
-		}
+		cmlhs_exp(v, label, hs, f, flen, slen);
+		gt_mul(u, u, v);
 		if (gt_cmp(e, u) != RLC_EQ) {
 			result = 0;
 		}
@@ -278,25 +326,78 @@ int cp_cmlhs_ver(g1_t r, g2_t s, g1_t sig[], g2_t z[], g1_t a[], g1_t c[],
 
 void cp_cmlhs_off(gt_t vk, g1_t h, int label[], gt_t *hs[], dig_t *f[],
 		int flen[], g2_t y[], g2_t pk[], int slen) {
-	gt_t v;
+	cmlhs_exp(vk, label, hs, f, flen, slen);
+}
 
-	gt_null(v);
+int cp_cmlhs_off_key(uint8_t *key, int label[], dig_t *f[], int flen[],
+		g2_t pk[], int slen) {
+	int i, j, len = 0, result = RLC_OK;
+	uint8_t *buf;
+	md_t ctx;
+
+	for (i = 0; i < slen; i++) {
+		len = RLC_MAX(len, g2_size_bin(pk[i], 1));
+	}
+	buf = RLC_ALLOCA(uint8_t, RLC_MAX(len, 1));
 
 	RLC_TRY {
-		gt_new(v);
+		if (buf == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
 
-		gt_set_unity(vk);
-		for (int i = 0; i < slen; i++) {
-			for (int j = 0; j < flen[i]; j++) {
-				gt_exp_dig(v, hs[i][label[j]], f[i][j]);
-				gt_mul(vk, vk, v);
+		/* Lengths are absorbed before contents, so the encoding is unique. */
+		md_init(ctx);
+		md_update_int(ctx, slen);
+		for (i = 0; i < slen; i++) {
+			len = g2_size_bin(pk[i], 1);
+			g2_write_bin(buf, len, pk[i], 1);
+			md_update_int(ctx, len);
+			md_update(ctx, buf, len);
+			md_update_int(ctx, flen[i]);
+			for (j = 0; j < flen[i]; j++) {
+				md_update_int(ctx, label[j]);
+				md_update_int(ctx, f[i][j]);
 			}
 		}
-	} RLC_CATCH_ANY {
-		RLC_THROW(ERR_CAUGHT);
-	} RLC_FINALLY {
-		gt_free(v);
+		md_final(key, ctx);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		RLC_FREE(buf);
 	}
+	return result;
+}
+
+int cp_cmlhs_off_size(gt_t vk) {
+	return RLC_MD_LEN + gt_size_bin(vk, 0);
+}
+
+int cp_cmlhs_off_write(uint8_t *bin, int len, gt_t vk,
+		const uint8_t *key) {
+	if (len != cp_cmlhs_off_size(vk)) {
+		RLC_THROW(ERR_NO_BUFFER);
+		return RLC_ERR;
+	}
+
+	memcpy(bin, key, RLC_MD_LEN);
+	gt_write_bin(bin + RLC_MD_LEN, len - RLC_MD_LEN, vk, 0);
+	return RLC_OK;
+}
+
+int cp_cmlhs_off_read(gt_t vk, const uint8_t *bin, int len,
+		const uint8_t *key) {
+	/* A cache computed for another function or label set is stale. */
+	if (len <= RLC_MD_LEN || util_cmp_const(bin, key, RLC_MD_LEN) != RLC_EQ) {
+		return RLC_ERR;
+	}
+
+	gt_read_bin(vk, bin + RLC_MD_LEN, len - RLC_MD_LEN);
+	if (!gt_is_valid(vk)) {
+		return RLC_ERR;
+	}
+	return RLC_OK;
 }
 
 int cp_cmlhs_onv(g1_t r, g2_t s, g1_t sig[], g2_t z[], g1_t a[], g1_t c[],
@@ -31,6 +31,37 @@
 
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Converts a message to an integer modulo the group order as in ECDSA.
+ *
+ * @param[out] e			- the resulting integer.
+ * @param[in] msg			- the message.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] hash			- the flag to indicate the message format.
+ * @param[in] n				- the group order.
+ */
+static void ecdsa_hash(bn_t e, uint8_t *msg, int len, int hash, bn_t n) {
+	uint8_t h[RLC_MD_LEN];
+
+	if (!hash) {
+		md_map(h, msg, len);
+		msg = h;
+		len = RLC_MD_LEN;
+	}
+
+	if (8 * len > bn_bits(n)) {
+		len = RLC_CEIL(bn_bits(n), 8);
+		bn_read_bin(e, msg, len);
+		bn_rsh(e, e, 8 * len - bn_bits(n));
+	} else {
+		bn_read_bin(e, msg, len);
+	}
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -59,9 +90,17 @@ int cp_ecdsa_gen(bn_t d, ec_t q) {
 }
 
 int cp_ecdsa_sig(bn_t r, bn_t s, uint8_t *msg, int len, int hash, bn_t d) {
+	int v;
+
+	return cp_ecdsa_sig_ext(r, s, &v, msg, len, hash, d);
+}
+
+int cp_ecdsa_sig_ext(bn_t r, bn_t s, int *v, uint8_t *msg, int len, int hash,
+		bn_t d) {
 	bn_t n, k, x, e;
 	ec_t p;
-	uint8_t h[RLC_MD_LEN];
+	uint8_t b[RLC_FC_BYTES + 1];
+	dig_t dig;
 	int result = RLC_OK;
 
 	bn_null(n);
@@ -86,19 +125,19 @@ int cp_ecdsa_sig(bn_t r, bn_t s, uint8_t *msg, int len, int hash, bn_t d) {
 				bn_mod(r, x, n);
 			} while (bn_is_zero(r));
 
-			if (!hash) {
-				md_map(h, msg, len);
-				msg = h;
-				len = RLC_MD_LEN;
-			}
-			if (8 * len > bn_bits(n)) {
-				len = RLC_CEIL(bn_bits(n), 8);
-				bn_read_bin(e, msg, len);
-				bn_rsh(e, e, 8 * len - bn_bits(n));
+			/* Keep the compressed y-coordinate and the quotient x / n. */
+			ec_write_bin(b, sizeof(b), p, 1);
+			bn_div(e, x, n);
+			bn_get_dig(&dig, e);
+			if (bn_bits(e) < (int)(8 * sizeof(int)) - 2) {
+				*v = (b[0] & 1) | (int)(dig << 1);
 			} else {
-				bn_read_bin(e, msg, len);
+				/* The quotient is too large on curves with big cofactors. */
+				*v = -1;
 			}
 
+			ecdsa_hash(e, msg, len, hash, n);
+
 			bn_mul(s, d, r);
 			bn_mod(s, s, n);
 			bn_add(s, s, e);
@@ -121,10 +160,119 @@ int cp_ecdsa_sig(bn_t r, bn_t s, uint8_t *msg, int len, int hash, bn_t d) {
 	return result;
 }
 
+int cp_ecdsa_pre(ecdsa_pre_t *pool, int n) {
+	bn_t m, x, *k = RLC_ALLOCA(bn_t, n);
+	ec_t *p = RLC_ALLOCA(ec_t, n);
+	int i, result = RLC_OK;
+
+	bn_null(m);
+	bn_null(x);
+
+	if (n == 0) {
+		RLC_FREE(k);
+		RLC_FREE(p);
+		return RLC_OK;
+	}
+
+	RLC_TRY {
+		bn_new(m);
+		bn_new(x);
+		if (k == NULL || p == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < n; i++) {
+			bn_null(k[i]);
+			ec_null(p[i]);
+			bn_new(k[i]);
+			ec_new(p[i]);
+		}
+
+		ec_curve_get_ord(m);
+		bn_rand_mod_sim(k, n, m);
+		for (i = 0; i < n; i++) {
+			ec_mul_gen(p[i], k[i]);
+		}
+		/* Normalize all nonce points and invert all nonces at once. */
+		ec_norm_sim(p, (const ec_t *)p, n);
+		for (i = 0; i < n; i++) {
+			ec_get_x(x, p[i]);
+			bn_mod(pool[i]->r, x, m);
+			/* Replace the nonce in the negligible case that r = 0. */
+			while (bn_is_zero(pool[i]->r)) {
+				bn_rand_mod(k[i], m);
+				ec_mul_gen(p[i], k[i]);
+				ec_get_x(x, p[i]);
+				bn_mod(pool[i]->r, x, m);
+			}
+		}
+		bn_mod_inv_sim(k, (const bn_t *)k, m, n);
+		for (i = 0; i < n; i++) {
+			bn_copy(pool[i]->k, k[i]);
+		}
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		bn_free(m);
+		bn_free(x);
+		for (i = 0; i < n; i++) {
+			bn_zero(k[i]);
+			bn_free(k[i]);
+			ec_free(p[i]);
+		}
+		RLC_FREE(k);
+		RLC_FREE(p);
+	}
+	return result;
+}
+
+int cp_ecdsa_sig_fast(bn_t r, bn_t s, uint8_t *msg, int len, int hash,
+		bn_t d, ecdsa_pre_t pre) {
+	bn_t n, e;
+	int result = RLC_OK;
+
+	bn_null(n);
+	bn_null(e);
+
+	if (bn_is_zero(pre->k)) {
+		/* The nonce was already used or never computed. */
+		return RLC_ERR;
+	}
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(e);
+
+		ec_curve_get_ord(n);
+		ecdsa_hash(e, msg, len, hash, n);
+
+		/* Compute s = k^{-1}(e + d * r) mod n. */
+		bn_copy(r, pre->r);
+		bn_mul(s, d, r);
+		bn_add(s, s, e);
+		bn_mod(s, s, n);
+		bn_mul(s, s, pre->k);
+		bn_mod(s, s, n);
+		if (bn_is_zero(s)) {
+			result = RLC_ERR;
+		}
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		bn_zero(pre->k);
+		bn_zero(pre->r);
+		bn_free(n);
+		bn_free(e);
+	}
+	return result;
+}
+
 int cp_ecdsa_ver(bn_t r, bn_t s, uint8_t *msg, int len, int hash, ec_t q) {
 	bn_t n, k, e, v;
 	ec_t p;
-	uint8_t h[RLC_MD_LEN];
 	int cmp, result = 0;
 
 	bn_null(n);
@@ -146,20 +294,7 @@ int cp_ecdsa_ver(bn_t r, bn_t s, uint8_t *msg, int len, int hash, ec_t q) {
 				!bn_is_zero(r) && !bn_is_zero(s) && ec_on_curve(q)) {
 			if (bn_cmp(r, n) == RLC_LT && bn_cmp(s, n) == RLC_LT) {
 				bn_mod_inv(k, s, n);
-
-				if (!hash) {
-					md_map(h, msg, len);
-					msg = h;
-					len = RLC_MD_LEN;
-				}
-
-				if (8 * len > bn_bits(n)) {
-					len = RLC_CEIL(bn_bits(n), 8);
-					bn_read_bin(e, msg, len);
-					bn_rsh(e, e, 8 * len - bn_bits(n));
-				} else {
-					bn_read_bin(e, msg, len);
-				}
+				ecdsa_hash(e, msg, len, hash, n);
 
 				bn_mul(e, e, k);
 				bn_mod(e, e, n);
@@ -196,3 +331,142 @@ int cp_ecdsa_ver(bn_t r, bn_t s, uint8_t *msg, int len, int hash, ec_t q) {
 	}
 	return result;
 }
+
+int cp_ecdsa_ver_batch(bn_t r[], bn_t s[], int v[], uint8_t *msg[], int len[],
+		int hash, ec_t q[], int n) {
+	int i, result = 1;
+#if EC_CUR == PRIME
+	bn_t m, t, u, *w = RLC_ALLOCA(bn_t, n), *k = RLC_ALLOCA(bn_t, 2 * n + 1);
+	ec_t *p = RLC_ALLOCA(ec_t, 2 * n + 1);
+
+	bn_null(m);
+	bn_null(t);
+	bn_null(u);
+
+	if (n == 0) {
+		RLC_FREE(w);
+		RLC_FREE(k);
+		RLC_FREE(p);
+		return 1;
+	}
+
+	RLC_TRY {
+		bn_new(m);
+		bn_new(t);
+		bn_new(u);
+		if (w == NULL || k == NULL || p == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < n; i++) {
+			bn_null(w[i]);
+			bn_new(w[i]);
+		}
+		for (i = 0; i < 2 * n + 1; i++) {
+			bn_null(k[i]);
+			ec_null(p[i]);
+			bn_new(k[i]);
+			ec_new(p[i]);
+		}
+
+		ec_curve_get_ord(m);
+		bn_read_raw(u, fp_prime_get(), RLC_FP_DIGS);
+
+		for (i = 0; i < n; i++) {
+			if (bn_sign(r[i]) != RLC_POS || bn_sign(s[i]) != RLC_POS ||
+					bn_is_zero(r[i]) || bn_is_zero(s[i]) ||
+					bn_cmp(r[i], m) != RLC_LT || bn_cmp(s[i], m) != RLC_LT ||
+					!ec_on_curve(q[i])) {
+				result = 0;
+			}
+		}
+
+		ec_curve_get_cof(t);
+		if (result && bn_cmp_dig(t, 1) != RLC_EQ) {
+			/* Recovered points and public keys may have components of small
+			 * order that the random weights do not cancel, and subgroup
+			 * checks would cost more than verifying one by one. */
+			for (i = 0; i < n; i++) {
+				result &= cp_ecdsa_ver(r[i], s[i], msg[i], len[i], hash, q[i]);
+			}
+		} else if (result) {
+			/* With a trivial cofactor, every recovered point is in the group
+			 * generated by G. Invert all s_i at once. */
+			bn_mod_inv_sim(w, (const bn_t *)s, m, n);
+
+			/* Check sum z_i([e_i/s_i]G + [r_i/s_i]Q_i - R_i) = 0. */
+			bn_zero(k[0]);
+			bn_rand_sim(k + 1, n, 128);
+			for (i = 0; i < n && result; i++) {
+				if (v[i] < 0) {
+					/* Without a hint, verify this signature on its own. */
+					result = cp_ecdsa_ver(r[i], s[i], msg[i], len[i], hash,
+							q[i]);
+					bn_zero(k[i + 1]);
+					bn_zero(k[i + n + 1]);
+					ec_set_infty(p[i + 1]);
+					ec_set_infty(p[i + n + 1]);
+					continue;
+				}
+				/* Recover R_i from r_i and the hint v_i. */
+				bn_mul_dig(t, m, v[i] >> 1);
+				bn_add(t, t, r[i]);
+				if (bn_cmp(t, u) != RLC_LT) {
+					result = 0;
+					continue;
+				}
+				fp_prime_conv(p[i + 1]->x, t);
+				fp_zero(p[i + 1]->y);
+				fp_set_bit(p[i + 1]->y, 0, v[i] & 1);
+				fp_set_dig(p[i + 1]->z, 1);
+				p[i + 1]->coord = BASIC;
+				result = ec_upk(p[i + 1], p[i + 1]);
+
+				ecdsa_hash(t, msg[i], len[i], hash, m);
+				bn_mul(t, t, w[i]);
+				bn_mod(t, t, m);
+				bn_mul(t, t, k[i + 1]);
+				bn_add(k[0], k[0], t);
+				bn_mul(k[i + n + 1], r[i], w[i]);
+				bn_mod(k[i + n + 1], k[i + n + 1], m);
+				bn_mul(k[i + n + 1], k[i + n + 1], k[i + 1]);
+				bn_mod(k[i + n + 1], k[i + n + 1], m);
+				bn_neg(k[i + 1], k[i + 1]);
+				ec_copy(p[i + n + 1], q[i]);
+			}
+
+			if (result) {
+				bn_mod(k[0], k[0], m);
+				ec_curve_get_gen(p[0]);
+				ec_mul_sim_lot(p[0], (const ec_t *)p, (const bn_t *)k,
+						2 * n + 1);
+				result = ec_is_infty(p[0]);
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(m);
+		bn_free(t);
+		bn_free(u);
+		for (i = 0; i < n; i++) {
+			bn_free(w[i]);
+		}
+		for (i = 0; i < 2 * n + 1; i++) {
+			bn_free(k[i]);
+			ec_free(p[i]);
+		}
+		RLC_FREE(w);
+		RLC_FREE(k);
+		RLC_FREE(p);
+	}
+#else
+	/* Points cannot be recovered from x alone, verify one by one. */
+	(void)v;
+	for (i = 0; i < n; i++) {
+		result &= cp_ecdsa_ver(r[i], s[i], msg[i], len[i], hash, q[i]);
+	}
+#endif
+	return result;
+}
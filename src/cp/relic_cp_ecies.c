@@ -31,6 +31,45 @@
 
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Derives the symmetric key from the shared point.
+ *
+ * @param[out] key			- the key.
+ * @param[in] size			- the key size in bytes.
+ * @param[in] p				- the shared point.
+ */
+static void ecies_kdf(uint8_t *key, int size, ec_t p) {
+	uint8_t _x[RLC_FC_BYTES + 1];
+	bn_t x;
+	int l;
+
+	bn_null(x);
+
+	RLC_TRY {
+		bn_new(x);
+
+		ec_get_x(x, p);
+		l = bn_size_bin(x);
+		if (bn_bits(x) % 8 == 0) {
+			/* Compatibility with BouncyCastle. */
+			l = l + 1;
+		}
+		bn_write_bin(_x, l, x);
+		md_kdf(key, size, _x, l);
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(x);
+		memset(_x, 0, sizeof(_x));
+	}
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -60,21 +99,19 @@ int cp_ecies_gen(bn_t d, ec_t q) {
 
 int cp_ecies_enc(ec_t r, uint8_t *out, int *out_len, uint8_t *in, int in_len,
 		ec_t q) {
-	bn_t k, n, x;
+	bn_t k, n;
 	ec_t p;
-	int l, result = RLC_OK, size = RLC_CEIL(RLC_MAX(128, ec_param_level()), 8);
-	uint8_t _x[RLC_FC_BYTES + 1], iv[RLC_BC_LEN] = { 0 };
-	uint8_t key[2 * 8 * (RLC_FC_BYTES + 1)];
+	aes_t a;
+	int result = RLC_OK, size = RLC_CEIL(RLC_MAX(128, ec_param_level()), 8);
+	uint8_t iv[RLC_BC_IV] = { 0 }, key[8 * (RLC_FC_BYTES + 1)];
 
 	bn_null(k);
 	bn_null(n);
-	bn_null(x);
 	ec_null(p);
 
 	RLC_TRY {
 		bn_new(k);
 		bn_new(n);
-		bn_new(x);
 		ec_new(p);
 
 		ec_curve_get_ord(n);
@@ -82,21 +119,11 @@ int cp_ecies_enc(ec_t r, uint8_t *out, int *out_len, uint8_t *in, int in_len,
 
 		ec_mul_gen(r, k);
 		ec_mul(p, q, k);
-		ec_get_x(x, p);
-		l = bn_size_bin(x);
-		if (bn_bits(x) % 8 == 0) {
-			/* Compatibility with BouncyCastle. */
-			l = l + 1;
-		}
-		bn_write_bin(_x, l, x);
-		md_kdf(key, 2 * size, _x, l);
-		l = *out_len;
-		if (bc_aes_cbc_enc(out, out_len, in, in_len, key, size, iv)
-				!= RLC_OK || (*out_len + RLC_MD_LEN) > l) {
+		ecies_kdf(key, size, p);
+		/* The key is used only once, so the nonce can be fixed. */
+		if (bc_aes_key(a, key, size) != RLC_OK || bc_aes_gcm_enc(out,
+				out_len, in, in_len, NULL, 0, a, iv) != RLC_OK) {
 			result = RLC_ERR;
-		} else {
-			md_hmac(out + *out_len, out, *out_len, key + size, size);
-			*out_len += RLC_MD_LEN;
 		}
 	}
 	RLC_CATCH_ANY {
@@ -105,8 +132,9 @@ int cp_ecies_enc(ec_t r, uint8_t *out, int *out_len, uint8_t *in, int in_len,
 	RLC_FINALLY {
 		bn_free(k);
 		bn_free(n);
-		bn_free(x);
 		ec_free(p);
+		memset(key, 0, sizeof(key));
+		memset(a, 0, sizeof(aes_t));
 	}
 
 	return result;
@@ -115,44 +143,90 @@ int cp_ecies_enc(ec_t r, uint8_t *out, int *out_len, uint8_t *in, int in_len,
 int cp_ecies_dec(uint8_t *out, int *out_len, ec_t r, uint8_t *in, int in_len,
 		bn_t d) {
 	ec_t p;
-	bn_t x;
-
-	int l, result = RLC_OK, size = RLC_CEIL(RLC_MAX(128, ec_param_level()), 8);
-	uint8_t _x[RLC_FC_BYTES + 1], h[RLC_MD_LEN], iv[RLC_BC_LEN] = { 0 };
-	uint8_t key[2 * 8 * (RLC_FC_BYTES + 1)];
+	aes_t a;
+	int result = RLC_OK, size = RLC_CEIL(RLC_MAX(128, ec_param_level()), 8);
+	uint8_t iv[RLC_BC_IV] = { 0 }, key[8 * (RLC_FC_BYTES + 1)];
 
-	bn_null(x);
 	ec_null(p);
 
 	RLC_TRY {
-		bn_new(x);
 		ec_new(p);
 
 		ec_mul(p, r, d);
-		ec_get_x(x, p);
-		l = bn_size_bin(x);
-		if (bn_bits(x) % 8 == 0) {
-			/* Compatibility with BouncyCastle. */
-			l = l + 1;
-		}
-		bn_write_bin(_x, l, x);
-		md_kdf(key, 2 * size, _x, l);
-		md_hmac(h, in, in_len - RLC_MD_LEN, key + size, size);
-		if (util_cmp_const(h, in + in_len - RLC_MD_LEN, RLC_MD_LEN)) {
+		ecies_kdf(key, size, p);
+		if (bc_aes_key(a, key, size) != RLC_OK || bc_aes_gcm_dec(out,
+				out_len, in, in_len, NULL, 0, a, iv) != RLC_OK) {
 			result = RLC_ERR;
-		} else {
-			if (bc_aes_cbc_dec(out, out_len, in, in_len - RLC_MD_LEN, key, size, iv)
-					!= RLC_OK) {
-				result = RLC_ERR;
-			}
 		}
 	}
 	RLC_CATCH_ANY {
 		result = RLC_ERR;
 	}
 	RLC_FINALLY {
-		bn_free(x);
 		ec_free(p);
+		memset(key, 0, sizeof(key));
+		memset(a, 0, sizeof(aes_t));
+	}
+
+	return result;
+}
+
+int cp_ecies_enc_init(ec_t r, strm_t s, ec_t q) {
+	bn_t k, n;
+	ec_t p;
+	int result = RLC_OK, size = RLC_CEIL(RLC_MAX(128, ec_param_level()), 8);
+	uint8_t key[8 * (RLC_FC_BYTES + 1)];
+
+	bn_null(k);
+	bn_null(n);
+	ec_null(p);
+
+	RLC_TRY {
+		bn_new(k);
+		bn_new(n);
+		ec_new(p);
+
+		ec_curve_get_ord(n);
+		bn_rand_mod(k, n);
+
+		ec_mul_gen(r, k);
+		ec_mul(p, q, k);
+		ecies_kdf(key, size, p);
+		result = cp_strm_init(s, key, size, 0);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		bn_free(k);
+		bn_free(n);
+		ec_free(p);
+		memset(key, 0, sizeof(key));
+	}
+
+	return result;
+}
+
+int cp_ecies_dec_init(strm_t s, ec_t r, bn_t d) {
+	ec_t p;
+	int result = RLC_OK, size = RLC_CEIL(RLC_MAX(128, ec_param_level()), 8);
+	uint8_t key[8 * (RLC_FC_BYTES + 1)];
+
+	ec_null(p);
+
+	RLC_TRY {
+		ec_new(p);
+
+		ec_mul(p, r, d);
+		ecies_kdf(key, size, p);
+		result = cp_strm_init(s, key, size, 1);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		ec_free(p);
+		memset(key, 0, sizeof(key));
 	}
 
 	return result;
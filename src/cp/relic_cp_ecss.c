@@ -31,6 +31,37 @@
 
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Computes the challenge e = H(R || Q || M) mod n for the variant of the
+ * scheme that carries the commitment point R.
+ *
+ * @param[out] e			- the challenge.
+ * @param[in] r				- the commitment point.
+ * @param[in] q				- the public key.
+ * @param[in] msg			- the message.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] n				- the group order.
+ */
+static void ecss_hash(bn_t e, const ec_t r, const ec_t q, const uint8_t *msg,
+		int len, const bn_t n) {
+	uint8_t hash[RLC_MD_LEN], buf[RLC_FC_BYTES + 1];
+	md_t ctx;
+
+	md_init(ctx);
+	ec_write_bin(buf, RLC_FC_BYTES + 1, r, 1);
+	md_update(ctx, buf, RLC_FC_BYTES + 1);
+	ec_write_bin(buf, RLC_FC_BYTES + 1, q, 1);
+	md_update(ctx, buf, RLC_FC_BYTES + 1);
+	md_update(ctx, msg, len);
+	md_final(hash, ctx);
+	bn_read_bin(e, hash, RLC_MD_LEN);
+	bn_mod(e, e, n);
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -60,8 +91,8 @@ int cp_ecss_gen(bn_t d, ec_t q) {
 int cp_ecss_sig(bn_t e, bn_t s, uint8_t *msg, int len, bn_t d) {
 	bn_t n, k, x, r;
 	ec_t p;
-	uint8_t hash[RLC_MD_LEN];
-	uint8_t *m = RLC_ALLOCA(uint8_t, len + RLC_FC_BYTES);
+	uint8_t hash[RLC_MD_LEN], buf[RLC_FC_BYTES];
+	md_t ctx;
 	int result = RLC_OK;
 
 	bn_null(n);
@@ -76,9 +107,6 @@ int cp_ecss_sig(bn_t e, bn_t s, uint8_t *msg, int len, bn_t d) {
 		bn_new(x);
 		bn_new(r);
 		ec_new(p);
-		if (m == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
 
 		ec_curve_get_ord(n);
 		do {
@@ -88,9 +116,11 @@ int cp_ecss_sig(bn_t e, bn_t s, uint8_t *msg, int len, bn_t d) {
 			bn_mod(r, x, n);
 		} while (bn_is_zero(r));
 
-		memcpy(m, msg, len);
-		bn_write_bin(m + len, RLC_FC_BYTES, r);
-		md_map(hash, m, len + RLC_FC_BYTES);
+		md_init(ctx);
+		md_update(ctx, msg, len);
+		bn_write_bin(buf, RLC_FC_BYTES, r);
+		md_update(ctx, buf, RLC_FC_BYTES);
+		md_final(hash, ctx);
 
 		if (8 * RLC_MD_LEN > bn_bits(n)) {
 			len = RLC_CEIL(bn_bits(n), 8);
@@ -117,7 +147,6 @@ int cp_ecss_sig(bn_t e, bn_t s, uint8_t *msg, int len, bn_t d) {
 		bn_free(x);
 		bn_free(r);
 		ec_free(p);
-		RLC_FREE(m);
 	}
 	return result;
 }
@@ -125,8 +154,8 @@ int cp_ecss_sig(bn_t e, bn_t s, uint8_t *msg, int len, bn_t d) {
 int cp_ecss_ver(bn_t e, bn_t s, uint8_t *msg, int len, ec_t q) {
 	bn_t n, ev, rv;
 	ec_t p;
-	uint8_t hash[RLC_MD_LEN];
-	uint8_t *m = RLC_ALLOCA(uint8_t, len + RLC_FC_BYTES);
+	uint8_t hash[RLC_MD_LEN], buf[RLC_FC_BYTES];
+	md_t ctx;
 	int result = 0;
 
 	bn_null(n);
@@ -139,9 +168,6 @@ int cp_ecss_ver(bn_t e, bn_t s, uint8_t *msg, int len, ec_t q) {
 		bn_new(ev);
 		bn_new(rv);
 		ec_new(p);
-		if (m == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
 
 		ec_curve_get_ord(n);
 
@@ -152,9 +178,11 @@ int cp_ecss_ver(bn_t e, bn_t s, uint8_t *msg, int len, ec_t q) {
 
 				bn_mod(rv, rv, n);
 
-				memcpy(m, msg, len);
-				bn_write_bin(m + len, RLC_FC_BYTES, rv);
-				md_map(hash, m, len + RLC_FC_BYTES);
+				md_init(ctx);
+				md_update(ctx, msg, len);
+				bn_write_bin(buf, RLC_FC_BYTES, rv);
+				md_update(ctx, buf, RLC_FC_BYTES);
+				md_final(hash, ctx);
 
 				if (8 * RLC_MD_LEN > bn_bits(n)) {
 					len = RLC_CEIL(bn_bits(n), 8);
@@ -183,7 +211,165 @@ int cp_ecss_ver(bn_t e, bn_t s, uint8_t *msg, int len, ec_t q) {
 		bn_free(ev);
 		bn_free(rv);
 		ec_free(p);
-		RLC_FREE(m);
+	}
+	return result;
+}
+
+int cp_ecss_sig_ext(ec_t r, bn_t s, uint8_t *msg, int len, bn_t d, ec_t q) {
+	bn_t n, k;
+	int result = RLC_OK;
+
+	bn_null(n);
+	bn_null(k);
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(k);
+
+		ec_curve_get_ord(n);
+		bn_rand_mod(k, n);
+		/* The fixed-base multiplication uses the precomputed table. */
+		ec_mul_gen(r, k);
+		ec_norm(r, r);
+
+		/* Compute s = k + H(R || Q || M) * d mod n. */
+		ecss_hash(s, r, q, msg, len, n);
+		bn_mul(s, s, d);
+		bn_add(s, s, k);
+		bn_mod(s, s, n);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		bn_free(n);
+		bn_free(k);
+	}
+	return result;
+}
+
+int cp_ecss_ver_ext(ec_t r, bn_t s, uint8_t *msg, int len, ec_t q) {
+	bn_t n, e;
+	ec_t p;
+	int result = 0;
+
+	bn_null(n);
+	bn_null(e);
+	ec_null(p);
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(e);
+		ec_new(p);
+
+		ec_curve_get_ord(n);
+
+		if (bn_sign(s) == RLC_POS && bn_cmp(s, n) == RLC_LT &&
+				!ec_is_infty(r) && ec_on_curve(r) && ec_on_curve(q)) {
+			ecss_hash(e, r, q, msg, len, n);
+
+			/* Check that [s]G - [e]Q = R. */
+			bn_sub(e, n, e);
+			ec_mul_sim_gen(p, s, q, e);
+			result = (ec_cmp(p, r) == RLC_EQ);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(n);
+		bn_free(e);
+		ec_free(p);
+	}
+	return result;
+}
+
+int cp_ecss_ver_batch(ec_t r[], bn_t s[], uint8_t *msg[], int len[], ec_t q[],
+		int n) {
+	bn_t m, t, *k = RLC_ALLOCA(bn_t, 2 * n + 1);
+	ec_t *p = RLC_ALLOCA(ec_t, 2 * n + 1);
+	int i, result = 0;
+
+	bn_null(m);
+	bn_null(t);
+
+	if (n == 0) {
+		RLC_FREE(k);
+		RLC_FREE(p);
+		return 1;
+	}
+
+	RLC_TRY {
+		bn_new(m);
+		bn_new(t);
+		if (k == NULL || p == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < 2 * n + 1; i++) {
+			bn_null(k[i]);
+			ec_null(p[i]);
+			bn_new(k[i]);
+			ec_new(p[i]);
+		}
+
+		ec_curve_get_ord(m);
+
+		result = 1;
+		for (i = 0; i < n; i++) {
+			if (bn_sign(s[i]) != RLC_POS || bn_cmp(s[i], m) != RLC_LT ||
+					ec_is_infty(r[i]) || !ec_on_curve(r[i]) ||
+					!ec_on_curve(q[i])) {
+				result = 0;
+			}
+		}
+
+		ec_curve_get_cof(t);
+		if (result && bn_cmp_dig(t, 1) != RLC_EQ) {
+			/* Points with components of small order would survive the random
+			 * weights, so verify one by one when the cofactor is not 1. */
+			for (i = 0; i < n; i++) {
+				result &= cp_ecss_ver_ext(r[i], s[i], msg[i], len[i], q[i]);
+			}
+		} else if (result) {
+			/* Normalize all points with a single inversion. */
+			for (i = 0; i < n; i++) {
+				ec_copy(p[i + 1], r[i]);
+				ec_copy(p[i + n + 1], q[i]);
+			}
+			ec_norm_sim(p + 1, (const ec_t *)p + 1, 2 * n);
+
+			/* Check [sum z_i s_i]G - sum [z_i]R_i - sum [z_i e_i]Q_i = 0. */
+			ec_curve_get_gen(p[0]);
+			bn_zero(k[0]);
+			bn_rand_sim(k + 1, n, 128);
+			for (i = 0; i < n; i++) {
+				ecss_hash(t, p[i + 1], p[i + n + 1], msg[i], len[i], m);
+				bn_mul(k[i + n + 1], k[i + 1], t);
+				bn_mod(k[i + n + 1], k[i + n + 1], m);
+				bn_neg(k[i + n + 1], k[i + n + 1]);
+				bn_mul(t, k[i + 1], s[i]);
+				bn_add(k[0], k[0], t);
+				bn_neg(k[i + 1], k[i + 1]);
+			}
+			bn_mod(k[0], k[0], m);
+
+			ec_mul_sim_lot(p[0], (const ec_t *)p, (const bn_t *)k, 2 * n + 1);
+			result = ec_is_infty(p[0]);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(m);
+		bn_free(t);
+		for (i = 0; i < 2 * n + 1; i++) {
+			bn_free(k[i]);
+			ec_free(p[i]);
+		}
+		RLC_FREE(k);
+		RLC_FREE(p);
 	}
 	return result;
 }
@@ -0,0 +1,390 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * Implementation of the Edwards-curve Digital Signature Algorithm.
+ *
+ * @ingroup cp
+ */
+
+#include "relic.h"
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Encodes a normalized point as in RFC 8032: the y-coordinate in little-endian
+ * order with the least significant bit of x stored in the topmost bit.
+ *
+ * @param[out] bin			- the output buffer of RLC_FP_BYTES bytes.
+ * @param[in] p				- the point to encode.
+ */
+static void eddsa_write(uint8_t *bin, const ed_t p) {
+	uint8_t t[RLC_FP_BYTES];
+
+	/* The parity must be taken from x outside of the Montgomery domain. */
+	fp_write_bin(t, RLC_FP_BYTES, p->x);
+	bin[RLC_FP_BYTES - 1] = (uint8_t)((t[RLC_FP_BYTES - 1] & 1) << 7);
+	fp_write_bin(t, RLC_FP_BYTES, p->y);
+	for (int i = 0; i < RLC_FP_BYTES - 1; i++) {
+		bin[i] = t[RLC_FP_BYTES - 1 - i];
+	}
+	bin[RLC_FP_BYTES - 1] |= t[0];
+}
+
+/**
+ * Reads a little-endian integer from a byte vector and reduces it modulo the
+ * group order.
+ *
+ * @param[out] a			- the resulting integer.
+ * @param[in] bin			- the byte vector.
+ * @param[in] len			- the number of bytes to read.
+ * @param[in] n				- the group order.
+ */
+static void eddsa_read(bn_t a, const uint8_t *bin, int len, const bn_t n) {
+	uint8_t t[RLC_MD_LEN_SH512];
+
+	for (int i = 0; i < len; i++) {
+		t[i] = bin[len - 1 - i];
+	}
+	bn_read_bin(a, t, len);
+	bn_mod(a, a, n);
+}
+
+/**
+ * Computes the challenge k = H(R || A || M) mod n.
+ *
+ * @param[out] k			- the challenge.
+ * @param[in] r				- the first component of the signature, normalized.
+ * @param[in] q				- the public key, normalized.
+ * @param[in] msg			- the message.
+ * @param[in] len			- the message length in bytes.
+ * @param[in] n				- the group order.
+ */
+static void eddsa_hash(bn_t k, const ed_t r, const ed_t q, const uint8_t *msg,
+		int len, const bn_t n) {
+	uint8_t h[RLC_MD_LEN_SH512], buf[RLC_FP_BYTES];
+	md_sh512_t ctx;
+
+	md_sh512_init(ctx);
+	eddsa_write(buf, r);
+	md_sh512_update(ctx, buf, RLC_FP_BYTES);
+	eddsa_write(buf, q);
+	md_sh512_update(ctx, buf, RLC_FP_BYTES);
+	md_sh512_update(ctx, msg, len);
+	md_sh512_final(h, ctx);
+	eddsa_read(k, h, RLC_MD_LEN_SH512, n);
+}
+
+/**
+ * Multiplies a point by the curve cofactor and checks if the result is the
+ * point at infinity.
+ *
+ * @param[in,out] p			- the point to test.
+ * @return a boolean value indicating if the point has small order.
+ */
+static int eddsa_is_small(ed_t p) {
+	/* The cofactor of Ed25519 is 8. */
+	for (int i = 0; i < 3; i++) {
+		ed_dbl(p, p);
+	}
+	return ed_is_infty(p);
+}
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+int cp_eddsa_gen(uint8_t *sk, ed_t q) {
+	rand_bytes(sk, RLC_FP_BYTES);
+	return cp_eddsa_pub(q, sk);
+}
+
+int cp_eddsa_pub(ed_t q, const uint8_t *sk) {
+	bn_t d;
+	uint8_t h[RLC_MD_LEN_SH512];
+	int result = RLC_OK;
+
+	bn_null(d);
+
+	RLC_TRY {
+		bn_new(d);
+
+		md_map_sh512(h, sk, RLC_FP_BYTES);
+		/* Clamp the secret scalar. */
+		h[0] &= 0xF8;
+		h[RLC_FP_BYTES - 1] &= 0x7F;
+		h[RLC_FP_BYTES - 1] |= 0x40;
+		for (int i = 0; i < RLC_FP_BYTES / 2; i++) {
+			RLC_SWAP(h[i], h[RLC_FP_BYTES - 1 - i]);
+		}
+		bn_read_bin(d, h, RLC_FP_BYTES);
+		ed_mul_gen(q, d);
+		ed_norm(q, q);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		bn_free(d);
+		memset(h, 0, sizeof(h));
+	}
+	return result;
+}
+
+int cp_eddsa_pub_write(uint8_t *bin, int len, const ed_t q) {
+	ed_t t;
+	int result = RLC_OK;
+
+	if (len != RLC_FP_BYTES) {
+		RLC_THROW(ERR_NO_BUFFER);
+		return RLC_ERR;
+	}
+
+	ed_null(t);
+
+	RLC_TRY {
+		ed_new(t);
+		ed_norm(t, q);
+		eddsa_write(bin, t);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		ed_free(t);
+	}
+	return result;
+}
+
+int cp_eddsa_sig_write(uint8_t *bin, int len, const ed_t r, const bn_t s) {
+	uint8_t t[RLC_FP_BYTES];
+
+	if (len != 2 * RLC_FP_BYTES || bn_sign(s) == RLC_NEG ||
+			bn_size_bin(s) > RLC_FP_BYTES) {
+		RLC_THROW(ERR_NO_BUFFER);
+		return RLC_ERR;
+	}
+
+	if (cp_eddsa_pub_write(bin, RLC_FP_BYTES, r) != RLC_OK) {
+		return RLC_ERR;
+	}
+	/* The scalar is stored in little-endian order after the point. */
+	bn_write_bin(t, RLC_FP_BYTES, s);
+	for (int i = 0; i < RLC_FP_BYTES; i++) {
+		bin[RLC_FP_BYTES + i] = t[RLC_FP_BYTES - 1 - i];
+	}
+	return RLC_OK;
+}
+
+int cp_eddsa_sig(ed_t r, bn_t s, uint8_t *msg, int len, uint8_t *sk, ed_t q) {
+	bn_t n, d, k;
+	ed_t t;
+	uint8_t h[RLC_MD_LEN_SH512];
+	md_sh512_t ctx;
+	int result = RLC_OK;
+
+	bn_null(n);
+	bn_null(d);
+	bn_null(k);
+	ed_null(t);
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(d);
+		bn_new(k);
+		ed_new(t);
+
+		ed_curve_get_ord(n);
+		md_map_sh512(h, sk, RLC_FP_BYTES);
+		h[0] &= 0xF8;
+		h[RLC_FP_BYTES - 1] &= 0x7F;
+		h[RLC_FP_BYTES - 1] |= 0x40;
+		eddsa_read(d, h, RLC_FP_BYTES, n);
+
+		/* The nonce is derived deterministically from the key prefix. */
+		md_sh512_init(ctx);
+		md_sh512_update(ctx, h + RLC_FP_BYTES, RLC_FP_BYTES);
+		md_sh512_update(ctx, msg, len);
+		md_sh512_final(h, ctx);
+		eddsa_read(k, h, RLC_MD_LEN_SH512, n);
+
+		ed_mul_gen(r, k);
+		ed_norm(r, r);
+		ed_norm(t, q);
+
+		/* Compute s = k + H(R || A || M) * d mod n. */
+		eddsa_hash(s, r, t, msg, len, n);
+		bn_mul(s, s, d);
+		bn_add(s, s, k);
+		bn_mod(s, s, n);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		bn_free(n);
+		bn_free(d);
+		bn_free(k);
+		ed_free(t);
+		memset(h, 0, sizeof(h));
+	}
+	return result;
+}
+
+int cp_eddsa_ver(ed_t r, bn_t s, uint8_t *msg, int len, ed_t q) {
+	bn_t n, k;
+	ed_t p, t, u;
+	int result = 0;
+
+	bn_null(n);
+	bn_null(k);
+	ed_null(p);
+	ed_null(t);
+	ed_null(u);
+
+	RLC_TRY {
+		bn_new(n);
+		bn_new(k);
+		ed_new(p);
+		ed_new(t);
+		ed_new(u);
+
+		ed_curve_get_ord(n);
+
+		if (bn_sign(s) == RLC_POS && bn_cmp(s, n) == RLC_LT &&
+				ed_on_curve(r) && ed_on_curve(q)) {
+			ed_norm(t, r);
+			ed_norm(u, q);
+			eddsa_hash(k, t, u, msg, len, n);
+
+			/* Check that [8]([s]B - [k]A - R) is the point at infinity. */
+			bn_sub(k, n, k);
+			ed_mul_sim_gen(p, s, u, k);
+			ed_sub(p, p, t);
+			result = eddsa_is_small(p);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(n);
+		bn_free(k);
+		ed_free(p);
+		ed_free(t);
+		ed_free(u);
+	}
+	return result;
+}
+
+int cp_eddsa_ver_batch(ed_t r[], bn_t s[], uint8_t *msg[], int len[], ed_t q[],
+		int n) {
+	bn_t m, t, *k = RLC_ALLOCA(bn_t, 2 * n + 1);
+	ed_t *p = RLC_ALLOCA(ed_t, 2 * n + 1);
+	int i, norm = 0, result = 0;
+
+	bn_null(m);
+	bn_null(t);
+
+	if (n == 0) {
+		RLC_FREE(k);
+		RLC_FREE(p);
+		return 1;
+	}
+
+	RLC_TRY {
+		bn_new(m);
+		bn_new(t);
+		if (k == NULL || p == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < 2 * n + 1; i++) {
+			bn_null(k[i]);
+			ed_null(p[i]);
+			bn_new(k[i]);
+			ed_new(p[i]);
+		}
+
+		ed_curve_get_ord(m);
+
+		result = 1;
+		for (i = 0; i < n; i++) {
+			if (bn_sign(s[i]) != RLC_POS || bn_cmp(s[i], m) != RLC_LT ||
+					!ed_on_curve(r[i]) || !ed_on_curve(q[i])) {
+				result = 0;
+			}
+		}
+
+		if (result) {
+			/* Keys and signatures are usually affine already, and
+			 * ed_mul_sim_lot() normalizes its inputs on its own, so only
+			 * invert when the hash below needs it. */
+			for (i = 0; i < n; i++) {
+				ed_copy(p[i + 1], r[i]);
+				ed_copy(p[i + n + 1], q[i]);
+				if (r[i]->coord != BASIC || q[i]->coord != BASIC) {
+					norm = 1;
+				}
+			}
+			if (norm) {
+				ed_norm_sim(p + 1, (const ed_t *)p + 1, 2 * n);
+			}
+
+			/* Check [8]([sum z_i s_i]B - sum [z_i]R_i - sum [z_i k_i]A_i). */
+			ed_curve_get_gen(p[0]);
+			bn_zero(k[0]);
+			bn_rand_sim(k + 1, n, 128);
+			for (i = 0; i < n; i++) {
+				eddsa_hash(t, p[i + 1], p[i + n + 1], msg[i], len[i], m);
+				bn_mul(k[i + n + 1], k[i + 1], t);
+				bn_mod(k[i + n + 1], k[i + n + 1], m);
+				bn_neg(k[i + n + 1], k[i + n + 1]);
+				bn_mul(t, k[i + 1], s[i]);
+				bn_add(k[0], k[0], t);
+				bn_neg(k[i + 1], k[i + 1]);
+			}
+			bn_mod(k[0], k[0], m);
+
+			ed_mul_sim_lot(p[0], (const ed_t *)p, (const bn_t *)k, 2 * n + 1);
+			result = eddsa_is_small(p[0]);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(m);
+		bn_free(t);
+		for (i = 0; i < 2 * n + 1; i++) {
+			bn_free(k[i]);
+			ed_free(p[i]);
+		}
+		RLC_FREE(k);
+		RLC_FREE(p);
+	}
+	return result;
+}
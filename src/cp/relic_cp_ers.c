@@ -103,45 +103,45 @@ int cp_ers_sig(bn_t td, ers_t p, uint8_t *msg, int len, bn_t sk, ec_t pk,
 }
 
 int cp_ers_ver(bn_t td, ers_t *s, int size, uint8_t *msg, int len, ec_t pp) {
-	bn_t n;
-	ec_t t, y[2];
-	int flag = 0, result = 0;
+	bn_t **c = RLC_ALLOCA(bn_t *, size), **r = RLC_ALLOCA(bn_t *, size);
+	ec_t t, *y = RLC_ALLOCA(ec_t, 2 * size);
+	int i, result = 0;
 
-	bn_null(n);
 	ec_null(t);
-	ec_null(y[0]);
-	ec_null(y[1]);
 
 	RLC_TRY {
-		bn_new(n);
 		ec_new(t);
-		ec_new(y[0]);
-		ec_new(y[1]);
+		if (c == NULL || r == NULL || y == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < 2 * size; i++) {
+			ec_null(y[i]);
+			ec_new(y[i]);
+		}
 
-		ec_curve_get_ord(n);
 		ec_mul_gen(t, td);
-
-		for (int i = 0; i < size; i++) {
-            ec_add(t, t, s[i]->h);
-        }
+		for (i = 0; i < size; i++) {
+			ec_add(t, t, s[i]->h);
+			ec_copy(y[2 * i], s[i]->h);
+			ec_copy(y[2 * i + 1], s[i]->pk);
+			c[i] = s[i]->c;
+			r[i] = s[i]->r;
+		}
 		if (ec_cmp(pp, t) == RLC_EQ) {
-			flag = 1;
-			for (int i = 0; i < size; i++) {
-				ec_copy(y[0], s[i]->h);
-				ec_copy(y[1], s[i]->pk);
-				flag &= cp_sokor_ver(s[i]->c, s[i]->r, msg, len, y, NULL);
-	        }
+			result = cp_sokor_ver_sim(c, r, msg, len, y, NULL, size);
 		}
-		result = flag;
 	}
 	RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	}
 	RLC_FINALLY {
-		bn_free(n);
 		ec_free(t);
-		ec_free(y[0]);
-		ec_free(y[1]);
+		for (i = 0; y != NULL && i < 2 * size; i++) {
+			ec_free(y[i]);
+		}
+		RLC_FREE(c);
+		RLC_FREE(r);
+		RLC_FREE(y);
 	}
 	return result;
 }
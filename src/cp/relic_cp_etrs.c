@@ -142,101 +142,147 @@ int cp_etrs_sig(bn_t *td, bn_t *y, int max, etrs_t p, uint8_t *msg, int len,
 
 int cp_etrs_ver(int thres, bn_t *td, bn_t *y, int max, etrs_t *s, int size,
 		uint8_t *msg, int len, ec_t pp) {
-	int i, flag = 0, result = 0;
-	bn_t l, n, u;
-	ec_t w[2];
-
-	int d = max + size - thres;
-	bn_t *v = RLC_ALLOCA(bn_t, d);
-	bn_t *_v = RLC_ALLOCA(bn_t, d);
-	bn_t *_y = RLC_ALLOCA(bn_t, d);
-	ec_t *_t = RLC_ALLOCA(ec_t, d);
-
-	bn_null(l);
+	int i, m, d = max + size - thres, flag = 0, result = 0;
+	bn_t k, n;
+	ec_t t, w;
+
+	m = RLC_MAX(d, 0);
+	bn_t *p = RLC_ALLOCA(bn_t, m + 1);
+	bn_t *v = RLC_ALLOCA(bn_t, RLC_MAX(m, 1));
+	bn_t *_y = RLC_ALLOCA(bn_t, RLC_MAX(m, 1));
+	ec_t *_t = RLC_ALLOCA(ec_t, RLC_MAX(m - max, 1));
+	bn_t **c = RLC_ALLOCA(bn_t *, RLC_MAX(size, 1));
+	bn_t **r = RLC_ALLOCA(bn_t *, RLC_MAX(size, 1));
+	ec_t *u = RLC_ALLOCA(ec_t, RLC_MAX(2 * size, 1));
+
+	bn_null(k);
 	bn_null(n);
-	bn_null(u);
-	ec_null(w[0]);
-	ec_null(w[1]);
+	ec_null(t);
+	ec_null(w);
 
 	RLC_TRY {
-		bn_new(l);
+		bn_new(k);
 		bn_new(n);
-		bn_new(u);
-		ec_new(w[0]);
-		ec_new(w[1]);
-		if (_y == NULL || _t == NULL || v == NULL) {
+		ec_new(t);
+		ec_new(w);
+		if (p == NULL || v == NULL || _y == NULL || _t == NULL || c == NULL ||
+				r == NULL || u == NULL) {
 			RLC_THROW(ERR_NO_MEMORY);
 		}
-		for (i = 0; i < d; i++) {
+		for (i = 0; i <= m; i++) {
+			bn_null(p[i]);
+			bn_new(p[i]);
+		}
+		for (i = 0; i < m; i++) {
 			bn_null(v[i]);
-			bn_null(_v[i]);
+			bn_null(_y[i]);
 			bn_new(v[i]);
-			bn_new(_v[i]);
 			bn_new(_y[i]);
+		}
+		for (i = 0; i < m - max; i++) {
+			ec_null(_t[i]);
 			ec_new(_t[i]);
 		}
+		for (i = 0; i < 2 * size; i++) {
+			ec_null(u[i]);
+			ec_new(u[i]);
+		}
 
-		for (i = 0; i < max; i++) {
+		for (i = 0; i < max && i < m; i++) {
 			bn_copy(_y[i], y[i]);
-			ec_mul_gen(_t[i], td[i]);
 		}
-		for (; i < d; i++) {
+		for (; i < m; i++) {
 			bn_copy(_y[i], s[i - max]->y);
-			ec_copy(_t[i], s[i - max]->h);
+			ec_copy(_t[i - max], s[i - max]->h);
 		}
 
 		ec_curve_get_ord(n);
 
+		/* The Lagrange coefficients at zero are v_i = -P(0) / (y_i * P'(y_i))
+		 * for P(x) = \prod_j (x - y_j), so a single inversion suffices. */
 		flag = 1;
-		ec_set_infty(w[0]);
-		for(i = 0; i < d; i++) {
-			for(int j = 0; j < d; j++) {
-				bn_set_dig(_v[j], 1);
-				if (j != i) {
-					bn_sub(_v[j], _y[j], _y[i]);
-					bn_mod(_v[j], _v[j], n);
-				}
+		bn_lag(p, (const bn_t *)_y, n, m);
+		bn_neg(k, p[0]);
+		bn_mod(k, k, n);
+		for (i = 0; i < m; i++) {
+			bn_mul_dig(p[i], p[i + 1], i + 1);
+			bn_mod(p[i], p[i], n);
+		}
+		bn_evl_sim(v, (const bn_t *)p, (const bn_t *)_y, n, m, m);
+		for (i = 0; i < m; i++) {
+			if (bn_is_zero(v[i])) {
+				/* Repeated abscissae make the interpolation singular. */
+				flag = 0;
+			} else if (!bn_is_zero(_y[i])) {
+				bn_mul(v[i], v[i], _y[i]);
+				bn_mod(v[i], v[i], n);
 			}
-			bn_mod_inv_sim(_v, _v, n, d);
-			bn_set_dig(v[i], 1);
-			for(int j = 0; j < d; j++) {
-				if (j != i) {
-					bn_mul(u, _y[j], _v[j]);
-					bn_mod(u, u, n);
-					bn_mul(v[i], v[i], u);
+		}
+
+		if (flag) {
+			bn_mod_inv_sim(v, (const bn_t *)v, n, m);
+			for (i = 0; i < m; i++) {
+				if (bn_is_zero(_y[i])) {
+					bn_set_dig(v[i], 1);
+				} else {
+					bn_mul(v[i], v[i], k);
 					bn_mod(v[i], v[i], n);
 				}
 			}
+
+			/* Fold the known trapdoors into a single multiplication by G. */
+			bn_zero(k);
+			for (i = 0; i < max && i < m; i++) {
+				bn_mul(p[i], v[i], td[i]);
+				bn_add(k, k, p[i]);
+				bn_mod(k, k, n);
+			}
+			ec_mul_gen(w, k);
+			if (m > max) {
+				ec_mul_sim_lot(t, (const ec_t *)_t, (const bn_t *)v + max,
+						m - max);
+				ec_add(w, w, t);
+			}
+			flag &= ec_cmp(w, pp) != RLC_EQ;
+		}
+
+		for (i = 0; i < size; i++) {
+			ec_copy(u[2 * i], s[i]->h);
+			ec_copy(u[2 * i + 1], s[i]->pk);
+			c[i] = s[i]->c;
+			r[i] = s[i]->r;
 		}
-		ec_mul_sim_lot(w[0], _t, v, d);
-		flag &= ec_cmp(w[0], pp) != RLC_EQ;
-
-		for (int i = 0; i < size; i++) {
-			ec_copy(w[0], s[i]->h);
-			ec_copy(w[1], s[i]->pk);
-			flag &= cp_sokor_ver(s[i]->c, s[i]->r, msg, len, w, NULL);
-        }
+		flag &= cp_sokor_ver_sim(c, r, msg, len, u, NULL, size);
 		result = flag;
 	}
 	RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	}
 	RLC_FINALLY {
-		bn_free(l);
+		bn_free(k);
 		bn_free(n);
-		bn_free(u);
-		ec_free(w[0]);
-		ec_free(w[1]);
-		for (int i = 0; i < d; i++) {
+		ec_free(t);
+		ec_free(w);
+		for (i = 0; p != NULL && i <= m; i++) {
+			bn_free(p[i]);
+		}
+		for (i = 0; v != NULL && _y != NULL && i < m; i++) {
 			bn_free(v[i]);
-			bn_free(_v[i]);
 			bn_free(_y[i]);
+		}
+		for (i = 0; _t != NULL && i < m - max; i++) {
 			ec_free(_t[i]);
 		}
+		for (i = 0; u != NULL && i < 2 * size; i++) {
+			ec_free(u[i]);
+		}
+		RLC_FREE(p);
 		RLC_FREE(v);
-		RLC_FREE(_v);
 		RLC_FREE(_y);
 		RLC_FREE(_t);
+		RLC_FREE(c);
+		RLC_FREE(r);
+		RLC_FREE(u);
 	}
 	return result;
 }
@@ -32,45 +32,26 @@
 #include "relic.h"
 
 /*============================================================================*/
-/* Public definitions                                                         */
+/* Private definitions                                                        */
 /*============================================================================*/
 
-int cp_ibe_gen(bn_t master, g1_t pub) {
-	bn_t n;
-	int result = RLC_OK;
-
-	bn_null(n);
-
-	RLC_TRY {
-		bn_new(n);
-
-		pc_get_ord(n);
-		bn_rand_mod(master, n);
-
-		/* K_pub = sG. */
-		g1_mul_gen(pub, master);
-	}
-	RLC_CATCH_ANY {
-		result = RLC_ERR;
-	}
-	RLC_FINALLY {
-		bn_free(n);
-	}
-	return result;
-}
-
-int cp_ibe_gen_prv(g2_t prv, char *id, bn_t master) {
-	g2_map(prv, (uint8_t *)id, strlen(id));
-	g2_mul(prv, prv, master);
-	return RLC_OK;
-}
+/**
+ * Size in bytes of the symmetric key derived from the pairing value.
+ */
+#define IBE_KEY			RLC_CEIL(RLC_MAX(128, pc_param_level()), 8)
 
-int cp_ibe_enc(uint8_t *out, int *out_len, uint8_t *in, int in_len, char *id,
-		g1_t pub) {
-	int l, result = RLC_OK;
-	uint8_t *buf = NULL, h[RLC_MD_LEN];
-	bn_t n;
-	bn_t r;
+/**
+ * Encapsulates a fresh symmetric key to an identity.
+ *
+ * @param[out] key			- the symmetric key of IBE_KEY bytes.
+ * @param[out] out			- the encoded ephemeral point.
+ * @param[in] id			- the identity.
+ * @param[in] pub			- the public key of the PKG.
+ */
+static void ibe_encap(uint8_t *key, uint8_t *out, char *id, g1_t pub) {
+	int l;
+	uint8_t *buf = NULL;
+	bn_t n, r;
 	g1_t p;
 	g2_t q;
 	gt_t e;
@@ -81,15 +62,6 @@ int cp_ibe_enc(uint8_t *out, int *out_len, uint8_t *in, int in_len, char *id,
 	g2_null(q);
 	gt_null(e);
 
-	if (pub == NULL || in_len <= 0 || in_len > RLC_MD_LEN ) {
-		return RLC_ERR;
-	}
-
-	l = 1 + 2 * RLC_FP_BYTES;
-	if (*out_len < (in_len + l)) {
-		return RLC_ERR;
-	}
-
 	RLC_TRY {
 		bn_new(n);
 		bn_new(r);
@@ -112,23 +84,17 @@ int cp_ibe_enc(uint8_t *out, int *out_len, uint8_t *in, int in_len, char *id,
 		/* e = e(K_pub, q). */
 		pc_map(e, pub, q);
 
-		/* h = H_2(e^r). */
+		/* k = KDF(e^r). */
 		bn_rand_mod(r, n);
 		gt_exp(e, e, r);
 		gt_write_bin(buf, l, e, 0);
-		md_map(h, buf, l);
+		md_kdf(key, IBE_KEY, buf, l);
 
-		/* P = [k]G. */
+		/* P = [r]G. */
 		g1_mul_gen(p, r);
-		g1_write_bin(out, *out_len, p, 0);
-
-		for (l = 0; l < RLC_MIN(in_len, RLC_MD_LEN); l++) {
-			out[l + (2 * RLC_FP_BYTES + 1)] = in[l] ^ h[l];
-		}
-
-		*out_len = in_len + (2 * RLC_FP_BYTES + 1);
+		g1_write_bin(out, 2 * RLC_FP_BYTES + 1, p, 0);
 	} RLC_CATCH_ANY {
-		result = RLC_ERR;
+		RLC_THROW(ERR_CAUGHT);
 	} RLC_FINALLY {
 		bn_free(n);
 		bn_free(r);
@@ -137,32 +103,29 @@ int cp_ibe_enc(uint8_t *out, int *out_len, uint8_t *in, int in_len, char *id,
 		gt_free(e);
 		RLC_FREE(buf);
 	}
-	return result;
 }
 
-int cp_ibe_dec(uint8_t *out, int *out_len, uint8_t *in, int in_len, g2_t prv) {
-	int l, result = RLC_OK;
-	uint8_t *buf = NULL, h[RLC_MD_LEN];
+/**
+ * Recovers an encapsulated symmetric key.
+ *
+ * @param[out] key			- the symmetric key of IBE_KEY bytes.
+ * @param[in] in			- the encoded ephemeral point.
+ * @param[in] prv			- the private key of the user.
+ */
+static void ibe_decap(uint8_t *key, uint8_t *in, g2_t prv) {
+	int l;
+	uint8_t *buf = NULL;
 	g1_t p;
 	gt_t e;
 
 	g1_null(p);
 	gt_null(e);
 
-	l = 2 * RLC_FP_BYTES + 1;
-	if (prv == NULL || in_len <= l || in_len > (RLC_MD_LEN + l)) {
-		return RLC_ERR;
-	}
-
-	if (*out_len < (in_len - l)) {
-		return RLC_ERR;
-	}
-
 	RLC_TRY {
 		g1_new(p);
 		gt_new(e);
 
-		g1_read_bin(p, in, l);
+		g1_read_bin(p, in, 2 * RLC_FP_BYTES + 1);
 
 		pc_map(e, p, prv);
 
@@ -173,21 +136,139 @@ int cp_ibe_dec(uint8_t *out, int *out_len, uint8_t *in, int in_len, g2_t prv) {
 			RLC_THROW(ERR_NO_MEMORY);
 		}
 		gt_write_bin(buf, l, e, 0);
-		md_map(h, buf, l);
+		md_kdf(key, IBE_KEY, buf, l);
+	} RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	} RLC_FINALLY {
+		g1_free(p);
+		gt_free(e);
+		RLC_FREE(buf);
+	}
+}
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+int cp_ibe_gen(bn_t master, g1_t pub) {
+	bn_t n;
+	int result = RLC_OK;
+
+	bn_null(n);
+
+	RLC_TRY {
+		bn_new(n);
+
+		pc_get_ord(n);
+		bn_rand_mod(master, n);
+
+		/* K_pub = sG. */
+		g1_mul_gen(pub, master);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		bn_free(n);
+	}
+	return result;
+}
 
-		in_len -= (2 * RLC_FP_BYTES + 1);
-		for (l = 0; l < RLC_MIN(in_len, RLC_MD_LEN); l++) {
-			out[l] = in[l + (2 * RLC_FP_BYTES + 1)] ^ h[l];
+int cp_ibe_gen_prv(g2_t prv, char *id, bn_t master) {
+	g2_map(prv, (uint8_t *)id, strlen(id));
+	g2_mul(prv, prv, master);
+	return RLC_OK;
+}
+
+int cp_ibe_enc(uint8_t *out, int *out_len, uint8_t *in, int in_len, char *id,
+		g1_t pub) {
+	int l = 2 * RLC_FP_BYTES + 1, result = RLC_OK;
+	uint8_t key[RLC_MD_LEN_SH512], iv[RLC_BC_IV] = { 0 };
+	aes_t a;
+
+	if (pub == NULL || in_len < 0 || *out_len < l) {
+		return RLC_ERR;
+	}
+
+	RLC_TRY {
+		ibe_encap(key, out, id, pub);
+		/* The key is used only once, so the nonce can be fixed. */
+		*out_len -= l;
+		if (bc_aes_key(a, key, IBE_KEY) != RLC_OK || bc_aes_gcm_enc(out + l,
+				out_len, in, in_len, NULL, 0, a, iv) != RLC_OK) {
+			result = RLC_ERR;
 		}
+		*out_len += l;
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	} RLC_FINALLY {
+		memset(key, 0, sizeof(key));
+		memset(a, 0, sizeof(aes_t));
+	}
+	return result;
+}
 
-		*out_len = in_len;
+int cp_ibe_dec(uint8_t *out, int *out_len, uint8_t *in, int in_len, g2_t prv) {
+	int l = 2 * RLC_FP_BYTES + 1, result = RLC_OK;
+	uint8_t key[RLC_MD_LEN_SH512], iv[RLC_BC_IV] = { 0 };
+	aes_t a;
+
+	if (prv == NULL || in_len < l + RLC_BC_TAG) {
+		return RLC_ERR;
+	}
+
+	RLC_TRY {
+		ibe_decap(key, in, prv);
+		if (bc_aes_key(a, key, IBE_KEY) != RLC_OK || bc_aes_gcm_dec(out,
+				out_len, in + l, in_len - l, NULL, 0, a, iv) != RLC_OK) {
+			result = RLC_ERR;
+		}
 	} RLC_CATCH_ANY {
 		result = RLC_ERR;
 	} RLC_FINALLY {
-		g1_free(p);
-		gt_free(e);
-		RLC_FREE(buf);
+		memset(key, 0, sizeof(key));
+		memset(a, 0, sizeof(aes_t));
+	}
+
+	return result;
+}
+
+int cp_ibe_enc_init(uint8_t *out, int *out_len, strm_t s, char *id,
+		g1_t pub) {
+	int result = RLC_OK;
+	uint8_t key[RLC_MD_LEN_SH512];
+
+	if (pub == NULL || *out_len < 2 * RLC_FP_BYTES + 1) {
+		return RLC_ERR;
 	}
 
+	RLC_TRY {
+		ibe_encap(key, out, id, pub);
+		*out_len = 2 * RLC_FP_BYTES + 1;
+		result = cp_strm_init(s, key, IBE_KEY, 0);
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	} RLC_FINALLY {
+		memset(key, 0, sizeof(key));
+	}
+	return result;
+}
+
+int cp_ibe_dec_init(strm_t s, uint8_t *in, int in_len, g2_t prv) {
+	int result = RLC_OK;
+	uint8_t key[RLC_MD_LEN_SH512];
+
+	if (prv == NULL || in_len != 2 * RLC_FP_BYTES + 1) {
+		return RLC_ERR;
+	}
+
+	RLC_TRY {
+		ibe_decap(key, in, prv);
+		result = cp_strm_init(s, key, IBE_KEY, 1);
+	} RLC_CATCH_ANY {
+		result = RLC_ERR;
+	} RLC_FINALLY {
+		memset(key, 0, sizeof(key));
+	}
 	return result;
 }
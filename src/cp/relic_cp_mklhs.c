@@ -31,6 +31,27 @@
 
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Size in bytes of an uncompressed element of G_1 in the verification cache.
+ */
+#define MKLHS_G1		(2 * RLC_FP_BYTES + 1)
+
+/**
+ * Writes a non-negative integer as a big-endian string of eight bytes.
+ *
+ * @param[out] bin			- the output buffer.
+ * @param[in] a				- the integer to write.
+ */
+static void mklhs_enc(uint8_t *bin, uint64_t a) {
+	for (int i = 7; i >= 0; i--, a >>= 8) {
+		bin[i] = (uint8_t)a;
+	}
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -137,26 +158,67 @@ int cp_mklhs_evl(g1_t sig, g1_t s[], dig_t f[], int len) {
 	return result;
 }
 
-int cp_mklhs_ver(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[],
-		char *tag[], dig_t *f[], int flen[], g2_t pk[], int slen) {
+int cp_mklhs_lab(g1_t h[], char *id[], char *tag[], int flen[], int slen) {
+	int i, j, k, len = 0, total = 0, result = RLC_OK;
+	const uint8_t **ptr;
+	uint8_t *str;
+	int *l;
+
+	for (i = 0; i < slen; i++) {
+		for (j = 0; j < flen[i]; j++) {
+			len += strlen(id[i]) + strlen(tag[j]);
+		}
+		total += flen[i];
+	}
+	str = RLC_ALLOCA(uint8_t, RLC_MAX(len, 1));
+	ptr = RLC_ALLOCA(const uint8_t *, RLC_MAX(total, 1));
+	l = RLC_ALLOCA(int, RLC_MAX(total, 1));
+
+	RLC_TRY {
+		if (str == NULL || ptr == NULL || l == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+
+		/* Lay out all the labels id_i || tag_j in a single buffer. */
+		len = k = 0;
+		for (i = 0; i < slen; i++) {
+			for (j = 0; j < flen[i]; j++, k++) {
+				ptr[k] = str + len;
+				memcpy(str + len, id[i], strlen(id[i]));
+				memcpy(str + len + strlen(id[i]), tag[j], strlen(tag[j]));
+				l[k] = strlen(id[i]) + strlen(tag[j]);
+				len += l[k];
+			}
+		}
+		g1_map_sim(h, ptr, l, total);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		RLC_FREE(str);
+		RLC_FREE(ptr);
+		RLC_FREE(l);
+	}
+	return result;
+}
+
+int cp_mklhs_ver_lab(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[],
+		g1_t h[], dig_t *f[], int flen[], g2_t pk[], int slen) {
 	bn_t t, n;
-	g1_t d, *g = RLC_ALLOCA(g1_t, slen);
+	g1_t *d = RLC_ALLOCA(g1_t, slen), *g = RLC_ALLOCA(g1_t, slen);
 	g2_t g2;
 	gt_t c, e;
-	int imax = 0, lmax = 0, fmax = 0, ver1 = 0, ver2 = 0;
-	for (int i = 0; i < slen; i++) {
-		fmax = RLC_MAX(fmax, flen[i]);
+	int i, imax = 0, ver1 = 0, ver2 = 0;
+	int *o = RLC_ALLOCA(int, slen), *l = RLC_ALLOCA(int, slen);
+	const uint8_t **ptr = RLC_ALLOCA(const uint8_t *, slen);
+	for (i = 0; i < slen; i++) {
 		imax = RLC_MAX(imax, strlen(id[i]));
-		for (int j = 0; j < flen[i]; j++) {
-			lmax = RLC_MAX(lmax, strlen(tag[j]));
-		}
 	}
-	g1_t *h = RLC_ALLOCA(g1_t, fmax);
-	uint8_t *str = RLC_ALLOCA(uint8_t, imax + RLC_MAX(strlen(data), lmax));
+	uint8_t *str = RLC_ALLOCA(uint8_t, slen * (strlen(data) + imax));
 
 	bn_null(t);
 	bn_null(n);
-	g1_null(d);
 	g2_null(g2);
 	gt_null(c);
 	gt_null(e);
@@ -164,47 +226,65 @@ int cp_mklhs_ver(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[],
 	RLC_TRY {
 		bn_new(t);
 		bn_new(n);
-		g1_new(d);
 		g2_new(g2);
 		gt_new(c);
 		gt_new(e);
-		if (g == NULL || h == NULL || str == NULL) {
-			RLC_FREE(g);
-			RLC_FREE(h);
+		if (d == NULL || g == NULL || o == NULL || l == NULL || ptr == NULL ||
+				str == NULL) {
 			RLC_THROW(ERR_NO_MEMORY);
 		}
 
 		bn_zero(t);
 		pc_get_ord(n);
-		for (int j = 0; j < slen; j++) {
-			g1_null(g[j]);
-			g1_new(g[j]);
-			bn_add(t, t, mu[j]);
+		for (i = 0; i < slen; i++) {
+			g1_null(d[i]);
+			g1_null(g[i]);
+			g1_new(d[i]);
+			g1_new(g[i]);
+			bn_add(t, t, mu[i]);
 			bn_mod(t, t, n);
 		}
-		for (int j = 0; j < fmax; j++) {
-			g1_null(h[j]);
-			g1_new(h[j]);
-		}
 
 		if (bn_cmp(m, t) == RLC_EQ) {
 			ver1 = 1;
 		}
 
-		for (int i = 0; i < slen; i++) {
-			memcpy(str, data, strlen(data));
-			memcpy(str + strlen(data), id[i], strlen(id[i]));
-			g1_map(d, str, strlen(data) + strlen(id[i]));
-			memcpy(str, id[i], strlen(id[i]));
+		/* Hash all the data || id_i strings at once. */
+		for (i = 0; i < slen; i++) {
+			o[i] = (i == 0 ? 0 : o[i - 1] + flen[i - 1]);
+			ptr[i] = str + i * (strlen(data) + imax);
+			memcpy(str + i * (strlen(data) + imax), data, strlen(data));
+			memcpy(str + i * (strlen(data) + imax) + strlen(data), id[i],
+					strlen(id[i]));
+			l[i] = strlen(data) + strlen(id[i]);
+		}
+		g1_map_sim(d, ptr, l, slen);
+
+		/* Compute g_i = sum f_ij * h_ij + (sum f_ij) * d_i + mu_i * g1. */
+#if MULTI == OPENMP
+		omp_set_num_threads(CORES);
+		#pragma omp parallel for copyin(core_ctx) schedule(dynamic)
+#endif
+		for (i = 0; i < slen; i++) {
+			bn_t s;
+			g1_t p;
+
+			bn_null(s);
+			g1_null(p);
+			bn_new(s);
+			g1_new(p);
+
+			bn_zero(s);
 			for (int j = 0; j < flen[i]; j++) {
-				memcpy(str + strlen(id[i]), tag[j], strlen(tag[j]));
-				g1_map(h[j], str, strlen(id[i]) + strlen(tag[j]));
-				g1_add(h[j], h[j], d);
+				bn_add_dig(s, s, f[i][j]);
 			}
-			g1_norm_sim(h, h, slen);
-			g1_mul_sim_dig(g[i], h, f[i], flen[i]);
-			g1_mul_gen(h[0], mu[i]);
-			g1_add(g[i], g[i], h[0]);
+			bn_mod(s, s, n);
+			g1_mul_sim_dig(g[i], h + o[i], f[i], flen[i]);
+			g1_mul_sim_gen(p, mu[i], d[i], s);
+			g1_add(g[i], g[i], p);
+
+			bn_free(s);
+			g1_free(p);
 		}
 		g1_norm_sim(g, g, slen);
 
@@ -221,71 +301,192 @@ int cp_mklhs_ver(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[],
 	RLC_FINALLY {
 		bn_free(t);
 		bn_free(n);
-		g1_free(d);
 		g2_free(g2);
 		gt_free(c);
 		gt_free(e);
-		for (int j = 0; j < slen; j++) {
-			g1_free(g[j]);
-		}
-		for (int j = 0; j < fmax; j++) {
-			g1_free(h[j]);
+		for (i = 0; d != NULL && g != NULL && i < slen; i++) {
+			g1_free(d[i]);
+			g1_free(g[i]);
 		}
+		RLC_FREE(d);
 		RLC_FREE(g);
-		RLC_FREE(h);
+		RLC_FREE(o);
+		RLC_FREE(l);
+		RLC_FREE(ptr);
 		RLC_FREE(str);
 	}
 	return (ver1 && ver2);
 }
 
+int cp_mklhs_ver(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[],
+		char *tag[], dig_t *f[], int flen[], g2_t pk[], int slen) {
+	int i, total = 0, result = 0;
+	g1_t *h;
+
+	for (i = 0; i < slen; i++) {
+		total += flen[i];
+	}
+	h = RLC_ALLOCA(g1_t, RLC_MAX(total, 1));
+
+	RLC_TRY {
+		if (h == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < total; i++) {
+			g1_null(h[i]);
+			g1_new(h[i]);
+		}
+
+		if (cp_mklhs_lab(h, id, tag, flen, slen) == RLC_OK) {
+			result = cp_mklhs_ver_lab(sig, m, mu, data, id, h, f, flen, pk,
+					slen);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		for (i = 0; h != NULL && i < total; i++) {
+			g1_free(h[i]);
+		}
+		RLC_FREE(h);
+	}
+	return result;
+}
+
 int cp_mklhs_off(g1_t h[], dig_t ft[], char *id[], char *tag[], dig_t *f[],
 		int flen[],	int slen) {
-	int imax = 0, lmax = 0, fmax = 0, result = RLC_OK;
-	for (int i = 0; i < slen; i++) {
-		fmax = RLC_MAX(fmax, flen[i]);
-		imax = RLC_MAX(imax, strlen(id[i]));
-		for (int j = 0; j < flen[i]; j++) {
-			lmax = RLC_MAX(lmax, strlen(tag[j]));
-		}
+	int i, o, total = 0, result = RLC_OK;
+	g1_t *_h;
+
+	for (i = 0; i < slen; i++) {
+		total += flen[i];
 	}
-	g1_t *_h = RLC_ALLOCA(g1_t, fmax);
-	uint8_t *str = RLC_ALLOCA(uint8_t, imax + lmax);
+	_h = RLC_ALLOCA(g1_t, RLC_MAX(total, 1));
 
 	RLC_TRY {
-		if (_h == NULL || str == NULL) {
-			RLC_FREE(_h);
+		if (_h == NULL) {
 			RLC_THROW(ERR_NO_MEMORY);
 		}
-
-		for (int j = 0; j < fmax; j++) {
-			g1_null(_h[j]);
-			g1_new(_h[j]);
+		for (i = 0; i < total; i++) {
+			g1_null(_h[i]);
+			g1_new(_h[i]);
 		}
 
-		for (int i = 0; i < slen; i++) {
+		result = cp_mklhs_lab(_h, id, tag, flen, slen);
+
+		for (i = 0, o = 0; i < slen; o += flen[i], i++) {
 			ft[i] = 0;
-			memcpy(str, id[i], strlen(id[i]));
 			for (int j = 0; j < flen[i]; j++) {
-				memcpy(str + strlen(id[i]), tag[j], strlen(tag[j]));
-				g1_map(_h[j], str, strlen(id[i]) + strlen(tag[j]));
 				ft[i] += f[i][j];
 			}
-			g1_mul_sim_dig(h[i], _h, f[i], flen[i]);
+			g1_mul_sim_dig(h[i], _h + o, f[i], flen[i]);
 		}
 	}
 	RLC_CATCH_ANY {
 		result = RLC_ERR;
 	}
 	RLC_FINALLY {
-		for (int j = 0; j < fmax; j++) {
-			g1_free(_h[j]);
+		for (i = 0; _h != NULL && i < total; i++) {
+			g1_free(_h[i]);
 		}
 		RLC_FREE(_h);
-		RLC_FREE(str);
 	}
 	return result;
 }
 
+int cp_mklhs_off_key(uint8_t *key, char *id[], char *tag[], dig_t *f[],
+		int flen[], int slen) {
+	uint8_t buf[MKLHS_G1];
+	g1_t g;
+	md_t ctx;
+	int result = RLC_OK;
+
+	g1_null(g);
+
+	RLC_TRY {
+		g1_new(g);
+
+		/* Bind the cache to the curve through the generator of G_1. */
+		g1_get_gen(g);
+		g1_write_bin(buf, MKLHS_G1, g, 0);
+
+		/* Lengths are absorbed before contents, so the encoding is unique. */
+		md_init(ctx);
+		md_update(ctx, buf, MKLHS_G1);
+		md_update_int(ctx, slen);
+		for (int i = 0; i < slen; i++) {
+			md_update_int(ctx, strlen(id[i]));
+			md_update(ctx, (const uint8_t *)id[i], strlen(id[i]));
+			md_update_int(ctx, flen[i]);
+			for (int j = 0; j < flen[i]; j++) {
+				md_update_int(ctx, strlen(tag[j]));
+				md_update(ctx, (const uint8_t *)tag[j], strlen(tag[j]));
+				md_update_int(ctx, f[i][j]);
+			}
+		}
+		md_final(key, ctx);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		g1_free(g);
+	}
+	return result;
+}
+
+int cp_mklhs_off_size(int slen) {
+	return RLC_MD_LEN + slen * (MKLHS_G1 + 8);
+}
+
+int cp_mklhs_off_write(uint8_t *bin, int len, g1_t h[], dig_t ft[],
+		const uint8_t *key, int slen) {
+	if (len != cp_mklhs_off_size(slen)) {
+		RLC_THROW(ERR_NO_BUFFER);
+		return RLC_ERR;
+	}
+
+	memcpy(bin, key, RLC_MD_LEN);
+	bin += RLC_MD_LEN;
+	for (int i = 0; i < slen; i++) {
+		/* The point at infinity is written as a zero prefix and padding. */
+		g1_write_bin(bin, MKLHS_G1, h[i], 0);
+		mklhs_enc(bin + MKLHS_G1, ft[i]);
+		bin += MKLHS_G1 + 8;
+	}
+	return RLC_OK;
+}
+
+int cp_mklhs_off_read(g1_t h[], dig_t ft[], const uint8_t *bin, int len,
+		const uint8_t *key, int slen) {
+	uint64_t t;
+
+	/* A cache computed for another function or label set is stale. */
+	if (len != cp_mklhs_off_size(slen) ||
+			util_cmp_const(bin, key, RLC_MD_LEN) != RLC_EQ) {
+		return RLC_ERR;
+	}
+
+	bin += RLC_MD_LEN;
+	for (int i = 0; i < slen; i++) {
+		g1_read_bin(h[i], bin, bin[0] == 0 ? 1 : MKLHS_G1);
+		if (!g1_is_infty(h[i]) && !g1_is_valid(h[i])) {
+			return RLC_ERR;
+		}
+		t = 0;
+		for (int j = 0; j < 8; j++) {
+			t = (t << 8) | bin[MKLHS_G1 + j];
+		}
+		ft[i] = (dig_t)t;
+		if (ft[i] != t) {
+			return RLC_ERR;
+		}
+		bin += MKLHS_G1 + 8;
+	}
+	return RLC_OK;
+}
+
 int cp_mklhs_onv(g1_t sig, bn_t m, bn_t mu[], char *data, char *id[], g1_t h[],
 		dig_t ft[], g2_t pk[], int slen) {
 	bn_t t, n;
@@ -31,6 +31,85 @@
 
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Flags the elements of the receiver's set that match some pairing result.
+ * Flagged elements are skipped, so the answer can be processed in chunks.
+ *
+ * @param[in,out] hit		- the flags of the matched elements.
+ * @param[in] q				- the normalized interpolations in the exponent.
+ * @param[in] m				- the receiver's input set size.
+ * @param[in] t				- the pairing results.
+ * @param[in] u				- the missing elements in the exponent.
+ * @param[in] n				- the number of pairing results.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+static int pbpsi_match(int hit[], g2_t q[], int m, gt_t t[], g1_t u[],
+		int n) {
+	int j, result = RLC_OK;
+	int *idx = RLC_ALLOCA(int, n);
+	g1_t *p = RLC_ALLOCA(g1_t, n);
+
+	RLC_TRY {
+		if (idx == NULL || p == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (j = 0; j < n; j++) {
+			g1_null(p[j]);
+			g1_new(p[j]);
+		}
+
+		/* Normalize all points once instead of inside every pairing. */
+		g1_norm_sim(p, (const g1_t *)u, n);
+
+		/* Sets have no repeated elements, so each tag matches at most one
+		 * element of the receiver and the scan can stop at the first hit.
+		 * Threads only read the flags from previous calls and record their
+		 * match in idx[j], so that hit[] is updated after the loop. */
+#if MULTI == OPENMP
+		omp_set_num_threads(CORES);
+		#pragma omp parallel for copyin(core_ctx) schedule(dynamic)
+#endif
+		for (j = 0; j < n; j++) {
+			gt_t e;
+
+			gt_null(e);
+			gt_new(e);
+			idx[j] = -1;
+			for (int k = 0; k < m; k++) {
+				if (!hit[k]) {
+					pc_map(e, p[j], q[k]);
+					if (gt_cmp(e, t[j]) == RLC_EQ && !gt_is_unity(e)) {
+						idx[j] = k;
+						break;
+					}
+				}
+			}
+			gt_free(e);
+		}
+
+		for (j = 0; j < n; j++) {
+			if (idx[j] >= 0) {
+				hit[idx[j]] = 1;
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		for (j = 0; p != NULL && j < n; j++) {
+			g1_free(p[j]);
+		}
+		RLC_FREE(idx);
+		RLC_FREE(p);
+	}
+	return result;
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -114,36 +193,71 @@ int cp_pbpsi_ask(g2_t d[], bn_t r, bn_t x[], g2_t s[], int m) {
 
 int cp_pbpsi_ans(gt_t t[], g1_t u[], g1_t ss, g2_t d, bn_t y[], int n) {
 	int j, result = RLC_OK;
-	bn_t q, tj;
-	g1_t g1;
-	g2_t g2;
+	bn_t q, *r = RLC_ALLOCA(bn_t, n);
+	g1_t g1, tab[RLC_G1_TABLE];
+	gt_t e;
 	unsigned int *shuffle = RLC_ALLOCA(unsigned int, n);
 
 	bn_null(q);
-	bn_null(tj);
 	g1_null(g1);
-	g2_null(g2);
+	gt_null(e);
 
 	RLC_TRY {
 		bn_new(q);
-		bn_new(tj);
 		g1_new(g1);
-		g2_new(g2);
-		if (shuffle == NULL) {
+		gt_new(e);
+		if (shuffle == NULL || r == NULL) {
 			RLC_THROW(ERR_NO_MEMORY);
 		}
+		for (j = 0; j < RLC_G1_TABLE; j++) {
+			g1_null(tab[j]);
+			g1_new(tab[j]);
+		}
+		for (j = 0; j < n; j++) {
+			bn_null(r[j]);
+			bn_new(r[j]);
+		}
 
 		util_perm(shuffle, n);
 
 		pc_get_ord(q);
-		g2_get_gen(g2);
+		/* Draw all blinding factors before the loop, which may be threaded. */
+		bn_rand_mod_sim(r, n, q);
+		/* Since e(g1^t_j, d) = e(g1, d)^t_j, pair only once. */
+		g1_get_gen(g1);
+		pc_map(e, g1, d);
+		/* The secret power is fixed, so precompute it as the generator. */
+		g1_mul_pre(tab, ss);
+
+#if MULTI == OPENMP
+		omp_set_num_threads(CORES);
+		#pragma omp parallel for copyin(core_ctx) schedule(dynamic)
+#endif
 		for (j = 0; j < n; j++) {
-			bn_rand_mod(tj, q);
-			g1_mul_gen(g1, tj);
-			pc_map(t[j], g1, d);
-			g1_mul_gen(u[j], y[shuffle[j]]);
-			g1_sub(u[j], ss, u[j]);
-			g1_mul(u[j], u[j], tj);
+			bn_t k;
+			g1_t p;
+
+			bn_null(k);
+			g1_null(p);
+			bn_new(k);
+			g1_new(p);
+
+			gt_exp(t[j], e, r[j]);
+			/* Compute u_j = [t_j](ss - g1^y_j) = [t_j]ss + [-t_j * y_j]g1. */
+			bn_mul(k, r[j], y[shuffle[j]]);
+			bn_mod(k, k, q);
+			bn_sub(k, q, k);
+			g1_mul_gen(p, k);
+			g1_mul_fix(u[j], (const g1_t *)tab, r[j]);
+			g1_add(u[j], u[j], p);
+
+			bn_free(k);
+			g1_free(p);
+		}
+
+		/* Normalize all answers with a single inversion. */
+		if (n > 0) {
+			g1_norm_sim(u, (const g1_t *)u, n);
 		}
 	}
 	RLC_CATCH_ANY {
@@ -151,9 +265,15 @@ int cp_pbpsi_ans(gt_t t[], g1_t u[], g1_t ss, g2_t d, bn_t y[], int n) {
 	}
 	RLC_FINALLY {
 		bn_free(q);
-		bn_free(tj);
 		g1_free(g1);
-		g2_free(g2);
+		gt_free(e);
+		for (j = 0; j < RLC_G1_TABLE; j++) {
+			g1_free(tab[j]);
+		}
+		for (j = 0; r != NULL && j < n; j++) {
+			bn_free(r[j]);
+		}
+		RLC_FREE(r);
 		RLC_FREE(shuffle);
 	}
 	return result;
@@ -161,23 +281,29 @@ int cp_pbpsi_ans(gt_t t[], g1_t u[], g1_t ss, g2_t d, bn_t y[], int n) {
 
 int cp_pbpsi_int(bn_t z[], int *len, g2_t d[], bn_t x[], int m, gt_t t[],
 		g1_t u[], int n) {
-	int j, k, result = RLC_OK;
-	gt_t e;
-
-	gt_null(e);
+	int j, result = RLC_OK;
+	int *hit = RLC_ALLOCA(int, m);
+	g2_t *q = RLC_ALLOCA(g2_t, m);
 
 	RLC_TRY {
-		gt_new(e);
+		if (hit == NULL || q == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (j = 0; j < m; j++) {
+			g2_null(q[j]);
+			g2_new(q[j]);
+			hit[j] = 0;
+		}
 
 		*len = 0;
-		if (m > 0) {
-			for (k = 0; k < m; k++) {
-				for (j = 0; j < n; j++) {
-					pc_map(e, u[j], d[k + 1]);
-					if (gt_cmp(e, t[j]) == RLC_EQ && !gt_is_unity(e)) {
-						bn_copy(z[*len], x[k]);
-						(*len)++;
-					}
+		if (m > 0 && n > 0) {
+			/* Normalize all points once instead of inside every pairing. */
+			g2_norm_sim(q, d + 1, m);
+			result = pbpsi_match(hit, q, m, t, u, n);
+			for (j = 0; result == RLC_OK && j < m; j++) {
+				if (hit[j]) {
+					bn_copy(z[*len], x[j]);
+					(*len)++;
 				}
 			}
 		}
@@ -186,7 +312,196 @@ int cp_pbpsi_int(bn_t z[], int *len, g2_t d[], bn_t x[], int m, gt_t t[],
 		result = RLC_ERR;
 	}
 	RLC_FINALLY {
-		gt_free(e);
+		for (j = 0; q != NULL && j < m; j++) {
+			g2_free(q[j]);
+		}
+		RLC_FREE(hit);
+		RLC_FREE(q);
+	}
+	return result;
+}
+
+int cp_pbpsi_ans_strm(g1_t ss, g2_t d, int (*get)(bn_t *, int, void *),
+		int (*put)(const uint8_t *, size_t, void *), void *arg) {
+	int i, n, lt, lu, result = RLC_OK;
+	bn_t *y = RLC_ALLOCA(bn_t, RLC_CP_BATCH);
+	g1_t *u = RLC_ALLOCA(g1_t, RLC_CP_BATCH);
+	gt_t *t = RLC_ALLOCA(gt_t, RLC_CP_BATCH);
+	uint8_t *buf = NULL, *ptr;
+
+	if (y == NULL || u == NULL || t == NULL) {
+		RLC_FREE(y);
+		RLC_FREE(u);
+		RLC_FREE(t);
+		return RLC_ERR;
+	}
+
+	RLC_TRY {
+		for (i = 0; i < RLC_CP_BATCH; i++) {
+			bn_null(y[i]);
+			g1_null(u[i]);
+			gt_null(t[i]);
+			bn_new(y[i]);
+			g1_new(u[i]);
+			gt_new(t[i]);
+		}
+
+		/* Records have fixed size, so take it from the generators. */
+		g1_get_gen(u[0]);
+		gt_get_gen(t[0]);
+		lu = g1_size_bin(u[0], 1);
+		lt = gt_size_bin(t[0], 1);
+		buf = RLC_ALLOCA(uint8_t, 4 + RLC_CP_BATCH * (lt + lu));
+		if (buf == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+
+		do {
+			n = get(y, RLC_CP_BATCH, arg);
+			if (n < 0 || n > RLC_CP_BATCH) {
+				result = RLC_ERR;
+				break;
+			}
+			if (n > 0 && cp_pbpsi_ans(t, u, ss, d, y, n) != RLC_OK) {
+				result = RLC_ERR;
+				break;
+			}
+			buf[0] = (uint8_t)(n >> 24);
+			buf[1] = (uint8_t)(n >> 16);
+			buf[2] = (uint8_t)(n >> 8);
+			buf[3] = (uint8_t)n;
+			ptr = buf + 4;
+			for (i = 0; i < n; i++) {
+				gt_write_bin(ptr, lt, t[i], 1);
+				g1_write_bin(ptr + lt, lu, u[i], 1);
+				ptr += lt + lu;
+			}
+			/* Send each chunk as soon as it is ready, so the receiver can
+			 * start on it before the whole answer is computed. */
+			if (put(buf, ptr - buf, arg) != RLC_OK) {
+				result = RLC_ERR;
+				break;
+			}
+		} while (n > 0);
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		for (i = 0; i < RLC_CP_BATCH; i++) {
+			bn_free(y[i]);
+			g1_free(u[i]);
+			gt_free(t[i]);
+		}
+		RLC_FREE(buf);
+		RLC_FREE(y);
+		RLC_FREE(u);
+		RLC_FREE(t);
+	}
+	return result;
+}
+
+int cp_pbpsi_int_strm(bn_t z[], int *len, g2_t d[], bn_t x[], int m,
+		int (*get)(uint8_t *, size_t, void *), void *arg) {
+	int i, n, lt, lu, result = RLC_OK;
+	uint32_t c;
+	int *hit = RLC_ALLOCA(int, m);
+	g2_t *q = RLC_ALLOCA(g2_t, m);
+	g1_t *u = RLC_ALLOCA(g1_t, RLC_CP_BATCH);
+	gt_t *t = RLC_ALLOCA(gt_t, RLC_CP_BATCH);
+	uint8_t *buf = NULL, *ptr;
+
+	if ((m > 0 && (hit == NULL || q == NULL)) || u == NULL || t == NULL) {
+		RLC_FREE(hit);
+		RLC_FREE(q);
+		RLC_FREE(u);
+		RLC_FREE(t);
+		return RLC_ERR;
+	}
+
+	RLC_TRY {
+		for (i = 0; i < RLC_CP_BATCH; i++) {
+			g1_null(u[i]);
+			gt_null(t[i]);
+			g1_new(u[i]);
+			gt_new(t[i]);
+		}
+		for (i = 0; i < m; i++) {
+			g2_null(q[i]);
+			g2_new(q[i]);
+			hit[i] = 0;
+		}
+
+		g1_get_gen(u[0]);
+		gt_get_gen(t[0]);
+		lu = g1_size_bin(u[0], 1);
+		lt = gt_size_bin(t[0], 1);
+		buf = RLC_ALLOCA(uint8_t, RLC_CP_BATCH * (lt + lu));
+		if (buf == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+
+		/* The interpolations are the same for every chunk. */
+		if (m > 0) {
+			g2_norm_sim(q, d + 1, m);
+		}
+
+		*len = 0;
+		do {
+			if (get(buf, 4, arg) != RLC_OK) {
+				result = RLC_ERR;
+				break;
+			}
+			c = ((uint32_t)buf[0] << 24) | ((uint32_t)buf[1] << 16) |
+					((uint32_t)buf[2] << 8) | buf[3];
+			if (c > RLC_CP_BATCH) {
+				result = RLC_ERR;
+				break;
+			}
+			n = (int)c;
+			if (n > 0 && get(buf, n * (lt + lu), arg) != RLC_OK) {
+				result = RLC_ERR;
+				break;
+			}
+			ptr = buf;
+			for (i = 0; i < n; i++) {
+				gt_read_bin(t[i], ptr, lt);
+				/* A zero prefix encodes the point at infinity. */
+				g1_read_bin(u[i], ptr + lt, ptr[lt] == 0 ? 1 : lu);
+				ptr += lt + lu;
+			}
+			/* Matched elements stay flagged across chunks, so repeated tags
+			 * from the sender cannot duplicate them in the output. */
+			if (n > 0 && m > 0 &&
+					pbpsi_match(hit, q, m, t, u, n) != RLC_OK) {
+				result = RLC_ERR;
+				break;
+			}
+		} while (n > 0);
+
+		for (i = 0; result == RLC_OK && i < m; i++) {
+			if (hit[i]) {
+				bn_copy(z[*len], x[i]);
+				(*len)++;
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		result = RLC_ERR;
+	}
+	RLC_FINALLY {
+		for (i = 0; i < RLC_CP_BATCH; i++) {
+			g1_free(u[i]);
+			gt_free(t[i]);
+		}
+		for (i = 0; i < m; i++) {
+			g2_free(q[i]);
+		}
+		RLC_FREE(buf);
+		RLC_FREE(hit);
+		RLC_FREE(q);
+		RLC_FREE(u);
+		RLC_FREE(t);
 	}
 	return result;
 }
@@ -117,6 +117,7 @@ int cp_rsapsi_ans(bn_t t[], bn_t u[], bn_t d, bn_t g, bn_t n, bn_t y[], int l) {
 		}
 
 		util_perm(shuffle, l);
+		bn_rand_mod_sim(t, l, n);
 
 		for (j = 0; j < l; j++) {
 			bn_write_bin(bin, len, y[shuffle[j]]);
@@ -129,7 +130,6 @@ int cp_rsapsi_ans(bn_t t[], bn_t u[], bn_t d, bn_t g, bn_t n, bn_t y[], int l) {
 				bn_add_dig(p, p, 2);
 			} while (!bn_is_prime(p));
 			bn_mxp(p, g, p, n);
-			bn_rand_mod(t[j], n);
 			bn_mxp(u[j], p, t[j], n);
 			bn_mxp(t[j], d, t[j], n);
 		}
@@ -159,15 +159,16 @@ int cp_rsapsi_int(bn_t z[], int *len, bn_t r, bn_t p[], bn_t n, bn_t x[], int m,
 		*len = 0;
 		if (m > 0) {
 			for (j = 0; j < l; j++) {
+				/* Since each p_k is a large prime that divides the group order
+				 * with negligible probability, the test u_j^(r * P / p_k) = t_j
+				 * for P = prod p_i is equivalent to u_j^(r * P) = t_j^p_k. */
 				bn_mxp(f, u[j], r, n);
+				for (i = 0; i < m; i++) {
+					bn_mxp(f, f, p[i], n);
+				}
 				for (k = 0; k < m; k++) {
-					bn_copy(e, f);
-					for (i = 0; i < m; i++) {
-						if (i != k) {
-							bn_mxp(e, e, p[i], n);
-						}
-					}
-					if (bn_cmp(e, t[j]) == RLC_EQ) {
+					bn_mxp(e, t[j], p[k], n);
+					if (bn_cmp(e, f) == RLC_EQ) {
 						bn_copy(z[*len], x[k]);
 						(*len)++;
 					}
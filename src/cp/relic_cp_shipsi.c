@@ -40,6 +40,52 @@
  */
 #define STAT_SEC	(40)
 
+/**
+ * Computes c[k] = a^(p[0] * ... * p[m - 1] / p[k]) mod n for all k. Each half
+ * of the set is handed the base raised to the primes in the other half, so the
+ * whole vector costs O(m log m) exponentiations by single primes instead of
+ * O(m^2).
+ *
+ * @param[out] c			- the resulting powers.
+ * @param[in] a				- the base.
+ * @param[in] p				- the primes.
+ * @param[in] m				- the number of primes.
+ * @param[in] n				- the modulus.
+ */
+static void shipsi_abo(bn_t c[], const bn_t a, bn_t p[], int m, bn_t n) {
+	int i, h = m / 2;
+	bn_t b;
+
+	if (m == 1) {
+		bn_copy(c[0], a);
+		return;
+	}
+
+	bn_null(b);
+
+	RLC_TRY {
+		bn_new(b);
+
+		bn_copy(b, a);
+		for (i = h; i < m; i++) {
+			bn_mxp(b, b, p[i], n);
+		}
+		shipsi_abo(c, b, p, h, n);
+
+		bn_copy(b, a);
+		for (i = 0; i < h; i++) {
+			bn_mxp(b, b, p[i], n);
+		}
+		shipsi_abo(c + h, b, p + h, m - h, n);
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(b);
+	}
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -170,29 +216,53 @@ int cp_shipsi_ans(bn_t t[], bn_t u, bn_t d, bn_t g, crt_t crt, bn_t y[], int n)
 
 int cp_shipsi_int(bn_t z[], int *len, bn_t r, bn_t p[], bn_t n, bn_t x[], int m,
 		bn_t t[], bn_t u, int l) {
-	int i, j, k, result = RLC_OK;
-	bn_t e, f;
+	int j, k, size, result = RLC_OK;
+	bn_t f, *e = RLC_ALLOCA(bn_t, m);
+	int *table;
+	dig_t h;
+
+	/* Open addressing table with at least twice as many slots as entries. */
+	size = 1;
+	while (size < 2 * m) {
+		size <<= 1;
+	}
+	table = RLC_ALLOCA(int, size);
 
-	bn_null(e);
 	bn_null(f);
 
 	RLC_TRY {
-		bn_new(e);
 		bn_new(f);
+		if ((m > 0 && e == NULL) || table == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (k = 0; k < m; k++) {
+			bn_null(e[k]);
+			bn_new(e[k]);
+		}
 
 		*len = 0;
 		if (m > 0) {
+			/* Compute e_k = u^(r * prod_{i != k} p_i) once for all k. */
 			bn_mxp(f, u, r, n);
+			shipsi_abo(e, f, p, m, n);
+
+			/* Index them by their least significant digit, which is uniform. */
+			memset(table, 0, size * sizeof(int));
+			for (k = 0; k < m; k++) {
+				bn_get_dig(&h, e[k]);
+				j = h & (size - 1);
+				while (table[j] != 0) {
+					j = (j + 1) & (size - 1);
+				}
+				table[j] = k + 1;
+			}
+
+			/* Stream the server tags through the table. */
 			for (j = 0; j < l; j++) {
-				for (k = 0; k < m; k++) {
-					bn_copy(e, f);
-					for (i = 0; i < m; i++) {
-						if (i != k) {
-							bn_mxp(e, e, p[i], n);
-						}
-					}
-					if (bn_cmp(e, t[j]) == RLC_EQ) {
-						bn_copy(z[*len], x[k]);
+				bn_get_dig(&h, t[j]);
+				for (k = h & (size - 1); table[k] != 0; k = (k + 1) & (size - 1)) {
+					if (bn_cmp(e[table[k] - 1], t[j]) == RLC_EQ) {
+						bn_copy(z[*len], x[table[k] - 1]);
 						(*len)++;
 					}
 				}
@@ -203,8 +273,12 @@ int cp_shipsi_int(bn_t z[], int *len, bn_t r, bn_t p[], bn_t n, bn_t x[], int m,
 		result = RLC_ERR;
 	}
 	RLC_FINALLY {
-		bn_free(e);
 		bn_free(f);
+		for (k = 0; k < m; k++) {
+			bn_free(e[k]);
+		}
+		RLC_FREE(e);
+		RLC_FREE(table);
 	}
 	return result;
 }
@@ -74,55 +74,61 @@ int cp_smlers_sig(bn_t td, smlers_t p, uint8_t *msg, int len, bn_t sk, ec_t pk,
 }
 
 int cp_smlers_ver(bn_t td, smlers_t *s, int size, uint8_t *msg, int len, ec_t pp) {
-	bn_t n;
-	ec_t t, g[2], y[2];
-	int flag = 0, result = 0;
+	bn_t **c = RLC_ALLOCA(bn_t *, 2 * size), **r = RLC_ALLOCA(bn_t *, 2 * size);
+	ec_t t, g[2], *y = RLC_ALLOCA(ec_t, 4 * size);
+	int i, result = 0;
 
-	bn_null(n);
 	ec_null(t);
 	ec_null(g[0]);
 	ec_null(g[1]);
-	ec_null(y[0]);
-	ec_null(y[1]);
 
 	RLC_TRY {
-		bn_new(n);
 		ec_new(t);
 		ec_new(g[0]);
 		ec_new(g[1]);
-		ec_new(y[0]);
-		ec_new(y[1]);
+		if (c == NULL || r == NULL || y == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < 4 * size; i++) {
+			ec_null(y[i]);
+			ec_new(y[i]);
+		}
 
-		ec_curve_get_ord(n);
 		ec_mul_gen(t, td);
 		ec_curve_get_gen(g[0]);
 		ec_map(g[1], msg, len);
 
-		for (int i = 0; i < size; i++) {
-            ec_add(t, t, s[i]->sig->h);
-        }
+		/* Proofs for the keys come first, then proofs for the tags. */
+		for (i = 0; i < size; i++) {
+			ec_add(t, t, s[i]->sig->h);
+			ec_copy(y[2 * i], s[i]->sig->h);
+			ec_copy(y[2 * i + 1], s[i]->sig->pk);
+			ec_copy(y[2 * (size + i)], s[i]->sig->h);
+			ec_copy(y[2 * (size + i) + 1], s[i]->tau);
+			c[i] = s[i]->sig->c;
+			r[i] = s[i]->sig->r;
+			c[size + i] = s[i]->c;
+			r[size + i] = s[i]->r;
+		}
 		if (ec_cmp(pp, t) == RLC_EQ) {
-			flag = 1;
-			for (int i = 0; i < size; i++) {
-				ec_copy(y[0], s[i]->sig->h);
-				ec_copy(y[1], s[i]->sig->pk);
-				flag &= cp_sokor_ver(s[i]->sig->c, s[i]->sig->r, msg, len, y, NULL);
-				ec_copy(y[1], s[i]->tau);
-				flag &= cp_sokor_ver(s[i]->c, s[i]->r, msg, len, y, g);
-	        }
+			result = cp_sokor_ver_sim(c, r, msg, len, y, NULL, size) &&
+					cp_sokor_ver_sim(c + size, r + size, msg, len,
+					y + 2 * size, g, size);
 		}
-		result = flag;
 	}
 	RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	}
 	RLC_FINALLY {
-		bn_free(n);
 		ec_free(t);
 		ec_free(g[0]);
 		ec_free(g[1]);
-		ec_free(y[0]);
-		ec_free(y[1]);
+		for (i = 0; y != NULL && i < 4 * size; i++) {
+			ec_free(y[i]);
+		}
+		RLC_FREE(c);
+		RLC_FREE(r);
+		RLC_FREE(y);
 	}
 	return result;
 }
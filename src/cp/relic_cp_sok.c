@@ -31,6 +31,24 @@
 
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Absorbs the compressed encoding of a point into a hash computation.
+ *
+ * @param[in,out] ctx		- the hash state.
+ * @param[in] p				- the point to absorb.
+ */
+static void sok_update(md_t ctx, const ec_t p) {
+	uint8_t buf[RLC_FC_BYTES + 1];
+	int l = ec_size_bin(p, 1);
+
+	ec_write_bin(buf, l, p, 1);
+	md_update(ctx, buf, l);
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -44,8 +62,8 @@ int cp_sokdl_sig(bn_t c, bn_t s, uint8_t *msg, int len, ec_t y, bn_t x) {
 	bn_t n, r;
 	ec_t t;
 	uint8_t h[RLC_MD_LEN];
-	uint8_t *buf, *m = RLC_ALLOCA(uint8_t, len + 3 * (RLC_FC_BYTES + 1));
-	int l, result = RLC_OK;
+	md_t ctx;
+	int result = RLC_OK;
 
 	bn_null(n);
 	bn_null(r);
@@ -55,29 +73,18 @@ int cp_sokdl_sig(bn_t c, bn_t s, uint8_t *msg, int len, ec_t y, bn_t x) {
 		bn_new(n);
 		bn_new(r);
 		ec_new(t);
-		if (m == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
 
-		buf = m;
 		ec_curve_get_ord(n);
 		ec_curve_get_gen(t);
-		memcpy(buf, msg, len);
-		buf += len;
-		l = ec_size_bin(t, 1);
-		ec_write_bin(buf, l, t, 1);
-		buf += l;
-		l = ec_size_bin(y, 1);
-		ec_write_bin(buf, l, y, 1);
-		buf += l;
+		md_init(ctx);
+		md_update(ctx, msg, len);
+		sok_update(ctx, t);
+		sok_update(ctx, y);
 
 		bn_rand_mod(r, n);
 		ec_mul_gen(t, r);
-		l = ec_size_bin(t, 1);
-		ec_write_bin(buf, l, t, 1);
-		buf += l;
-
-		md_map(h, m, len + 3 * (RLC_FC_BYTES + 1));
+		sok_update(ctx, t);
+		md_final(h, ctx);
 		bn_read_bin(c, h, RLC_MD_LEN);
 		bn_mod(c, c, n);
 
@@ -92,7 +99,6 @@ int cp_sokdl_sig(bn_t c, bn_t s, uint8_t *msg, int len, ec_t y, bn_t x) {
 		bn_free(n);
 		bn_free(r);
 		ec_free(t);
-		RLC_FREE(m);
 	}
 	return result;
 }
@@ -101,8 +107,8 @@ int cp_sokdl_ver(bn_t c, bn_t s, uint8_t *msg, int len, ec_t y) {
 	bn_t n, v;
 	ec_t t;
 	uint8_t h[RLC_MD_LEN];
-	uint8_t *buf, *m = RLC_ALLOCA(uint8_t, len + 3 * (RLC_FC_BYTES + 1));
-	int l, result = 0;
+	md_t ctx;
+	int result = 0;
 
 	bn_null(n);
 	bn_null(v);
@@ -112,28 +118,18 @@ int cp_sokdl_ver(bn_t c, bn_t s, uint8_t *msg, int len, ec_t y) {
 		bn_new(n);
 		bn_new(v);
 		ec_new(t);
-		if (m == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
 
-		buf = m;
 		ec_curve_get_ord(n);
 		ec_curve_get_gen(t);
-		memcpy(buf, msg, len);
-		buf += len;
-		l = ec_size_bin(t, 1);
-		ec_write_bin(buf, l, t, 1);
-		buf += l;
-		l = ec_size_bin(y, 1);
-		ec_write_bin(buf, l, y, 1);
-		buf += l;
+		md_init(ctx);
+		md_update(ctx, msg, len);
+		sok_update(ctx, t);
+		sok_update(ctx, y);
 
 		/* Compute t' = [r]G + [c]Y. */
 		ec_mul_sim_gen(t, s, y, c);
-		l = ec_size_bin(t, 1);
-		ec_write_bin(buf, l, t, 1);
-
-		md_map(h, m, len + 3 * (RLC_FC_BYTES + 1));
+		sok_update(ctx, t);
+		md_final(h, ctx);
 		bn_read_bin(v, h, RLC_MD_LEN);
 		bn_mod(v, v, n);
 
@@ -148,7 +144,6 @@ int cp_sokdl_ver(bn_t c, bn_t s, uint8_t *msg, int len, ec_t y) {
 		bn_free(n);
 		bn_free(v);
 		ec_free(t);
-		RLC_FREE(m);
 	}
 	return result;
 }
@@ -158,8 +153,8 @@ int cp_sokor_sig(bn_t c[2], bn_t s[2], uint8_t *msg, int len, ec_t y[2],
 	bn_t n, v[2], z;
 	ec_t u, t[2];
 	uint8_t h[RLC_MD_LEN];
-	uint8_t *buf, *m = RLC_ALLOCA(uint8_t, len + 6 * (RLC_FC_BYTES + 1));
-	int l, result = RLC_OK;
+	md_t ctx;
+	int result = RLC_OK;
 	int one = 1 ^ first;
 	int zero = 0 ^ first;
 
@@ -179,15 +174,11 @@ int cp_sokor_sig(bn_t c[2], bn_t s[2], uint8_t *msg, int len, ec_t y[2],
 		ec_new(u);
 		ec_new(t[0]);
 		ec_new(t[1]);
-		if (m == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
 
-		buf = m;
 		ec_curve_get_ord(n);
 		bn_rand_mod(c[zero], n);
-		memcpy(buf, msg, len);
-		buf += len;
+		md_init(ctx);
+		md_update(ctx, msg, len);
 
 		bn_rand_mod(v[0], n);
 		bn_rand_mod(v[1], n);
@@ -218,17 +209,11 @@ int cp_sokor_sig(bn_t c[2], bn_t s[2], uint8_t *msg, int len, ec_t y[2],
 			if (g != NULL) {
 				ec_copy(u, g[i]);
 			}
-			l = ec_size_bin(u, 1);
-			ec_write_bin(buf, l, u, 1);
-			buf += l;
-			l = ec_size_bin(y[i], 1);
-			ec_write_bin(buf, l, y[i], 1);
-			buf += l;
-			l = ec_size_bin(t[i], 1);
-			ec_write_bin(buf, l, t[i], 1);
-			buf += l;
+			sok_update(ctx, u);
+			sok_update(ctx, y[i]);
+			sok_update(ctx, t[i]);
 		}
-		md_map(h, m, len + 6 * (RLC_FC_BYTES + 1));
+		md_final(h, ctx);
 		bn_read_bin(z, h, RLC_MD_LEN);
 		bn_mod(z, z, n);
 
@@ -251,7 +236,6 @@ int cp_sokor_sig(bn_t c[2], bn_t s[2], uint8_t *msg, int len, ec_t y[2],
 		ec_free(u);
 		ec_free(t[0]);
 		ec_free(t[1]);
-		RLC_FREE(m);
 	}
 	return result;
 }
@@ -261,8 +245,8 @@ int cp_sokor_ver(bn_t c[2], bn_t s[2], uint8_t *msg, int len, ec_t y[2],
 	bn_t n, v[2], z;
 	ec_t t;
 	uint8_t h[RLC_MD_LEN];
-	uint8_t *buf, *m = RLC_ALLOCA(uint8_t, len + 6 * (RLC_FC_BYTES + 1));
-	int l, result = 0;
+	md_t ctx;
+	int result = 0;
 
 	bn_null(n);
 	bn_null(v[0]);
@@ -276,14 +260,10 @@ int cp_sokor_ver(bn_t c[2], bn_t s[2], uint8_t *msg, int len, ec_t y[2],
 		bn_new(v[1]);
 		bn_new(z);
 		ec_new(t);
-		if (m == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
 
-		buf = m;
 		ec_curve_get_ord(n);
-		memcpy(buf, msg, len);
-		buf += len;
+		md_init(ctx);
+		md_update(ctx, msg, len);
 
 		for (int i = 0; i < 2; i++) {
 			if (g != NULL) {
@@ -291,22 +271,16 @@ int cp_sokor_ver(bn_t c[2], bn_t s[2], uint8_t *msg, int len, ec_t y[2],
 			} else {
 				ec_curve_get_gen(t);
 			}
-			l = ec_size_bin(t, 1);
-			ec_write_bin(buf, l, t, 1);
-			buf += l;
-			l = ec_size_bin(y[i], 1);
-			ec_write_bin(buf, l, y[i], 1);
-			buf += l;
+			sok_update(ctx, t);
+			sok_update(ctx, y[i]);
 			if (g != NULL) {
 				ec_mul_sim(t, g[i], s[i], y[i], c[i]);
 			} else {
 				ec_mul_sim_gen(t, s[i], y[i], c[i]);
 			}
-			l = ec_size_bin(t, 1);
-			ec_write_bin(buf, l, t, 1);
-			buf += l;
+			sok_update(ctx, t);
 		}
-		md_map(h, m, len + 6 * (RLC_FC_BYTES + 1));
+		md_final(h, ctx);
 		bn_read_bin(z, h, RLC_MD_LEN);
 		bn_mod(z, z, n);
 
@@ -327,7 +301,84 @@ int cp_sokor_ver(bn_t c[2], bn_t s[2], uint8_t *msg, int len, ec_t y[2],
 		bn_free(v[1]);
 		bn_free(z);
 		ec_free(t);
-		RLC_FREE(m);
+	}
+	return result;
+}
+
+int cp_sokor_ver_sim(bn_t *c[], bn_t *r[], uint8_t *msg, int len, ec_t y[],
+		ec_t g[2], int n) {
+	bn_t m;
+	ec_t t;
+	uint8_t buf[2][RLC_FC_BYTES + 1];
+	int i, l[2], result = 1;
+	md_t ctx;
+
+	bn_null(m);
+	ec_null(t);
+
+	RLC_TRY {
+		bn_new(m);
+		ec_new(t);
+
+		ec_curve_get_ord(m);
+		/* The message and the generators are common to all proofs. */
+		md_init(ctx);
+		md_update(ctx, msg, len);
+		for (i = 0; i < 2; i++) {
+			if (g != NULL) {
+				ec_copy(t, g[i]);
+			} else {
+				ec_curve_get_gen(t);
+			}
+			l[i] = ec_size_bin(t, 1);
+			ec_write_bin(buf[i], l[i], t, 1);
+		}
+
+#if MULTI == OPENMP
+		omp_set_num_threads(CORES);
+		#pragma omp parallel for copyin(core_ctx) reduction(&:result)
+#endif
+		for (i = 0; i < n; i++) {
+			uint8_t h[RLC_MD_LEN];
+			md_t s;
+			bn_t z;
+			ec_t p;
+
+			bn_null(z);
+			ec_null(p);
+			bn_new(z);
+			ec_new(p);
+
+			memcpy(s, ctx, sizeof(md_t));
+			for (int j = 0; j < 2; j++) {
+				md_update(s, buf[j], l[j]);
+				sok_update(s, y[2 * i + j]);
+				if (g != NULL) {
+					ec_mul_sim(p, g[j], r[i][j], y[2 * i + j], c[i][j]);
+				} else {
+					ec_mul_sim_gen(p, r[i][j], y[2 * i + j], c[i][j]);
+				}
+				sok_update(s, p);
+			}
+			md_final(h, s);
+			bn_read_bin(z, h, RLC_MD_LEN);
+			bn_mod(z, z, m);
+
+			bn_sub(z, z, c[i][0]);
+			bn_sub(z, z, c[i][1]);
+			bn_mod(z, z, m);
+			result &= bn_is_zero(z);
+
+			bn_free(z);
+			ec_free(p);
+		}
+	}
+	RLC_CATCH_ANY {
+		result = 0;
+	}
+	RLC_FINALLY {
+		bn_free(m);
+		ec_free(t);
 	}
 	return result;
 }
@@ -0,0 +1,223 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+
+/**
+ * @file
+ *
+ * Implementation of encrypted streams sealed in chunks.
+ *
+ * Each chunk of RLC_CP_CHUNK bytes is sealed with AES-GCM under a nonce
+ * holding its index and a flag marking the last chunk, as in the STREAM
+ * construction of Hoang, Reyhanitabar, Rogaway and Vizar. Chunks cannot be
+ * reordered or dropped, and a truncated stream fails to authenticate.
+ *
+ * @ingroup cp
+ */
+
+#include "relic.h"
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Returns the number of input bytes consumed by each chunk.
+ *
+ * @param[in] s				- the stream.
+ */
+#define STRM_IN(S)			((S)->dec ? RLC_CP_CHUNK + RLC_BC_TAG : RLC_CP_CHUNK)
+
+/**
+ * Returns the number of output bytes produced by each chunk.
+ *
+ * @param[in] s				- the stream.
+ */
+#define STRM_OUT(S)			((S)->dec ? RLC_CP_CHUNK : RLC_CP_CHUNK + RLC_BC_TAG)
+
+/**
+ * Seals or opens a chunk of a stream.
+ *
+ * @param[out] out			- the output.
+ * @param[in] in			- the input.
+ * @param[in] len			- the number of input bytes.
+ * @param[in,out] s			- the stream.
+ * @param[in] last			- the flag indicating the last chunk.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+static int strm_chunk(uint8_t *out, const uint8_t *in, size_t len, strm_t s,
+		int last) {
+	uint8_t iv[RLC_BC_IV] = { 0 };
+	int l = RLC_CP_CHUNK + RLC_BC_TAG;
+
+	/* The nonce is 0^56 || seq || last, so that chunks cannot be reordered. */
+	for (int i = 0; i < 4; i++) {
+		iv[RLC_BC_IV - 2 - i] = (uint8_t)(s->seq >> (8 * i));
+	}
+	iv[RLC_BC_IV - 1] = (uint8_t)last;
+	if (s->seq == UINT32_MAX) {
+		return RLC_ERR;
+	}
+	s->seq++;
+	if (s->dec) {
+		return bc_aes_gcm_dec(out, &l, in, (int)len, NULL, 0, s->key, iv);
+	}
+	return bc_aes_gcm_enc(out, &l, in, (int)len, NULL, 0, s->key, iv);
+}
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+int cp_strm_init(strm_t s, const uint8_t *key, int key_len, int dec) {
+	if (bc_aes_key(s->key, key, key_len) != RLC_OK) {
+		s->end = 1;
+		return RLC_ERR;
+	}
+	s->len = 0;
+	s->seq = 0;
+	s->dec = (dec != 0);
+	s->end = 0;
+	return RLC_OK;
+}
+
+size_t cp_strm_size(const strm_t s, size_t in_len) {
+	size_t total = s->len + in_len;
+
+	/* The last chunk is kept until more input arrives or the stream ends. */
+	if (total == 0) {
+		return 0;
+	}
+	return ((total - 1) / STRM_IN(s)) * STRM_OUT(s);
+}
+
+int cp_strm_updatev(const strm_iov_t *out, int out_cnt, size_t *out_len,
+		const uint8_t *in, size_t in_len, strm_t s) {
+	size_t n, l, m, off = 0, room = 0, need = cp_strm_size(s, in_len);
+	const uint8_t *src;
+	uint8_t *dst;
+	int i, j = 0;
+
+	*out_len = 0;
+	if (s->end) {
+		return RLC_ERR;
+	}
+	for (i = 0; i < out_cnt && room < need; i++) {
+		room += out[i].len;
+	}
+	if (room < need) {
+		return RLC_ERR;
+	}
+
+	for (n = need / STRM_OUT(s); n > 0; n--) {
+		if (s->len == 0 && in_len >= STRM_IN(s)) {
+			/* Process the chunk directly from the input. */
+			src = in;
+			in += STRM_IN(s);
+			in_len -= STRM_IN(s);
+		} else {
+			l = STRM_IN(s) - s->len;
+			memcpy(s->buf + s->len, in, l);
+			in += l;
+			in_len -= l;
+			src = s->buf;
+		}
+		s->len = 0;
+
+		while (j < out_cnt && off == out[j].len) {
+			j++;
+			off = 0;
+		}
+		/* Write the chunk in place if it fits in the current buffer. */
+		if (out[j].len - off >= STRM_OUT(s)) {
+			dst = out[j].buf + off;
+		} else {
+			dst = s->buf;
+		}
+		if (strm_chunk(dst, src, STRM_IN(s), s, 0) != RLC_OK) {
+			cp_strm_clean(s);
+			return RLC_ERR;
+		}
+		if (dst != s->buf) {
+			off += STRM_OUT(s);
+		} else {
+			/* Otherwise, spread it over the next buffers. */
+			for (l = 0; l < STRM_OUT(s); l += m) {
+				while (off == out[j].len) {
+					j++;
+					off = 0;
+				}
+				m = RLC_MIN(STRM_OUT(s) - l, out[j].len - off);
+				memcpy(out[j].buf + off, s->buf + l, m);
+				off += m;
+			}
+		}
+		*out_len += STRM_OUT(s);
+	}
+
+	memcpy(s->buf + s->len, in, in_len);
+	s->len += in_len;
+	return RLC_OK;
+}
+
+int cp_strm_update(uint8_t *out, size_t *out_len, const uint8_t *in,
+		size_t in_len, strm_t s) {
+	strm_iov_t iov;
+
+	iov.buf = out;
+	iov.len = *out_len;
+	return cp_strm_updatev(&iov, 1, out_len, in, in_len, s);
+}
+
+int cp_strm_final(uint8_t *out, size_t *out_len, strm_t s) {
+	size_t l;
+	int result = RLC_OK;
+
+	if (s->end || (s->dec && s->len < RLC_BC_TAG)) {
+		cp_strm_clean(s);
+		return RLC_ERR;
+	}
+	l = (s->dec ? s->len - RLC_BC_TAG : s->len + RLC_BC_TAG);
+	if (*out_len < l) {
+		/* Keep the stream open, so the caller can retry with more room. */
+		*out_len = l;
+		return RLC_ERR;
+	}
+	if (strm_chunk(s->buf, s->buf, s->len, s, 1) != RLC_OK) {
+		result = RLC_ERR;
+	} else {
+		memcpy(out, s->buf, l);
+		*out_len = l;
+	}
+	cp_strm_clean(s);
+	return result;
+}
+
+void cp_strm_clean(strm_t s) {
+	if (s->buf != NULL) {
+		memset(s->buf, 0, RLC_CP_CHUNK + RLC_BC_TAG);
+	}
+	memset(s->key, 0, sizeof(aes_t));
+	s->len = 0;
+	s->end = 1;
+}
@@ -34,6 +34,24 @@
 
 #include "relic.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Absorbs the compressed encoding of a point into a hash computation.
+ *
+ * @param[in,out] ctx		- the hash state.
+ * @param[in] p				- the point to absorb.
+ */
+static void vbnn_update(md_t ctx, const ec_t p) {
+	uint8_t buf[RLC_FC_BYTES + 1];
+	int l = ec_size_bin(p, 1);
+
+	ec_write_bin(buf, l, p, 1);
+	md_update(ctx, buf, l);
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -72,8 +90,8 @@ int cp_vbnn_gen(bn_t msk, ec_t mpk) {
 
 int cp_vbnn_gen_prv(bn_t sk, ec_t pk, bn_t msk, uint8_t *id, int id_len) {
 	uint8_t hash[RLC_MD_LEN];
-	int len, result = RLC_OK;
-	uint8_t *buf = NULL;
+	int result = RLC_OK;
+	md_t ctx;
 	bn_t n, r;
 
 	/* zero variables */
@@ -95,15 +113,10 @@ int cp_vbnn_gen_prv(bn_t sk, ec_t pk, bn_t msk, uint8_t *id, int id_len) {
 		ec_mul_gen(pk, r);
 
 		/* calculate s part of the user key */
-		len = id_len + ec_size_bin(pk, 1);
-		buf = RLC_ALLOCA(uint8_t, len);
-		if (buf == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
-		memcpy(buf, id, id_len);
-		ec_write_bin(buf + id_len, ec_size_bin(pk, 1), pk, 1);
-
-		md_map(hash, buf, len);
+		md_init(ctx);
+		md_update(ctx, id, id_len);
+		vbnn_update(ctx, pk);
+		md_final(hash, ctx);
 		bn_read_bin(sk, hash, RLC_MD_LEN);
 		bn_mod(sk, sk, n);
 		bn_mul(sk, sk, msk);
@@ -117,15 +130,15 @@ int cp_vbnn_gen_prv(bn_t sk, ec_t pk, bn_t msk, uint8_t *id, int id_len) {
 		/* free variables */
 		bn_free(n);
 		bn_free(r);
-		RLC_FREE(buf);
 	}
 	return result;
 }
 
 int cp_vbnn_sig(ec_t r, bn_t z, bn_t h, uint8_t *id, int id_len,
 		uint8_t *msg, int msg_len, bn_t sk, ec_t pk) {
-	int len, result = RLC_OK;
-	uint8_t *buf = NULL, *buf_i, hash[RLC_MD_LEN];
+	int result = RLC_OK;
+	uint8_t hash[RLC_MD_LEN];
+	md_t ctx;
 	bn_t n, y;
 	ec_t t;
 
@@ -146,22 +159,12 @@ int cp_vbnn_sig(ec_t r, bn_t z, bn_t h, uint8_t *id, int id_len,
 		ec_mul_gen(t, y);
 
 		/* calculate h part of the signature */
-		len = id_len + msg_len + ec_size_bin(t, 1) + ec_size_bin(pk, 1);
-		buf = RLC_ALLOCA(uint8_t, len);
-		if (buf == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
-
-		buf_i = buf;
-		memcpy(buf_i, id, id_len);
-		buf_i += id_len;
-		memcpy(buf_i, msg, msg_len);
-		buf_i += msg_len;
-		ec_write_bin(buf_i, ec_size_bin(pk, 1), pk, 1);
-		buf_i += ec_size_bin(pk, 1);
-		ec_write_bin(buf_i, ec_size_bin(t, 1), t, 1);
-
-		md_map(hash, buf, len);
+		md_init(ctx);
+		md_update(ctx, id, id_len);
+		md_update(ctx, msg, msg_len);
+		vbnn_update(ctx, pk);
+		vbnn_update(ctx, t);
+		md_final(hash, ctx);
 		bn_read_bin(h, hash, RLC_MD_LEN);
 		bn_mod(h, h, n);
 
@@ -181,15 +184,15 @@ int cp_vbnn_sig(ec_t r, bn_t z, bn_t h, uint8_t *id, int id_len,
 		bn_free(n);
 		bn_free(y);
 		ec_free(t);
-		RLC_FREE(buf);
 	}
 	return result;
 }
 
 int cp_vbnn_ver(ec_t r, bn_t z, bn_t h, uint8_t *id, int id_len,
 		uint8_t *msg, int msg_len, ec_t mpk) {
-	int len, result = 0;
-	uint8_t *buf = NULL, *buf_i, hash[RLC_MD_LEN];
+	int result = 0;
+	uint8_t hash[RLC_MD_LEN];
+	md_t ctx;
 	bn_t n, c, _h;
 	ec_t Z;
 	ec_t t;
@@ -208,23 +211,14 @@ int cp_vbnn_ver(ec_t r, bn_t z, bn_t h, uint8_t *id, int id_len,
 		ec_new(Z);
 		ec_new(t);
 
-		/* calculate c */
-		len = id_len + msg_len + 2 * ec_size_bin(r, 1);
-		buf = RLC_ALLOCA(uint8_t, len);
-		if (buf == NULL) {
-			RLC_THROW(ERR_NO_MEMORY);
-		}
-
 		/* get order of ECC group */
 		ec_curve_get_ord(n);
 
-		buf_i = buf;
-		memcpy(buf_i, id, id_len);
-		buf_i += id_len;
-		ec_write_bin(buf_i, ec_size_bin(r, 1), r, 1);
-
-		len = id_len + ec_size_bin(r, 1);
-		md_map(hash, buf, len);
+		/* calculate c */
+		md_init(ctx);
+		md_update(ctx, id, id_len);
+		vbnn_update(ctx, r);
+		md_final(hash, ctx);
 		bn_read_bin(c, hash, RLC_MD_LEN);
 		bn_mod(c, c, n);
 
@@ -238,20 +232,14 @@ int cp_vbnn_ver(ec_t r, bn_t z, bn_t h, uint8_t *id, int id_len,
 		ec_norm(Z, Z);
 
 		/* calculate h_verify */
-		buf_i = buf;
-		memcpy(buf_i, id, id_len);
-		buf_i += id_len;
-		memcpy(buf_i, msg, msg_len);
-		buf_i += msg_len;
-		ec_write_bin(buf_i, ec_size_bin(r, 1), r, 1);
-		buf_i += ec_size_bin(r, 1);
-		ec_write_bin(buf_i, ec_size_bin(Z, 1), Z, 1);
-
-		len = id_len + msg_len + ec_size_bin(r, 1) + ec_size_bin(Z, 1);
-		md_map(hash, buf, len);
+		md_init(ctx);
+		md_update(ctx, id, id_len);
+		md_update(ctx, msg, msg_len);
+		vbnn_update(ctx, r);
+		vbnn_update(ctx, Z);
+		md_final(hash, ctx);
 		bn_read_bin(_h, hash, RLC_MD_LEN);
 		bn_mod(_h, _h, n);
-		RLC_FREE(buf);
 
 		if (bn_cmp(h, _h) == RLC_EQ) {
 			result = 1;
@@ -269,7 +257,6 @@ int cp_vbnn_ver(ec_t r, bn_t z, bn_t h, uint8_t *id, int id_len,
 		bn_free(_h);
 		ec_free(Z);
 		ec_free(t);
-		RLC_FREE(buf);
 	}
 	return result;
 }
@@ -64,57 +64,57 @@ static void detect_opt(int *opt, fb_t a) {
 /*============================================================================*/
 
 void eb_curve_init(void) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 #ifdef EB_PRECO
 	for (int i = 0; i < RLC_EB_TABLE; i++) {
-		ctx->eb_ptr[i] = &(ctx->eb_pre[i]);
+		par->eb_ptr[i] = &(par->eb_pre[i]);
 	}
 #endif
-	fb_zero(ctx->eb_g.x);
-	fb_zero(ctx->eb_g.y);
-	fb_zero(ctx->eb_g.z);
-	bn_make(&(ctx->eb_r), RLC_FB_DIGS);
-	bn_make(&(ctx->eb_h), RLC_FB_DIGS);
+	fb_zero(par->eb_g.x);
+	fb_zero(par->eb_g.y);
+	fb_zero(par->eb_g.z);
+	bn_make(&(par->eb_r), RLC_FB_DIGS);
+	bn_make(&(par->eb_h), RLC_FB_DIGS);
 }
 
 void eb_curve_clean(void) {
-	ctx_t *ctx = core_get();
-	if (ctx != NULL) {
-		bn_clean(&(ctx->eb_r));
-		bn_clean(&(ctx->eb_h));
+	params_t *par = core_par_get();
+	if (par != NULL) {
+		bn_clean(&(par->eb_r));
+		bn_clean(&(par->eb_h));
 	}
 }
 
 dig_t *eb_curve_get_a(void) {
-	return core_get()->eb_a;
+	return core_par_get()->eb_a;
 }
 
 int eb_curve_opt_a(void) {
-	return core_get()->eb_opt_a;
+	return core_par_get()->eb_opt_a;
 }
 
 dig_t *eb_curve_get_b(void) {
-	return core_get()->eb_b;
+	return core_par_get()->eb_b;
 }
 
 int eb_curve_opt_b(void) {
-	return core_get()->eb_opt_b;
+	return core_par_get()->eb_opt_b;
 }
 
 int eb_curve_is_kbltz(void) {
-	return core_get()->eb_is_kbltz;
+	return core_par_get()->eb_is_kbltz;
 }
 
 void eb_curve_get_gen(eb_t g) {
-	eb_copy(g, &(core_get()->eb_g));
+	eb_copy(g, &(core_par_get()->eb_g));
 }
 
 void eb_curve_get_ord(bn_t n) {
-	bn_copy(n, &(core_get()->eb_r));
+	bn_copy(n, &(core_par_get()->eb_r));
 }
 
 void eb_curve_get_cof(bn_t h) {
-	bn_copy(h, &(core_get()->eb_h));
+	bn_copy(h, &(core_par_get()->eb_h));
 }
 
 const eb_t *eb_curve_get_tab(void) {
@@ -122,9 +122,9 @@ const eb_t *eb_curve_get_tab(void) {
 
 	/* Return a meaningful pointer. */
 #if ALLOC == AUTO
-	return (const eb_t *)*(core_get()->eb_ptr);
+	return (const eb_t *)*(core_par_get()->eb_ptr);
 #else
-	return (const eb_t *)core_get()->eb_ptr;
+	return (const eb_t *)core_par_get()->eb_ptr;
 #endif
 
 #else
@@ -135,24 +135,24 @@ const eb_t *eb_curve_get_tab(void) {
 
 void eb_curve_set(const fb_t a, const fb_t b, const eb_t g, const bn_t r,
 		const bn_t h) {
-	ctx_t *ctx = core_get();
-	fb_copy(ctx->eb_a, a);
-	fb_copy(ctx->eb_b, b);
+	params_t *par = core_par_own();
+	fb_copy(par->eb_a, a);
+	fb_copy(par->eb_b, b);
 
-	detect_opt(&(ctx->eb_opt_a), ctx->eb_a);
-	detect_opt(&(ctx->eb_opt_b), ctx->eb_b);
+	detect_opt(&(par->eb_opt_a), par->eb_a);
+	detect_opt(&(par->eb_opt_b), par->eb_b);
 
-	if (fb_cmp_dig(ctx->eb_b, 1) == RLC_EQ) {
-		ctx->eb_is_kbltz = 1;
+	if (fb_cmp_dig(par->eb_b, 1) == RLC_EQ) {
+		par->eb_is_kbltz = 1;
 	} else {
-		ctx->eb_is_kbltz = 0;
+		par->eb_is_kbltz = 0;
 	}
 
-	eb_norm(&(ctx->eb_g), g);
-	bn_copy(&(ctx->eb_r), r);
-	bn_copy(&(ctx->eb_h), h);
+	eb_norm(&(par->eb_g), g);
+	bn_copy(&(par->eb_r), r);
+	bn_copy(&(par->eb_h), h);
 
 #if defined(EB_PRECO)
-	eb_mul_pre((eb_t *)eb_curve_get_tab(), &(ctx->eb_g));
+	eb_mul_pre((eb_t *)eb_curve_get_tab(), &(par->eb_g));
 #endif
 }
@@ -247,7 +247,7 @@
 /*============================================================================*/
 
 int eb_param_get(void) {
-	return core_get()->eb_id;
+	return core_par_get()->eb_id;
 }
 
 void eb_param_set(int param) {
@@ -263,6 +263,8 @@ void eb_param_set(int param) {
 	bn_null(r);
 	bn_null(h);
 
+	core_par_own();
+
 	RLC_TRY {
 		fb_new(a);
 		fb_new(b);
@@ -270,7 +272,7 @@ void eb_param_set(int param) {
 		bn_new(r);
 		bn_new(h);
 
-		core_get()->eb_id = 0;
+		core_par_get()->eb_id = 0;
 
 		switch (param) {
 #if defined(EB_PLAIN) && FB_POLYN == 163
@@ -348,7 +350,7 @@ void eb_param_set(int param) {
 		g->coord = BASIC;
 
 		eb_curve_set(a, b, g, r, h);
-		core_get()->eb_id = param;
+		core_par_get()->eb_id = param;
 	}
 	RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
@@ -424,7 +426,7 @@ int eb_param_set_any_kbltz(void) {
 }
 
 void eb_param_print(void) {
-	switch (core_get()->eb_id) {
+	switch (core_par_get()->eb_id) {
 		case NIST_B163:
 			util_banner("Curve NIST-B163:", 0);
 			break;
@@ -468,7 +470,7 @@ void eb_param_print(void) {
 }
 
 int eb_param_level(void) {
-	switch (core_get()->eb_id) {
+	switch (core_par_get()->eb_id) {
 		case NIST_B163:
 		case NIST_K163:
 			return 80;
@@ -33,35 +33,35 @@
 #include "relic_core.h"
 
 void ed_curve_init(void) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 #ifdef ED_PRECO
 	for (int i = 0; i < RLC_ED_TABLE; i++) {
-		ctx->ed_ptr[i] = &(ctx->ed_pre[i]);
+		par->ed_ptr[i] = &(par->ed_pre[i]);
 	}
 #endif
-	ed_set_infty(&ctx->ed_g);
-	bn_make(&ctx->ed_r, RLC_FP_DIGS);
-	bn_make(&ctx->ed_h, RLC_FP_DIGS);
+	ed_set_infty(&par->ed_g);
+	bn_make(&par->ed_r, RLC_FP_DIGS);
+	bn_make(&par->ed_h, RLC_FP_DIGS);
 }
 
 void ed_curve_clean(void) {
-	ctx_t *ctx = core_get();
-	if (ctx != NULL) {
-		bn_clean(&ctx->ed_r);
-		bn_clean(&ctx->ed_h);		
+	params_t *par = core_par_get();
+	if (par != NULL) {
+		bn_clean(&par->ed_r);
+		bn_clean(&par->ed_h);		
 	}
 }
 
 void ed_curve_get_gen(ed_t g) {
-	ed_copy(g, &core_get()->ed_g);
+	ed_copy(g, &core_par_get()->ed_g);
 }
 
 void ed_curve_get_ord(bn_t n) {
-	bn_copy(n, &core_get()->ed_r);
+	bn_copy(n, &core_par_get()->ed_r);
 }
 
 void ed_curve_get_cof(bn_t h) {
-	bn_copy(h, &core_get()->ed_h);
+	bn_copy(h, &core_par_get()->ed_h);
 }
 
 const ed_t *ed_curve_get_tab(void) {
@@ -69,9 +69,9 @@ const ed_t *ed_curve_get_tab(void) {
 
 	/* Return a meaningful pointer. */
 #if ALLOC == AUTO
-	return (const ed_t *)*core_get()->ed_ptr;
+	return (const ed_t *)*core_par_get()->ed_ptr;
 #else
-	return (const ed_t *)core_get()->ed_ptr;
+	return (const ed_t *)core_par_get()->ed_ptr;
 #endif
 
 #else
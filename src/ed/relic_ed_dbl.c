@@ -57,7 +57,7 @@ void ed_dbl_basic(ed_t r, const ed_t p) {
 		fp_mul(t0, p->x, p->y);
 		fp_sqr(t1, t0);
 
-		fp_mul(t1, t1, core_get()->ed_d);
+		fp_mul(t1, t1, core_par_get()->ed_d);
 		fp_add_dig(t2, t1, 1);
 		fp_inv(t2, t2);
 		fp_sub_dig(t1, t1, 1);
@@ -68,7 +68,7 @@ void ed_dbl_basic(ed_t r, const ed_t p) {
 		fp_mul(t0, t0, t2);
 
 		fp_sqr(t2, p->x);
-		fp_mul(t2, t2, core_get()->ed_a);
+		fp_mul(t2, t2, core_par_get()->ed_a);
 		fp_sqr(r->y, p->y);
 		fp_sub(r->y, r->y, t2);
 		fp_mul(r->y, r->y, t1);
@@ -125,7 +125,7 @@ void ed_dbl_projc(ed_t r, const ed_t p) {
 		fp_sqr(t2, p->y);
 
 		/* E = a * C */
-		fp_mul(t3, core_get()->ed_a, t1);
+		fp_mul(t3, core_par_get()->ed_a, t1);
 
 		/* F = E + D, H = Z^2 */
 		fp_add(t4, t3, t2);
@@ -195,7 +195,7 @@ void ed_dbl_extnd(ed_t r, const ed_t p) {
 		fp_dbl(r->z, r->z);
 
 		/* D = a * A */
-		fp_mul(r->t, core_get()->ed_a, t0);
+		fp_mul(r->t, core_par_get()->ed_a, t0);
 
 		/* E = (X + Y) ^ 2 - A - B */
 		fp_add(t2, p->x, p->y);
@@ -48,11 +48,11 @@ void ed_map_ell2_5mod8(ed_t p, fp_t t) {
 	fp_null(tv5);
 
 	/* aliases to make code easier to read */
-	ctx_t *ctx = core_get();
-	dig_t *c_2exp = ctx->ed_map_c[0];
-	dig_t *sqrt_M1 = ctx->ed_map_c[1];
-	dig_t *sqrt_M486664 = ctx->ed_map_c[2];
-	dig_t *c_486662 = ctx->ed_map_c[3];
+	params_t *par = core_par_get();
+	dig_t *c_2exp = par->ed_map_c[0];
+	dig_t *sqrt_M1 = par->ed_map_c[1];
+	dig_t *sqrt_M486664 = par->ed_map_c[2];
+	dig_t *c_486662 = par->ed_map_c[3];
 
 	RLC_TRY {
 		bn_new(h);
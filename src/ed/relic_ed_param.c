@@ -55,9 +55,9 @@
 #define ASSIGN_ED(CURVE, FIELD)												\
 	fp_param_set(FIELD);													\
 	RLC_GET(str, CURVE##_A, sizeof(CURVE##_A));								\
-	fp_read_str(core_get()->ed_a, str, strlen(str), 16);					\
+	fp_read_str(core_par_get()->ed_a, str, strlen(str), 16);					\
 	RLC_GET(str, CURVE##_D, sizeof(CURVE##_D));								\
-	fp_read_str(core_get()->ed_d, str, strlen(str), 16);					\
+	fp_read_str(core_par_get()->ed_d, str, strlen(str), 16);					\
 	RLC_GET(str, CURVE##_X, sizeof(CURVE##_X));								\
 	fp_read_str(g->x, str, strlen(str), 16);								\
 	RLC_GET(str, CURVE##_Y, sizeof(CURVE##_Y));								\
@@ -69,7 +69,7 @@
 	bn_read_str(h, str, strlen(str), 16);
 
 void ed_param_set(int param) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 	char str[2 * RLC_FP_BYTES + 2];
 
 	ed_t g;
@@ -85,7 +85,7 @@ void ed_param_set(int param) {
 		bn_new(r);
 		bn_new(h);
 
-		ctx->ed_id = 0;
+		par->ed_id = 0;
 
 		switch (param) {
 #if FP_PRIME == 255
@@ -106,17 +106,17 @@ void ed_param_set(int param) {
 #endif
 		g->coord = BASIC;
 
-		bn_copy(&ctx->ed_h, h);
-		bn_copy(&ctx->ed_r, r);
-		ed_copy(&ctx->ed_g, g);
+		bn_copy(&par->ed_h, h);
+		bn_copy(&par->ed_r, r);
+		ed_copy(&par->ed_g, g);
 
 #ifdef ED_PRECO
 		for (int i = 0; i < RLC_ED_TABLE; i++) {
-			ctx->ed_ptr[i] = &(ctx->ed_pre[i]);
+			par->ed_ptr[i] = &(par->ed_pre[i]);
 		}
-		ed_mul_pre((ed_t *)ed_curve_get_tab(), &ctx->ed_g);
+		ed_mul_pre((ed_t *)ed_curve_get_tab(), &par->ed_g);
 #endif
-		ctx->ed_id = param;
+		par->ed_id = param;
 
 		/* compute constants for p == 5 mod 8 */
 		if (fp_prime_get_2ad() == 2) {
@@ -126,29 +126,29 @@ void ed_param_set(int param) {
 			bn_add_dig(h, h, 3);                         /* p + 3 */
 			bn_rsh(h, h, 3);                             /* (p + 3) / 8 */
 			/* compute 2^((p+3)/8) */
-			fp_set_dig(ctx->ed_map_c[0], 2);
-			fp_exp(ctx->ed_map_c[0], ctx->ed_map_c[0], h);
+			fp_set_dig(par->ed_map_c[0], 2);
+			fp_exp(par->ed_map_c[0], par->ed_map_c[0], h);
 
 			/* compute sqrt(-1) */
-			fp_set_dig(ctx->ed_map_c[1], 1);
-			fp_neg(ctx->ed_map_c[1], ctx->ed_map_c[1]);
-			if (!fp_srt(ctx->ed_map_c[1], ctx->ed_map_c[1])) {
+			fp_set_dig(par->ed_map_c[1], 1);
+			fp_neg(par->ed_map_c[1], par->ed_map_c[1]);
+			if (!fp_srt(par->ed_map_c[1], par->ed_map_c[1])) {
 				/* should never happen because 2adicity > 1 */
 				RLC_THROW(ERR_NO_VALID);
 			}
 
 			if (param == CURVE_ED25519) {
 				/* compute sqrt(-486664) for mapping curve25519 -> edwards25519 */
-				fp_read_str(ctx->ed_map_c[3], "486662", 6, 10);
-				fp_add_dig(ctx->ed_map_c[2], ctx->ed_map_c[3], 2);
-				fp_neg(ctx->ed_map_c[2], ctx->ed_map_c[2]);
-				if (!fp_srt(ctx->ed_map_c[2], ctx->ed_map_c[2])) {
+				fp_read_str(par->ed_map_c[3], "486662", 6, 10);
+				fp_add_dig(par->ed_map_c[2], par->ed_map_c[3], 2);
+				fp_neg(par->ed_map_c[2], par->ed_map_c[2]);
+				if (!fp_srt(par->ed_map_c[2], par->ed_map_c[2])) {
 					RLC_THROW(ERR_NO_VALID);
 				}
-				fp_prime_back(h, ctx->ed_map_c[2]);
-				/* make sure sgn0(ctx->ed_map_c[2]) == 0 */
+				fp_prime_back(h, par->ed_map_c[2]);
+				/* make sure sgn0(par->ed_map_c[2]) == 0 */
 				if (bn_get_bit(h, 0) != 0) {
-					fp_neg(ctx->ed_map_c[2], ctx->ed_map_c[2]);
+					fp_neg(par->ed_map_c[2], par->ed_map_c[2]);
 				}
 			} else {
 				/* don't know how to compute remaining constants for other curves */
@@ -180,7 +180,7 @@ int ed_param_set_any(void) {
 }
 
 int ed_param_get(void) {
-	return core_get()->ed_id;
+	return core_par_get()->ed_id;
 }
 
 int ed_param_level(void) {
@@ -60,11 +60,9 @@ int ed_upk(ed_t r, const ed_t p) {
 		/* x = +/- sqrt((y^2 - 1) / (dy^2 - a)). */
 		fp_sqr(t, p->y);
 		fp_sub_dig(u, t, 1);
-		fp_mul(t, t, core_get()->ed_d);
-		fp_sub(t, t, core_get()->ed_a);
-		fp_inv(t, t);
-		fp_mul(u, u, t);
-		fp_srt(u, u);
+		fp_mul(t, t, core_par_get()->ed_d);
+		fp_sub(t, t, core_par_get()->ed_a);
+		fp_srt_div(u, u, t);
 
 		if (fp_get_bit(u, 0) != fp_get_bit(p->x, 0)) {
 			fp_neg(u, u);
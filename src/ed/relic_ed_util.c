@@ -42,11 +42,6 @@
 /*============================================================================*/
 
 int ed_is_infty(const ed_t p) {
-	fp_t t;
-	int r = 0;
-
-	fp_null(t);
-
 	if (p->coord == BASIC) {
 		return (fp_is_zero(p->x) && (fp_cmp_dig(p->y, 1) == RLC_EQ));
 	}
@@ -56,20 +51,8 @@ int ed_is_infty(const ed_t p) {
 		return 0;
 	}
 
-	RLC_TRY {
-		fp_new(t);
-		fp_inv(t, p->z);
-		fp_mul(t, p->y, t);
-		if (fp_is_zero(p->x) && (fp_cmp_dig(t, 1) == RLC_EQ)) {
-			r = 1;
-		}
-	} RLC_CATCH_ANY {
-		RLC_THROW(ERR_CAUGHT);
-	} RLC_FINALLY {
-		fp_free(t);
-	}
-
-	return r;
+	/* The neutral element is (0 : Z : Z), so there is no need to invert Z. */
+	return (fp_is_zero(p->x) && (fp_cmp(p->y, p->z) == RLC_EQ));
 }
 
 void ed_set_infty(ed_t p) {
@@ -154,12 +137,12 @@ void ed_rhs(fp_t rhs, const ed_t p) {
 
 		// 1 = a * X^2 + Y^2 - d * X^2 * Y^2
 		fp_sqr(t0, p->x);
-		fp_mul(t0, t0, core_get()->ed_a);
+		fp_mul(t0, t0, core_par_get()->ed_a);
 		fp_sqr(t1, p->y);
 		fp_add(t1, t1, t0);
 		fp_mul(t0, p->x, p->y);
 		fp_sqr(t0, t0);
-		fp_mul(t0, t0, core_get()->ed_d);
+		fp_mul(t0, t0, core_par_get()->ed_d);
 		fp_sub(rhs, t1, t0);
 	} RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
@@ -85,13 +85,13 @@ static void ep_curve_set_map(const fp_t u) {
 
 	const int abNeq0 = (ep_curve_opt_a() != RLC_ZERO) && (ep_curve_opt_b() != RLC_ZERO);
 
-	ctx_t *ctx = core_get();
-	dig_t *c1 = ctx->ep_map_c[0];
-	dig_t *c2 = ctx->ep_map_c[1];
-	dig_t *c3 = ctx->ep_map_c[2];
-	dig_t *c4 = ctx->ep_map_c[3];
+	params_t *par = core_par_get();
+	dig_t *c1 = par->ep_map_c[0];
+	dig_t *c2 = par->ep_map_c[1];
+	dig_t *c3 = par->ep_map_c[2];
+	dig_t *c4 = par->ep_map_c[3];
 
-	fp_copy(ctx->ep_map_u, u);
+	fp_copy(par->ep_map_u, u);
 
 	RLC_TRY {
 		bn_new(t);
@@ -101,12 +101,12 @@ static void ep_curve_set_map(const fp_t u) {
 			/* constants 3 and 4: a and b for either the curve or the isogeny */
 #ifdef EP_CTMAP
 			if (ep_curve_is_ctmap()) {
-				fp_copy(c3, ctx->ep_iso.a);
-				fp_copy(c4, ctx->ep_iso.b);
+				fp_copy(c3, par->ep_iso.a);
+				fp_copy(c4, par->ep_iso.b);
 			} else {
 #endif
-				fp_copy(c3, ctx->ep_a);
-				fp_copy(c4, ctx->ep_b);
+				fp_copy(c3, par->ep_a);
+				fp_copy(c4, par->ep_b);
 #ifdef EP_CTMAP
 			}
 #endif
@@ -115,25 +115,32 @@ static void ep_curve_set_map(const fp_t u) {
 			fp_inv(c1, c1);     /* c1 = -1 / a */
 			fp_mul(c1, c1, c4); /* c1 = -b / a */
 
-			/* constant 2 is unused in this case */
+			/* constant 2: u * sqrt(u * qnr), used to get sqrt(g(x2)) */
+			fp_set_dig(c2, -fp_prime_get_qnr());
+			fp_neg(c2, c2);
+			fp_mul(c2, c2, par->ep_map_u);
+			if (!fp_srt(c2, c2)) {
+				RLC_THROW(ERR_NO_VALID);
+			}
+			fp_mul(c2, c2, par->ep_map_u);
 		} else {
 			/* SvdW map constants */
 			/* constant 1: g(u) = u^3 + a * u + b */
-			fp_sqr(c1, ctx->ep_map_u);
-			fp_add(c1, c1, ctx->ep_a);
-			fp_mul(c1, c1, ctx->ep_map_u);
-			fp_add(c1, c1, ctx->ep_b);
+			fp_sqr(c1, par->ep_map_u);
+			fp_add(c1, c1, par->ep_a);
+			fp_mul(c1, c1, par->ep_map_u);
+			fp_add(c1, c1, par->ep_b);
 
 			/* constant 2: -u / 2 */
 			fp_set_dig(c2, 1);
 			fp_neg(c2, c2);                /* -1 */
 			fp_hlv(c2, c2);                /* -1/2 */
-			fp_mul(c2, c2, ctx->ep_map_u); /* c2 = -1/2 * u */
+			fp_mul(c2, c2, par->ep_map_u); /* c2 = -1/2 * u */
 
 			/* constant 3: sqrt(-g(u) * (3 * u^2 + 4 * a)) */
-			fp_sqr(c3, ctx->ep_map_u);    /* c3 = u^2 */
+			fp_sqr(c3, par->ep_map_u);    /* c3 = u^2 */
 			fp_mul_dig(c3, c3, 3);        /* c3 = 3 * u^2 */
-			fp_mul_dig(c4, ctx->ep_a, 4); /* c4 = 4 * a */
+			fp_mul_dig(c4, par->ep_a, 4); /* c4 = 4 * a */
 			fp_add(c4, c3, c4);           /* c4 = 3 * u^2 + 4 * a */
 			fp_neg(c4, c4);               /* c4 = -(3 * u^2 + 4 * a) */
 			fp_mul(c3, c4, c1);           /* c3 = -g(u) * (3 * u^2 + 4 * a) */
@@ -174,26 +181,26 @@ static void ep_curve_set_map(const fp_t u) {
  */
 static void ep_curve_set(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 		const bn_t h, const fp_t u, int ctmap) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
-	fp_copy(ctx->ep_a, a);
-	fp_copy(ctx->ep_b, b);
-	fp_dbl(ctx->ep_b3, b);
-	fp_add(ctx->ep_b3, ctx->ep_b3, b);
+	fp_copy(par->ep_a, a);
+	fp_copy(par->ep_b, b);
+	fp_dbl(par->ep_b3, b);
+	fp_add(par->ep_b3, par->ep_b3, b);
 
-	detect_opt(&(ctx->ep_opt_a), ctx->ep_a);
-	detect_opt(&(ctx->ep_opt_b), ctx->ep_b);
-	detect_opt(&(ctx->ep_opt_b3), ctx->ep_b3);
+	detect_opt(&(par->ep_opt_a), par->ep_a);
+	detect_opt(&(par->ep_opt_b), par->ep_b);
+	detect_opt(&(par->ep_opt_b3), par->ep_b3);
 
-	ctx->ep_is_ctmap = ctmap;
+	par->ep_is_ctmap = ctmap;
 	ep_curve_set_map(u);
 
-	ep_norm(&(ctx->ep_g), g);
-	bn_copy(&(ctx->ep_r), r);
-	bn_copy(&(ctx->ep_h), h);
+	ep_norm(&(par->ep_g), g);
+	bn_copy(&(par->ep_r), r);
+	bn_copy(&(par->ep_h), h);
 
 #if defined(EP_PRECO)
-	ep_mul_pre((ep_t *)ep_curve_get_tab(), &(ctx->ep_g));
+	ep_mul_pre((ep_t *)ep_curve_get_tab(), &(par->ep_g));
 #endif
 }
 
@@ -202,82 +209,82 @@ static void ep_curve_set(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 /*============================================================================*/
 
 void ep_curve_init(void) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 #ifdef EP_PRECO
 	for (int i = 0; i < RLC_EP_TABLE; i++) {
-		ctx->ep_ptr[i] = &(ctx->ep_pre[i]);
+		par->ep_ptr[i] = &(par->ep_pre[i]);
 	}
 #endif
-	ep_set_infty(&ctx->ep_g);
-	bn_make(&ctx->ep_r, RLC_FP_DIGS);
-	bn_make(&ctx->ep_h, RLC_FP_DIGS);
+	ep_set_infty(&par->ep_g);
+	bn_make(&par->ep_r, RLC_FP_DIGS);
+	bn_make(&par->ep_h, RLC_FP_DIGS);
 #if defined(EP_ENDOM) && (EP_MUL == LWNAF || EP_FIX == COMBS || EP_FIX == LWNAF || !defined(STRIP))
 	for (int i = 0; i < 3; i++) {
-		bn_make(&(ctx->ep_v1[i]), RLC_FP_DIGS);
-		bn_make(&(ctx->ep_v2[i]), RLC_FP_DIGS);
+		bn_make(&(par->ep_v1[i]), RLC_FP_DIGS);
+		bn_make(&(par->ep_v2[i]), RLC_FP_DIGS);
 	}
 #endif
 }
 
 void ep_curve_clean(void) {
-	ctx_t *ctx = core_get();
-	if (ctx != NULL) {
-		bn_clean(&ctx->ep_r);
-		bn_clean(&ctx->ep_h);
+	params_t *par = core_par_get();
+	if (par != NULL) {
+		bn_clean(&par->ep_r);
+		bn_clean(&par->ep_h);
 #if defined(EP_ENDOM) && (EP_MUL == LWNAF || EP_FIX == LWNAF || !defined(STRIP))
 		for (int i = 0; i < 3; i++) {
-			bn_clean(&(ctx->ep_v1[i]));
-			bn_clean(&(ctx->ep_v2[i]));
+			bn_clean(&(par->ep_v1[i]));
+			bn_clean(&(par->ep_v2[i]));
 		}
 #endif
 	}
 }
 
 dig_t *ep_curve_get_a(void) {
-	return core_get()->ep_a;
+	return core_par_get()->ep_a;
 }
 
 dig_t *ep_curve_get_b(void) {
-	return core_get()->ep_b;
+	return core_par_get()->ep_b;
 }
 
 dig_t *ep_curve_get_b3(void) {
-	return core_get()->ep_b3;
+	return core_par_get()->ep_b3;
 }
 
 #if defined(EP_ENDOM) && (EP_MUL == LWNAF || EP_FIX == COMBS || EP_FIX == LWNAF || EP_SIM == INTER || !defined(STRIP))
 
 dig_t *ep_curve_get_beta(void) {
-	return core_get()->beta;
+	return core_par_get()->beta;
 }
 
 void ep_curve_get_v1(bn_t v[]) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 	for (int i = 0; i < 3; i++) {
-		bn_copy(v[i], &(ctx->ep_v1[i]));
+		bn_copy(v[i], &(par->ep_v1[i]));
 	}
 }
 
 void ep_curve_get_v2(bn_t v[]) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 	for (int i = 0; i < 3; i++) {
-		bn_copy(v[i], &(ctx->ep_v2[i]));
+		bn_copy(v[i], &(par->ep_v2[i]));
 	}
 }
 
 #endif
 
 int ep_curve_opt_a(void) {
-	return core_get()->ep_opt_a;
+	return core_par_get()->ep_opt_a;
 }
 
 int ep_curve_opt_b(void) {
-	return core_get()->ep_opt_b;
+	return core_par_get()->ep_opt_b;
 }
 
 void ep_curve_mul_a(fp_t c, const fp_t a) {
-	ctx_t *ctx = core_get();
-	switch (ctx->ep_opt_a) {
+	params_t *par = core_par_get();
+	switch (par->ep_opt_a) {
 		case RLC_ZERO:
 			fp_zero(c);
 			break;
@@ -286,18 +293,18 @@ void ep_curve_mul_a(fp_t c, const fp_t a) {
 			break;
 #if FP_RDC != MONTY
 		case RLC_TINY:
-			fp_mul_dig(c, a, ctx->ep_a[0]);
+			fp_mul_dig(c, a, par->ep_a[0]);
 			break;
 #endif
 		default:
-			fp_mul(c, a, ctx->ep_a);
+			fp_mul(c, a, par->ep_a);
 			break;
 	}
 }
 
 void ep_curve_mul_b(fp_t c, const fp_t a) {
-	ctx_t *ctx = core_get();
-	switch (ctx->ep_opt_b) {
+	params_t *par = core_par_get();
+	switch (par->ep_opt_b) {
 		case RLC_ZERO:
 			fp_zero(c);
 			break;
@@ -306,18 +313,18 @@ void ep_curve_mul_b(fp_t c, const fp_t a) {
 			break;
 #if FP_RDC != MONTY
 		case RLC_TINY:
-			fp_mul_dig(c, a, ctx->ep_b[0]);
+			fp_mul_dig(c, a, par->ep_b[0]);
 			break;
 #endif
 		default:
-			fp_mul(c, a, ctx->ep_b);
+			fp_mul(c, a, par->ep_b);
 			break;
 	}
 }
 
 void ep_curve_mul_b3(fp_t c, const fp_t a) {
-	ctx_t *ctx = core_get();
-	switch (ctx->ep_opt_b3) {
+	params_t *par = core_par_get();
+	switch (par->ep_opt_b3) {
 		case RLC_ZERO:
 			fp_zero(c);
 			break;
@@ -326,41 +333,41 @@ void ep_curve_mul_b3(fp_t c, const fp_t a) {
 			break;
 #if FP_RDC != MONTY
 		case RLC_TINY:
-			fp_mul_dig(c, a, ctx->ep_b3[0]);
+			fp_mul_dig(c, a, par->ep_b3[0]);
 			break;
 #endif
 		default:
-			fp_mul(c, a, ctx->ep_b3);
+			fp_mul(c, a, par->ep_b3);
 			break;
 	}
 }
 
 int ep_curve_is_endom(void) {
-	return core_get()->ep_is_endom;
+	return core_par_get()->ep_is_endom;
 }
 
 int ep_curve_is_super(void) {
-	return core_get()->ep_is_super;
+	return core_par_get()->ep_is_super;
 }
 
 int ep_curve_is_pairf(void) {
-	return core_get()->ep_is_pairf;
+	return core_par_get()->ep_is_pairf;
 }
 
 int ep_curve_is_ctmap(void) {
-	return core_get()->ep_is_ctmap;
+	return core_par_get()->ep_is_ctmap;
 }
 
 void ep_curve_get_gen(ep_t g) {
-	ep_copy(g, &core_get()->ep_g);
+	ep_copy(g, &core_par_get()->ep_g);
 }
 
 void ep_curve_get_ord(bn_t n) {
-	bn_copy(n, &core_get()->ep_r);
+	bn_copy(n, &core_par_get()->ep_r);
 }
 
 void ep_curve_get_cof(bn_t h) {
-	bn_copy(h, &core_get()->ep_h);
+	bn_copy(h, &core_par_get()->ep_h);
 }
 
 const ep_t *ep_curve_get_tab(void) {
@@ -368,9 +375,9 @@ const ep_t *ep_curve_get_tab(void) {
 
 	/* Return a meaningful pointer. */
 #if ALLOC == AUTO
-	return (const ep_t *)*core_get()->ep_ptr;
+	return (const ep_t *)*core_par_get()->ep_ptr;
 #else
-	return (const ep_t *)core_get()->ep_ptr;
+	return (const ep_t *)core_par_get()->ep_ptr;
 #endif
 
 #else
@@ -382,7 +389,7 @@ const ep_t *ep_curve_get_tab(void) {
 
 iso_t ep_curve_get_iso() {
 #ifdef EP_CTMAP
-	return &core_get()->ep_iso;
+	return &core_par_get()->ep_iso;
 #else
 	return NULL;
 #endif /* EP_CTMAP */
@@ -392,9 +399,9 @@ iso_t ep_curve_get_iso() {
 
 void ep_curve_set_plain(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 		const bn_t h, const fp_t u, int ctmap) {
-	ctx_t *ctx = core_get();
-	ctx->ep_is_endom = 0;
-	ctx->ep_is_super = 0;
+	params_t *par = core_par_own();
+	par->ep_is_endom = 0;
+	par->ep_is_super = 0;
 
 	ep_curve_set(a, b, g, r, h, u, ctmap);
 }
@@ -405,9 +412,9 @@ void ep_curve_set_plain(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 
 void ep_curve_set_super(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 		const bn_t h, const fp_t u, int ctmap) {
-	ctx_t *ctx = core_get();
-	ctx->ep_is_endom = 0;
-	ctx->ep_is_super = 1;
+	params_t *par = core_par_own();
+	par->ep_is_endom = 0;
+	par->ep_is_super = 1;
 
 	ep_curve_set(a, b, g, r, h, u, ctmap);
 }
@@ -419,9 +426,9 @@ void ep_curve_set_super(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 void ep_curve_set_endom(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 		const bn_t h, const fp_t beta, const bn_t l, const fp_t u, int ctmap) {
 	int bits = bn_bits(r);
-	ctx_t *ctx = core_get();
-	ctx->ep_is_endom = 1;
-	ctx->ep_is_super = 0;
+	params_t *par = core_par_own();
+	par->ep_is_endom = 1;
+	par->ep_is_super = 0;
 
 	ep_curve_set(a, b, g, r, h, u, ctmap);
 
@@ -440,7 +447,7 @@ void ep_curve_set_endom(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 		bn_new(m);
 
 		/* Check if [m]P = \psi(P). */
-		fp_copy(ctx->beta, beta);
+		fp_copy(par->beta, beta);
 		bn_copy(m, l);
 		ep_psi(p, g);
 		ep_copy(q, g);
@@ -453,40 +460,40 @@ void ep_curve_set_endom(const fp_t a, const fp_t b, const ep_t g, const bn_t r,
 		ep_norm(q, q);
 		/* Fix beta in case it is the wrong value. */
 		if (ep_cmp(q, p) != RLC_EQ) {
-			fp_neg(ctx->beta, ctx->beta);
-			fp_sub_dig(ctx->beta, ctx->beta, 1);
+			fp_neg(par->beta, par->beta);
+			fp_sub_dig(par->beta, par->beta, 1);
 		}
-		bn_gcd_ext_mid(&(ctx->ep_v1[1]), &(ctx->ep_v1[2]), &(ctx->ep_v2[1]),
-				&(ctx->ep_v2[2]), m, r);
+		bn_gcd_ext_mid(&(par->ep_v1[1]), &(par->ep_v1[2]), &(par->ep_v2[1]),
+				&(par->ep_v2[2]), m, r);
 		/* m = (v1[1] * v2[2] - v1[2] * v2[1]) / 2. */
-		bn_mul(&(ctx->ep_v1[0]), &(ctx->ep_v1[1]), &(ctx->ep_v2[2]));
-		bn_mul(&(ctx->ep_v2[0]), &(ctx->ep_v1[2]), &(ctx->ep_v2[1]));
-		bn_sub(m, &(ctx->ep_v1[0]), &(ctx->ep_v2[0]));
+		bn_mul(&(par->ep_v1[0]), &(par->ep_v1[1]), &(par->ep_v2[2]));
+		bn_mul(&(par->ep_v2[0]), &(par->ep_v1[2]), &(par->ep_v2[1]));
+		bn_sub(m, &(par->ep_v1[0]), &(par->ep_v2[0]));
 		bn_hlv(m, m);
 		/* v1[0] = round(v2[2] * 2^|n| / m). */
-		bn_lsh(&(ctx->ep_v1[0]), &(ctx->ep_v2[2]), bits + 1);
-		if (bn_sign(&(ctx->ep_v1[0])) == RLC_POS) {
-			bn_add(&(ctx->ep_v1[0]), &(ctx->ep_v1[0]), m);
+		bn_lsh(&(par->ep_v1[0]), &(par->ep_v2[2]), bits + 1);
+		if (bn_sign(&(par->ep_v1[0])) == RLC_POS) {
+			bn_add(&(par->ep_v1[0]), &(par->ep_v1[0]), m);
 		} else {
-			bn_sub(&(ctx->ep_v1[0]), &(ctx->ep_v1[0]), m);
+			bn_sub(&(par->ep_v1[0]), &(par->ep_v1[0]), m);
 		}
 		bn_dbl(m, m);
-		bn_div(&(ctx->ep_v1[0]), &(ctx->ep_v1[0]), m);
-		if (bn_sign(&ctx->ep_v1[0]) == RLC_NEG) {
-			bn_add_dig(&(ctx->ep_v1[0]), &(ctx->ep_v1[0]), 1);
+		bn_div(&(par->ep_v1[0]), &(par->ep_v1[0]), m);
+		if (bn_sign(&par->ep_v1[0]) == RLC_NEG) {
+			bn_add_dig(&(par->ep_v1[0]), &(par->ep_v1[0]), 1);
 		}
 		/* v2[0] = round(v1[2] * 2^|n| / m). */
-		bn_lsh(&(ctx->ep_v2[0]), &(ctx->ep_v1[2]), bits + 1);
-		if (bn_sign(&(ctx->ep_v2[0])) == RLC_POS) {
-			bn_add(&(ctx->ep_v2[0]), &(ctx->ep_v2[0]), m);
+		bn_lsh(&(par->ep_v2[0]), &(par->ep_v1[2]), bits + 1);
+		if (bn_sign(&(par->ep_v2[0])) == RLC_POS) {
+			bn_add(&(par->ep_v2[0]), &(par->ep_v2[0]), m);
 		} else {
-			bn_sub(&(ctx->ep_v2[0]), &(ctx->ep_v2[0]), m);
+			bn_sub(&(par->ep_v2[0]), &(par->ep_v2[0]), m);
 		}
-		bn_div(&(ctx->ep_v2[0]), &(ctx->ep_v2[0]), m);
-		if (bn_sign(&ctx->ep_v2[0]) == RLC_NEG) {
-			bn_add_dig(&(ctx->ep_v2[0]), &(ctx->ep_v2[0]), 1);
+		bn_div(&(par->ep_v2[0]), &(par->ep_v2[0]), m);
+		if (bn_sign(&par->ep_v2[0]) == RLC_NEG) {
+			bn_add_dig(&(par->ep_v2[0]), &(par->ep_v2[0]), 1);
 		}
-		bn_neg(&(ctx->ep_v2[0]), &(ctx->ep_v2[0]));
+		bn_neg(&(par->ep_v2[0]), &(par->ep_v2[0]));
 	} RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	} RLC_FINALLY {
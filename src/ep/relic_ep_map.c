@@ -55,11 +55,118 @@ TMPL_MAP_HORNER(fp, fp_st)
 		TMPL_MAP_ISOGENY_MAP(ep, fp, iso)
 #endif /* EP_CTMAP */
 /**
- * Simplified SWU mapping from Section 4 of
- * "Fast and simple constant-time hashing to the BLS12-381 Elliptic Curve"
+ * Simplified SWU mapping from Section 6.6.2 of RFC 9380. Both candidates x1 and
+ * x2 = u * t^2 * x1 are kept as fractions, so that the inversion and the square
+ * root share a single exponentiation: from s = 1/sqrt(U * V) for
+ * g(x1) = U / V and V = D^3, we get sqrt(g(x1)) = U * s and 1/V = U * s^2.
+ *
+ * @param[out] p			- the result.
+ * @param[in] t				- the field element to map.
  */
+static void ep_map_sswu(ep_t p, fp_t t) {
+	fp_t t0, t1, t2, t3, n, d, u, v;
+	params_t *par = core_par_get();
+	dig_t *c = par->ep_map_c[1];
+	dig_t *a = par->ep_map_c[2];
+	dig_t *b = par->ep_map_c[3];
+	int sq, z;
+
+	fp_null(t0);
+	fp_null(t1);
+	fp_null(t2);
+	fp_null(t3);
+	fp_null(n);
+	fp_null(d);
+	fp_null(u);
+	fp_null(v);
+
+	RLC_TRY {
+		fp_new(t0);
+		fp_new(t1);
+		fp_new(t2);
+		fp_new(t3);
+		fp_new(n);
+		fp_new(d);
+		fp_new(u);
+		fp_new(v);
+
+		fp_sqr(t0, t);
+		fp_mul(t0, t0, par->ep_map_u); /* t0 = u * t^2 */
+		fp_sqr(t1, t0);
+		fp_add(t1, t1, t0);            /* t1 = u^2 * t^4 + u * t^2 */
+
+		/* x1 = N / D, with N = b * (t1 + 1) and D = -a * t1 or D = u * a. */
+		fp_add_dig(n, t1, 1);
+		fp_mul(n, n, b);
+		fp_neg(d, t1);
+		dv_copy_cond(d, par->ep_map_u, RLC_FP_DIGS, fp_is_zero(t1));
+		fp_mul(d, d, a);
+
+		/* g(x1) = U / V, with U = N^3 + a * N * D^2 + b * D^3 and V = D^3. */
+		fp_sqr(t2, d);
+		fp_mul(v, t2, d);
+		fp_mul(u, t2, a);
+		fp_sqr(t3, n);
+		fp_add(u, u, t3);
+		fp_mul(u, u, n);
+		fp_mul(t3, v, b);
+		fp_add(u, u, t3);
+
+		/* In the exceptional case g(x1) = 0, which is a square, run the same
+		 * steps with U = 1 to get x1 = N / D without branching, and set y = 0
+		 * at the end. */
+		z = fp_is_zero(u);
+		fp_set_dig(t3, 1);
+		dv_copy_cond(u, t3, RLC_FP_DIGS, z);
+
+		/* t3 = 1/sqrt(U * V) or t3 = 1/sqrt(qnr * U * V). */
+		fp_mul(t3, u, v);
+		fp_set_dig(v, 1);
+		sq = fp_srt_div(t3, v, t3);
+
+		/* y = sqrt(g(x1)) or y = sqrt(g(x1) / qnr). */
+		fp_mul(p->y, u, t3);
+		/* v = 1 / (qnr * V) and then v = 1 / V. */
+		fp_sqr(v, t3);
+		fp_mul(v, v, u);
+		fp_mul_dig(t3, v, -fp_prime_get_qnr());
+		fp_neg(t3, t3);
+		dv_copy_cond(v, t3, RLC_FP_DIGS, !sq);
+		/* x1 = N * D^2 / V. */
+		fp_mul(v, v, t2);
+		fp_mul(p->x, n, v);
+
+		/* If g(x1) is not a square, then take x2 = u * t^2 * x1 and
+		 * sqrt(g(x2)) = t^3 * u * sqrt(u * qnr) * sqrt(g(x1) / qnr). */
+		sq |= z;
+		fp_mul(t0, t0, p->x);
+		dv_copy_cond(p->x, t0, RLC_FP_DIGS, !sq);
+		fp_sqr(t1, t);
+		fp_mul(t1, t1, t);
+		fp_mul(t1, t1, c);
+		fp_mul(t1, t1, p->y);
+		dv_copy_cond(p->y, t1, RLC_FP_DIGS, !sq);
+		fp_zero(t1);
+		dv_copy_cond(p->y, t1, RLC_FP_DIGS, z);
+		fp_set_dig(p->z, 1);
+		p->coord = BASIC;
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		fp_free(t0);
+		fp_free(t1);
+		fp_free(t2);
+		fp_free(t3);
+		fp_free(n);
+		fp_free(d);
+		fp_free(u);
+		fp_free(v);
+	}
+}
+
 #define EP_MAP_COPY_COND(O, I, C) dv_copy_cond(O, I, RLC_FP_DIGS, C)
-		TMPL_MAP_SSWU(ep, fp, dig_t, EP_MAP_COPY_COND)
 /**
  * Shallue--van de Woestijne map, based on the definition from
  * draft-irtf-cfrg-hash-to-curve-06, Section 6.6.1
@@ -72,27 +179,25 @@ static inline int fp_sgn0(const fp_t t, bn_t k) {
 	return bn_get_bit(k, 0);
 }
 
-/*============================================================================*/
-/* Public definitions                                                         */
-/*============================================================================*/
-
-void ep_map_from_field(ep_t p, const uint8_t *uniform_bytes, int len) {
+/**
+ * Maps an array of uniformly random bytes to the sum of two points in the curve
+ * before cofactor clearing. The result is not normalized.
+ *
+ * @param[out] p			- the result.
+ * @param[in] uniform_bytes	- the array of uniform bytes to map.
+ * @param[in] len_per_elm	- the number of bytes per field element.
+ */
+static void ep_map_imp(ep_t p, const uint8_t *uniform_bytes, int len_per_elm) {
 	bn_t k;
 	fp_t t;
 	ep_t q;
 	int neg;
-	/* enough space for two field elements plus extra bytes for uniformity */
-	const int len_per_elm = (FP_PRIME + ep_param_level() + 7) / 8;
 
 	bn_null(k);
 	fp_null(t);
 	ep_null(q);
 
 	RLC_TRY {
-		if (len != 2 * len_per_elm) {
-			RLC_THROW(ERR_NO_VALID);
-		}
-
 		bn_new(k);
 		fp_new(t);
 		ep_new(q);
@@ -139,9 +244,30 @@ void ep_map_from_field(ep_t p, const uint8_t *uniform_bytes, int len) {
 
 		/* sum the result */
 		ep_add(p, p, q);
-		ep_norm(p, p);
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		bn_free(k);
+		fp_free(t);
+		ep_free(q);
+	}
+}
+
+/**
+ * Clears the cofactor of a normalized point obtained from the map.
+ *
+ * @param[in,out] p			- the point to multiply.
+ */
+static void ep_map_cof(ep_t p) {
+	bn_t k;
+
+	bn_null(k);
+
+	RLC_TRY {
+		bn_new(k);
 
-		/* clear cofactor */
 		switch (ep_curve_is_pairf()) {
 			case EP_BN:
 				/* h = 1 */
@@ -177,11 +303,27 @@ void ep_map_from_field(ep_t p, const uint8_t *uniform_bytes, int len) {
 	}
 	RLC_FINALLY {
 		bn_free(k);
-		fp_free(t);
-		ep_free(q);
 	}
 }
 
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+void ep_map_from_field(ep_t p, const uint8_t *uniform_bytes, int len) {
+	/* enough space for two field elements plus extra bytes for uniformity */
+	const int len_per_elm = (FP_PRIME + ep_param_level() + 7) / 8;
+
+	if (len != 2 * len_per_elm) {
+		RLC_THROW(ERR_NO_VALID);
+		return;
+	}
+
+	ep_map_imp(p, uniform_bytes, len_per_elm);
+	ep_norm(p, p);
+	ep_map_cof(p);
+}
+
 void ep_map_dst(ep_t p, const uint8_t *msg, int len, const uint8_t *dst,
 		int dst_len) {
 
@@ -208,3 +350,52 @@ void ep_map_dst(ep_t p, const uint8_t *msg, int len, const uint8_t *dst,
 void ep_map(ep_t p, const uint8_t *msg, int len) {
 	ep_map_dst(p, msg, len, (const uint8_t *)"RELIC", 5);
 }
+
+void ep_map_sim(ep_t p[], const uint8_t *msg[], const int len[], int n) {
+	/* enough space for two field elements plus extra bytes for uniformity */
+	const int len_per_elm = (FP_PRIME + ep_param_level() + 7) / 8;
+	uint8_t *buf;
+	int i;
+
+	if (n <= 0) {
+		return;
+	}
+	buf = RLC_ALLOCA(uint8_t, 2 * len_per_elm * n);
+
+	RLC_TRY {
+		if (buf == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+
+#if MULTI == OPENMP
+		omp_set_num_threads(CORES);
+		#pragma omp parallel for copyin(core_ctx)
+#endif
+		for (i = 0; i < n; i++) {
+			uint8_t *u = buf + 2 * i * len_per_elm;
+
+			md_xmd(u, 2 * len_per_elm, msg[i], len[i],
+					(const uint8_t *)"RELIC", 5);
+			ep_map_imp(p[i], u, len_per_elm);
+		}
+
+		/* Share a single inversion among all points before clearing. */
+		ep_norm_sim(p, (const ep_t *)p, n);
+
+		if (ep_curve_is_pairf() != EP_BN) {
+#if MULTI == OPENMP
+			omp_set_num_threads(CORES);
+			#pragma omp parallel for copyin(core_ctx)
+#endif
+			for (i = 0; i < n; i++) {
+				ep_map_cof(p[i]);
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		RLC_FREE(buf);
+	}
+}
@@ -120,23 +120,29 @@ void ep_norm_sim(ep_t *r, const ep_t *t, int n) {
 		for (i = 0; i < n; i++) {
 			fp_null(a[i]);
 			fp_new(a[i]);
-			fp_copy(a[i], t[i]->z);
+			/* Points at infinity must not zero the accumulated product. */
+			if (ep_is_infty(t[i])) {
+				fp_set_dig(a[i], 1);
+			} else {
+				fp_copy(a[i], t[i]->z);
+			}
 		}
 
 		fp_inv_sim(a, (const fp_t *)a, n);
 
 		for (i = 0; i < n; i++) {
+			if (ep_is_infty(t[i])) {
+				ep_set_infty(r[i]);
+				continue;
+			}
 			fp_copy(r[i]->x, t[i]->x);
 			fp_copy(r[i]->y, t[i]->y);
-			if (!ep_is_infty(t[i])) {
-				fp_copy(r[i]->z, a[i]);
-			}
-		}
+			fp_copy(r[i]->z, a[i]);
+			r[i]->coord = t[i]->coord;
 #if EP_ADD == PROJC || EP_ADD == JACOB || !defined(STRIP)
-		for (i = 0; i < n; i++) {
 			ep_norm_imp(r[i], r[i], 1);
-		}
 #endif /* EP_ADD == PROJC */
+		}
 	}
 	RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
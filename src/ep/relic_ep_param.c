@@ -765,7 +765,7 @@ static inline void ep_param_set_ctmap(const char *a_str, const char *b_str,
 /*============================================================================*/
 
 int ep_param_get(void) {
-	return core_get()->ep_id;
+	return core_par_get()->ep_id;
 }
 
 void ep_param_set(int param) {
@@ -784,6 +784,8 @@ void ep_param_set(int param) {
 	bn_null(r);
 	bn_null(h);
 
+	core_par_own();
+
 	RLC_TRY {
 		fp_new(a);
 		fp_new(b);
@@ -794,7 +796,7 @@ void ep_param_set(int param) {
 		bn_new(r);
 		bn_new(h);
 
-		core_get()->ep_id = 0;
+		core_par_get()->ep_id = 0;
 
 		switch (param) {
 #if defined(EP_ENDOM) && FP_PRIME == 158
@@ -1123,22 +1125,22 @@ void ep_param_set(int param) {
 #if defined(EP_PLAIN)
 		if (plain) {
 			ep_curve_set_plain(a, b, g, r, h, u, ctmap);
-			core_get()->ep_id = param;
+			core_par_get()->ep_id = param;
 		}
 #endif
 
 #if defined(EP_ENDOM)
 		if (endom) {
 			ep_curve_set_endom(a, b, g, r, h, beta, lamb, u, ctmap);
-			core_get()->ep_id = param;
-			core_get()->ep_is_pairf = pairf;
+			core_par_get()->ep_id = param;
+			core_par_get()->ep_is_pairf = pairf;
 		}
 #endif
 
 #if defined(EP_SUPER)
 		if (super) {
 			ep_curve_set_super(a, b, g, r, h, u, ctmap);
-			core_get()->ep_id = param;
+			core_par_get()->ep_id = param;
 		}
 #endif
 	}
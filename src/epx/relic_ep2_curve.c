@@ -424,11 +424,11 @@ static void ep2_curve_set_map(void) {
 
 	const int abNeq0 = (ep2_curve_opt_a() != RLC_ZERO) && (ep2_curve_opt_b() != RLC_ZERO);
 
-	ctx_t *ctx = core_get();
-	fp_t *c1 = ctx->ep2_map_c[0];
-	fp_t *c2 = ctx->ep2_map_c[1];
-	fp_t *c3 = ctx->ep2_map_c[2];
-	fp_t *c4 = ctx->ep2_map_c[3];
+	params_t *par = core_par_get();
+	fp_t *c1 = par->ep2_map_c[0];
+	fp_t *c2 = par->ep2_map_c[1];
+	fp_t *c3 = par->ep2_map_c[2];
+	fp_t *c4 = par->ep2_map_c[3];
 
 	RLC_TRY {
 		bn_new(t);
@@ -438,12 +438,12 @@ static void ep2_curve_set_map(void) {
 			/* constants 3 and 4 are a and b for the curve or isogeny */
 #ifdef EP_CTMAP
 			if (ep2_curve_is_ctmap()) {
-				fp2_copy(c3, ctx->ep2_iso.a);
-				fp2_copy(c4, ctx->ep2_iso.b);
+				fp2_copy(c3, par->ep2_iso.a);
+				fp2_copy(c4, par->ep2_iso.b);
 			} else {
 #endif
-				fp2_copy(c3, ctx->ep2_a);
-				fp2_copy(c4, ctx->ep2_b);
+				fp2_copy(c3, par->ep2_a);
+				fp2_copy(c4, par->ep2_b);
 #ifdef EP_CTMAP
 			}
 #endif
@@ -456,21 +456,21 @@ static void ep2_curve_set_map(void) {
 		} else {
 			/* SvdW map constants */
 			/* constant 1: g(u) = u^3 + a * u + b */
-			fp2_sqr(c1, ctx->ep2_map_u);
-			fp2_add(c1, c1, ctx->ep2_a);
-			fp2_mul(c1, c1, ctx->ep2_map_u);
-			fp2_add(c1, c1, ctx->ep2_b);
+			fp2_sqr(c1, par->ep2_map_u);
+			fp2_add(c1, c1, par->ep2_a);
+			fp2_mul(c1, c1, par->ep2_map_u);
+			fp2_add(c1, c1, par->ep2_b);
 
 			/* constant 2: -u / 2 */
 			fp2_set_dig(c2, 2);
 			fp2_neg(c2, c2);                 /* -2 */
 			fp2_inv(c2, c2);                 /* -1 / 2 */
-			fp2_mul(c2, c2, ctx->ep2_map_u); /* -u / 2 */
+			fp2_mul(c2, c2, par->ep2_map_u); /* -u / 2 */
 
 			/* constant 3: sqrt(-g(u) * (3 * u^2 + 4 * a)) */
-			fp2_sqr(c3, ctx->ep2_map_u);    /* u^2 */
+			fp2_sqr(c3, par->ep2_map_u);    /* u^2 */
 			fp2_mul_dig(c3, c3, 3);         /* 3 * u^2 */
-			fp2_mul_dig(c4, ctx->ep2_a, 4); /* 4 * a */
+			fp2_mul_dig(c4, par->ep2_a, 4); /* 4 * a */
 			fp2_add(c4, c3, c4);            /* 3 * u^2 + 4 * a */
 			fp2_neg(c4, c4);                /* -(3 * u^2 + 4 * a) */
 			fp2_mul(c3, c4, c1);            /* -g(u) * (3 * u^2 + 4 * a) */
@@ -541,38 +541,38 @@ static void detect_opt(int *opt, fp2_t a) {
 /*============================================================================*/
 
 void ep2_curve_init(void) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
 #ifdef EP_PRECO
 	for (int i = 0; i < RLC_EP_TABLE; i++) {
-		ctx->ep2_ptr[i] = &(ctx->ep2_pre[i]);
+		par->ep2_ptr[i] = &(par->ep2_pre[i]);
 	}
 #endif
 
 #if ALLOC == DYNAMIC
-	ep2_new(ctx->ep2_g);
-	fp2_new(ctx->ep2_a);
-	fp2_new(ctx->ep2_b);
-	fp2_new(ctx->ep2_map_u);
+	ep2_new(par->ep2_g);
+	fp2_new(par->ep2_a);
+	fp2_new(par->ep2_b);
+	fp2_new(par->ep2_map_u);
 	for (unsigned i = 0; i < 4; ++i) {
-		fp2_new(ctx->ep2_map_c[i]);
+		fp2_new(par->ep2_map_c[i]);
 	}
-	fp2_new(ctx->ep2_frb[0]);
-	fp2_new(ctx->ep2_frb[1]);
+	fp2_new(par->ep2_frb[0]);
+	fp2_new(par->ep2_frb[1]);
 #endif
 
 #ifdef EP_PRECO
 #if ALLOC == DYNAMIC
 	for (int i = 0; i < RLC_EP_TABLE; i++) {
-		fp2_new(ctx->ep2_pre[i].x);
-		fp2_new(ctx->ep2_pre[i].y);
-		fp2_new(ctx->ep2_pre[i].z);
+		fp2_new(par->ep2_pre[i].x);
+		fp2_new(par->ep2_pre[i].y);
+		fp2_new(par->ep2_pre[i].z);
 	}
 #endif
 #endif
-	ep2_set_infty(ctx->ep2_g);
-	bn_make(&(ctx->ep2_r), RLC_FP_DIGS);
-	bn_make(&(ctx->ep2_h), RLC_FP_DIGS);
+	ep2_set_infty(par->ep2_g);
+	bn_make(&(par->ep2_r), RLC_FP_DIGS);
+	bn_make(&(par->ep2_h), RLC_FP_DIGS);
 
 #ifdef EP_CTMAP
 	iso2_t iso = ep2_curve_get_iso();
@@ -595,17 +595,17 @@ void ep2_curve_init(void) {
 }
 
 void ep2_curve_clean(void) {
-	ctx_t *ctx = core_get();
-	if (ctx != NULL) {
+	params_t *par = core_par_get();
+	if (par != NULL) {
 #ifdef EP_PRECO
 		for (int i = 0; i < RLC_EP_TABLE; i++) {
-			fp2_free(ctx->ep2_pre[i].x);
-			fp2_free(ctx->ep2_pre[i].y);
-			fp2_free(ctx->ep2_pre[i].z);
+			fp2_free(par->ep2_pre[i].x);
+			fp2_free(par->ep2_pre[i].y);
+			fp2_free(par->ep2_pre[i].z);
 		}
 #endif
-		bn_clean(&(ctx->ep2_r));
-		bn_clean(&(ctx->ep2_h));
+		bn_clean(&(par->ep2_r));
+		bn_clean(&(par->ep2_h));
 
 #ifdef EP_CTMAP
 		iso2_t iso = ep2_curve_get_iso();
@@ -619,44 +619,44 @@ void ep2_curve_clean(void) {
 			fp2_free(iso->yd[i]);
 		}
 #endif
-		ep2_free(ctx->ep2_g);
-		fp2_free(ctx->ep2_a);
-		fp2_free(ctx->ep2_b);
-		fp2_free(ctx->ep2_map_u);
+		ep2_free(par->ep2_g);
+		fp2_free(par->ep2_a);
+		fp2_free(par->ep2_b);
+		fp2_free(par->ep2_map_u);
 		for (unsigned i = 0; i < 4; ++i) {
-			fp2_free(ctx->ep2_map_c[i]);
+			fp2_free(par->ep2_map_c[i]);
 		}
-		fp2_free(ctx->ep2_frb[0]);
-		fp2_free(ctx->ep2_frb[1]);
+		fp2_free(par->ep2_frb[0]);
+		fp2_free(par->ep2_frb[1]);
 	}
 }
 
 int ep2_curve_opt_a(void) {
-	return core_get()->ep2_opt_a;
+	return core_par_get()->ep2_opt_a;
 }
 
 int ep2_curve_opt_b(void) {
-	return core_get()->ep2_opt_b;
+	return core_par_get()->ep2_opt_b;
 }
 
 int ep2_curve_is_twist(void) {
-	return core_get()->ep2_is_twist;
+	return core_par_get()->ep2_is_twist;
 }
 
 int ep2_curve_is_ctmap(void) {
-	return core_get()->ep2_is_ctmap;
+	return core_par_get()->ep2_is_ctmap;
 }
 
 void ep2_curve_get_gen(ep2_t g) {
-	ep2_copy(g, core_get()->ep2_g);
+	ep2_copy(g, core_par_get()->ep2_g);
 }
 
 fp_t *ep2_curve_get_a(void) {
-	return core_get()->ep2_a;
+	return core_par_get()->ep2_a;
 }
 
 fp_t *ep2_curve_get_b(void) {
-	return core_get()->ep2_b;
+	return core_par_get()->ep2_b;
 }
 
 void ep2_curve_get_vs(bn_t *v) {
@@ -707,21 +707,21 @@ void ep2_curve_get_vs(bn_t *v) {
 }
 
 void ep2_curve_get_ord(bn_t n) {
-	ctx_t *ctx = core_get();
-	if (ctx->ep2_is_twist) {
+	params_t *par = core_par_get();
+	if (par->ep2_is_twist) {
 		ep_curve_get_ord(n);
 	} else {
-		bn_copy(n, &(ctx->ep2_r));
+		bn_copy(n, &(par->ep2_r));
 	}
 }
 
 void ep2_curve_get_cof(bn_t h) {
-	bn_copy(h, &(core_get()->ep2_h));
+	bn_copy(h, &(core_par_get()->ep2_h));
 }
 
 iso2_t ep2_curve_get_iso() {
 #ifdef EP_CTMAP
-	return &core_get()->ep2_iso;
+	return &core_par_get()->ep2_iso;
 #else
 	return NULL;
 #endif /* EP_CTMAP */
@@ -731,9 +731,9 @@ iso2_t ep2_curve_get_iso() {
 
 ep2_t *ep2_curve_get_tab(void) {
 #if ALLOC == AUTO
-	return (ep2_t *)*(core_get()->ep2_ptr);
+	return (ep2_t *)*(core_par_get()->ep2_ptr);
 #else
-	return core_get()->ep2_ptr;
+	return core_par_get()->ep2_ptr;
 #endif
 }
 
@@ -742,7 +742,7 @@ ep2_t *ep2_curve_get_tab(void) {
 void ep2_curve_set_twist(int type) {
 	int ctmap = 0;
 	char str[4 * RLC_FP_BYTES + 1];
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 	ep2_t g;
 	fp2_t a, b, u;
 	bn_t r, h;
@@ -754,9 +754,9 @@ void ep2_curve_set_twist(int type) {
 	bn_null(r);
 	bn_null(h);
 
-	ctx->ep2_is_twist = 0;
+	par->ep2_is_twist = 0;
 	if (type == RLC_EP_MTYPE || type == RLC_EP_DTYPE) {
-		ctx->ep2_is_twist = type;
+		par->ep2_is_twist = type;
 	} else {
 		return;
 	}
@@ -838,27 +838,27 @@ void ep2_curve_set_twist(int type) {
 		fp2_set_dig(g->z, 1);
 		g->coord = BASIC;
 
-		ep2_copy(ctx->ep2_g, g);
-		fp2_copy(ctx->ep2_a, a);
-		fp2_copy(ctx->ep2_b, b);
+		ep2_copy(par->ep2_g, g);
+		fp2_copy(par->ep2_a, a);
+		fp2_copy(par->ep2_b, b);
 
-		detect_opt(&(ctx->ep2_opt_a), ctx->ep2_a);
-		detect_opt(&(ctx->ep2_opt_b), ctx->ep2_b);
+		detect_opt(&(par->ep2_opt_a), par->ep2_a);
+		detect_opt(&(par->ep2_opt_b), par->ep2_b);
 
-		fp2_copy(ctx->ep2_map_u, u);
-		bn_copy(&(ctx->ep2_r), r);
-		bn_copy(&(ctx->ep2_h), h);
-		ctx->ep2_is_ctmap = ctmap;
+		fp2_copy(par->ep2_map_u, u);
+		bn_copy(&(par->ep2_r), r);
+		bn_copy(&(par->ep2_h), h);
+		par->ep2_is_ctmap = ctmap;
 		/* I don't have a better place for this. */
 		fp_prime_calc();
 
-		fp_copy(ctx->ep2_frb[0][0], ctx->fp2_p1[1][0]);
-		fp_copy(ctx->ep2_frb[0][1], ctx->fp2_p1[1][1]);
-		fp_copy(ctx->ep2_frb[1][0], ctx->fp2_p1[2][0]);
-		fp_copy(ctx->ep2_frb[1][1], ctx->fp2_p1[2][1]);
+		fp_copy(par->ep2_frb[0][0], par->fp2_p1[1][0]);
+		fp_copy(par->ep2_frb[0][1], par->fp2_p1[1][1]);
+		fp_copy(par->ep2_frb[1][0], par->fp2_p1[2][0]);
+		fp_copy(par->ep2_frb[1][1], par->fp2_p1[2][1]);
 		if (type == RLC_EP_MTYPE) {
-			fp2_inv(ctx->ep2_frb[0], ctx->ep2_frb[0]);
-			fp2_inv(ctx->ep2_frb[1], ctx->ep2_frb[1]);
+			fp2_inv(par->ep2_frb[0], par->ep2_frb[0]);
+			fp2_inv(par->ep2_frb[1], par->ep2_frb[1]);
 		}
 
 		/* compute constants for hash-to-curve */
@@ -870,7 +870,7 @@ void ep2_curve_set_twist(int type) {
 #endif
 
 #if defined(EP_PRECO)
-		ep2_mul_pre((ep2_t *)ep2_curve_get_tab(), ctx->ep2_g);
+		ep2_mul_pre((ep2_t *)ep2_curve_get_tab(), par->ep2_g);
 #endif
 	}
 	RLC_CATCH_ANY {
@@ -887,17 +887,17 @@ void ep2_curve_set_twist(int type) {
 }
 
 void ep2_curve_set(fp2_t a, fp2_t b, ep2_t g, bn_t r, bn_t h) {
-	ctx_t *ctx = core_get();
-	ctx->ep2_is_twist = 0;
+	params_t *par = core_par_own();
+	par->ep2_is_twist = 0;
 
-	fp2_copy(ctx->ep2_a, a);
-	fp2_copy(ctx->ep2_b, b);
+	fp2_copy(par->ep2_a, a);
+	fp2_copy(par->ep2_b, b);
 
-	ep2_norm(ctx->ep2_g, g);
-	bn_copy(&(ctx->ep2_r), r);
-	bn_copy(&(ctx->ep2_h), h);
+	ep2_norm(par->ep2_g, g);
+	bn_copy(&(par->ep2_r), r);
+	bn_copy(&(par->ep2_h), h);
 
 #if defined(EP_PRECO)
-	ep2_mul_pre((ep2_t *)ep2_curve_get_tab(), ctx->ep2_g);
+	ep2_mul_pre((ep2_t *)ep2_curve_get_tab(), par->ep2_g);
 #endif
 }
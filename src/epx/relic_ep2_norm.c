@@ -111,18 +111,25 @@ void ep2_norm_sim(ep2_t *r, ep2_t *t, int n) {
 		for (i = 0; i < n; i++) {
 			fp2_null(a[i]);
 			fp2_new(a[i]);
-			fp2_copy(a[i], t[i]->z);
+			/* Points at infinity must not zero the accumulated product. */
+			if (ep2_is_infty(t[i])) {
+				fp2_set_dig(a[i], 1);
+			} else {
+				fp2_copy(a[i], t[i]->z);
+			}
 		}
 
 		fp2_inv_sim(a, a, n);
 
 		for (i = 0; i < n; i++) {
+			if (ep2_is_infty(t[i])) {
+				ep2_set_infty(r[i]);
+				continue;
+			}
 			fp2_copy(r[i]->x, t[i]->x);
 			fp2_copy(r[i]->y, t[i]->y);
 			fp2_copy(r[i]->z, a[i]);
-		}
-
-		for (i = 0; i < n; i++) {
+			r[i]->coord = t[i]->coord;
 			ep2_norm_imp(r[i], r[i], 1);
 		}
 	}
@@ -144,74 +144,74 @@ static void detect_opt(int *opt, fp4_t a) {
 /*============================================================================*/
 
 void ep4_curve_init(void) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
 #ifdef EP_PRECO
 	for (int i = 0; i < RLC_EP_TABLE; i++) {
-		ctx->ep4_ptr[i] = &(ctx->ep4_pre[i]);
+		par->ep4_ptr[i] = &(par->ep4_pre[i]);
 	}
 #endif
 
 #if ALLOC == DYNAMIC
-	ep4_new(ctx->ep4_g);
-	fp4_new(ctx->ep4_a);
-	fp4_new(ctx->ep4_b);
+	ep4_new(par->ep4_g);
+	fp4_new(par->ep4_a);
+	fp4_new(par->ep4_b);
 #endif
 
 #ifdef EP_PRECO
 #if ALLOC == DYNAMIC
 	for (int i = 0; i < RLC_EP_TABLE; i++) {
-		fp4_new(ctx->ep4_pre[i].x);
-		fp4_new(ctx->ep4_pre[i].y);
-		fp4_new(ctx->ep4_pre[i].z);
+		fp4_new(par->ep4_pre[i].x);
+		fp4_new(par->ep4_pre[i].y);
+		fp4_new(par->ep4_pre[i].z);
 	}
 #endif
 #endif
-	ep4_set_infty(ctx->ep4_g);
-	bn_make(&(ctx->ep4_r), RLC_FP_DIGS);
-	bn_make(&(ctx->ep4_h), RLC_FP_DIGS);
+	ep4_set_infty(par->ep4_g);
+	bn_make(&(par->ep4_r), RLC_FP_DIGS);
+	bn_make(&(par->ep4_h), RLC_FP_DIGS);
 }
 
 void ep4_curve_clean(void) {
-	ctx_t *ctx = core_get();
-	if (ctx != NULL) {
+	params_t *par = core_par_get();
+	if (par != NULL) {
 #ifdef EP_PRECO
 		for (int i = 0; i < RLC_EP_TABLE; i++) {
-			fp4_free(ctx->ep4_pre[i].x);
-			fp4_free(ctx->ep4_pre[i].y);
-			fp4_free(ctx->ep4_pre[i].z);
+			fp4_free(par->ep4_pre[i].x);
+			fp4_free(par->ep4_pre[i].y);
+			fp4_free(par->ep4_pre[i].z);
 		}
 #endif
-		bn_clean(&(ctx->ep4_r));
-		bn_clean(&(ctx->ep4_h));
-		ep4_free(ctx->ep4_g);
-		fp4_free(ctx->ep4_a);
-		fp4_free(ctx->ep4_b);
+		bn_clean(&(par->ep4_r));
+		bn_clean(&(par->ep4_h));
+		ep4_free(par->ep4_g);
+		fp4_free(par->ep4_a);
+		fp4_free(par->ep4_b);
 	}
 }
 
 int ep4_curve_opt_a(void) {
-	return core_get()->ep4_opt_a;
+	return core_par_get()->ep4_opt_a;
 }
 
 int ep4_curve_opt_b(void) {
-	return core_get()->ep4_opt_b;
+	return core_par_get()->ep4_opt_b;
 }
 
 int ep4_curve_is_twist(void) {
-	return core_get()->ep4_is_twist;
+	return core_par_get()->ep4_is_twist;
 }
 
 void ep4_curve_get_gen(ep4_t g) {
-	ep4_copy(g, core_get()->ep4_g);
+	ep4_copy(g, core_par_get()->ep4_g);
 }
 
 void ep4_curve_get_a(fp4_t a) {
-	fp4_copy(a, core_get()->ep4_a);
+	fp4_copy(a, core_par_get()->ep4_a);
 }
 
 void ep4_curve_get_b(fp4_t b) {
-	fp4_copy(b, core_get()->ep4_b);
+	fp4_copy(b, core_par_get()->ep4_b);
 }
 
 void ep4_curve_get_vs(bn_t *v) {
@@ -262,25 +262,25 @@ void ep4_curve_get_vs(bn_t *v) {
 }
 
 void ep4_curve_get_ord(bn_t n) {
-	ctx_t *ctx = core_get();
-	if (ctx->ep4_is_twist) {
+	params_t *par = core_par_get();
+	if (par->ep4_is_twist) {
 		ep_curve_get_ord(n);
 	} else {
-		bn_copy(n, &(ctx->ep4_r));
+		bn_copy(n, &(par->ep4_r));
 	}
 }
 
 void ep4_curve_get_cof(bn_t h) {
-	bn_copy(h, &(core_get()->ep4_h));
+	bn_copy(h, &(core_par_get()->ep4_h));
 }
 
 #if defined(EP_PRECO)
 
 ep4_t *ep4_curve_get_tab(void) {
 #if ALLOC == AUTO
-	return (ep4_t *)*(core_get()->ep4_ptr);
+	return (ep4_t *)*(core_par_get()->ep4_ptr);
 #else
-	return core_get()->ep4_ptr;
+	return core_par_get()->ep4_ptr;
 #endif
 }
 
@@ -288,7 +288,7 @@ ep4_t *ep4_curve_get_tab(void) {
 
 void ep4_curve_set_twist(int type) {
 	char str[8 * RLC_FP_BYTES + 1];
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 	ep4_t g;
 	fp4_t a, b;
 	bn_t r, h;
@@ -299,9 +299,9 @@ void ep4_curve_set_twist(int type) {
 	bn_null(r);
 	bn_null(h);
 
-	ctx->ep4_is_twist = 0;
+	par->ep4_is_twist = 0;
 	if (type == RLC_EP_MTYPE || type == RLC_EP_DTYPE) {
-		ctx->ep4_is_twist = type;
+		par->ep4_is_twist = type;
 	} else {
 		return;
 	}
@@ -329,15 +329,15 @@ void ep4_curve_set_twist(int type) {
 		fp4_set_dig(g->z, 1);
 		g->coord = BASIC;
 
-		ep4_copy(ctx->ep4_g, g);
-		fp4_copy(ctx->ep4_a, a);
-		fp4_copy(ctx->ep4_b, b);
+		ep4_copy(par->ep4_g, g);
+		fp4_copy(par->ep4_a, a);
+		fp4_copy(par->ep4_b, b);
 
-		detect_opt(&(ctx->ep4_opt_a), ctx->ep4_a);
-		detect_opt(&(ctx->ep4_opt_b), ctx->ep4_b);
+		detect_opt(&(par->ep4_opt_a), par->ep4_a);
+		detect_opt(&(par->ep4_opt_b), par->ep4_b);
 
-		bn_copy(&(ctx->ep4_r), r);
-		bn_copy(&(ctx->ep4_h), h);
+		bn_copy(&(par->ep4_r), r);
+		bn_copy(&(par->ep4_h), h);
 
 #if defined(WITH_PC)
 		/* Compute pairing generator. */
@@ -345,7 +345,7 @@ void ep4_curve_set_twist(int type) {
 #endif
 
 #if defined(EP_PRECO)
-		ep4_mul_pre((ep4_t *)ep4_curve_get_tab(), ctx->ep4_g);
+		ep4_mul_pre((ep4_t *)ep4_curve_get_tab(), par->ep4_g);
 #endif
 	}
 	RLC_CATCH_ANY {
@@ -361,17 +361,17 @@ void ep4_curve_set_twist(int type) {
 }
 
 void ep4_curve_set(fp4_t a, fp4_t b, ep4_t g, bn_t r, bn_t h) {
-	ctx_t *ctx = core_get();
-	ctx->ep4_is_twist = 0;
+	params_t *par = core_par_own();
+	par->ep4_is_twist = 0;
 
-	fp4_copy(ctx->ep4_a, a);
-	fp4_copy(ctx->ep4_b, b);
+	fp4_copy(par->ep4_a, a);
+	fp4_copy(par->ep4_b, b);
 
-	ep4_norm(ctx->ep4_g, g);
-	bn_copy(&(ctx->ep4_r), r);
-	bn_copy(&(ctx->ep4_h), h);
+	ep4_norm(par->ep4_g, g);
+	bn_copy(&(par->ep4_r), r);
+	bn_copy(&(par->ep4_h), h);
 
 #if defined(EP_PRECO)
-	ep4_mul_pre((ep4_t *)ep4_curve_get_tab(), ctx->ep4_g);
+	ep4_mul_pre((ep4_t *)ep4_curve_get_tab(), par->ep4_g);
 #endif
 }
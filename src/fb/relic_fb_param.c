@@ -44,10 +44,11 @@
 /*============================================================================*/
 
 int fb_param_get(void) {
-	return core_get()->fb_id;
+	return core_par_get()->fb_id;
 }
 
 void fb_param_set(int param) {
+	core_par_own();
 	switch (param) {
 		case PENTA_8:
 			fb_poly_set_penta(4, 3, 2);
@@ -138,7 +139,7 @@ void fb_param_set(int param) {
 			RLC_THROW(ERR_NO_VALID);
 			break;
 	}
-	core_get()->fb_id = param;
+	core_par_get()->fb_id = param;
 }
 
 void fb_param_set_any(void) {
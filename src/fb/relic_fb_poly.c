@@ -54,12 +54,12 @@
 static void find_trace(void) {
 	fb_t t0, t1;
 	int counter;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
 	fb_null(t0);
 	fb_null(t1);
 
-	ctx->fb_ta = ctx->fb_tb = ctx->fb_tc = -1;
+	par->fb_ta = par->fb_tb = par->fb_tc = -1;
 
 	RLC_TRY {
 		fb_new(t0);
@@ -77,15 +77,15 @@ static void find_trace(void) {
 			if (!fb_is_zero(t0)) {
 				switch (counter) {
 					case 0:
-						ctx->fb_ta = i;
-						ctx->fb_tb = ctx->fb_tc = -1;
+						par->fb_ta = i;
+						par->fb_tb = par->fb_tc = -1;
 						break;
 					case 1:
-						ctx->fb_tb = i;
-						ctx->fb_tc = -1;
+						par->fb_tb = i;
+						par->fb_tc = -1;
 						break;
 					case 2:
-						ctx->fb_tc = i;
+						par->fb_tc = i;
 						break;
 					default:
 						RLC_THROW(ERR_NO_VALID);
@@ -116,7 +116,7 @@ static void find_trace(void) {
 static void find_solve(void) {
 	int i, j, k, l;
 	fb_t t0;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
 	fb_null(t0);
 
@@ -132,14 +132,14 @@ static void find_solve(void) {
 						fb_set_bit(t0, i + 2 * k + 1, 1);
 					}
 				}
-				fb_copy(ctx->fb_half[l][j], t0);
+				fb_copy(par->fb_half[l][j], t0);
 				for (k = 0; k < (RLC_FB_BITS - 1) / 2; k++) {
-					fb_sqr(ctx->fb_half[l][j], ctx->fb_half[l][j]);
-					fb_sqr(ctx->fb_half[l][j], ctx->fb_half[l][j]);
-					fb_add(ctx->fb_half[l][j], ctx->fb_half[l][j], t0);
+					fb_sqr(par->fb_half[l][j], par->fb_half[l][j]);
+					fb_sqr(par->fb_half[l][j], par->fb_half[l][j]);
+					fb_add(par->fb_half[l][j], par->fb_half[l][j], t0);
 				}
 			}
-			fb_rsh(ctx->fb_half[l][j], ctx->fb_half[l][j], 1);
+			fb_rsh(par->fb_half[l][j], par->fb_half[l][j], 1);
 		}
 	}
 	RLC_CATCH_ANY {
@@ -158,17 +158,17 @@ static void find_solve(void) {
  * Precomputes the square root of z.
  */
 static void find_srz(void) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
-	fb_set_dig(ctx->fb_srz, 2);
+	fb_set_dig(par->fb_srz, 2);
 
 	for (int i = 1; i < RLC_FB_BITS; i++) {
-		fb_sqr(ctx->fb_srz, ctx->fb_srz);
+		fb_sqr(par->fb_srz, par->fb_srz);
 	}
 
 #ifdef FB_PRECO
 	for (int i = 0; i <= 255; i++) {
-		fb_mul_dig(ctx->fb_tab_srz[i], ctx->fb_srz, i);
+		fb_mul_dig(par->fb_tab_srz[i], par->fb_srz, i);
 	}
 #endif
 }
@@ -182,64 +182,64 @@ static void find_srz(void) {
  */
 static void find_chain(void) {
 	int i, j, k, l, x, y, u[RLC_TERMS + 1];
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
-	ctx->chain_len = -1;
+	par->chain_len = -1;
 	for (int i = 0; i < RLC_TERMS; i++) {
-		ctx->chain[i] = (i << 8) + i;
+		par->chain[i] = (i << 8) + i;
 	}
 	switch (RLC_FB_BITS) {
 		case 127:
-			ctx->chain[1] = (1 << 8) + 0;
-			ctx->chain[4] = (4 << 8) + 2;
-			ctx->chain[7] = (7 << 8) + 2;
-			ctx->chain_len = 9;
+			par->chain[1] = (1 << 8) + 0;
+			par->chain[4] = (4 << 8) + 2;
+			par->chain[7] = (7 << 8) + 2;
+			par->chain_len = 9;
 			break;
 		case 193:
-			ctx->chain[1] = (1 << 8) + 0;
-			ctx->chain_len = 8;
+			par->chain[1] = (1 << 8) + 0;
+			par->chain_len = 8;
 			break;
 		case 233:
-			ctx->chain[1] = (1 << 8) + 0;
-			ctx->chain[3] = (3 << 8) + 0;
-			ctx->chain[6] = (6 << 8) + 0;
-			ctx->chain_len = 10;
+			par->chain[1] = (1 << 8) + 0;
+			par->chain[3] = (3 << 8) + 0;
+			par->chain[6] = (6 << 8) + 0;
+			par->chain_len = 10;
 			break;
 		case 251:
-			ctx->chain[1] = (1 << 8) + 0;
-			ctx->chain[2] = (2 << 8) + 1;
-			ctx->chain[4] = (4 << 8) + 3;
-			ctx->chain[5] = (5 << 8) + 4;
-			ctx->chain[7] = (7 << 8) + 6;
-			ctx->chain[8] = (8 << 8) + 7;
-			ctx->chain_len = 10;
+			par->chain[1] = (1 << 8) + 0;
+			par->chain[2] = (2 << 8) + 1;
+			par->chain[4] = (4 << 8) + 3;
+			par->chain[5] = (5 << 8) + 4;
+			par->chain[7] = (7 << 8) + 6;
+			par->chain[8] = (8 << 8) + 7;
+			par->chain_len = 10;
 			break;
 		case 283:
-			ctx->chain[4] = (4 << 8) + 0;
-			ctx->chain[6] = (6 << 8) + 0;
-			ctx->chain[9] = (9 << 8) + 0;
-			ctx->chain_len = 11;
+			par->chain[4] = (4 << 8) + 0;
+			par->chain[6] = (6 << 8) + 0;
+			par->chain[9] = (9 << 8) + 0;
+			par->chain_len = 11;
 			break;
 		case 353:
-			ctx->chain[2] = (2 << 8) + 0;
-			ctx->chain[4] = (4 << 8) + 0;
-			ctx->chain_len = 10;
+			par->chain[2] = (2 << 8) + 0;
+			par->chain[4] = (4 << 8) + 0;
+			par->chain_len = 10;
 			break;
 		case 367:
-			ctx->chain[1] = (1 << 8) + 0;
-			ctx->chain[2] = (2 << 8) + 1;
-			ctx->chain[6] = (6 << 8) + 3;
-			ctx->chain[9] = (9 << 8) + 2;
-			ctx->chain_len = 11;
+			par->chain[1] = (1 << 8) + 0;
+			par->chain[2] = (2 << 8) + 1;
+			par->chain[6] = (6 << 8) + 3;
+			par->chain[9] = (9 << 8) + 2;
+			par->chain_len = 11;
 			break;
 		case 1223:
-			ctx->chain[1] = (1 << 8) + 0;
-			ctx->chain[2] = (2 << 8) + 0;
-			ctx->chain[4] = (4 << 8) + 2;
-			ctx->chain[5] = (5 << 8) + 4;
-			ctx->chain[10] = (10 << 8) + 2;
-			ctx->chain[11] = (11 << 8) + 10;
-			ctx->chain_len = 13;
+			par->chain[1] = (1 << 8) + 0;
+			par->chain[2] = (2 << 8) + 0;
+			par->chain[4] = (4 << 8) + 2;
+			par->chain[5] = (5 << 8) + 4;
+			par->chain[10] = (10 << 8) + 2;
+			par->chain[11] = (11 << 8) + 10;
+			par->chain_len = 13;
 			break;
 		default:
 			l = 0;
@@ -255,11 +255,11 @@ static void find_chain(void) {
 				}
 			}
 			i = 0;
-			ctx->chain_len = k + l;
+			par->chain_len = k + l;
 			while (j != 1) {
 				if ((j & 0x01) != 0) {
 					i++;
-					ctx->chain[ctx->chain_len - i] = ((ctx->chain_len - i) << 8) + 0;
+					par->chain[par->chain_len - i] = ((par->chain_len - i) << 8) + 0;
 				}
 				i++;
 				j = j >> 1;
@@ -269,9 +269,9 @@ static void find_chain(void) {
 
 	u[0] = 1;
 	u[1] = 2;
-	for (i = 2; i <= ctx->chain_len; i++) {
-		x = ctx->chain[i - 1] >> 8;
-		y = ctx->chain[i - 1] - (x << 8);
+	for (i = 2; i <= par->chain_len; i++) {
+		x = par->chain[i - 1] >> 8;
+		y = par->chain[i - 1] - (x << 8);
 		if (x == y) {
 			u[i] = 2 * u[i - 1];
 		} else {
@@ -279,7 +279,7 @@ static void find_chain(void) {
 		}
 	}
 
-	for (i = 0; i <= ctx->chain_len; i++) {
+	for (i = 0; i <= par->chain_len; i++) {
 		fb_itr_pre((fb_st *)fb_poly_tab_sqr(i), u[i]);
 	}
 }
@@ -292,7 +292,7 @@ static void find_chain(void) {
  * @param[in] f				- the new irreducible polynomial.
  */
 static void fb_poly_set(const fb_t f) {
-	fb_copy(core_get()->fb_poly, f);
+	fb_copy(core_par_get()->fb_poly, f);
 #if FB_TRC == QUICK || !defined(STRIP)
 	find_trace();
 #endif
@@ -312,67 +312,67 @@ static void fb_poly_set(const fb_t f) {
 /*============================================================================*/
 
 void fb_poly_init(void) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
-	fb_zero(ctx->fb_poly);
-	ctx->fb_pa = ctx->fb_pb = ctx->fb_pc = 0;
-	ctx->fb_na = ctx->fb_nb = ctx->fb_nc = -1;
+	fb_zero(par->fb_poly);
+	par->fb_pa = par->fb_pb = par->fb_pc = 0;
+	par->fb_na = par->fb_nb = par->fb_nc = -1;
 }
 
 void fb_poly_clean(void) {
 }
 
 dig_t *fb_poly_get(void) {
-	return core_get()->fb_poly;
+	return core_par_get()->fb_poly;
 }
 
 void fb_poly_add(fb_t c, const fb_t a) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
 	if (c != a) {
 		fb_copy(c, a);
 	}
 
-	if (ctx->fb_pa != 0) {
-		c[RLC_FB_DIGS - 1] ^= ctx->fb_poly[RLC_FB_DIGS - 1];
-		if (ctx->fb_na != RLC_FB_DIGS - 1) {
-			c[ctx->fb_na] ^= ctx->fb_poly[ctx->fb_na];
+	if (par->fb_pa != 0) {
+		c[RLC_FB_DIGS - 1] ^= par->fb_poly[RLC_FB_DIGS - 1];
+		if (par->fb_na != RLC_FB_DIGS - 1) {
+			c[par->fb_na] ^= par->fb_poly[par->fb_na];
 		}
-		if (ctx->fb_pb != 0 && ctx->fb_pc != 0) {
-			if (ctx->fb_nb != ctx->fb_na) {
-				c[ctx->fb_nb] ^= ctx->fb_poly[ctx->fb_nb];
+		if (par->fb_pb != 0 && par->fb_pc != 0) {
+			if (par->fb_nb != par->fb_na) {
+				c[par->fb_nb] ^= par->fb_poly[par->fb_nb];
 			}
-			if (ctx->fb_nc != ctx->fb_na && ctx->fb_nc != ctx->fb_nb) {
-				c[ctx->fb_nc] ^= ctx->fb_poly[ctx->fb_nc];
+			if (par->fb_nc != par->fb_na && par->fb_nc != par->fb_nb) {
+				c[par->fb_nc] ^= par->fb_poly[par->fb_nc];
 			}
 		}
-		if (ctx->fb_na != 0 && ctx->fb_nb != 0 && ctx->fb_nc != 0) {
+		if (par->fb_na != 0 && par->fb_nb != 0 && par->fb_nc != 0) {
 			c[0] ^= 1;
 		}
 	} else {
-		fb_add(c, a, ctx->fb_poly);
+		fb_add(c, a, par->fb_poly);
 	}
 }
 
 void fb_poly_set_dense(const fb_t f) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 	fb_poly_set(f);
-	ctx->fb_pa = ctx->fb_pb = ctx->fb_pc = 0;
-	ctx->fb_na = ctx->fb_nb = ctx->fb_nc = -1;
+	par->fb_pa = par->fb_pb = par->fb_pc = 0;
+	par->fb_na = par->fb_nb = par->fb_nc = -1;
 }
 
 void fb_poly_set_trino(int a) {
 	fb_t f;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 
 	fb_null(f);
 
 	RLC_TRY {
-		ctx->fb_pa = a;
-		ctx->fb_pb = ctx->fb_pc = 0;
+		par->fb_pa = a;
+		par->fb_pb = par->fb_pc = 0;
 
-		ctx->fb_na = ctx->fb_pa >> RLC_DIG_LOG;
-		ctx->fb_nb = ctx->fb_nc = -1;
+		par->fb_na = par->fb_pa >> RLC_DIG_LOG;
+		par->fb_nb = par->fb_nc = -1;
 
 		fb_new(f);
 		fb_zero(f);
@@ -391,20 +391,20 @@ void fb_poly_set_trino(int a) {
 
 void fb_poly_set_penta(int a, int b, int c) {
 	fb_t f;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 
 	fb_null(f);
 
 	RLC_TRY {
 		fb_new(f);
 
-		ctx->fb_pa = a;
-		ctx->fb_pb = b;
-		ctx->fb_pc = c;
+		par->fb_pa = a;
+		par->fb_pb = b;
+		par->fb_pc = c;
 
-		ctx->fb_na = ctx->fb_pa >> RLC_DIG_LOG;
-		ctx->fb_nb = ctx->fb_pb >> RLC_DIG_LOG;
-		ctx->fb_nc = ctx->fb_pc >> RLC_DIG_LOG;
+		par->fb_na = par->fb_pa >> RLC_DIG_LOG;
+		par->fb_nb = par->fb_pb >> RLC_DIG_LOG;
+		par->fb_nc = par->fb_pc >> RLC_DIG_LOG;
 
 		fb_zero(f);
 		fb_set_bit(f, RLC_FB_BITS, 1);
@@ -424,7 +424,7 @@ void fb_poly_set_penta(int a, int b, int c) {
 
 dig_t *fb_poly_get_srz(void) {
 #if FB_SRT == QUICK || !defined(STRIP)
-	return core_get()->fb_srz;
+	return core_par_get()->fb_srz;
 #else
 	return NULL;
 #endif
@@ -433,7 +433,7 @@ dig_t *fb_poly_get_srz(void) {
 const fb_st *fb_poly_tab_sqr(int i) {
 #if FB_INV == ITOHT || !defined(STRIP)
 	/* If ITOHT inversion is used and tables are precomputed, return them. */
-	return (const fb_st *)core_get()->fb_tab_sqr[i];
+	return (const fb_st *)core_par_get()->fb_tab_sqr[i];
 #else
 	return NULL;
 #endif
@@ -443,7 +443,7 @@ const dig_t *fb_poly_tab_srz(int i) {
 #if FB_SRT == QUICK || !defined(STRIP)
 
 #ifdef FB_PRECO
-	return core_get()->fb_tab_srz[i];
+	return core_par_get()->fb_tab_srz[i];
 #else
 	return NULL;
 #endif
@@ -455,25 +455,25 @@ const dig_t *fb_poly_tab_srz(int i) {
 
 void fb_poly_get_trc(int *a, int *b, int *c) {
 #if FB_TRC == QUICK || !defined(STRIP)
-	ctx_t *ctx = core_get();
-	*a = ctx->fb_ta;
-	*b = ctx->fb_tb;
-	*c = ctx->fb_tc;
+	params_t *par = core_par_get();
+	*a = par->fb_ta;
+	*b = par->fb_tb;
+	*c = par->fb_tc;
 #else
 	*a = *b = *c = -1;
 #endif
 }
 
 void fb_poly_get_rdc(int *a, int *b, int *c) {
-	ctx_t *ctx = core_get();
-	*a = ctx->fb_pa;
-	*b = ctx->fb_pb;
-	*c = ctx->fb_pc;
+	params_t *par = core_par_get();
+	*a = par->fb_pa;
+	*b = par->fb_pb;
+	*c = par->fb_pc;
 }
 
 const dig_t *fb_poly_get_slv(void) {
 #if FB_SLV == QUICK || !defined(STRIP)
-	return (dig_t *)&(core_get()->fb_half);
+	return (dig_t *)&(core_par_get()->fb_half);
 #else
 	return NULL;
 #endif
@@ -481,12 +481,12 @@ const dig_t *fb_poly_get_slv(void) {
 
 const int *fb_poly_get_chain(int *len) {
 #if FB_INV == ITOHT || !defined(STRIP)
-	ctx_t *ctx = core_get();
-	if (ctx->chain_len > 0 && ctx->chain_len < RLC_TERMS) {
+	params_t *par = core_par_get();
+	if (par->chain_len > 0 && par->chain_len < RLC_TERMS) {
 		if (len != NULL) {
-			*len = ctx->chain_len;
+			*len = par->chain_len;
 		}
-		return ctx->chain;
+		return par->chain;
 	} else {
 		if (len != NULL) {
 			*len = 0;
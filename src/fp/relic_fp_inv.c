@@ -590,11 +590,11 @@ void fp_inv_jmpds(fp_t c, const fp_t a) {
 
 #if (FP_PRIME % WSIZE) != 0
 		int j = 0;
-		fp_copy(pre, core_get()->inv.dp);
+		fp_copy(pre, core_par_get()->inv.dp);
 #else
-		fp_copy(pre, core_get()->conv.dp);
-		fp_mul(pre, pre, core_get()->conv.dp);
-		fp_mul(pre, pre, core_get()->inv.dp);
+		fp_copy(pre, core_par_get()->conv.dp);
+		fp_mul(pre, pre, core_par_get()->conv.dp);
+		fp_mul(pre, pre, core_par_get()->inv.dp);
 #endif
 
 		f[RLC_FP_DIGS] = g[RLC_FP_DIGS] = 0;
@@ -715,7 +715,7 @@ void fp_inv_jmpds(fp_t c, const fp_t a) {
 			fp_rdcn_low(p11, t);
 			fp_addc_low(t, v0, v1);
 			fp_rdcn_low(p01, t);
-			fp_mulm_low(pre, pre, core_get()->conv.dp);
+			fp_mulm_low(pre, pre, core_par_get()->conv.dp);
 #endif
 		}
 
@@ -75,7 +75,7 @@
 /*============================================================================*/
 
 int fp_param_get(void) {
-	return core_get()->fp_id;
+	return core_par_get()->fp_id;
 }
 
 void fp_param_set(int param) {
@@ -90,13 +90,15 @@ void fp_param_set(int param) {
 	/* Suppress possible unused parameter warning. */
 	(void) f;
 
+	core_par_own();
+
 	RLC_TRY {
 		bn_new(t0);
 		bn_new(t1);
 		bn_new(t2);
 		bn_new(p);
 
-		core_get()->fp_id = param;
+		core_par_get()->fp_id = param;
 
 		switch (param) {
 #if FP_PRIME == 158
@@ -513,7 +515,7 @@ void fp_param_set(int param) {
 #else
 			default:
 				fp_param_set_any_dense();
-				core_get()->fp_id = 0;
+				core_par_get()->fp_id = 0;
 				break;
 #endif
 		}
@@ -46,8 +46,8 @@
  */
 static void fp_prime_set(const bn_t p) {
 	bn_t t;
-	fp_t r;
-	ctx_t *ctx = core_get();
+	fp_t r, s;
+	params_t *par = core_par_get();
 
 	if (p->used != RLC_FP_DIGS) {
 		RLC_THROW(ERR_NO_VALID);
@@ -56,30 +56,32 @@ static void fp_prime_set(const bn_t p) {
 
 	bn_null(t);
 	fp_null(r);
+	fp_null(s);
 
 	RLC_TRY {
 		bn_new(t);
 		fp_new(r);
+		fp_new(s);
 
-		bn_copy(&(ctx->prime), p);
+		bn_copy(&(par->prime), p);
 
 #if FP_RDC == MONTY || !defined(STRIP)
 
-		bn_mod_pre_monty(t, &(ctx->prime));
-		ctx->u = t->dp[0];
+		bn_mod_pre_monty(t, &(par->prime));
+		par->u = t->dp[0];
 
 		/* compute R mod p */
-		bn_set_dig(&(ctx->one), 1);
-		bn_lsh(&(ctx->one), &(ctx->one), RLC_FP_DIGS * RLC_DIG);
-		bn_mod(&(ctx->one), &(ctx->one), &(ctx->prime));
+		bn_set_dig(&(par->one), 1);
+		bn_lsh(&(par->one), &(par->one), RLC_FP_DIGS * RLC_DIG);
+		bn_mod(&(par->one), &(par->one), &(par->prime));
 
 		/* compute the R^2 mod p */
-		fp_add(r, ctx->one.dp, ctx->one.dp);
+		fp_add(r, par->one.dp, par->one.dp);
 		bn_set_dig(t, RLC_FP_DIGS);
 		bn_lsh(t, t, RLC_DIG_LOG);
-		fp_exp(ctx->conv.dp, r, t);
-		ctx->conv.used = RLC_FP_DIGS;
-		bn_trim(&(ctx->conv));
+		fp_exp(par->conv.dp, r, t);
+		par->conv.used = RLC_FP_DIGS;
+		bn_trim(&(par->conv));
 
 #endif /* FP_RDC == MONTY */
 
@@ -94,22 +96,22 @@ static void fp_prime_set(const bn_t p) {
 #else
 		bn_set_dig(t, d);
 #endif
-		ctx->inv.used = RLC_FP_DIGS;
-		dv_copy(ctx->inv.dp, fp_prime_get(), RLC_FP_DIGS);
-		fp_add_dig(ctx->inv.dp, ctx->inv.dp, 1);
-		fp_hlv(ctx->inv.dp, ctx->inv.dp);
-		fp_exp(ctx->inv.dp, ctx->inv.dp, t);
+		par->inv.used = RLC_FP_DIGS;
+		dv_copy(par->inv.dp, fp_prime_get(), RLC_FP_DIGS);
+		fp_add_dig(par->inv.dp, par->inv.dp, 1);
+		fp_hlv(par->inv.dp, par->inv.dp);
+		fp_exp(par->inv.dp, par->inv.dp, t);
 
 #if FP_RDC == MONTY
 
 #if (FP_PRIME % WSIZE) != 0
-		fp_mul(ctx->inv.dp, ctx->inv.dp, ctx->conv.dp);
-		fp_mul(ctx->inv.dp, ctx->inv.dp, ctx->conv.dp);
+		fp_mul(par->inv.dp, par->inv.dp, par->conv.dp);
+		fp_mul(par->inv.dp, par->inv.dp, par->conv.dp);
 
 		for (int i = 1, j = 0; i < d / (RLC_DIG - 2); i++) {
 			j = i % RLC_FP_DIGS;
 			if (j == 0) {
-				fp_mulm_low(ctx->inv.dp, ctx->inv.dp, ctx->conv.dp);
+				fp_mulm_low(par->inv.dp, par->inv.dp, par->conv.dp);
 			}
 		}
 #endif
@@ -119,51 +121,73 @@ static void fp_prime_set(const bn_t p) {
 #endif /* FP_INV */
 
 		/* Now look for proper quadratic/cubic non-residues. */
-		ctx->qnr = ctx->cnr = 0;
-		bn_mod_dig(&(ctx->mod8), &(ctx->prime), 8);
+		par->qnr = par->cnr = 0;
+		bn_mod_dig(&(par->mod8), &(par->prime), 8);
 
-		switch (ctx->mod8) {
+		switch (par->mod8) {
 			case 3:
-				ctx->qnr = -1;
-				ctx->cnr = 2;
+				par->qnr = -1;
+				par->cnr = 2;
 				break;
 			case 7:
-				ctx->qnr = -1;
-				ctx->cnr = -2;
+				par->qnr = -1;
+				par->cnr = -2;
 				/* TODO: implement cube root to handle this better. */
 #if FP_PRIME == 638
-				ctx->cnr = -3;
+				par->cnr = -3;
 #endif
 				break;
 			case 1:
 			case 5:
-				ctx->qnr = -2;
-				ctx->cnr = 2;
+				par->qnr = -2;
+				par->cnr = 2;
 				/* Check if it is a quadratic non-residue or find another. */
-				fp_set_dig(r, -ctx->qnr);
+				fp_set_dig(r, -par->qnr);
 				fp_neg(r, r);
-				while (fp_srt(r, r) == 1) {
-					ctx->qnr--;
-					fp_set_dig(r, -ctx->qnr);
+				while (fp_smb(r) == 1) {
+					par->qnr--;
+					fp_set_dig(r, -par->qnr);
 					fp_neg(r, r);
 					/* We cannot guarantee a cubic extension anymore. */
-					ctx->cnr = 0;
+					par->cnr = 0;
 				};
 				break;
 		}
 #ifdef FP_QNRES
-		if (ctx->mod8 != 3) {
+		if (par->mod8 != 3) {
 			RLC_THROW(ERR_NO_VALID);
 		}
 #endif
 
-		ctx->ad2 = 0;
+		par->ad2 = 0;
 		bn_sub_dig(t, p, 1);
 		while (bn_is_even(t)) {
-			ctx->ad2++;
+			par->ad2++;
 			bn_hlv(t, t);
 		}
 
+		/* Precompute constants for square roots, with p - 1 = 2^ad2 * q. */
+		bn_hlv(&(par->srt), t);
+		fp_set_dig(r, -par->qnr);
+		fp_neg(r, r);
+		fp_exp(s, r, &(par->srt));
+		/* Compute srt_r = n^(-(q + 1)/2) and z = n^q for the non-residue n. */
+		fp_mul(par->srt_r, s, r);
+		fp_mul(s, s, par->srt_r);
+		fp_inv(par->srt_r, par->srt_r);
+		fp_inv(par->srt_z[0], s);
+		for (int i = 1; i < RLC_MIN(par->ad2, RLC_FP_SRT_MAX); i++) {
+			fp_sqr(par->srt_z[i], par->srt_z[i - 1]);
+		}
+		/* Tabulate the powers of g = z^(2^(ad2 - w)) of order 2^w. */
+		for (int i = RLC_FP_SRT_WIN; i < par->ad2; i++) {
+			fp_sqr(s, s);
+		}
+		fp_set_dig(par->srt_g[0], 1);
+		for (int i = 1; i < (1 << RLC_FP_SRT_WIN); i++) {
+			fp_mul(par->srt_g[i], par->srt_g[i - 1], s);
+		}
+
 		fp_prime_calc();
 	}
 	RLC_CATCH_ANY {
@@ -172,6 +196,7 @@ static void fp_prime_set(const bn_t p) {
 	RLC_FINALLY {
 		bn_free(t);
 		fp_free(r);
+		fp_free(s);
 	}
 }
 
@@ -180,62 +205,64 @@ static void fp_prime_set(const bn_t p) {
 /*============================================================================*/
 
 void fp_prime_init(void) {
-	ctx_t *ctx = core_get();
-	ctx->fp_id = 0;
-	bn_make(&(ctx->prime), RLC_FP_DIGS);
-	bn_make(&(ctx->par), RLC_FP_DIGS);
+	params_t *par = core_par_get();
+	par->fp_id = 0;
+	bn_make(&(par->prime), RLC_FP_DIGS);
+	bn_make(&(par->par), RLC_FP_DIGS);
+	bn_make(&(par->srt), RLC_FP_DIGS);
 #if FP_RDC == QUICK || !defined(STRIP)
-	ctx->sps_len = 0;
-	memset(ctx->sps, 0, sizeof(ctx->sps));
+	par->sps_len = 0;
+	memset(par->sps, 0, sizeof(par->sps));
 #endif
 #if FP_RDC == MONTY || !defined(STRIP)
-	bn_make(&(ctx->conv), RLC_FP_DIGS);
-	bn_make(&(ctx->one), RLC_FP_DIGS);
+	bn_make(&(par->conv), RLC_FP_DIGS);
+	bn_make(&(par->one), RLC_FP_DIGS);
 #endif
 #if FP_INV == JUMPDS || !defined(STRIP)
-	bn_make(&(ctx->inv), RLC_FP_DIGS);
+	bn_make(&(par->inv), RLC_FP_DIGS);
 #endif /* FP_INV */
 }
 
 void fp_prime_clean(void) {
-	ctx_t *ctx = core_get();
-	if (ctx != NULL) {
-		ctx->fp_id = 0;
+	params_t *par = core_par_get();
+	if (par != NULL) {
+		par->fp_id = 0;
 #if FP_RDC == QUICK || !defined(STRIP)
-		ctx->sps_len = 0;
-		memset(ctx->sps, 0, sizeof(ctx->sps));
+		par->sps_len = 0;
+		memset(par->sps, 0, sizeof(par->sps));
 #endif
 #if FP_RDC == MONTY || !defined(STRIP)
-		bn_clean(&(ctx->one));
-		bn_clean(&(ctx->conv));
+		bn_clean(&(par->one));
+		bn_clean(&(par->conv));
 #endif
 #if FP_INV == JUMPDS || !defined(STRIP)
-		bn_clean(&(ctx->inv));
+		bn_clean(&(par->inv));
 #endif /* FP_INV */
-		bn_clean(&(ctx->prime));
-		bn_clean(&(ctx->par));
+		bn_clean(&(par->prime));
+		bn_clean(&(par->par));
+		bn_clean(&(par->srt));
 	}
 }
 
 const dig_t *fp_prime_get(void) {
-	return core_get()->prime.dp;
+	return core_par_get()->prime.dp;
 }
 
 const dig_t *fp_prime_get_rdc(void) {
-	return &(core_get()->u);
+	return &(core_par_get()->u);
 }
 
 void fp_prime_get_par(bn_t x) {
-	bn_copy(x, &(core_get()->par));
+	bn_copy(x, &(core_par_get()->par));
 }
 
 const int *fp_prime_get_par_sps(int *len) {
-	ctx_t *ctx = core_get();
-	if (ctx->par_len > 0) {
+	params_t *par = core_par_get();
+	if (par->par_len > 0) {
 		if (len != NULL) {
-			*len = ctx->par_len;
+			*len = par->par_len;
 		}
-		return ctx->par_sps;
+		return par->par_sps;
 	}
 	if (len != NULL) {
 		*len = 0;
@@ -245,12 +272,12 @@ const int *fp_prime_get_par_sps(int *len) {
 
 const int *fp_prime_get_sps(int *len) {
 #if FP_RDC == QUICK || !defined(STRIP)
-	ctx_t *ctx = core_get();
-	if (ctx->sps_len > 0 && ctx->sps_len < RLC_TERMS) {
+	params_t *par = core_par_get();
+	if (par->sps_len > 0 && par->sps_len < RLC_TERMS) {
 		if (len != NULL) {
-			*len = ctx->sps_len;
+			*len = par->sps_len;
 		}
-		return ctx->sps;
+		return par->sps;
 	} else {
 		if (len != NULL) {
 			*len = 0;
@@ -264,29 +291,30 @@ const int *fp_prime_get_sps(int *len) {
 
 const dig_t *fp_prime_get_conv(void) {
 #if FP_RDC == MONTY || !defined(STRIP)
-	return core_get()->conv.dp;
+	return core_par_get()->conv.dp;
 #else
 	return NULL;
 #endif
 }
 
 dig_t fp_prime_get_mod8(void) {
-	return core_get()->mod8;
+	return core_par_get()->mod8;
 }
 
 int fp_prime_get_qnr(void) {
-	return core_get()->qnr;
+	return core_par_get()->qnr;
 }
 
 int fp_prime_get_cnr(void) {
-	return core_get()->cnr;
+	return core_par_get()->cnr;
 }
 
 int fp_prime_get_2ad(void) {
-	return core_get()->ad2;
+	return core_par_get()->ad2;
 }
 
 void fp_prime_set_dense(const bn_t p) {
+	core_par_own();
 	fp_prime_set(p);
 #if FP_RDC == QUICK
 	RLC_THROW(ERR_NO_CONFIG);
@@ -295,7 +323,7 @@ void fp_prime_set_dense(const bn_t p) {
 
 void fp_prime_set_pairf(const bn_t x, int pairf) {
 	bn_t p, t0, t1;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 	int len = bn_bits(x) + 1;
 	int8_t s[RLC_FP_BITS + 1];
 
@@ -308,7 +336,7 @@ void fp_prime_set_pairf(const bn_t x, int pairf) {
 		bn_new(t0);
 		bn_new(t1);
 
-		bn_copy(&(ctx->par), x);
+		bn_copy(&(par->par), x);
 		bn_copy(t0, x);
 
 		switch (pairf) {
@@ -432,22 +460,22 @@ void fp_prime_set_pairf(const bn_t x, int pairf) {
 		}
 
 		/* Store parameter in NAF form. */
-		ctx->par_len = 0;
-		bn_rec_naf(s, &len, &(ctx->par), 2);
+		par->par_len = 0;
+		bn_rec_naf(s, &len, &(par->par), 2);
 		/* Fix corner case to avoid problems with sparse representation. */
 		if (s[0] == -1) {
 			s[0] = 1;
 			s[1] = -1;
 		}
-		for (int i = 0; i < len && ctx->par_len < RLC_TERMS; i++) {
+		for (int i = 0; i < len && par->par_len < RLC_TERMS; i++) {
 			if (s[i] > 0) {
-				ctx->par_sps[ctx->par_len++] = i;
+				par->par_sps[par->par_len++] = i;
 			}
 			if (s[i] < 0) {
-				ctx->par_sps[ctx->par_len++] = -i;
+				par->par_sps[par->par_len++] = -i;
 			}
 		}
-		if (ctx->par_len == RLC_TERMS) {
+		if (par->par_len == RLC_TERMS) {
 			RLC_THROW(ERR_NO_VALID);
 		}
 	} RLC_CATCH_ANY {
@@ -465,6 +493,8 @@ void fp_prime_set_pmers(const int *f, int len) {
 	bn_null(p);
 	bn_null(t);
 
+	core_par_own();
+
 	RLC_TRY {
 		bn_new(p);
 		bn_new(t);
@@ -491,12 +521,12 @@ void fp_prime_set_pmers(const int *f, int len) {
 		}
 
 #if FP_RDC == QUICK || !defined(STRIP)
-		ctx_t *ctx = core_get();
+		params_t *par = core_par_get();
 		for (int i = 0; i < len; i++) {
-			ctx->sps[i] = f[i];
+			par->sps[i] = f[i];
 		}
-		ctx->sps[len] = 0;
-		ctx->sps_len = len;
+		par->sps[len] = 0;
+		par->sps_len = len;
 #endif /* FP_RDC == QUICK */
 
 		fp_prime_set(p);
@@ -511,6 +541,7 @@ void fp_prime_set_pmers(const int *f, int len) {
 }
 
 void fp_prime_calc(void) {
+	core_par_own();
 #ifdef WITH_FPX
 	if (fp_prime_get_qnr() != 0) {
 		fp2_field_init();
@@ -531,7 +562,7 @@ void fp_prime_conv(fp_t c, const bn_t a) {
 		bn_new(t);
 
 		/* Reduce a modulo the prime to ensure bounds. */
-		bn_mod(t, a, &(core_get()->prime));
+		bn_mod(t, a, &(core_par_get()->prime));
 
 		if (bn_is_zero(t)) {
 			fp_zero(c);
@@ -540,7 +571,7 @@ void fp_prime_conv(fp_t c, const bn_t a) {
 			dv_copy(c, t->dp, t->used);
 			dv_zero(c + t->used, RLC_FP_DIGS - t->used);
 #if FP_RDC == MONTY
-			fp_mul(c, c, core_get()->conv.dp);
+			fp_mul(c, c, core_par_get()->conv.dp);
 #endif
 		}
 	}
@@ -554,7 +585,7 @@ void fp_prime_conv(fp_t c, const bn_t a) {
 
 void fp_prime_conv_dig(fp_t c, dig_t a) {
 	dv_t t;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
 	bn_null(t);
 
@@ -564,13 +595,13 @@ void fp_prime_conv_dig(fp_t c, dig_t a) {
 #if FP_RDC == MONTY
 		if (a != 1) {
 			dv_zero(t, 2 * RLC_FP_DIGS + 1);
-			t[RLC_FP_DIGS] = fp_mul1_low(t, ctx->conv.dp, a);
+			t[RLC_FP_DIGS] = fp_mul1_low(t, par->conv.dp, a);
 			fp_rdc(c, t);
 		} else {
-			dv_copy(c, ctx->one.dp, RLC_FP_DIGS);
+			dv_copy(c, par->one.dp, RLC_FP_DIGS);
 		}
 #else
-		(void)ctx;
+		(void)par;
 		fp_zero(c);
 		c[0] = a;
 #endif
@@ -26,112 +26,232 @@
  *
  * Implementation of the square root function.
  *
- * @ingroup bn
+ * @ingroup fp
  */
 
 #include "relic_core.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Finishes a square root extraction after the exponentiation. Writes p - 1 as
+ * 2^s * q for odd q and receives r = a^((q + 1)/2) and t = a^q = z^e for the
+ * primitive 2^s-th root of unity z = n^q. The discrete logarithm e is
+ * recovered in windows of RLC_FP_SRT_WIN bits by table lookup, as in
+ * Bernstein's and Sarkar's variants of Tonelli-Shanks, so that the square
+ * root r * z^(-e/2) costs no further exponentiation. The table lookups and
+ * multiplications do not depend on e, but the Tonelli-Shanks fallback for
+ * 2-adicities above RLC_FP_SRT_MAX is not constant time.
+ *
+ * @param[out] c			- the square root of a or of a/n.
+ * @param[in] r				- the value a^((q + 1)/2).
+ * @param[in] t				- the value a^q.
+ * @return					- 1 if a is a square, 0 otherwise.
+ */
+static int fp_srt_log(fp_t c, const fp_t r, const fp_t t) {
+	const params_t *par = core_par_get();
+	const int s = fp_prime_get_2ad();
+	const int w = RLC_MIN(RLC_FP_SRT_WIN, s), l = RLC_CEIL(s, w);
+	int i, j, k, m, d, f, h, result = 1;
+	uint8_t e[RLC_FP_SRT_MAX];
+	fp_t b, g, *u = RLC_ALLOCA(fp_t, l);
+
+	fp_null(b);
+	fp_null(g);
+
+	RLC_TRY {
+		if (u == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (k = 0; k < l; k++) {
+			fp_null(u[k]);
+			fp_new(u[k]);
+		}
+		fp_new(b);
+		fp_new(g);
+
+		if (s > RLC_FP_SRT_MAX) {
+			/* Tables are too large, so fall back to Tonelli-Shanks. */
+			fp_copy(c, r);
+			fp_copy(u[0], t);
+			fp_copy(b, t);
+			for (i = 1; i < s; i++) {
+				fp_sqr(b, b);
+			}
+			if (fp_cmp_dig(b, 1) != RLC_EQ) {
+				/* Compute the root of a/n instead, as (a/n)^q = t/z. */
+				result = 0;
+				fp_mul(c, c, par->srt_r);
+				fp_mul(u[0], u[0], par->srt_z[0]);
+			}
+			fp_copy(g, par->srt_z[0]);
+			m = s;
+			while (fp_cmp_dig(u[0], 1) != RLC_EQ) {
+				fp_copy(b, u[0]);
+				for (i = 0; fp_cmp_dig(b, 1) != RLC_EQ; i++) {
+					fp_sqr(b, b);
+				}
+				fp_copy(b, g);
+				for (j = 0; j < m - i - 1; j++) {
+					fp_sqr(b, b);
+				}
+				m = i;
+				fp_sqr(g, b);
+				fp_mul(u[0], u[0], g);
+				fp_mul(c, c, b);
+			}
+		} else {
+			/* Compute u[k] = t^(2^(s - w * (k + 1))), with u[l - 1] = t. */
+			fp_copy(u[l - 1], t);
+			for (k = l - 2; k >= 0; k--) {
+				fp_sqr(u[k], u[k + 1]);
+				for (i = 1; i < (k == l - 2 ? s - w * (l - 1) : w); i++) {
+					fp_sqr(u[k], u[k]);
+				}
+			}
+
+			/* Recover e from the least significant window upwards. The bits
+			 * of e are secret, so always multiply and scan the whole table. */
+			for (k = 0; k < l; k++) {
+				/* Digit k has d bits and ends at bit m. */
+				d = (k == l - 1 ? s - w * k : w);
+				m = w * k + d;
+				/* Remove the known bits of e, leaving g^digit of order 2^d. */
+				fp_copy(b, u[k]);
+				for (i = 0; i < w * k; i++) {
+					fp_mul(g, b, par->srt_z[i + s - m]);
+					dv_copy_cond(b, g, RLC_FP_DIGS, e[i]);
+				}
+				f = j = 0;
+				for (i = 0; i < (1 << w); i++) {
+					h = (dv_cmp_const(b, par->srt_g[i], RLC_FP_DIGS) == RLC_EQ);
+					j = RLC_SEL(j, i, h);
+					f |= h;
+				}
+				if (!f) {
+					RLC_THROW(ERR_NO_VALID);
+					break;
+				}
+				j >>= (w - d);
+				for (i = 0; i < d; i++) {
+					e[w * k + i] = (j >> i) & 1;
+				}
+			}
+
+			/* Compute c = r * z^(-e/2), or c = r * (1/n)^((q + 1)/2) *
+			 * z^(-(e - 1)/2) for odd e, which is the root of a/n. */
+			fp_copy(c, r);
+			fp_mul(g, c, par->srt_r);
+			dv_copy_cond(c, g, RLC_FP_DIGS, e[0]);
+			result = e[0] ^ 1;
+			for (i = 1; i < s; i++) {
+				fp_mul(g, c, par->srt_z[i - 1]);
+				dv_copy_cond(c, g, RLC_FP_DIGS, e[i]);
+			}
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		for (k = 0; k < l; k++) {
+			fp_free(u[k]);
+		}
+		RLC_FREE(u);
+		fp_free(b);
+		fp_free(g);
+	}
+	return result;
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
 
 int fp_srt(fp_t c, const fp_t a) {
-	bn_t e;
-	fp_t t0;
-	fp_t t1;
-	int r = 0;
+	fp_t r, t;
+	int result = 0;
+
+	if (fp_is_zero(a)) {
+		fp_zero(c);
+		return 1;
+	}
 
-	bn_null(e);
-	fp_null(t0);
-	fp_null(t1);
+	fp_null(r);
+	fp_null(t);
 
+	RLC_TRY {
+		fp_new(r);
+		fp_new(t);
+
+		/* Compute t = a^((q - 1)/2), r = a^((q + 1)/2) and t = a^q. */
+		fp_exp(t, a, &(core_par_get()->srt));
+		fp_mul(r, t, a);
+		fp_mul(t, t, r);
+		result = fp_srt_log(r, r, t);
+		if (result) {
+			fp_copy(c, r);
+		}
+	}
+	RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	}
+	RLC_FINALLY {
+		fp_free(r);
+		fp_free(t);
+	}
+	return result;
+}
+
+int fp_srt_div(fp_t c, const fp_t a, const fp_t b) {
+	fp_t r, t, u;
+	int result = 0;
+
+	if (fp_is_zero(b)) {
+		fp_zero(c);
+		return 0;
+	}
 	if (fp_is_zero(a)) {
 		fp_zero(c);
 		return 1;
 	}
 
+	fp_null(r);
+	fp_null(t);
+	fp_null(u);
+
 	RLC_TRY {
-		bn_new(e);
-		fp_new(t0);
-		fp_new(t1);
-
-		/* Make e = p. */
-		e->used = RLC_FP_DIGS;
-		dv_copy(e->dp, fp_prime_get(), RLC_FP_DIGS);
-
-		if (fp_prime_get_mod8() == 3 || fp_prime_get_mod8() == 7) {
-			/* Easy case, compute a^((p + 1)/4). */
-			bn_add_dig(e, e, 1);
-			bn_rsh(e, e, 2);
-
-			fp_exp(t0, a, e);
-			fp_sqr(t1, t0);
-			r = (fp_cmp(t1, a) == RLC_EQ);
-			fp_copy(c, t0);
-		} else {
-			int f = 0, m = 0;
-
-			/* First, check if there is a root. Compute t1 = a^((p - 1)/2). */
-			bn_rsh(e, e, 1);
-			fp_exp(t0, a, e);
-
-			if (fp_cmp_dig(t0, 1) != RLC_EQ) {
-				/* Nope, there is no square root. */
-				r = 0;
-			} else {
-				r = 1;
-				/* Find a quadratic non-residue modulo p, that is a number t2
-				 * such that (t2 | p) = t2^((p - 1)/2)!= 1. */
-				do {
-					fp_rand(t1);
-					fp_exp(t0, t1, e);
-				} while (fp_cmp_dig(t0, 1) == RLC_EQ);
-
-				/* Write p - 1 as (e * 2^f), odd e. */
-				bn_lsh(e, e, 1);
-				while (bn_is_even(e)) {
-					bn_rsh(e, e, 1);
-					f++;
-				}
+		fp_new(r);
+		fp_new(t);
+		fp_new(u);
 
-				/* Compute t2 = t2^e. */
-				fp_exp(t1, t1, e);
-
-				/* Compute t1 = a^e, c = a^((e + 1)/2) = a^(e/2 + 1), odd e. */
-				bn_rsh(e, e, 1);
-				fp_exp(t0, a, e);
-				fp_mul(e->dp, t0, a);
-				fp_sqr(t0, t0);
-				fp_mul(t0, t0, a);
-				fp_copy(c, e->dp);
-
-				while (1) {
-					if (fp_cmp_dig(t0, 1) == RLC_EQ) {
-						break;
-					}
-					fp_copy(e->dp, t0);
-					for (m = 0; (m < f) && (fp_cmp_dig(t0, 1) != RLC_EQ); m++) {
-						fp_sqr(t0, t0);
-					}
-					fp_copy(t0, e->dp);
-					for (int i = 0; i < f - m - 1; i++) {
-						fp_sqr(t1, t1);
-					}
-					fp_mul(c, c, t1);
-					fp_sqr(t1, t1);
-					fp_mul(t0, t0, t1);
-					f = m;
-				}
-			}
+		/* Compute u = b^(2^s - 1) and t = a * b^(2^(s + 1) - 1). */
+		fp_copy(u, b);
+		for (int i = 1; i < fp_prime_get_2ad(); i++) {
+			fp_sqr(u, u);
+			fp_mul(u, u, b);
 		}
+		fp_sqr(t, u);
+		fp_mul(t, t, b);
+		fp_mul(t, t, a);
+		/* Since b^(2^s * q) = 1, we get t = (a/b)^((q - 1)/2) / b. */
+		fp_exp(t, t, &(core_par_get()->srt));
+		fp_mul(t, t, u);
+		/* Compute r = (a/b)^((q + 1)/2) and t = (a/b)^q. */
+		fp_mul(r, t, a);
+		fp_mul(t, t, b);
+		fp_mul(t, t, r);
+		result = fp_srt_log(c, r, t);
 	}
 	RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	}
 	RLC_FINALLY {
-		bn_free(e);
-		fp_free(t0);
-		fp_free(t1);
+		fp_free(r);
+		fp_free(t);
+		fp_free(u);
 	}
-	return r;
+	return result;
 }
@@ -242,7 +242,7 @@ void fp_read_bin(fp_t a, const uint8_t *bin, int len) {
 		bn_read_bin(t, bin, len);
 
 		/* Reject values out of bounds. */
-		if (bn_sign(t) == RLC_NEG || bn_cmp(t, &core_get()->prime) != RLC_LT) {
+		if (bn_sign(t) == RLC_NEG || bn_cmp(t, &core_par_get()->prime) != RLC_LT) {
 			RLC_THROW(ERR_NO_VALID);
 		} else {
 			if (bn_is_zero(t)) {
@@ -208,15 +208,15 @@ void fp2_mul_art(fp2_t c, fp2_t a) {
 }
 
 void fp2_mul_frb(fp2_t c, fp2_t a, int i, int j) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 
 #if ALLOC == AUTO
 	switch(i) {
 		case 1:
-			fp2_mul(c, a, ctx->fp2_p1[j - 1]);
+			fp2_mul(c, a, par->fp2_p1[j - 1]);
 			break;
 		case 2:
-			fp2_mul(c, a, ctx->fp2_p2[j - 1]);
+			fp2_mul(c, a, par->fp2_p2[j - 1]);
 			break;
 	}
 #else
@@ -229,12 +229,12 @@ void fp2_mul_frb(fp2_t c, fp2_t a, int i, int j) {
 
 		switch(i) {
 			case 1:
-				fp_copy(t[0], ctx->fp2_p1[j - 1][0]);
-				fp_copy(t[1], ctx->fp2_p1[j - 1][1]);
+				fp_copy(t[0], par->fp2_p1[j - 1][0]);
+				fp_copy(t[1], par->fp2_p1[j - 1][1]);
 				break;
 			case 2:
-				fp_copy(t[0], ctx->fp2_p2[j - 1][0]);
-				fp_copy(t[1], ctx->fp2_p2[j - 1][1]);
+				fp_copy(t[0], par->fp2_p2[j - 1][0]);
+				fp_copy(t[1], par->fp2_p2[j - 1][1]);
 				break;
 		}
 
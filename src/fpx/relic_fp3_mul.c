@@ -178,32 +178,32 @@ void fp3_mul_nor(fp3_t c, fp3_t a) {
 }
 
 void fp3_mul_frb(fp3_t c, fp3_t a, int i, int j) {
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_get();
 	fp3_copy(c, a);
 	switch (i % 3) {
 		case 0:
 			if (j % 3 == 1) {
-				fp_mul(c[1], c[1], ctx->fp3_p0[0]);
-				fp_mul(c[2], c[2], ctx->fp3_p0[1]);
+				fp_mul(c[1], c[1], par->fp3_p0[0]);
+				fp_mul(c[2], c[2], par->fp3_p0[1]);
 			}
 			if (j % 3 == 2) {
-				fp_mul(c[1], c[1], ctx->fp3_p0[1]);
-				fp_mul(c[2], c[2], ctx->fp3_p0[0]);
+				fp_mul(c[1], c[1], par->fp3_p0[1]);
+				fp_mul(c[2], c[2], par->fp3_p0[0]);
 			}
 			break;
 		case 1:
-			fp_mul(c[0], c[0], ctx->fp3_p1[j - 1]);
-			fp_mul(c[1], c[1], ctx->fp3_p1[j - 1]);
-			fp_mul(c[2], c[2], ctx->fp3_p1[j - 1]);
-			for (int k = 0; k < (j * ctx->frb3[0]) % 3; k++) {
+			fp_mul(c[0], c[0], par->fp3_p1[j - 1]);
+			fp_mul(c[1], c[1], par->fp3_p1[j - 1]);
+			fp_mul(c[2], c[2], par->fp3_p1[j - 1]);
+			for (int k = 0; k < (j * par->frb3[0]) % 3; k++) {
 				fp3_mul_nor(c, c);
 			}
 			break;
 		case 2:
-			fp_mul(c[0], c[0], ctx->fp3_p2[j - 1]);
-			fp_mul(c[1], c[1], ctx->fp3_p2[j - 1]);
-			fp_mul(c[2], c[2], ctx->fp3_p2[j - 1]);
-			for (int k = 0; k < ctx->frb3[j]; k++) {
+			fp_mul(c[0], c[0], par->fp3_p2[j - 1]);
+			fp_mul(c[1], c[1], par->fp3_p2[j - 1]);
+			fp_mul(c[2], c[2], par->fp3_p2[j - 1]);
+			for (int k = 0; k < par->frb3[j]; k++) {
 				fp3_mul_nor(c, c);
 			}
 			break;
@@ -175,8 +175,8 @@ void fp4_mul_frb(fp4_t c, fp4_t a, int i, int j) {
 	RLC_TRY {
 		fp2_new(t);
 
-		fp_copy(t[0], core_get()->fp4_p1[0]);
-		fp_copy(t[1], core_get()->fp4_p1[1]);
+		fp_copy(t[0], core_par_get()->fp4_p1[0]);
+		fp_copy(t[1], core_par_get()->fp4_p1[1]);
 	    if (i == 1) {
 			for (int k = 0; k < j; k++) {
 	        	fp2_mul(c[0], a[0], t);
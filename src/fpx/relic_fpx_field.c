@@ -43,14 +43,14 @@ int fp2_field_get_qnr() {
 #elif FP_PRIME == 446
 	return 16;
 #else
-	return core_get()->qnr2;
+	return core_par_get()->qnr2;
 #endif
 }
 
 void fp2_field_init(void) {
 	bn_t e;
 	fp2_t t0, t1;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 
 	bn_null(e);
 	fp2_null(t0);
@@ -63,20 +63,20 @@ void fp2_field_init(void) {
 
 		/* Start by finding a quadratic/cubic non-residue. */
 #ifdef FP_QNRES
-		ctx->qnr2 = 1;
+		par->qnr2 = 1;
 #else
 		/* First start with u as quadratic non-residue. */
-		ctx->qnr2 = 0;
+		par->qnr2 = 0;
 		fp_zero(t0[0]);
 		fp_set_dig(t0[1], 1);
 		/* If it does not work, attempt (u + 2), otherwise double. */
 		if (fp2_srt(t1, t0) == 1) {
-			ctx->qnr2 = 2;
-			fp_set_dig(t0[0], ctx->qnr2);
-			while (fp2_srt(t1, t0) == 1 && util_bits_dig(ctx->qnr2) < RLC_DIG - 1) {
+			par->qnr2 = 2;
+			fp_set_dig(t0[0], par->qnr2);
+			while (fp2_srt(t1, t0) == 1 && util_bits_dig(par->qnr2) < RLC_DIG - 1) {
 				/* Pick a power of 2 for efficiency. */
-				ctx->qnr2 *= 2;
-				fp_set_dig(t0[0], ctx->qnr2);
+				par->qnr2 *= 2;
+				fp_set_dig(t0[0], par->qnr2);
 			}
 		}
 #endif /* !FP_QNRES */
@@ -89,21 +89,21 @@ void fp2_field_init(void) {
 		bn_sub_dig(e, e, 1);
 		bn_div_dig(e, e, 6);
 		fp2_exp(t0, t0, e);
-		fp_copy(ctx->fp2_p1[0][0], t0[0]);
-		fp_copy(ctx->fp2_p1[0][1], t0[1]);
+		fp_copy(par->fp2_p1[0][0], t0[0]);
+		fp_copy(par->fp2_p1[0][1], t0[1]);
 		fp2_sqr(t1, t0);
-		fp_copy(ctx->fp2_p1[1][0], t1[0]);
-		fp_copy(ctx->fp2_p1[1][1], t1[1]);
+		fp_copy(par->fp2_p1[1][0], t1[0]);
+		fp_copy(par->fp2_p1[1][1], t1[1]);
 		fp2_mul(t1, t1, t0);
-		fp_copy(ctx->fp2_p1[2][0], t1[0]);
-		fp_copy(ctx->fp2_p1[2][1], t1[1]);
+		fp_copy(par->fp2_p1[2][0], t1[0]);
+		fp_copy(par->fp2_p1[2][1], t1[1]);
 		fp2_sqr(t1, t0);
 		fp2_sqr(t1, t1);
-		fp_copy(ctx->fp2_p1[3][0], t1[0]);
-		fp_copy(ctx->fp2_p1[3][1], t1[1]);
+		fp_copy(par->fp2_p1[3][0], t1[0]);
+		fp_copy(par->fp2_p1[3][1], t1[1]);
 		fp2_mul(t1, t1, t0);
-		fp_copy(ctx->fp2_p1[4][0], t1[0]);
-		fp_copy(ctx->fp2_p1[4][1], t1[1]);
+		fp_copy(par->fp2_p1[4][0], t1[0]);
+		fp_copy(par->fp2_p1[4][1], t1[1]);
 
 		/* Compute QNR^(p - (p mod 4))/4. */
 		fp2_set_dig(t1, 1);
@@ -112,8 +112,8 @@ void fp2_field_init(void) {
 		dv_copy(e->dp, fp_prime_get(), RLC_FP_DIGS);
 		bn_div_dig(e, e, 4);
 		fp2_exp(t0, t0, e);
-		fp_copy(ctx->fp2_p2[0][0], t0[0]);
-		fp_copy(ctx->fp2_p2[0][1], t0[1]);
+		fp_copy(par->fp2_p2[0][0], t0[0]);
+		fp_copy(par->fp2_p2[0][1], t0[1]);
 
 		/* Compute QNR^(p - (p mod 12))/12. */
 		fp2_set_dig(t1, 1);
@@ -122,8 +122,8 @@ void fp2_field_init(void) {
 		dv_copy(e->dp, fp_prime_get(), RLC_FP_DIGS);
 		bn_div_dig(e, e, 12);
 		fp2_exp(t0, t0, e);
-		fp_copy(ctx->fp2_p2[1][0], t0[0]);
-		fp_copy(ctx->fp2_p2[1][1], t0[1]);
+		fp_copy(par->fp2_p2[1][0], t0[0]);
+		fp_copy(par->fp2_p2[1][1], t0[1]);
 
 		/* Compute QNR^(p - (p mod 24))/24. */
 		fp2_set_dig(t1, 1);
@@ -132,8 +132,8 @@ void fp2_field_init(void) {
 		dv_copy(e->dp, fp_prime_get(), RLC_FP_DIGS);
 		bn_div_dig(e, e, 24);
 		fp2_exp(t0, t0, e);
-		fp_copy(ctx->fp2_p2[2][0], t0[0]);
-		fp_copy(ctx->fp2_p2[2][1], t0[1]);
+		fp_copy(par->fp2_p2[2][0], t0[0]);
+		fp_copy(par->fp2_p2[2][1], t0[1]);
 	} RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	} RLC_FINALLY {
@@ -146,7 +146,7 @@ void fp2_field_init(void) {
 void fp3_field_init(void) {
 	bn_t e;
 	fp3_t t0, t1, t2;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 
 	bn_null(e);
 	fp3_null(t0);
@@ -161,15 +161,15 @@ void fp3_field_init(void) {
 
 		/* Compute t0 = u^((p - (p mod 3))/3). */
 		if (fp_prime_get_cnr() < 0) {
-			fp_set_dig(ctx->fp3_p0[0], -fp_prime_get_cnr());
-			fp_neg(ctx->fp3_p0[0], ctx->fp3_p0[0]);
+			fp_set_dig(par->fp3_p0[0], -fp_prime_get_cnr());
+			fp_neg(par->fp3_p0[0], par->fp3_p0[0]);
 		} else {
-			fp_set_dig(ctx->fp3_p0[0], fp_prime_get_cnr());
+			fp_set_dig(par->fp3_p0[0], fp_prime_get_cnr());
 		}
 		bn_read_raw(e, fp_prime_get(), RLC_FP_DIGS);
 		bn_div_dig(e, e, 3);
-		fp_exp(ctx->fp3_p0[0], ctx->fp3_p0[0], e);
-		fp_sqr(ctx->fp3_p0[1], ctx->fp3_p0[0]);
+		fp_exp(par->fp3_p0[0], par->fp3_p0[0], e);
+		fp_sqr(par->fp3_p0[1], par->fp3_p0[0]);
 
 		/* Compute t0 = u^((p - (p mod 6))/6). */
 		fp3_zero(t0);
@@ -179,18 +179,18 @@ void fp3_field_init(void) {
 		fp3_exp(t0, t0, e);
 
 		/* Look for a non-trivial subfield element.. */
-		ctx->frb3[0] = 0;
-		while (ctx->frb3[0] < 3 && fp_is_zero(t0[ctx->frb3[0]++]));
+		par->frb3[0] = 0;
+		while (par->frb3[0] < 3 && fp_is_zero(t0[par->frb3[0]++]));
 		/* Fill rest of table with powers of constant. */
-		fp_copy(ctx->fp3_p1[0], t0[--ctx->frb3[0] % 3]);
+		fp_copy(par->fp3_p1[0], t0[--par->frb3[0] % 3]);
 		fp3_sqr(t1, t0);
-		fp_copy(ctx->fp3_p1[1], t1[(2 * ctx->frb3[0]) % 3]);
+		fp_copy(par->fp3_p1[1], t1[(2 * par->frb3[0]) % 3]);
 		fp3_mul(t2, t1, t0);
-		fp_copy(ctx->fp3_p1[2], t2[(3 * ctx->frb3[0]) % 3]);
+		fp_copy(par->fp3_p1[2], t2[(3 * par->frb3[0]) % 3]);
 		fp3_sqr(t2, t1);
-		fp_copy(ctx->fp3_p1[3], t2[(4 * ctx->frb3[0]) % 3]);
+		fp_copy(par->fp3_p1[3], t2[(4 * par->frb3[0]) % 3]);
 		fp3_mul(t2, t2, t0);
-		fp_copy(ctx->fp3_p1[4], t2[(5 * ctx->frb3[0]) % 3]);
+		fp_copy(par->fp3_p1[4], t2[(5 * par->frb3[0]) % 3]);
 
 		/* Compute t0 = u^((p - (p mod 9))/9). */
 		fp3_zero(t0);
@@ -199,9 +199,9 @@ void fp3_field_init(void) {
 		bn_div_dig(e, e, 9);
 		fp3_exp(t0, t0, e);
 		/* Look for a non-trivial subfield element.. */
-		ctx->frb3[1] = 0;
-		while (ctx->frb3[1] < 3 && fp_is_zero(t0[ctx->frb3[1]++]));
-		fp_copy(ctx->fp3_p2[0], t0[--ctx->frb3[1]]);
+		par->frb3[1] = 0;
+		while (par->frb3[1] < 3 && fp_is_zero(t0[par->frb3[1]++]));
+		fp_copy(par->fp3_p2[0], t0[--par->frb3[1]]);
 
 		/* Compute t0 = u^((p - (p mod 18))/18). */
 		fp3_zero(t0);
@@ -210,9 +210,9 @@ void fp3_field_init(void) {
 		bn_div_dig(e, e, 18);
 		fp3_exp(t0, t0, e);
 		/* Look for a non-trivial subfield element.. */
-		ctx->frb3[2] = 0;
-		while (ctx->frb3[2] < 3 && fp_is_zero(t0[ctx->frb3[2]++]));
-		fp_copy(ctx->fp3_p2[1], t0[--ctx->frb3[2]]);
+		par->frb3[2] = 0;
+		while (par->frb3[2] < 3 && fp_is_zero(t0[par->frb3[2]++]));
+		fp_copy(par->fp3_p2[1], t0[--par->frb3[2]]);
 	} RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	} RLC_FINALLY {
@@ -226,7 +226,7 @@ void fp3_field_init(void) {
 void fp4_field_init() {
 	bn_t e;
 	fp4_t t0;
-	ctx_t *ctx = core_get();
+	params_t *par = core_par_own();
 
 	bn_null(e);
 	fp4_null(t0);
@@ -242,8 +242,8 @@ void fp4_field_init() {
 		bn_sub_dig(e, e, 1);
 		bn_div_dig(e, e, 6);
 		fp4_exp(t0, t0, e);
-		fp_copy(ctx->fp4_p1[0], t0[1][0]);
-		fp_copy(ctx->fp4_p1[1], t0[1][1]);
+		fp_copy(par->fp4_p1[0], t0[1][0]);
+		fp_copy(par->fp4_p1[1], t0[1][1]);
 	} RLC_CATCH_ANY {
 	    RLC_THROW(ERR_CAUGHT);
 	} RLC_FINALLY {
@@ -0,0 +1,113 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * Implementation of the BLAKE2b hash function.
+ *
+ * @ingroup md
+ */
+
+#include <string.h>
+
+#include "relic_conf.h"
+#include "relic_core.h"
+#include "relic_util.h"
+#include "relic_md.h"
+#include "blake2.h"
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Checks at compile time that the hash state fits the public storage.
+ */
+typedef char b2b_fits[sizeof(blake2b_state) <= sizeof(md_b2b_st) ? 1 : -1];
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+#if MD_MAP == B2B256 || !defined(STRIP)
+
+void md_map_b2b256(uint8_t *hash, const uint8_t *msg, int len) {
+	md_b2b_t ctx;
+
+	md_b2b256_init(ctx);
+	md_b2b256_update(ctx, msg, len);
+	md_b2b256_final(hash, ctx);
+}
+
+void md_b2b256_init(md_b2b_t ctx) {
+	if (blake2b_init((blake2b_state *)ctx->state, RLC_MD_LEN_B2B256) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+}
+
+void md_b2b256_update(md_b2b_t ctx, const uint8_t *msg, size_t len) {
+	if (blake2b_update((blake2b_state *)ctx->state, msg, len) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+}
+
+void md_b2b256_final(uint8_t *hash, md_b2b_t ctx) {
+	if (blake2b_final((blake2b_state *)ctx->state, hash, RLC_MD_LEN_B2B256) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+	memset(ctx, 0, sizeof(md_b2b_t));
+}
+
+#endif
+
+#if MD_MAP == B2B512 || !defined(STRIP)
+
+void md_map_b2b512(uint8_t *hash, const uint8_t *msg, int len) {
+	md_b2b_t ctx;
+
+	md_b2b512_init(ctx);
+	md_b2b512_update(ctx, msg, len);
+	md_b2b512_final(hash, ctx);
+}
+
+void md_b2b512_init(md_b2b_t ctx) {
+	if (blake2b_init((blake2b_state *)ctx->state, RLC_MD_LEN_B2B512) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+}
+
+void md_b2b512_update(md_b2b_t ctx, const uint8_t *msg, size_t len) {
+	if (blake2b_update((blake2b_state *)ctx->state, msg, len) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+}
+
+void md_b2b512_final(uint8_t *hash, md_b2b_t ctx) {
+	if (blake2b_final((blake2b_state *)ctx->state, hash, RLC_MD_LEN_B2B512) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+	memset(ctx, 0, sizeof(md_b2b_t));
+}
+
+#endif
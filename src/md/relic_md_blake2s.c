@@ -37,6 +37,15 @@
 #include "relic_md.h"
 #include "blake2.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Checks at compile time that the hash state fits the public storage.
+ */
+typedef char b2s_fits[sizeof(blake2s_state) <= sizeof(md_b2s_st) ? 1 : -1];
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -44,8 +53,30 @@
 #if MD_MAP == B2S160 || !defined(STRIP)
 
 void md_map_b2s160(uint8_t *hash, const uint8_t *msg, int len) {
-	memset(hash, 0, RLC_MD_LEN_B2S160);
-	blake2s(hash, RLC_MD_LEN_B2S160, msg, len, NULL, 0);
+	md_b2s_t ctx;
+
+	md_b2s160_init(ctx);
+	md_b2s160_update(ctx, msg, len);
+	md_b2s160_final(hash, ctx);
+}
+
+void md_b2s160_init(md_b2s_t ctx) {
+	if (blake2s_init((blake2s_state *)ctx->state, RLC_MD_LEN_B2S160) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+}
+
+void md_b2s160_update(md_b2s_t ctx, const uint8_t *msg, size_t len) {
+	if (blake2s_update((blake2s_state *)ctx->state, msg, len) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+}
+
+void md_b2s160_final(uint8_t *hash, md_b2s_t ctx) {
+	if (blake2s_final((blake2s_state *)ctx->state, hash, RLC_MD_LEN_B2S160) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+	memset(ctx, 0, sizeof(md_b2s_t));
 }
 
 #endif
@@ -53,8 +84,30 @@ void md_map_b2s160(uint8_t *hash, const uint8_t *msg, int len) {
 #if MD_MAP == B2S256 || !defined(STRIP)
 
 void md_map_b2s256(uint8_t *hash, const uint8_t *msg, int len) {
-	memset(hash, 0, RLC_MD_LEN_B2S256);
-	blake2s(hash, RLC_MD_LEN_B2S256, msg, len, NULL, 0);
+	md_b2s_t ctx;
+
+	md_b2s256_init(ctx);
+	md_b2s256_update(ctx, msg, len);
+	md_b2s256_final(hash, ctx);
+}
+
+void md_b2s256_init(md_b2s_t ctx) {
+	if (blake2s_init((blake2s_state *)ctx->state, RLC_MD_LEN_B2S256) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+}
+
+void md_b2s256_update(md_b2s_t ctx, const uint8_t *msg, size_t len) {
+	if (blake2s_update((blake2s_state *)ctx->state, msg, len) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+}
+
+void md_b2s256_final(uint8_t *hash, md_b2s_t ctx) {
+	if (blake2s_final((blake2s_state *)ctx->state, hash, RLC_MD_LEN_B2S256) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+	}
+	memset(ctx, 0, sizeof(md_b2s_t));
 }
 
 #endif
@@ -0,0 +1,508 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * Implementation of the BLAKE3 hash function.
+ *
+ * The input is split into chunks of 1 KiB, each hashed independently into a
+ * chaining value, and chaining values are combined pairwise in a binary tree.
+ * Runs of whole chunks are compressed several at a time, one chunk per lane
+ * of a vector register, and runs long enough are split among threads when
+ * the library is built with OpenMP. Chaining values of complete subtrees are
+ * kept in a stack, so the state does not grow with the input length.
+ *
+ * @ingroup md
+ */
+
+#include <string.h>
+
+#include "relic_conf.h"
+#include "relic_core.h"
+#include "relic_arch.h"
+#include "relic_util.h"
+#include "relic_md.h"
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Size in bytes of a BLAKE3 block.
+ */
+#define B3_BLOCK			64
+
+/**
+ * Size in bytes of a BLAKE3 chunk.
+ */
+#define B3_CHUNK			1024
+
+/**
+ * Number of chunks compressed in parallel, so that the compiler can map each
+ * chunk to a lane of a vector register.
+ */
+#define B3_WAY				8
+
+/**
+ * Maximum number of chunks hashed before their chaining values are merged
+ * into the tree.
+ */
+#define B3_BATCH			256
+
+/**
+ * Minimum number of groups of chunks that justifies spawning threads.
+ */
+#define B3_THREADS			4
+
+/**
+ * Domain separation flags.
+ */
+enum {
+	/** Flag for the first block of a chunk. */
+	B3_START = 1,
+	/** Flag for the last block of a chunk. */
+	B3_END = 2,
+	/** Flag for parent nodes. */
+	B3_PARENT = 4,
+	/** Flag for the root node. */
+	B3_ROOT = 8
+};
+
+/**
+ * Forces inlining, so that the lane-parallel code is compiled again for each
+ * instruction set it is called from.
+ */
+#ifdef __GNUC__
+#define B3_INLINE			inline __attribute__((always_inline))
+#else
+#define B3_INLINE			inline
+#endif
+
+/**
+ * Rotates a 32-bit word to the right.
+ */
+#define B3_ROTR(X, I)		(((X) >> (I)) | ((X) << (32 - (I))))
+
+/**
+ * Initial chaining value, shared with SHA-256.
+ */
+static const uint32_t b3_iv[8] = {
+	0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+	0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+/**
+ * Order in which message words are consumed in each round.
+ */
+static const uint8_t b3_sigma[7][16] = {
+	{  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+	{  2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8 },
+	{  3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1 },
+	{ 10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6 },
+	{ 12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4 },
+	{  9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7 },
+	{ 11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13 }
+};
+
+/**
+ * Reads a little-endian 32-bit word.
+ *
+ * @param[in] p				- the bytes to read.
+ * @return the word.
+ */
+static B3_INLINE uint32_t b3_load(const uint8_t *p) {
+	return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+			((uint32_t)p[3] << 24);
+}
+
+/**
+ * Computes the BLAKE3 mixing function on a single state.
+ *
+ * @param[in,out] v			- the state.
+ * @param[in] a				- the index of the first word.
+ * @param[in] b				- the index of the second word.
+ * @param[in] c				- the index of the third word.
+ * @param[in] d				- the index of the fourth word.
+ * @param[in] x				- the first message word.
+ * @param[in] y				- the second message word.
+ */
+static B3_INLINE void b3_g(uint32_t v[16], int a, int b, int c, int d,
+		uint32_t x, uint32_t y) {
+	v[a] += v[b] + x;
+	v[d] = B3_ROTR(v[d] ^ v[a], 16);
+	v[c] += v[d];
+	v[b] = B3_ROTR(v[b] ^ v[c], 12);
+	v[a] += v[b] + y;
+	v[d] = B3_ROTR(v[d] ^ v[a], 8);
+	v[c] += v[d];
+	v[b] = B3_ROTR(v[b] ^ v[c], 7);
+}
+
+/**
+ * Computes the BLAKE3 compression function.
+ *
+ * @param[out] out			- the 16 output words.
+ * @param[in] cv			- the input chaining value.
+ * @param[in] m				- the 16 message words.
+ * @param[in] ctr			- the counter.
+ * @param[in] len			- the number of bytes in the block.
+ * @param[in] flags			- the domain separation flags.
+ */
+static void b3_compress(uint32_t out[16], const uint32_t cv[8],
+		const uint32_t m[16], uint64_t ctr, uint32_t len, uint32_t flags) {
+	uint32_t v[16];
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		v[i] = cv[i];
+	}
+	for (i = 0; i < 4; i++) {
+		v[i + 8] = b3_iv[i];
+	}
+	v[12] = (uint32_t)ctr;
+	v[13] = (uint32_t)(ctr >> 32);
+	v[14] = len;
+	v[15] = flags;
+
+	for (i = 0; i < 7; i++) {
+		const uint8_t *s = b3_sigma[i];
+		b3_g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+		b3_g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+		b3_g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+		b3_g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+		b3_g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+		b3_g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+		b3_g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+		b3_g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+	}
+
+	for (i = 0; i < 8; i++) {
+		out[i] = v[i] ^ v[i + 8];
+		out[i + 8] = v[i + 8] ^ cv[i];
+	}
+}
+
+/**
+ * Compresses a block into a chaining value, keeping only the first half of the
+ * output.
+ *
+ * @param[in,out] cv		- the chaining value.
+ * @param[in] block			- the block of B3_BLOCK bytes.
+ * @param[in] ctr			- the counter.
+ * @param[in] len			- the number of bytes in the block.
+ * @param[in] flags			- the domain separation flags.
+ */
+static void b3_block(uint32_t cv[8], const uint8_t *block, uint64_t ctr,
+		uint32_t len, uint32_t flags) {
+	uint32_t m[16], out[16];
+
+	for (int i = 0; i < 16; i++) {
+		m[i] = b3_load(block + 4 * i);
+	}
+	b3_compress(out, cv, m, ctr, len, flags);
+	memcpy(cv, out, 8 * sizeof(uint32_t));
+}
+
+/**
+ * Computes the chaining value of a parent node.
+ *
+ * @param[out] cv			- the chaining value of the parent.
+ * @param[in] left			- the chaining value of the left child.
+ * @param[in] right			- the chaining value of the right child.
+ */
+static void b3_parent(uint32_t cv[8], const uint32_t left[8],
+		const uint32_t right[8]) {
+	uint32_t m[16], out[16];
+
+	memcpy(m, left, 8 * sizeof(uint32_t));
+	memcpy(m + 8, right, 8 * sizeof(uint32_t));
+	b3_compress(out, b3_iv, m, 0, B3_BLOCK, B3_PARENT);
+	memcpy(cv, out, 8 * sizeof(uint32_t));
+}
+
+/**
+ * Computes the BLAKE3 mixing function on every lane of the state.
+ *
+ * @param[in,out] v			- the state, one word of every chunk per row.
+ * @param[in] a				- the index of the first word.
+ * @param[in] b				- the index of the second word.
+ * @param[in] c				- the index of the third word.
+ * @param[in] d				- the index of the fourth word.
+ * @param[in] x				- the first message words.
+ * @param[in] y				- the second message words.
+ */
+static B3_INLINE void b3_lane_g(uint32_t v[16][B3_WAY], int a, int b, int c,
+		int d, const uint32_t x[B3_WAY], const uint32_t y[B3_WAY]) {
+	for (int l = 0; l < B3_WAY; l++) {
+		v[a][l] += v[b][l] + x[l];
+		v[d][l] = B3_ROTR(v[d][l] ^ v[a][l], 16);
+		v[c][l] += v[d][l];
+		v[b][l] = B3_ROTR(v[b][l] ^ v[c][l], 12);
+		v[a][l] += v[b][l] + y[l];
+		v[d][l] = B3_ROTR(v[d][l] ^ v[a][l], 8);
+		v[c][l] += v[d][l];
+		v[b][l] = B3_ROTR(v[b][l] ^ v[c][l], 7);
+	}
+}
+
+/**
+ * Hashes B3_WAY consecutive chunks into their chaining values.
+ *
+ * @param[out] cv			- the chaining values.
+ * @param[in] in			- the B3_WAY chunks.
+ * @param[in] ctr			- the index of the first chunk.
+ */
+static B3_INLINE void b3_lanes(uint32_t cv[][8], const uint8_t *in,
+		uint64_t ctr) {
+	uint32_t h[8][B3_WAY], m[16][B3_WAY], v[16][B3_WAY];
+	int b, i, l;
+
+	for (i = 0; i < 8; i++) {
+		for (l = 0; l < B3_WAY; l++) {
+			h[i][l] = b3_iv[i];
+		}
+	}
+
+	for (b = 0; b < B3_CHUNK / B3_BLOCK; b++) {
+		/* Transpose the message so that each row holds one word per chunk. */
+		for (l = 0; l < B3_WAY; l++) {
+			for (i = 0; i < 16; i++) {
+				m[i][l] = b3_load(in + l * B3_CHUNK + b * B3_BLOCK + 4 * i);
+			}
+		}
+		for (l = 0; l < B3_WAY; l++) {
+			for (i = 0; i < 8; i++) {
+				v[i][l] = h[i][l];
+			}
+			for (i = 0; i < 4; i++) {
+				v[i + 8][l] = b3_iv[i];
+			}
+			v[12][l] = (uint32_t)(ctr + l);
+			v[13][l] = (uint32_t)((ctr + l) >> 32);
+			v[14][l] = B3_BLOCK;
+			v[15][l] = (b == 0 ? B3_START : 0) |
+					(b == B3_CHUNK / B3_BLOCK - 1 ? B3_END : 0);
+		}
+		for (i = 0; i < 7; i++) {
+			const uint8_t *s = b3_sigma[i];
+			b3_lane_g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+			b3_lane_g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+			b3_lane_g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+			b3_lane_g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+			b3_lane_g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+			b3_lane_g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+			b3_lane_g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+			b3_lane_g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+		}
+		for (i = 0; i < 8; i++) {
+			for (l = 0; l < B3_WAY; l++) {
+				h[i][l] = v[i][l] ^ v[i + 8][l];
+			}
+		}
+	}
+
+	for (l = 0; l < B3_WAY; l++) {
+		for (i = 0; i < 8; i++) {
+			cv[l][i] = h[i][l];
+		}
+	}
+}
+
+/**
+ * Hashes B3_WAY consecutive chunks with the baseline instruction set.
+ *
+ * @param[out] cv			- the chaining values.
+ * @param[in] in			- the B3_WAY chunks.
+ * @param[in] ctr			- the index of the first chunk.
+ */
+static void b3_way(uint32_t cv[][8], const uint8_t *in, uint64_t ctr) {
+	b3_lanes(cv, in, ctr);
+}
+
+#if ARCH == X64 && defined(__GNUC__) && !defined(USE_32BIT_ONLY)
+
+/**
+ * Hashes B3_WAY consecutive chunks with 256-bit vector registers.
+ *
+ * @param[out] cv			- the chaining values.
+ * @param[in] in			- the B3_WAY chunks.
+ * @param[in] ctr			- the index of the first chunk.
+ */
+__attribute__((target("avx2")))
+static void b3_way_avx2(uint32_t cv[][8], const uint8_t *in, uint64_t ctr) {
+	b3_lanes(cv, in, ctr);
+}
+
+#endif
+
+/**
+ * Hashes consecutive whole chunks into their chaining values.
+ *
+ * @param[out] cv			- the chaining values.
+ * @param[in] in			- the chunks.
+ * @param[in] n				- the number of chunks, at most B3_BATCH.
+ * @param[in] ctr			- the index of the first chunk.
+ */
+static void b3_chunks(uint32_t cv[][8], const uint8_t *in, int n,
+		uint64_t ctr) {
+	void (*way)(uint32_t (*)[8], const uint8_t *, uint64_t) = b3_way;
+	int g, groups = n / B3_WAY;
+
+#if ARCH == X64 && defined(__GNUC__) && !defined(USE_32BIT_ONLY)
+	/* Select the backend here, as worker threads have no library context. */
+	if (arch_has(RLC_X64_AVX2)) {
+		way = b3_way_avx2;
+	}
+#endif
+
+#if MULTI == OPENMP
+	#pragma omp parallel for if (groups >= B3_THREADS)
+#endif
+	for (g = 0; g < groups; g++) {
+		way(cv + g * B3_WAY, in + g * B3_WAY * B3_CHUNK, ctr + g * B3_WAY);
+	}
+
+	for (g = groups * B3_WAY; g < n; g++) {
+		memcpy(cv[g], b3_iv, sizeof(b3_iv));
+		for (int b = 0; b < B3_CHUNK / B3_BLOCK; b++) {
+			b3_block(cv[g], in + g * B3_CHUNK + b * B3_BLOCK, ctr + g, B3_BLOCK,
+					(b == 0 ? B3_START : 0) |
+					(b == B3_CHUNK / B3_BLOCK - 1 ? B3_END : 0));
+		}
+	}
+}
+
+/**
+ * Pushes the chaining value of a complete chunk into the tree, merging every
+ * subtree it completes.
+ *
+ * @param[in,out] ctx		- the hash state.
+ * @param[in] cv			- the chaining value of the chunk.
+ */
+static void b3_push(md_blake3_t ctx, const uint32_t cv[8]) {
+	uint32_t t[8];
+	uint64_t total = ++ctx->chunk;
+
+	memcpy(t, cv, sizeof(t));
+	/* Each trailing zero of the chunk count closes one level of the tree. */
+	while ((total & 1) == 0) {
+		b3_parent(t, ctx->stack[--ctx->depth], t);
+		total >>= 1;
+	}
+	memcpy(ctx->stack[ctx->depth++], t, sizeof(t));
+}
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+#if MD_MAP == BLAKE3 || !defined(STRIP)
+
+void md_map_blake3(uint8_t *hash, const uint8_t *msg, int len) {
+	md_blake3_t ctx;
+
+	md_blake3_init(ctx);
+	md_blake3_update(ctx, msg, len);
+	md_blake3_final(hash, ctx);
+}
+
+void md_blake3_init(md_blake3_t ctx) {
+	memset(ctx, 0, sizeof(md_blake3_t));
+	memcpy(ctx->cv, b3_iv, sizeof(b3_iv));
+}
+
+void md_blake3_update(md_blake3_t ctx, const uint8_t *msg, size_t len) {
+	uint32_t cv[B3_BATCH][8];
+	size_t n;
+
+	while (len > 0) {
+		/* A chunk is only closed when more input follows, as the last one
+		 * may be the root. */
+		if (ctx->blocks == B3_CHUNK / B3_BLOCK - 1 && ctx->len == B3_BLOCK) {
+			b3_block(ctx->cv, ctx->buf, ctx->chunk, B3_BLOCK, B3_END);
+			b3_push(ctx, ctx->cv);
+			memcpy(ctx->cv, b3_iv, sizeof(b3_iv));
+			ctx->blocks = ctx->len = 0;
+		}
+
+		if (ctx->blocks == 0 && ctx->len == 0 && len > B3_CHUNK) {
+			/* Hash whole chunks directly from the input. */
+			n = RLC_MIN((len - 1) / B3_CHUNK, B3_BATCH);
+			b3_chunks(cv, msg, (int)n, ctx->chunk);
+			for (size_t i = 0; i < n; i++) {
+				b3_push(ctx, cv[i]);
+			}
+			msg += n * B3_CHUNK;
+			len -= n * B3_CHUNK;
+			continue;
+		}
+
+		if (ctx->len == B3_BLOCK) {
+			b3_block(ctx->cv, ctx->buf, ctx->chunk, B3_BLOCK,
+					ctx->blocks == 0 ? B3_START : 0);
+			ctx->blocks++;
+			ctx->len = 0;
+		}
+		n = RLC_MIN(len, (size_t)(B3_BLOCK - ctx->len));
+		memcpy(ctx->buf + ctx->len, msg, n);
+		ctx->len += n;
+		msg += n;
+		len -= n;
+	}
+	memset(cv, 0, sizeof(cv));
+}
+
+void md_blake3_final(uint8_t *hash, md_blake3_t ctx) {
+	uint32_t cv[8], m[16], out[16];
+	uint32_t len = ctx->len, flags = B3_END | (ctx->blocks == 0 ? B3_START : 0);
+	uint64_t ctr = ctx->chunk;
+	int i;
+
+	/* Start from the last chunk and fold the stack from right to left, so
+	 * that the final compression is the root of the tree. */
+	memcpy(cv, ctx->cv, sizeof(cv));
+	memset(ctx->buf + len, 0, B3_BLOCK - len);
+	for (i = 0; i < 16; i++) {
+		m[i] = b3_load(ctx->buf + 4 * i);
+	}
+	while (ctx->depth > 0) {
+		b3_compress(out, cv, m, ctr, len, flags);
+		memcpy(m, ctx->stack[--ctx->depth], 8 * sizeof(uint32_t));
+		memcpy(m + 8, out, 8 * sizeof(uint32_t));
+		memcpy(cv, b3_iv, sizeof(cv));
+		ctr = 0;
+		len = B3_BLOCK;
+		flags = B3_PARENT;
+	}
+	b3_compress(out, cv, m, ctr, len, flags | B3_ROOT);
+
+	for (i = 0; i < RLC_MD_LEN_BLAKE3; i++) {
+		hash[i] = (uint8_t)(out[i / 4] >> (8 * (i % 4)));
+	}
+	memset(out, 0, sizeof(out));
+	memset(m, 0, sizeof(m));
+	memset(ctx, 0, sizeof(md_blake3_t));
+}
+
+#endif
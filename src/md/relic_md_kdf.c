@@ -43,27 +43,24 @@
 void md_kdf(uint8_t *key, int key_len, const uint8_t *in,
 		int in_len) {
 	uint32_t i, j, d;
-	uint8_t* buffer = RLC_ALLOCA(uint8_t, in_len + sizeof(uint32_t));
-	uint8_t* t = RLC_ALLOCA(uint8_t, key_len + RLC_MD_LEN);
-	if (buffer == NULL || t == NULL) {
-		RLC_FREE(buffer);
-		RLC_FREE(t);
-		RLC_THROW(ERR_NO_MEMORY);
-		return;
-	}
+	uint8_t h[RLC_MD_LEN];
+	md_t z, ctx;
 
 	/* d = ceil(kLen/hLen). */
 	d = RLC_CEIL(key_len, RLC_MD_LEN);
-	memcpy(buffer, in, in_len);
+	/* Absorb the shared secret once and reuse the state for every counter. */
+	md_init(z);
+	md_update(z, in, in_len);
 	for (i = 1; i <= d; i++) {
 		j = util_conv_big(i);
 		/* c = integer_to_string(c, 4). */
-		memcpy(buffer + in_len, &j, sizeof(uint32_t));
+		ctx[0] = z[0];
+		md_update(ctx, (uint8_t *)&j, sizeof(uint32_t));
 		/* t = t || hash(z || c). */
-		md_map(t + (i - 1) * RLC_MD_LEN, buffer, in_len + sizeof(uint32_t));
+		md_final(h, ctx);
+		memcpy(key + (i - 1) * RLC_MD_LEN, h,
+				RLC_MIN(RLC_MD_LEN, key_len - (i - 1) * RLC_MD_LEN));
 	}
-	memcpy(key, t, key_len);
-
-	RLC_FREE(buffer);
-	RLC_FREE(t);
+	memset(z, 0, sizeof(md_t));
+	memset(h, 0, sizeof(h));
 }
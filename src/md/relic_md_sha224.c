@@ -29,11 +29,23 @@
  * @ingroup md
  */
 
+#include <limits.h>
+#include <string.h>
+
 #include "relic_conf.h"
 #include "relic_core.h"
 #include "relic_md.h"
 #include "sha.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Checks at compile time that the hash state fits the public storage.
+ */
+typedef char sh224_fits[sizeof(SHA224Context) <= sizeof(md_sh256_st) ? 1 : -1];
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -41,20 +53,39 @@
 #if MD_MAP == SH224 || !defined(STRIP)
 
 void md_map_sh224(uint8_t *hash, const uint8_t *msg, int len) {
-	SHA224Context ctx;
+	md_sh256_t ctx;
 
-	if (SHA224Reset(&ctx) != shaSuccess) {
+	md_sh224_init(ctx);
+	md_sh224_update(ctx, msg, len);
+	md_sh224_final(hash, ctx);
+}
+
+void md_sh224_init(md_sh256_t ctx) {
+	if (SHA224Reset((SHA224Context *)ctx->state) != shaSuccess) {
 		RLC_THROW(ERR_NO_VALID);
-		return;
 	}
-	if (SHA224Input(&ctx, msg, len) != shaSuccess) {
-		RLC_THROW(ERR_NO_VALID);
-		return;
+}
+
+void md_sh224_update(md_sh256_t ctx, const uint8_t *msg, size_t len) {
+	unsigned int l;
+
+	/* Split the input for the unsigned lengths of the implementation. */
+	while (len > 0) {
+		l = (unsigned int)RLC_MIN(len, UINT_MAX);
+		if (SHA224Input((SHA224Context *)ctx->state, msg, l) != shaSuccess) {
+			RLC_THROW(ERR_NO_VALID);
+			return;
+		}
+		msg += l;
+		len -= l;
 	}
-	if (SHA224Result(&ctx, hash) != shaSuccess) {
+}
+
+void md_sh224_final(uint8_t *hash, md_sh256_t ctx) {
+	if (SHA224Result((SHA224Context *)ctx->state, hash) != shaSuccess) {
 		RLC_THROW(ERR_NO_VALID);
-		return;
 	}
+	memset(ctx, 0, sizeof(md_sh256_t));
 }
 
 #endif
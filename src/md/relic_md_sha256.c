@@ -29,11 +29,23 @@
  * @ingroup md
  */
 
+#include <limits.h>
+#include <string.h>
+
 #include "relic_conf.h"
 #include "relic_core.h"
 #include "relic_md.h"
 #include "sha.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Checks at compile time that the hash state fits the public storage.
+ */
+typedef char sh256_fits[sizeof(SHA256Context) <= sizeof(md_sh256_st) ? 1 : -1];
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -41,20 +53,39 @@
 #if MD_MAP == SH256 || !defined(STRIP)
 
 void md_map_sh256(uint8_t *hash, const uint8_t *msg, int len) {
-	SHA256Context ctx;
+	md_sh256_t ctx;
 
-	if (SHA256Reset(&ctx) != shaSuccess) {
+	md_sh256_init(ctx);
+	md_sh256_update(ctx, msg, len);
+	md_sh256_final(hash, ctx);
+}
+
+void md_sh256_init(md_sh256_t ctx) {
+	if (SHA256Reset((SHA256Context *)ctx->state) != shaSuccess) {
 		RLC_THROW(ERR_NO_VALID);
-		return;
 	}
-	if (SHA256Input(&ctx, msg, len) != shaSuccess) {
-		RLC_THROW(ERR_NO_VALID);
-		return;
+}
+
+void md_sh256_update(md_sh256_t ctx, const uint8_t *msg, size_t len) {
+	unsigned int l;
+
+	/* Split the input for the unsigned lengths of the implementation. */
+	while (len > 0) {
+		l = (unsigned int)RLC_MIN(len, UINT_MAX);
+		if (SHA256Input((SHA256Context *)ctx->state, msg, l) != shaSuccess) {
+			RLC_THROW(ERR_NO_VALID);
+			return;
+		}
+		msg += l;
+		len -= l;
 	}
-	if (SHA256Result(&ctx, hash) != shaSuccess) {
+}
+
+void md_sh256_final(uint8_t *hash, md_sh256_t ctx) {
+	if (SHA256Result((SHA256Context *)ctx->state, hash) != shaSuccess) {
 		RLC_THROW(ERR_NO_VALID);
-		return;
 	}
+	memset(ctx, 0, sizeof(md_sh256_t));
 }
 
 #endif
@@ -29,11 +29,23 @@
  * @ingroup md
  */
 
+#include <limits.h>
+#include <string.h>
+
 #include "relic_conf.h"
 #include "relic_core.h"
 #include "relic_md.h"
 #include "sha.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Checks at compile time that the hash state fits the public storage.
+ */
+typedef char sh384_fits[sizeof(SHA384Context) <= sizeof(md_sh512_st) ? 1 : -1];
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -41,20 +53,39 @@
 #if MD_MAP == SH384 || !defined(STRIP)
 
 void md_map_sh384(uint8_t *hash, const uint8_t *msg, int len) {
-	SHA384Context ctx;
+	md_sh512_t ctx;
 
-	if (SHA384Reset(&ctx) != shaSuccess) {
+	md_sh384_init(ctx);
+	md_sh384_update(ctx, msg, len);
+	md_sh384_final(hash, ctx);
+}
+
+void md_sh384_init(md_sh512_t ctx) {
+	if (SHA384Reset((SHA384Context *)ctx->state) != shaSuccess) {
 		RLC_THROW(ERR_NO_VALID);
-		return;
 	}
-	if (SHA384Input(&ctx, msg, len) != shaSuccess) {
-		RLC_THROW(ERR_NO_VALID);
-		return;
+}
+
+void md_sh384_update(md_sh512_t ctx, const uint8_t *msg, size_t len) {
+	unsigned int l;
+
+	/* Split the input for the unsigned lengths of the implementation. */
+	while (len > 0) {
+		l = (unsigned int)RLC_MIN(len, UINT_MAX);
+		if (SHA384Input((SHA384Context *)ctx->state, msg, l) != shaSuccess) {
+			RLC_THROW(ERR_NO_VALID);
+			return;
+		}
+		msg += l;
+		len -= l;
 	}
-	if (SHA384Result(&ctx, hash) != shaSuccess) {
+}
+
+void md_sh384_final(uint8_t *hash, md_sh512_t ctx) {
+	if (SHA384Result((SHA384Context *)ctx->state, hash) != shaSuccess) {
 		RLC_THROW(ERR_NO_VALID);
-		return;
 	}
+	memset(ctx, 0, sizeof(md_sh512_t));
 }
 
 #endif
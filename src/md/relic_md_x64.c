@@ -0,0 +1,276 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * Implementation of the SHA-256 and SHA-512 compression functions with x64
+ * instruction set extensions.
+ *
+ * SHA-256 uses the SHA extensions, which compute two rounds per instruction
+ * and four words of the message schedule in two instructions. SHA-512 has no
+ * such support on most processors, so the message schedule of two blocks is
+ * computed in AVX2 registers and the rounds use the BMI2 rotations.
+ *
+ * @ingroup md
+ */
+
+#include <string.h>
+
+#include "sha.h"
+
+#ifdef SHA_X64
+
+#include <immintrin.h>
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Round constants of SHA-256.
+ */
+static const uint32_t sha256_k[64] = {
+	0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1,
+	0x923F82A4, 0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+	0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786,
+	0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+	0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147,
+	0x06CA6351, 0x14292967, 0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+	0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B,
+	0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+	0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A,
+	0x5B9CCA4F, 0x682E6FF3, 0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+	0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2
+};
+
+/**
+ * Round constants of SHA-512.
+ */
+static const uint64_t sha512_k[80] = {
+	0x428A2F98D728AE22, 0x7137449123EF65CD, 0xB5C0FBCFEC4D3B2F,
+	0xE9B5DBA58189DBBC, 0x3956C25BF348B538, 0x59F111F1B605D019,
+	0x923F82A4AF194F9B, 0xAB1C5ED5DA6D8118, 0xD807AA98A3030242,
+	0x12835B0145706FBE, 0x243185BE4EE4B28C, 0x550C7DC3D5FFB4E2,
+	0x72BE5D74F27B896F, 0x80DEB1FE3B1696B1, 0x9BDC06A725C71235,
+	0xC19BF174CF692694, 0xE49B69C19EF14AD2, 0xEFBE4786384F25E3,
+	0x0FC19DC68B8CD5B5, 0x240CA1CC77AC9C65, 0x2DE92C6F592B0275,
+	0x4A7484AA6EA6E483, 0x5CB0A9DCBD41FBD4, 0x76F988DA831153B5,
+	0x983E5152EE66DFAB, 0xA831C66D2DB43210, 0xB00327C898FB213F,
+	0xBF597FC7BEEF0EE4, 0xC6E00BF33DA88FC2, 0xD5A79147930AA725,
+	0x06CA6351E003826F, 0x142929670A0E6E70, 0x27B70A8546D22FFC,
+	0x2E1B21385C26C926, 0x4D2C6DFC5AC42AED, 0x53380D139D95B3DF,
+	0x650A73548BAF63DE, 0x766A0ABB3C77B2A8, 0x81C2C92E47EDAEE6,
+	0x92722C851482353B, 0xA2BFE8A14CF10364, 0xA81A664BBC423001,
+	0xC24B8B70D0F89791, 0xC76C51A30654BE30, 0xD192E819D6EF5218,
+	0xD69906245565A910, 0xF40E35855771202A, 0x106AA07032BBD1B8,
+	0x19A4C116B8D2D0C8, 0x1E376C085141AB53, 0x2748774CDF8EEB99,
+	0x34B0BCB5E19B48A8, 0x391C0CB3C5C95A63, 0x4ED8AA4AE3418ACB,
+	0x5B9CCA4F7763E373, 0x682E6FF3D6B2B8A3, 0x748F82EE5DEFB2FC,
+	0x78A5636F43172F60, 0x84C87814A1F0AB72, 0x8CC702081A6439EC,
+	0x90BEFFFA23631E28, 0xA4506CEBDE82BDE9, 0xBEF9A3F7B2C67915,
+	0xC67178F2E372532B, 0xCA273ECEEA26619C, 0xD186B8C721C0C207,
+	0xEADA7DD6CDE0EB1E, 0xF57D4F7FEE6ED178, 0x06F067AA72176FBA,
+	0x0A637DC5A2C898A6, 0x113F9804BEF90DAE, 0x1B710B35131C471B,
+	0x28DB77F523047D84, 0x32CAAB7B40C72493, 0x3C9EBE0A15C9BEBC,
+	0x431D67C49C100D4C, 0x4CC5D4BECB3E42B6, 0x597F299CFC657E2A,
+	0x5FCB6FAB3AD6FAEC, 0x6C44198C4A475817
+};
+
+/**
+ * Computes four rounds of SHA-256, first extending the message schedule if
+ * the rounds are past the first sixteen. The registers hold the previous four
+ * groups of four message words, from the oldest to the newest, and the oldest
+ * is replaced by the new group.
+ */
+#define SHA256_QUAD(S0, S1, W0, W1, W2, W3, I)								\
+	if ((I) >= 4) {															\
+		W0 = _mm_sha256msg1_epu32(W0, W1);									\
+		W0 = _mm_add_epi32(W0, _mm_alignr_epi8(W3, W2, 4));					\
+		W0 = _mm_sha256msg2_epu32(W0, W3);									\
+	}																		\
+	m = _mm_add_epi32(W0,													\
+			_mm_loadu_si128((const __m128i *)(sha256_k + 4 * (I))));		\
+	S1 = _mm_sha256rnds2_epu32(S1, S0, m);									\
+	S0 = _mm_sha256rnds2_epu32(S0, S1, _mm_shuffle_epi32(m, 0x0E));
+
+/**
+ * Rotates the 64-bit words of a vector register to the right.
+ */
+#define SHA512_VROTR(X, I)	_mm256_or_si256(_mm256_srli_epi64(X, I),		\
+		_mm256_slli_epi64(X, 64 - (I)))
+
+/**
+ * Rotates a 64-bit word to the right.
+ */
+#define SHA512_ROTR(X, I)	(((X) >> (I)) | ((X) << (64 - (I))))
+
+/**
+ * Computes the message schedule of two SHA-512 blocks and adds the round
+ * constants. Each vector register holds two consecutive words of each block,
+ * so that every step extends the schedule of both blocks by two words.
+ *
+ * @param[out] w			- the two schedules with the round constants.
+ * @param[in] in			- the first block.
+ * @param[in] next			- the second block, which may be the first.
+ */
+__attribute__((target("avx2,bmi2")))
+static void sha512_sched(uint64_t w[2][80], const uint8_t *in,
+		const uint8_t *next) {
+	const __m256i swap = _mm256_set_epi64x(0x08090A0B0C0D0E0F,
+			0x0001020304050607, 0x08090A0B0C0D0E0F, 0x0001020304050607);
+	__m256i x[40], s, t, k;
+	int i;
+
+	for (i = 0; i < 8; i++) {
+		x[i] = _mm256_set_m128i(
+				_mm_loadu_si128((const __m128i *)(next + 16 * i)),
+				_mm_loadu_si128((const __m128i *)(in + 16 * i)));
+		x[i] = _mm256_shuffle_epi8(x[i], swap);
+	}
+	for (i = 8; i < 40; i++) {
+		/* Words W[t - 15], W[t - 14] and W[t - 7], W[t - 6] of each lane. */
+		s = _mm256_alignr_epi8(x[i - 7], x[i - 8], 8);
+		t = _mm256_alignr_epi8(x[i - 3], x[i - 4], 8);
+		s = _mm256_xor_si256(_mm256_xor_si256(SHA512_VROTR(s, 1),
+				SHA512_VROTR(s, 8)), _mm256_srli_epi64(s, 7));
+		x[i] = _mm256_add_epi64(_mm256_add_epi64(x[i - 8], s), t);
+		t = x[i - 1];
+		t = _mm256_xor_si256(_mm256_xor_si256(SHA512_VROTR(t, 19),
+				SHA512_VROTR(t, 61)), _mm256_srli_epi64(t, 6));
+		x[i] = _mm256_add_epi64(x[i], t);
+	}
+	for (i = 0; i < 40; i++) {
+		k = _mm256_broadcastsi128_si256(
+				_mm_loadu_si128((const __m128i *)(sha512_k + 2 * i)));
+		x[i] = _mm256_add_epi64(x[i], k);
+		_mm_storeu_si128((__m128i *)(w[0] + 2 * i),
+				_mm256_castsi256_si128(x[i]));
+		_mm_storeu_si128((__m128i *)(w[1] + 2 * i),
+				_mm256_extracti128_si256(x[i], 1));
+	}
+}
+
+/**
+ * Computes the rounds of SHA-512 over a message schedule that already
+ * includes the round constants.
+ *
+ * @param[in,out] h			- the intermediate hash value.
+ * @param[in] w				- the message schedule.
+ */
+__attribute__((target("avx2,bmi2")))
+static void sha512_rounds(uint64_t h[8], const uint64_t w[80]) {
+	uint64_t a = h[0], b = h[1], c = h[2], d = h[3];
+	uint64_t e = h[4], f = h[5], g = h[6], k = h[7], t1, t2;
+
+	for (int t = 0; t < 80; t++) {
+		t1 = k + (SHA512_ROTR(e, 14) ^ SHA512_ROTR(e, 18) ^ SHA512_ROTR(e, 41))
+				+ ((e & f) ^ (~e & g)) + w[t];
+		t2 = (SHA512_ROTR(a, 28) ^ SHA512_ROTR(a, 34) ^ SHA512_ROTR(a, 39))
+				+ ((a & b) ^ (a & c) ^ (b & c));
+		k = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+	h[0] += a;
+	h[1] += b;
+	h[2] += c;
+	h[3] += d;
+	h[4] += e;
+	h[5] += f;
+	h[6] += g;
+	h[7] += k;
+}
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+__attribute__((target("sha,sse4.1")))
+void sha256_x64(uint32_t H[8], const uint8_t *blocks, size_t n) {
+	const __m128i swap = _mm_set_epi64x(0x0C0D0E0F08090A0B,
+			0x0405060700010203);
+	__m128i s0, s1, t0, t1, w0, w1, w2, w3, m;
+
+	/* Rearrange the state as ABEF and CDGH for the round instructions. */
+	t0 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)H), 0xB1);
+	s1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(H + 4)), 0x1B);
+	s0 = _mm_alignr_epi8(t0, s1, 8);
+	s1 = _mm_blend_epi16(s1, t0, 0xF0);
+
+	for (; n > 0; n--, blocks += 64) {
+		t0 = s0;
+		t1 = s1;
+		w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)blocks), swap);
+		w1 = _mm_shuffle_epi8(
+				_mm_loadu_si128((const __m128i *)(blocks + 16)), swap);
+		w2 = _mm_shuffle_epi8(
+				_mm_loadu_si128((const __m128i *)(blocks + 32)), swap);
+		w3 = _mm_shuffle_epi8(
+				_mm_loadu_si128((const __m128i *)(blocks + 48)), swap);
+		SHA256_QUAD(s0, s1, w0, w1, w2, w3, 0);
+		SHA256_QUAD(s0, s1, w1, w2, w3, w0, 1);
+		SHA256_QUAD(s0, s1, w2, w3, w0, w1, 2);
+		SHA256_QUAD(s0, s1, w3, w0, w1, w2, 3);
+		for (int i = 4; i < 16; i += 4) {
+			SHA256_QUAD(s0, s1, w0, w1, w2, w3, i);
+			SHA256_QUAD(s0, s1, w1, w2, w3, w0, i + 1);
+			SHA256_QUAD(s0, s1, w2, w3, w0, w1, i + 2);
+			SHA256_QUAD(s0, s1, w3, w0, w1, w2, i + 3);
+		}
+		s0 = _mm_add_epi32(s0, t0);
+		s1 = _mm_add_epi32(s1, t1);
+	}
+
+	/* Restore the order ABCD and EFGH. */
+	t0 = _mm_shuffle_epi32(s0, 0x1B);
+	s1 = _mm_shuffle_epi32(s1, 0xB1);
+	_mm_storeu_si128((__m128i *)H, _mm_blend_epi16(t0, s1, 0xF0));
+	_mm_storeu_si128((__m128i *)(H + 4), _mm_alignr_epi8(s1, t0, 8));
+}
+
+void sha512_x64(uint64_t H[8], const uint8_t *blocks, size_t n) {
+	uint64_t w[2][80];
+
+	while (n > 0) {
+		if (n >= 2) {
+			sha512_sched(w, blocks, blocks + 128);
+			sha512_rounds(H, w[0]);
+			sha512_rounds(H, w[1]);
+			blocks += 256;
+			n -= 2;
+		} else {
+			sha512_sched(w, blocks, blocks);
+			sha512_rounds(H, w[0]);
+			n--;
+		}
+	}
+	memset(w, 0, sizeof(w));
+}
+
+#endif /* SHA_X64 */
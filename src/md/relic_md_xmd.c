@@ -24,7 +24,7 @@
 /**
  * @file
  *
- * Implementation of an extensible-output function from a Merkle-Damgaard hash.
+ * Implementation of an extensible-output function from a hash function.
  *
  * @ingroup md
  */
@@ -33,36 +33,19 @@
 
 #include "relic_conf.h"
 #include "relic_core.h"
-#include "sha.h"
+#include "relic_md.h"
 
 /*============================================================================*/
 /* Private definitions                                                        */
 /*============================================================================*/
 
 /**
- * Helper: check result of a SHA call.
+ * Construct an extensible-output function based on the incremental interface
+ * of hash function HNAME, with state HTYPE, block size HBlockSize and digest
+ * length HHashSize in bytes.
  */
-#define _check_md(EXPR)                                                        \
-	do {                                                                       \
-		if ((EXPR) != shaSuccess) {                                            \
-			RLC_THROW(ERR_NO_VALID);                                           \
-			return;                                                            \
-		}                                                                      \
-	} while (0)
-
-/**
- * Construct an extensible-output function based on HASH, which must be
- * one of SHA224, SHA256, SHA384, or SHA512.
- */
-#define make_md_xmd(HASH, HNAME)                                               \
-	_make_md_xmd(md_xmd_##HNAME, HASH##_Message_Block_Size, HASH##HashSize,    \
-				 HASH##Context, HASH##Reset, HASH##Input, HASH##Result)
-
-/**
- * Helper for make_md_xmd
- */
-#define _make_md_xmd(HName, HBlockSize, HHashSize, HContext, HReset, HInput, HResult)                             \
-	void HName(uint8_t *buf, int buf_len, const uint8_t *in, int in_len, const uint8_t *dst, int dst_len) {       \
+#define make_md_xmd(HNAME, HTYPE, HBlockSize, HHashSize)                                                          \
+	void md_xmd_##HNAME(uint8_t *buf, int buf_len, const uint8_t *in, int in_len, const uint8_t *dst, int dst_len) { \
 		const unsigned ell = (buf_len + HHashSize - 1) / HHashSize;                                               \
 		if (buf_len < 0 || ell > 255 || dst_len > 255) {                                                          \
 			RLC_THROW(ERR_NO_VALID);                                                                              \
@@ -78,14 +61,14 @@
                                                                                                                   \
 		/* now compute b_0 */                                                                                     \
 		uint8_t b_0[HHashSize];                                                                                   \
-		HContext ctx;                                                                                             \
-		_check_md(HReset(&ctx));                                                                                  \
-		_check_md(HInput(&ctx, Z_pad, HBlockSize)); /* Z_pad */                                                   \
-		_check_md(HInput(&ctx, in, in_len));        /* msg */                                                     \
-		_check_md(HInput(&ctx, l_i_b_0_str, 3));    /* l_i_b_str || I2OSP(0, 1) */                                \
-		_check_md(HInput(&ctx, dst, dst_len));      /* DST */                                                     \
-		_check_md(HInput(&ctx, dstlen_str, 1));     /* I2OSP(len(dst), 1) */                                      \
-		_check_md(HResult(&ctx, b_0));              /* finalize computation */                                    \
+		HTYPE ctx;                                                                                                \
+		md_##HNAME##_init(ctx);                                                                                   \
+		md_##HNAME##_update(ctx, Z_pad, HBlockSize); /* Z_pad */                                                  \
+		md_##HNAME##_update(ctx, in, in_len);        /* msg */                                                    \
+		md_##HNAME##_update(ctx, l_i_b_0_str, 3);    /* l_i_b_str || I2OSP(0, 1) */                               \
+		md_##HNAME##_update(ctx, dst, dst_len);      /* DST */                                                    \
+		md_##HNAME##_update(ctx, dstlen_str, 1);     /* I2OSP(len(dst), 1) */                                     \
+		md_##HNAME##_final(b_0, ctx);                /* finalize computation */                                   \
                                                                                                                   \
 		/* now compute b_i */                                                                                     \
 		uint8_t b_i[HHashSize + 1] = {                                                                            \
@@ -98,11 +81,11 @@
 			}                                                                                                     \
 			b_i[HHashSize] = i;                                                                                   \
                                                                                                                   \
-			_check_md(HReset(&ctx));                                                                              \
-			_check_md(HInput(&ctx, b_i, HHashSize + 1)); /* b_0 ^ b_(i-1) || I2OSP(i, 1) */                       \
-			_check_md(HInput(&ctx, dst, dst_len));       /* DST */                                                \
-			_check_md(HInput(&ctx, dstlen_str, 1));      /* I2OSP(len(dst), 1) */                                 \
-			_check_md(HResult(&ctx, b_i));               /* finalize computation */                               \
+			md_##HNAME##_init(ctx);                                                                               \
+			md_##HNAME##_update(ctx, b_i, HHashSize + 1); /* b_0 ^ b_(i-1) || I2OSP(i, 1) */                      \
+			md_##HNAME##_update(ctx, dst, dst_len);       /* DST */                                               \
+			md_##HNAME##_update(ctx, dstlen_str, 1);      /* I2OSP(len(dst), 1) */                                \
+			md_##HNAME##_final(b_i, ctx);                 /* finalize computation */                              \
                                                                                                                   \
 			/* copy into output buffer */                                                                         \
 			const int rem_after = buf_len - i * HHashSize;                                                        \
@@ -116,17 +99,37 @@
 /*============================================================================*/
 
 #if MD_MAP == SH224 || !defined(STRIP)
-make_md_xmd(SHA224, sh224)
+make_md_xmd(sh224, md_sh256_t, 64, RLC_MD_LEN_SH224)
 #endif
 
 #if MD_MAP == SH256 || !defined(STRIP)
-make_md_xmd(SHA256, sh256)
+make_md_xmd(sh256, md_sh256_t, 64, RLC_MD_LEN_SH256)
 #endif
 
 #if MD_MAP == SH384 || !defined(STRIP)
-make_md_xmd(SHA384, sh384)
+make_md_xmd(sh384, md_sh512_t, 128, RLC_MD_LEN_SH384)
 #endif
 
 #if MD_MAP == SH512 || !defined(STRIP)
-make_md_xmd(SHA512, sh512)
+make_md_xmd(sh512, md_sh512_t, 128, RLC_MD_LEN_SH512)
+#endif
+
+#if MD_MAP == B2S160 || !defined(STRIP)
+make_md_xmd(b2s160, md_b2s_t, 64, RLC_MD_LEN_B2S160)
+#endif
+
+#if MD_MAP == B2S256 || !defined(STRIP)
+make_md_xmd(b2s256, md_b2s_t, 64, RLC_MD_LEN_B2S256)
+#endif
+
+#if MD_MAP == B2B256 || !defined(STRIP)
+make_md_xmd(b2b256, md_b2b_t, 128, RLC_MD_LEN_B2B256)
+#endif
+
+#if MD_MAP == B2B512 || !defined(STRIP)
+make_md_xmd(b2b512, md_b2b_t, 128, RLC_MD_LEN_B2B512)
+#endif
+
+#if MD_MAP == BLAKE3 || !defined(STRIP)
+make_md_xmd(blake3, md_blake3_t, 64, RLC_MD_LEN_BLAKE3)
 #endif
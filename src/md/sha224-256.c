@@ -69,6 +69,8 @@ static void SHA224_256Finalize(SHA256Context *context,
 static void SHA224_256PadMessage(SHA256Context *context,
   uint8_t Pad_Byte);
 static void SHA224_256ProcessMessageBlock(SHA256Context *context);
+static void SHA224_256ProcessBlocks(uint32_t H[8], const uint8_t *blocks,
+  size_t n);
 static int SHA224_256Reset(SHA256Context *context, uint32_t *H0);
 static int SHA224_256ResultN(SHA256Context *context,
   uint8_t Message_Digest[], int HashSize);
@@ -234,11 +236,28 @@ int SHA256Input(SHA256Context *context, const uint8_t *message_array,
   if (context->Corrupted)
      return context->Corrupted;
 
-  while (length-- && !context->Corrupted) {
+  while (length && !context->Corrupted) {
+    uint32_t addTemp;
+
+    /* Compress whole blocks directly from the input. */
+    if (context->Message_Block_Index == 0 &&
+        length >= SHA256_Message_Block_Size) {
+      unsigned int blocks = 0;
+      while (length >= SHA256_Message_Block_Size &&
+        !SHA224_256AddLength(context, 8 * SHA256_Message_Block_Size)) {
+        length -= SHA256_Message_Block_Size;
+        blocks++;
+      }
+      SHA224_256ProcessBlocks(context->Intermediate_Hash, message_array,
+        blocks);
+      message_array += blocks * SHA256_Message_Block_Size;
+      continue;
+    }
+
     context->Message_Block[context->Message_Block_Index++] =
     		(uint8_t)(*message_array & 0xFF);
+    length--;
 
-    uint32_t addTemp;
     if (!SHA224_256AddLength(context, 8) &&
       (context->Message_Block_Index == SHA256_Message_Block_Size))
       SHA224_256ProcessMessageBlock(context);
@@ -434,13 +453,39 @@ static void SHA224_256PadMessage(SHA256Context *context,
  *
  * Returns:
  *   Nothing.
+ */
+static void SHA224_256ProcessMessageBlock(SHA256Context *context)
+{
+  SHA224_256ProcessBlocks(context->Intermediate_Hash,
+    context->Message_Block, 1);
+  context->Message_Block_Index = 0;
+}
+
+/*
+ * SHA224_256ProcessBlocks
+ *
+ * Description:
+ *   This function will process a number of consecutive 512-bit
+ *   message blocks, using the SHA extensions when available.
+ *
+ * Parameters:
+ *   H: [in/out]
+ *     The intermediate hash value to update
+ *   blocks: [in]
+ *     The message blocks
+ *   n: [in]
+ *     The number of blocks
+ *
+ * Returns:
+ *   Nothing.
  *
  * Comments:
  *   Many of the variable names in this code, especially the
  *   single character names, were used because those were the
  *   names used in the publication.
  */
-static void SHA224_256ProcessMessageBlock(SHA256Context *context)
+static void SHA224_256ProcessBlocks(uint32_t H[8], const uint8_t *blocks,
+  size_t n)
 {
   /* Constants defined in FIPS-180-2, section 4.2.2 */
   static const uint32_t K[64] = {
@@ -461,53 +506,60 @@ static void SHA224_256ProcessMessageBlock(SHA256Context *context)
   int        t, t4;                   /* Loop counter */
   uint32_t   temp1, temp2;            /* Temporary word value */
   uint32_t   W[64];                   /* Word sequence */
-  uint32_t   A, B, C, D, E, F, G, H;  /* Word buffers */
+  uint32_t   A, B, C, D, E, F, G, I;  /* Word buffers */
 
-  /*
-   * Initialize the first 16 words in the array W
-   */
-  for (t = t4 = 0; t < 16; t++, t4 += 4)
-    W[t] = (((uint32_t)context->Message_Block[t4]) << 24) |
-           (((uint32_t)context->Message_Block[t4 + 1]) << 16) |
-           (((uint32_t)context->Message_Block[t4 + 2]) << 8) |
-           (((uint32_t)context->Message_Block[t4 + 3]));
-
-  for (t = 16; t < 64; t++)
-    W[t] = SHA256_sigma1(W[t-2]) + W[t-7] +
-        SHA256_sigma0(W[t-15]) + W[t-16];
-
-  A = context->Intermediate_Hash[0];
-  B = context->Intermediate_Hash[1];
-  C = context->Intermediate_Hash[2];
-  D = context->Intermediate_Hash[3];
-  E = context->Intermediate_Hash[4];
-  F = context->Intermediate_Hash[5];
-  G = context->Intermediate_Hash[6];
-  H = context->Intermediate_Hash[7];
-
-  for (t = 0; t < 64; t++) {
-    temp1 = H + SHA256_SIGMA1(E) + SHA_Ch(E,F,G) + K[t] + W[t];
-    temp2 = SHA256_SIGMA0(A) + SHA_Maj(A,B,C);
-    H = G;
-    G = F;
-    F = E;
-    E = D + temp1;
-    D = C;
-    C = B;
-    B = A;
-    A = temp1 + temp2;
+#ifdef SHA_X64
+  if (arch_has(RLC_X64_SHA)) {
+    sha256_x64(H, blocks, n);
+    return;
+  }
+#endif
+
+  for (; n > 0; n--, blocks += SHA256_Message_Block_Size) {
+    /*
+     * Initialize the first 16 words in the array W
+     */
+    for (t = t4 = 0; t < 16; t++, t4 += 4)
+      W[t] = (((uint32_t)blocks[t4]) << 24) |
+             (((uint32_t)blocks[t4 + 1]) << 16) |
+             (((uint32_t)blocks[t4 + 2]) << 8) |
+             (((uint32_t)blocks[t4 + 3]));
+
+    for (t = 16; t < 64; t++)
+      W[t] = SHA256_sigma1(W[t-2]) + W[t-7] +
+          SHA256_sigma0(W[t-15]) + W[t-16];
+
+    A = H[0];
+    B = H[1];
+    C = H[2];
+    D = H[3];
+    E = H[4];
+    F = H[5];
+    G = H[6];
+    I = H[7];
+
+    for (t = 0; t < 64; t++) {
+      temp1 = I + SHA256_SIGMA1(E) + SHA_Ch(E,F,G) + K[t] + W[t];
+      temp2 = SHA256_SIGMA0(A) + SHA_Maj(A,B,C);
+      I = G;
+      G = F;
+      F = E;
+      E = D + temp1;
+      D = C;
+      C = B;
+      B = A;
+      A = temp1 + temp2;
+    }
+
+    H[0] += A;
+    H[1] += B;
+    H[2] += C;
+    H[3] += D;
+    H[4] += E;
+    H[5] += F;
+    H[6] += G;
+    H[7] += I;
   }
-
-  context->Intermediate_Hash[0] += A;
-  context->Intermediate_Hash[1] += B;
-  context->Intermediate_Hash[2] += C;
-  context->Intermediate_Hash[3] += D;
-  context->Intermediate_Hash[4] += E;
-  context->Intermediate_Hash[5] += F;
-  context->Intermediate_Hash[6] += G;
-  context->Intermediate_Hash[7] += H;
-
-  context->Message_Block_Index = 0;
 }
 
 /*
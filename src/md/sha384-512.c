@@ -455,15 +455,33 @@ int SHA512Input(SHA512Context *context,
   if (context->Corrupted)
      return context->Corrupted;
 
-  while (length-- && !context->Corrupted) {
-    context->Message_Block[context->Message_Block_Index++] =
-    		(uint8_t)(*message_array & 0xFF);
-
+  while (length && !context->Corrupted) {
 #ifdef USE_32BIT_ONLY
     uint32_t ADDTO4_temp, ADDTO4_temp2, addTemp[4] = { 0, 0, 0, 0 };
 #else
     uint64_t addTemp;
 #endif
+
+#ifdef SHA_X64
+    /* Compress whole blocks directly from the input. */
+    if (context->Message_Block_Index == 0 &&
+        length >= SHA512_Message_Block_Size && arch_has(RLC_X64_AVX2)) {
+      unsigned int blocks = 0;
+      while (length >= SHA512_Message_Block_Size &&
+        !SHA384_512AddLength(context, 8 * SHA512_Message_Block_Size)) {
+        length -= SHA512_Message_Block_Size;
+        blocks++;
+      }
+      sha512_x64(context->Intermediate_Hash, message_array, blocks);
+      message_array += blocks * SHA512_Message_Block_Size;
+      continue;
+    }
+#endif
+
+    context->Message_Block[context->Message_Block_Index++] =
+    		(uint8_t)(*message_array & 0xFF);
+    length--;
+
     if (!SHA384_512AddLength(context, 8) &&
       (context->Message_Block_Index == SHA512_Message_Block_Size))
       SHA384_512ProcessMessageBlock(context);
@@ -709,6 +727,14 @@ static void SHA384_512PadMessage(SHA512Context *context,
  */
 static void SHA384_512ProcessMessageBlock(SHA512Context *context)
 {
+#ifdef SHA_X64
+  if (arch_has(RLC_X64_AVX2)) {
+    sha512_x64(context->Intermediate_Hash, context->Message_Block, 1);
+    context->Message_Block_Index = 0;
+    return;
+  }
+#endif
+
   /* Constants defined in FIPS-180-2, section 4.2.3 */
 #ifdef USE_32BIT_ONLY
   static const uint32_t K[80*2] = {
@@ -24,8 +24,26 @@
 #endif /* USE_MODIFIED_MACROS */
 
 #define SHA_Parity(x, y, z)  ((x) ^ (y) ^ (z))
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "relic_conf.h"
+#include "relic_arch.h"
+
 #if WSIZE <= 32
 #define USE_32BIT_ONLY
 #endif
 
+/*
+ * Compression functions accelerated with the SHA extensions and with
+ * AVX2, which process a number of consecutive message blocks. They are
+ * only called after the extensions are detected at run time.
+ */
+#if ARCH == X64 && defined(__GNUC__) && !defined(USE_32BIT_ONLY)
+#define SHA_X64
+void sha256_x64(uint32_t H[8], const uint8_t *blocks, size_t n);
+void sha512_x64(uint64_t H[8], const uint8_t *blocks, size_t n);
+#endif
+
 #endif /* _SHA_PRIVATE__H */
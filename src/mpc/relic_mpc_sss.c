@@ -34,6 +34,151 @@
 #include "relic_mpc.h"
 #include "relic_util.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Allocates and initializes a vector of n integers. The vectors shared by
+ * many secrets grow with the number of secrets and parties, so they are taken
+ * from the heap even when ALLOC = AUTO.
+ *
+ * @param[in] n				- the number of integers.
+ * @return the allocated vector, or NULL if there is no memory available.
+ */
+static bn_t *sss_new(size_t n) {
+    bn_t *a = (bn_t *)malloc(RLC_MAX(n, 1) * sizeof(bn_t));
+
+    if (a == NULL) {
+        RLC_THROW(ERR_NO_MEMORY);
+        return NULL;
+    }
+    for (int i = 0; i < n; i++) {
+        bn_null(a[i]);
+        bn_new(a[i]);
+    }
+    return a;
+}
+
+/**
+ * Frees a vector allocated with sss_new().
+ *
+ * @param[in] a				- the vector to free.
+ * @param[in] n				- the number of integers.
+ */
+static void sss_free(bn_t *a, size_t n) {
+    if (a != NULL) {
+        for (int i = 0; i < n; i++) {
+            bn_free(a[i]);
+        }
+        free(a);
+    }
+}
+
+/**
+ * Computes the Lagrange coefficients at zero for a set of abscissae, so that
+ * a secret is recovered as the inner product with the ordinates.
+ *
+ * @param[out] l			- the Lagrange coefficients.
+ * @param[in] x				- the indexes of the parties contributing shares.
+ * @param[in] order			- the order of the finite field.
+ * @param[in] k				- the threshold.
+ * @return RLC_OK if no errors occurred, RLC_ERR otherwise.
+ */
+static int sss_lag(bn_t *l, const bn_t *x, const bn_t order, size_t k) {
+    bn_t t, *a = RLC_ALLOCA(bn_t, k + 1);
+    int result = RLC_OK;
+
+    bn_null(t);
+
+    RLC_TRY {
+        if (a == NULL) {
+            RLC_THROW(ERR_NO_MEMORY);
+        }
+
+        bn_new(t);
+        for (int i = 0; i <= k; i++) {
+            bn_null(a[i]);
+            bn_new(a[i]);
+        }
+
+        /* The Lagrange coefficients at zero are -P(0) / (x_i * P'(x_i)) for
+         * P(x) = \prod_j (x - x_j), computed with fast multipoint evaluation. */
+        bn_lag(a, x, order, k);
+        bn_neg(t, a[0]);
+        bn_mod(t, t, order);
+        for (int i = 0; i < k; i++) {
+            bn_mul_dig(a[i], a[i + 1], i + 1);
+            bn_mod(a[i], a[i], order);
+        }
+        bn_evl_sim(l, (const bn_t *)a, x, order, k, k);
+        for (int i = 0; i < k; i++) {
+            if (bn_is_zero(l[i])) {
+                /* Repeated abscissae make the interpolation singular. */
+                result = RLC_ERR;
+            }
+            bn_mod(a[i], x[i], order);
+            if (!bn_is_zero(a[i])) {
+                bn_mul(l[i], l[i], a[i]);
+                bn_mod(l[i], l[i], order);
+            }
+        }
+
+        if (result == RLC_OK) {
+            bn_mod_inv_sim(l, (const bn_t *)l, order, k);
+            for (int i = 0; i < k; i++) {
+                if (bn_is_zero(a[i])) {
+                    bn_set_dig(l[i], 1);
+                } else {
+                    bn_mul(l[i], l[i], t);
+                    bn_mod(l[i], l[i], order);
+                }
+            }
+        }
+    } RLC_CATCH_ANY {
+        RLC_THROW(ERR_CAUGHT);
+    } RLC_FINALLY {
+        bn_free(t);
+        for (int i = 0; i <= k; i++) {
+            bn_free(a[i]);
+        }
+        RLC_FREE(a);
+    }
+
+    return result;
+}
+
+/**
+ * Computes an inner product modulo the order, accumulating the products and
+ * reducing only once every RLC_TERMS terms.
+ *
+ * @param[out] c			- the result.
+ * @param[in] a				- the first vector.
+ * @param[in] b				- the second vector.
+ * @param[in] k				- the length of the vectors.
+ * @param[in] order			- the order of the finite field.
+ */
+static void sss_dot(bn_t c, const bn_t *a, const bn_t *b, size_t k,
+        const bn_t order) {
+    bn_t t;
+
+    /* No error handling here, since this may run in several threads. */
+    bn_null(t);
+    bn_new(t);
+
+    bn_zero(c);
+    for (int i = 0; i < k; i++) {
+        bn_mul(t, a[i], b[i]);
+        bn_add(c, c, t);
+        if (i % RLC_TERMS == RLC_TERMS - 1) {
+            bn_mod(c, c, order);
+        }
+    }
+    bn_mod(c, c, order);
+
+    bn_free(t);
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -63,8 +208,8 @@ int mpc_sss_gen(bn_t *x, bn_t *y, const bn_t secret, const bn_t order,
         }
         for (int i = 0; i < n; i++) {
             bn_set_dig(x[i], i + 1);
-            bn_evl(y[i], a, x[i], order, k);
         }
+        bn_evl_sim(y, (const bn_t *)a, (const bn_t *)x, order, k, n);
     } RLC_CATCH_ANY {
         RLC_THROW(ERR_CAUGHT);
     } RLC_FINALLY {
@@ -80,69 +225,130 @@ int mpc_sss_gen(bn_t *x, bn_t *y, const bn_t secret, const bn_t order,
 
 int mpc_sss_key(bn_t key, const bn_t *x, const bn_t *y, const bn_t order,
         size_t k) {
-    bn_t t;
-    bn_t *a = RLC_ALLOCA(bn_t, k);
-    bn_t *b = RLC_ALLOCA(bn_t, k);
+    bn_t *l = RLC_ALLOCA(bn_t, k);
+    int result = RLC_OK;
 
     if (k < 2) {
-        RLC_FREE(a);
-        RLC_FREE(b);
+        RLC_FREE(l);
         return RLC_ERR;
     }
 
-    bn_null(t);
-
     RLC_TRY {
-        if (a == NULL || b == NULL) {
+        if (l == NULL) {
             RLC_THROW(ERR_NO_MEMORY);
         }
-
-        bn_new(t);
         for (int i = 0; i < k; i++) {
-            bn_null(a[i]);
-            bn_null(b[i]);
-            bn_new(a[i]);
-            bn_new(b[i]);
+            bn_null(l[i]);
+            bn_new(l[i]);
         }
 
+        bn_zero(key);
+        result = sss_lag(l, x, order, k);
+        if (result == RLC_OK) {
+            sss_dot(key, (const bn_t *)l, y, k, order);
+        }
+    } RLC_CATCH_ANY {
+        RLC_THROW(ERR_CAUGHT);
+    } RLC_FINALLY {
         for (int i = 0; i < k; i++) {
-            bn_set_dig(a[i], 1);
-            bn_set_dig(b[i], 1);
-            for (int m = 0; m < k; m++) {
-                if (m != i) {
-                    bn_sub(t, x[m], x[i]);
-                    bn_mod(t, t, order);
-                    bn_mul(a[i], a[i], x[m]);
-                    bn_mul(b[i], b[i], t);
-                    bn_mod(a[i], a[i], order);
-                    bn_mod(b[i], b[i], order);
+            bn_free(l[i]);
+        }
+        RLC_FREE(l);
+    }
+
+    return result;
+}
+
+int mpc_sss_gen_sim(bn_t *x, bn_t *y, const bn_t *key, const bn_t order,
+        size_t k, size_t n, size_t m) {
+    bn_t *v = NULL, *a = NULL;
+    int j, result = RLC_OK;
+
+    if (k < 2 || n < k) {
+        return RLC_ERR;
+    }
+
+    RLC_TRY {
+        v = sss_new(n * k);
+        a = sss_new(m * k);
+        if (v == NULL || a == NULL) {
+            result = RLC_ERR;
+        } else {
+            /* Precompute the Vandermonde matrix with rows (1, ..., x_i^k-1). */
+            for (int i = 0; i < n; i++) {
+                bn_set_dig(x[i], i + 1);
+                bn_set_dig(v[i * k], 1);
+                for (int l = 1; l < k; l++) {
+                    bn_mul_dig(v[i * k + l], v[i * k + l - 1], i + 1);
+                    bn_mod(v[i * k + l], v[i * k + l], order);
+                }
+            }
+
+            /* Draw all coefficients before the loop, which may be threaded. */
+            for (j = 0; j < m; j++) {
+                bn_copy(a[j * k], key[j]);
+                bn_rand_mod_sim(a + j * k + 1, k - 1, order);
+            }
+
+#if MULTI == OPENMP
+            omp_set_num_threads(CORES);
+            #pragma omp parallel for copyin(core_ctx)
+#endif
+            for (j = 0; j < m; j++) {
+                for (int i = 0; i < n; i++) {
+                    sss_dot(y[j * n + i], (const bn_t *)v + i * k,
+                            (const bn_t *)a + j * k, k, order);
                 }
             }
         }
-        bn_mod_inv_sim(b, b, order, k);
-        bn_mul(a[0], a[0], b[0]);
-        bn_mod(a[0], a[0], order);
-        bn_mul(a[0], a[0], y[0]);
-        bn_mod(key, a[0], order);
-        for (int i = 1; i < k; i++) {
-            bn_mul(a[i], a[i], b[i]);
-            bn_mod(a[i], a[i], order);
-            bn_mul(a[i], a[i], y[i]);
-            bn_mod(a[i], a[i], order);
-            bn_add(key, key, a[i]);
-            bn_mod(key, key, order);
+    } RLC_CATCH_ANY {
+        result = RLC_ERR;
+    } RLC_FINALLY {
+        sss_free(v, n * k);
+        sss_free(a, m * k);
+    }
+
+    return result;
+}
+
+int mpc_sss_key_sim(bn_t *key, const bn_t *x, const bn_t *y, const bn_t order,
+        size_t k, size_t m) {
+    bn_t *l = RLC_ALLOCA(bn_t, k);
+    int j, result = RLC_OK;
+
+    if (k < 2) {
+        RLC_FREE(l);
+        return RLC_ERR;
+    }
+
+    RLC_TRY {
+        if (l == NULL) {
+            RLC_THROW(ERR_NO_MEMORY);
+        }
+        for (int i = 0; i < k; i++) {
+            bn_null(l[i]);
+            bn_new(l[i]);
+        }
+
+        /* The Lagrange basis depends only on the abscissae, so share it. */
+        result = sss_lag(l, x, order, k);
+        if (result == RLC_OK) {
+#if MULTI == OPENMP
+            omp_set_num_threads(CORES);
+            #pragma omp parallel for copyin(core_ctx)
+#endif
+            for (j = 0; j < m; j++) {
+                sss_dot(key[j], (const bn_t *)l, y + j * k, k, order);
+            }
         }
     } RLC_CATCH_ANY {
-        RLC_THROW(ERR_CAUGHT);
+        result = RLC_ERR;
     } RLC_FINALLY {
-        bn_free(t);
         for (int i = 0; i < k; i++) {
-            bn_free(a[i]);
-            bn_free(b[i]);
+            bn_free(l[i]);
         }
-        RLC_FREE(a);
-        RLC_FREE(b);
+        RLC_FREE(l);
     }
 
-    return RLC_OK;
+    return result;
 }
@@ -38,7 +38,7 @@
 /*============================================================================*/
 
 void pc_core_init(void) {
-	gt_new(core_get()->gt_g);
+	gt_new(core_par_get()->gt_g);
 }
 
 void pc_core_calc(void) {
@@ -50,6 +50,8 @@ void pc_core_calc(void) {
 	g2_null(g2);
 	gt_null(gt);
 
+	core_par_own();
+
 	RLC_TRY {
 		g1_new(g1);
 		g2_new(g2);
@@ -59,7 +61,7 @@ void pc_core_calc(void) {
 		g2_get_gen(g2);
 
 		pc_map(gt, g1, g2);
-		gt_copy(core_get()->gt_g, gt);
+		gt_copy(core_par_get()->gt_g, gt);
 	} RLC_CATCH_ANY {
 		RLC_THROW(ERR_CAUGHT);
 	} RLC_FINALLY {
@@ -70,8 +72,8 @@ void pc_core_calc(void) {
 }
 
 void pc_core_clean(void) {
-	ctx_t *ctx = core_get();
-	if (ctx != NULL) {
-		gt_free(core_get()->gt_g);
+	params_t *par = core_par_get();
+	if (par != NULL) {
+		gt_free(core_par_get()->gt_g);
 	}
 }
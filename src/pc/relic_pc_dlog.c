@@ -0,0 +1,340 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * Implementation of bounded discrete logarithms in pairing groups.
+ *
+ * @ingroup pc
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "relic_pc.h"
+#include "relic_core.h"
+#include "relic_util.h"
+#include "relic_tmpl_dlog.h"
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Number of baby steps computed together, also the unit of parallel work.
+ */
+#define DLOG_CHUNK			64
+
+/**
+ * Logarithm of the largest number of baby steps used without a table.
+ */
+#define DLOG_LOG			16
+
+/**
+ * Number of times the kangaroo method is restarted with different jumps.
+ */
+#define DLOG_TRIES			4
+
+/**
+ * Size in bytes of the header of a serialized table.
+ */
+#define DLOG_HEAD			8
+
+/**
+ * Computes a 64-bit fingerprint of a serialized group element.
+ *
+ * @param[in] bin			- the serialized element.
+ * @param[in] len			- the number of bytes in the serialization.
+ * @return the fingerprint.
+ */
+static uint64_t dlog_key(const uint8_t *bin, int len) {
+	uint64_t key = 0;
+
+	/* Take the least significant bytes and the leading sign byte. */
+	for (int i = RLC_MAX(len - 8, 0); i < len; i++) {
+		key = (key << 8) | bin[i];
+	}
+	return key ^ bin[0];
+}
+
+/**
+ * Computes the fingerprint of an element of G_1 from its compressed form.
+ *
+ * @param[in] p				- the element.
+ * @return the fingerprint.
+ */
+static uint64_t g1_dlog_key(g1_t p) {
+	uint8_t bin[2 * RLC_PC_BYTES + 1];
+	int len = g1_size_bin(p, 1);
+
+	g1_write_bin(bin, len, p, 1);
+	return dlog_key(bin, len);
+}
+
+/**
+ * Computes the fingerprint of an element of G_2 from its compressed form.
+ *
+ * @param[in] p				- the element.
+ * @return the fingerprint.
+ */
+static uint64_t g2_dlog_key(g2_t p) {
+	uint8_t bin[8 * RLC_PC_BYTES + 1];
+	int len = g2_size_bin(p, 1);
+
+	g2_write_bin(bin, len, p, 1);
+	return dlog_key(bin, len);
+}
+
+/**
+ * Computes the fingerprint of an element of G_T from its compressed form.
+ *
+ * @param[in] a				- the element.
+ * @return the fingerprint.
+ */
+static uint64_t gt_dlog_key(gt_t a) {
+#if FP_PRIME < 1536 && FP_PRIME != 509
+	uint8_t bin[2 * RLC_PC_BYTES];
+
+	/* The last coordinate kept by fp12_pck() ends the compressed encoding.
+	 * Elements of G_T are unitary, so the cyclotomic test can be skipped. */
+	fp2_write_bin(bin, sizeof(bin), a[1][2], 0);
+	return dlog_key(bin, sizeof(bin));
+#else
+	uint8_t bin[24 * RLC_PC_BYTES];
+	int len = gt_size_bin(a, 0);
+
+	gt_write_bin(bin, len, a, 0);
+	return dlog_key(bin, len);
+#endif
+}
+
+/**
+ * Compares two table entries by their fingerprints.
+ *
+ * @param[in] a				- the first entry.
+ * @param[in] b				- the second entry.
+ * @return the result of the comparison as required by qsort().
+ */
+static int dlog_cmp(const void *a, const void *b) {
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+/**
+ * Sorts the entries of a table by their fingerprints.
+ *
+ * @param[in,out] tab		- the table to sort.
+ */
+static void dlog_sort(dlog_tab_t tab) {
+	qsort(tab->t, tab->m - 1, 2 * sizeof(uint64_t), dlog_cmp);
+}
+
+/**
+ * Searches a table for a fingerprint.
+ *
+ * @param[in] tab			- the table.
+ * @param[in] key			- the fingerprint.
+ * @return the discrete logarithm stored in the table, or zero if not found.
+ */
+static int dlog_find(dlog_tab_t tab, uint64_t key) {
+	int i, lo = 0, hi = tab->m - 2;
+
+	while (lo <= hi) {
+		i = lo + (hi - lo) / 2;
+		if (tab->t[2 * i] == key) {
+			return (int)tab->t[2 * i + 1];
+		}
+		if (tab->t[2 * i] < key) {
+			lo = i + 1;
+		} else {
+			hi = i - 1;
+		}
+	}
+	return 0;
+}
+
+/**
+ * Allocates the entries of a table with m baby steps.
+ *
+ * @param[out] tab			- the table.
+ * @param[in] m				- the number of baby steps.
+ */
+static void dlog_alloc(dlog_tab_t tab, int m) {
+	if (!tab->map) {
+		free(tab->t);
+	}
+	tab->map = 0;
+	tab->m = m;
+	tab->t = (uint64_t *)malloc(2 * (m - 1) * sizeof(uint64_t));
+	if (tab->t == NULL) {
+		tab->m = 0;
+		RLC_THROW(ERR_NO_MEMORY);
+	}
+}
+
+/**
+ * Chooses the jumps for the kangaroo method in an interval of length n, as
+ * powers of two with mean close to sqrt(n)/2.
+ *
+ * @param[in] n				- the length of the interval.
+ * @param[out] t			- the number of jumps of the tame kangaroo.
+ * @return the number of distinct jumps.
+ */
+static int dlog_jumps(dig_t n, dig_t *t) {
+	dig_t r = (dig_t)1 << ((util_bits_dig(n) + 1) / 2);
+	int k = 1;
+
+	while (k < RLC_DIG - 2 && ((dig_t)1 << k) < k * (r / 2)) {
+		k++;
+	}
+	*t = 2 * r;
+	return k;
+}
+
+/**
+ * Normalizes elements of G_1 simultaneously.
+ */
+#define dlog_norm1(R, P, N)		g1_norm_sim(R, (const g1_t *)P, N)
+
+/**
+ * Negates and normalizes an element of G_1.
+ */
+#define dlog_neg1(R, P)			g1_neg(R, P); g1_norm(R, R)
+
+/**
+ * Negates and normalizes an element of G_2.
+ */
+#define dlog_neg2(R, P)			g2_neg(R, P); g2_norm(R, R)
+
+/**
+ * Elements of G_T need no normalization.
+ */
+#define dlog_normt(R, P, N)		/* empty */
+
+/**
+ * Distributes the construction of a table among threads.
+ */
+#if MULTI == OPENMP
+#define DLOG_PARALLEL														\
+	omp_set_num_threads(CORES);												\
+	_Pragma("omp parallel for copyin(core_ctx)")
+#else
+#define DLOG_PARALLEL			/* empty */
+#endif
+
+TMPL_DLOG_CHUNK(g1, g1_add, g1_mul_dig, dlog_norm1)
+TMPL_DLOG_BUILD(g1)
+TMPL_DLOG_BSGS(g1, g1_add, g1_mul_dig, dlog_neg1, dlog_norm1, g1_is_infty)
+TMPL_DLOG_KANG(g1, g1_add, g1_dbl, g1_mul_dig, dlog_norm1, DLOG_TRIES)
+
+TMPL_DLOG_CHUNK(g2, g2_add, g2_mul_dig, g2_norm_sim)
+TMPL_DLOG_BUILD(g2)
+TMPL_DLOG_BSGS(g2, g2_add, g2_mul_dig, dlog_neg2, g2_norm_sim, g2_is_infty)
+TMPL_DLOG_KANG(g2, g2_add, g2_dbl, g2_mul_dig, g2_norm_sim, DLOG_TRIES)
+
+TMPL_DLOG_CHUNK(gt, gt_mul, gt_exp_dig, dlog_normt)
+TMPL_DLOG_BUILD(gt)
+TMPL_DLOG_BSGS(gt, gt_mul, gt_exp_dig, gt_inv, dlog_normt, gt_is_unity)
+TMPL_DLOG_KANG(gt, gt_mul, gt_sqr, gt_exp_dig, dlog_normt, 1)
+
+/**
+ * Reads the number of baby steps from the header of a serialized table.
+ *
+ * @param[in] bin			- the byte vector.
+ * @param[in] len			- the buffer capacity.
+ * @return the number of baby steps, or zero if the buffer is invalid.
+ */
+static int dlog_head(const uint8_t *bin, int len) {
+	int m = 0;
+
+	if (len < DLOG_HEAD) {
+		return 0;
+	}
+	for (int i = 0; i < 4; i++) {
+		m = (m << 8) | bin[i];
+	}
+	if (m < 2 || len != DLOG_HEAD + 2 * (m - 1) * (int)sizeof(uint64_t)) {
+		return 0;
+	}
+	return m;
+}
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+TMPL_DLOG_BOUNDED(g1)
+TMPL_DLOG_BOUNDED(g2)
+TMPL_DLOG_BOUNDED(gt)
+
+int pc_dlog_size_bin(dlog_tab_t tab) {
+	return DLOG_HEAD + 2 * (tab->m - 1) * sizeof(uint64_t);
+}
+
+void pc_dlog_write_bin(uint8_t *bin, int len, dlog_tab_t tab) {
+	if (tab->m < 2 || len != pc_dlog_size_bin(tab)) {
+		RLC_THROW(ERR_NO_BUFFER);
+		return;
+	}
+
+	memset(bin, 0, DLOG_HEAD);
+	for (int i = 0; i < 4; i++) {
+		bin[i] = (uint8_t)(tab->m >> (24 - 8 * i));
+	}
+	memcpy(bin + DLOG_HEAD, tab->t, len - DLOG_HEAD);
+}
+
+void pc_dlog_read_bin(dlog_tab_t tab, const uint8_t *bin, int len) {
+	int m = dlog_head(bin, len);
+
+	if (m == 0) {
+		RLC_THROW(ERR_NO_BUFFER);
+		return;
+	}
+	dlog_alloc(tab, m);
+	if (tab->t != NULL) {
+		memcpy(tab->t, bin + DLOG_HEAD, len - DLOG_HEAD);
+	}
+}
+
+void pc_dlog_map_bin(dlog_tab_t tab, const uint8_t *bin, int len) {
+	int m = dlog_head(bin, len);
+
+	if (m == 0) {
+		RLC_THROW(ERR_NO_BUFFER);
+		return;
+	}
+	if (((uintptr_t)(bin + DLOG_HEAD)) % sizeof(uint64_t) != 0) {
+		RLC_THROW(ERR_NO_VALID);
+		return;
+	}
+	if (!tab->map) {
+		free(tab->t);
+	}
+	/* Reference the entries in place, the buffer must outlive the table. */
+	tab->t = (uint64_t *)(bin + DLOG_HEAD);
+	tab->m = m;
+	tab->map = 1;
+}
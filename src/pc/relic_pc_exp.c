@@ -31,6 +31,212 @@
 #include "relic_pc.h"
 #include "relic_core.h"
 
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Squares an element of the cyclotomic subgroup of the extension field that
+ * contains G_T, if such a specialized squaring is available.
+ */
+#if FP_PRIME < 1536
+#define gt_sqr_cyc(C, A)	RLC_CAT(RLC_GT_LOWER, sqr_cyc)(C, A)
+#else
+#define gt_sqr_cyc(C, A)	gt_sqr(C, A)
+#endif
+
+/**
+ * Returns the number of parts produced by the Frobenius decomposition of an
+ * exponent in G_T, together with the flag expected by bn_rec_frb().
+ *
+ * @param[out] bls			- the flag indicating a BLS curve.
+ * @return the number of parts, or 1 if the decomposition is not available.
+ */
+static int gt_exp_frb(int *bls) {
+	*bls = 0;
+#if FP_PRIME < 1536 && FP_PRIME != 509
+	if (ep_curve_is_pairf() == EP_BN || ep_curve_is_pairf() == EP_B12) {
+		*bls = (ep_curve_is_pairf() == EP_B12);
+		return 4;
+	}
+#elif FP_PRIME == 509
+	if (ep_curve_is_pairf() == EP_B24) {
+		*bls = 1;
+		return 8;
+	}
+#endif
+	return 1;
+}
+
+/**
+ * Recodes an exponent into signed digits of w bits, where each digit lies in
+ * the interval (-2^(w-1), 2^(w-1)]. The sign of the exponent is folded into
+ * the digits.
+ *
+ * @param[out] d			- the digits, least significant first.
+ * @param[in] k				- the exponent.
+ * @param[in] len			- the number of digits to produce.
+ * @param[in] w				- the window size.
+ */
+static void gt_exp_rec(int16_t *d, const bn_t k, int len, int w) {
+	int i, j, v, c = 0, s = (bn_sign(k) == RLC_NEG ? -1 : 1);
+
+	for (i = 0; i < len; i++) {
+		v = c;
+		for (j = 0; j < w; j++) {
+			v += bn_get_bit(k, i * w + j) << j;
+		}
+		c = (v > (1 << (w - 1)));
+		if (c) {
+			v -= (1 << w);
+		}
+		d[i] = (int16_t)(s * v);
+	}
+}
+
+/**
+ * Exponentiates several elements of G_T simultaneously with the bucket method
+ * of Pippenger. Exponent i of element j is applied to the j-th power of the
+ * Frobenius of element i, so the Frobenius is applied only to the partial
+ * results. Computes c = \prod_i \prod_j frb^j(a_i)^(d_{i,j}).
+ *
+ * @param[out] c			- the result.
+ * @param[in] a				- the elements to exponentiate.
+ * @param[in] dig			- the signed digits of the exponents.
+ * @param[in] n				- the number of elements.
+ * @param[in] m				- the number of exponents per element.
+ * @param[in] len			- the number of digits per exponent.
+ * @param[in] w				- the window size.
+ */
+static void gt_exp_pip(gt_t c, gt_t *a, const int16_t *dig, int n,
+		int m, int len, int w) {
+	const int h = (1 << (w - 1));
+	int i, j, k, l, d, s, su, sv, *f = RLC_ALLOCA(int, m * h);
+	gt_t t, u, v, *b = RLC_ALLOCA(gt_t, m * h);
+
+	gt_null(t);
+	gt_null(u);
+	gt_null(v);
+
+	RLC_TRY {
+		if (f == NULL || b == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		gt_new(t);
+		gt_new(u);
+		gt_new(v);
+		for (i = 0; i < m * h; i++) {
+			gt_null(b[i]);
+			gt_new(b[i]);
+		}
+
+		s = 0;
+		for (l = len - 1; l >= 0; l--) {
+			if (s) {
+				for (i = 0; i < w; i++) {
+					gt_sqr_cyc(c, c);
+				}
+			}
+
+			/* Fill the buckets with the elements indexed by their digits. */
+			memset(f, 0, m * h * sizeof(int));
+			for (i = 0; i < n; i++) {
+				for (j = 0; j < m; j++) {
+					d = dig[(i * m + j) * len + l];
+					if (d != 0) {
+						k = j * h + (d > 0 ? d : -d) - 1;
+						if (d < 0) {
+							gt_inv(t, a[i]);
+						} else {
+							gt_copy(t, a[i]);
+						}
+						if (f[k]) {
+							gt_mul(b[k], b[k], t);
+						} else {
+							gt_copy(b[k], t);
+							f[k] = 1;
+						}
+					}
+				}
+			}
+
+			/* Compute \prod_k b_k^(k + 1) with running products, then combine
+			 * the partial results with Horner's rule on the Frobenius. */
+			sv = 0;
+			for (j = m - 1; j >= 0; j--) {
+				if (sv) {
+					gt_frb(v, v, 1);
+				}
+				su = 0;
+				for (k = h - 1; k >= 0; k--) {
+					if (f[j * h + k]) {
+						if (su) {
+							gt_mul(u, u, b[j * h + k]);
+						} else {
+							gt_copy(u, b[j * h + k]);
+							su = 1;
+						}
+					}
+					if (su) {
+						if (sv) {
+							gt_mul(v, v, u);
+						} else {
+							gt_copy(v, u);
+							sv = 1;
+						}
+					}
+				}
+			}
+
+			if (sv) {
+				if (s) {
+					gt_mul(c, c, v);
+				} else {
+					gt_copy(c, v);
+					s = 1;
+				}
+			}
+		}
+
+		if (!s) {
+			gt_set_unity(c);
+		}
+	} RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	} RLC_FINALLY {
+		gt_free(t);
+		gt_free(u);
+		gt_free(v);
+		for (i = 0; b != NULL && i < m * h; i++) {
+			gt_free(b[i]);
+		}
+		RLC_FREE(f);
+		RLC_FREE(b);
+	}
+}
+
+/**
+ * Chooses the window size minimizing the cost of the bucket method.
+ *
+ * @param[in] n				- the number of exponents.
+ * @param[in] m				- the number of bucket sets.
+ * @param[in] bits			- the maximum length of the exponents.
+ * @return the window size.
+ */
+static int gt_exp_win(int n, int m, int bits) {
+	int w, best = 1, cost, min = -1;
+
+	for (w = 1; w <= 12; w++) {
+		/* Each window takes one product per digit and two per bucket. */
+		cost = ((bits + w) / w) * (n + m * (1 << w));
+		if (min < 0 || cost < min) {
+			min = cost;
+			best = w;
+		}
+	}
+	return best;
+}
+
 /*============================================================================*/
 /* Public definitions                                                         */
 /*============================================================================*/
@@ -226,6 +432,127 @@ void gt_exp_sim(gt_t e, gt_t a, bn_t b, gt_t c, bn_t d) {
 	}
 }
 
+void gt_exp_sim_lot(gt_t c, gt_t a[], bn_t b[], int n) {
+	int i, j, m, w, bls, len, l = 0;
+	int16_t *dig = NULL;
+	bn_t e, q, x, _b[8];
+
+	if (n == 0) {
+		gt_set_unity(c);
+		return;
+	}
+
+	if (n == 1) {
+		gt_exp(c, a[0], b[0]);
+		return;
+	}
+
+	bn_null(e);
+	bn_null(q);
+	bn_null(x);
+
+	RLC_TRY {
+		bn_new(e);
+		bn_new(q);
+		bn_new(x);
+		for (i = 0; i < 8; i++) {
+			bn_null(_b[i]);
+			bn_new(_b[i]);
+		}
+
+		/* Split exponents with the Frobenius, as in the GLS method. */
+		m = gt_exp_frb(&bls);
+		pc_get_ord(q);
+		fp_prime_get_par(x);
+		for (i = 0; i < n; i++) {
+			bn_mod(e, b[i], q);
+			if (m > 1) {
+				bn_rec_frb(_b, m, e, x, q, bls);
+			} else {
+				bn_copy(_b[0], e);
+			}
+			for (j = 0; j < m; j++) {
+				l = RLC_MAX(l, bn_bits(_b[j]));
+			}
+		}
+
+		w = gt_exp_win(n * m, m, l);
+		len = (l + w) / w;
+		dig = RLC_ALLOCA(int16_t, n * m * len);
+		if (dig == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < n; i++) {
+			bn_mod(e, b[i], q);
+			if (m > 1) {
+				bn_rec_frb(_b, m, e, x, q, bls);
+			} else {
+				bn_copy(_b[0], e);
+			}
+			for (j = 0; j < m; j++) {
+				gt_exp_rec(dig + (i * m + j) * len, _b[j], len, w);
+			}
+		}
+
+		gt_exp_pip(c, a, dig, n, m, len, w);
+	} RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	} RLC_FINALLY {
+		bn_free(e);
+		bn_free(q);
+		bn_free(x);
+		for (i = 0; i < 8; i++) {
+			bn_free(_b[i]);
+		}
+		RLC_FREE(dig);
+	}
+}
+
+void gt_exp_sim_dig(gt_t c, gt_t a[], dig_t b[], int n) {
+	int i, w, len, l = 0;
+	int16_t *dig = NULL;
+	bn_t e;
+
+	if (n == 0) {
+		gt_set_unity(c);
+		return;
+	}
+
+	if (n == 1) {
+		gt_exp_dig(c, a[0], b[0]);
+		return;
+	}
+
+	bn_null(e);
+
+	RLC_TRY {
+		bn_new(e);
+
+		for (i = 0; i < n; i++) {
+			l = RLC_MAX(l, util_bits_dig(b[i]));
+		}
+
+		/* Exponents are already short, so there is nothing to split. */
+		w = gt_exp_win(n, 1, l);
+		len = (l + w) / w;
+		dig = RLC_ALLOCA(int16_t, n * len);
+		if (dig == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
+		for (i = 0; i < n; i++) {
+			bn_set_dig(e, b[i]);
+			gt_exp_rec(dig + i * len, e, len, w);
+		}
+
+		gt_exp_pip(c, a, dig, n, 1, len, w);
+	} RLC_CATCH_ANY {
+		RLC_THROW(ERR_CAUGHT);
+	} RLC_FINALLY {
+		bn_free(e);
+		RLC_FREE(dig);
+	}
+}
+
 void gt_exp_gen(gt_t c, bn_t b) {
 	bn_t n, _b;
 	gt_t g;
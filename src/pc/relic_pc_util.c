@@ -61,7 +61,7 @@ void gt_rand(gt_t a) {
 }
 
 void gt_get_gen(gt_t g) {
-    gt_copy(g, core_get()->gt_g);
+    gt_copy(g, core_par_get()->gt_g);
 }
 
 int g1_is_valid(g1_t a) {
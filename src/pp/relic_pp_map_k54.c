@@ -114,13 +114,13 @@ static void pp_mil_k54(fp54_t r, fp9_t qx, fp9_t qy, ep_t p, bn_t a) {
 		fp3_set_dig(sz[1], 1);
 		fp9_inv(sz, sz);
 		fp_copy(sz[0][0], sz[2][2]);
-		fp_mul(sz[0][0], sz[0][0], core_get()->fp3_p0[1]);
-		fp_mul(sz[0][0], sz[0][0], core_get()->fp3_p1[3]);
-		fp_mul(sz[0][0], sz[0][0], core_get()->fp3_p1[0]);
+		fp_mul(sz[0][0], sz[0][0], core_par_get()->fp3_p0[1]);
+		fp_mul(sz[0][0], sz[0][0], core_par_get()->fp3_p1[3]);
+		fp_mul(sz[0][0], sz[0][0], core_par_get()->fp3_p1[0]);
 		fp3_mul_nor(sz[0], sz[0]);
 		fp3_mul_nor(sz[0], sz[0]);
 		fp3_mul_nor(sz[0], sz[0]);
-		fp_mul(sz[1][0], sz[0][0], core_get()->fp3_p2[1]);
+		fp_mul(sz[1][0], sz[0][0], core_par_get()->fp3_p2[1]);
 
 		for (int i = 0; i < 3; i++) {
 			fp3_mul(ry[i], ry[i], sz[0]);
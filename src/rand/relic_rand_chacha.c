@@ -0,0 +1,333 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * Implementation of a fast-key-erasure pseudo-random number generator based
+ * on the ChaCha20 stream cipher.
+ *
+ * The internal state holds a 256-bit key followed by a buffer of keystream.
+ * Each time the buffer is refilled, the first 32 bytes of keystream replace
+ * the key, so that past outputs cannot be recovered from a compromised state.
+ * Bytes are erased from the buffer as they are returned, and the context
+ * counter keeps the offset of the first unused byte.
+ *
+ * @ingroup rand
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "relic_conf.h"
+#include "relic_core.h"
+#include "relic_label.h"
+#include "relic_rand.h"
+#include "relic_md.h"
+#include "relic_err.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+#if RAND == CHACHA
+
+/**
+ * Size in bytes of a ChaCha20 block.
+ */
+#define RAND_BLOCK			64
+
+/**
+ * Number of blocks computed in parallel, so that the compiler can map each
+ * block to a lane of a vector register.
+ */
+#define RAND_WAY			4
+
+/**
+ * Size in bytes of the key.
+ */
+#define RAND_KEY			32
+
+/**
+ * Size in bytes of the buffer of keystream.
+ */
+#define RAND_BUF			(RLC_RAND_SIZE - RAND_KEY)
+
+/**
+ * Rotates a 32-bit word to the left.
+ */
+#define RAND_ROTL(X, I)		(((X) << (I)) | ((X) >> (32 - (I))))
+
+#ifdef __SSE2__
+
+/**
+ * Rotates each 32-bit word of a vector register to the left.
+ */
+#define RAND_VROTL(X, I)	_mm_or_si128(_mm_slli_epi32(X, I), _mm_srli_epi32(X, 32 - (I)))
+
+/**
+ * Computes a ChaCha quarter round on four blocks held in vector registers.
+ *
+ * @param[in,out] v			- the state, one word of every block per register.
+ * @param[in] a				- the index of the first word.
+ * @param[in] b				- the index of the second word.
+ * @param[in] c				- the index of the third word.
+ * @param[in] d				- the index of the fourth word.
+ */
+static inline void rand_vround(__m128i v[16], int a, int b, int c, int d) {
+	v[a] = _mm_add_epi32(v[a], v[b]);
+	v[d] = _mm_xor_si128(v[d], v[a]);
+	v[d] = RAND_VROTL(v[d], 16);
+	v[c] = _mm_add_epi32(v[c], v[d]);
+	v[b] = _mm_xor_si128(v[b], v[c]);
+	v[b] = RAND_VROTL(v[b], 12);
+	v[a] = _mm_add_epi32(v[a], v[b]);
+	v[d] = _mm_xor_si128(v[d], v[a]);
+	v[d] = RAND_VROTL(v[d], 8);
+	v[c] = _mm_add_epi32(v[c], v[d]);
+	v[b] = _mm_xor_si128(v[b], v[c]);
+	v[b] = RAND_VROTL(v[b], 7);
+}
+
+#endif
+
+/**
+ * Computes a ChaCha quarter round on every lane of the state, for compilers
+ * without vector support.
+ *
+ * @param[in,out] x			- the state.
+ * @param[in] a				- the index of the first word.
+ * @param[in] b				- the index of the second word.
+ * @param[in] c				- the index of the third word.
+ * @param[in] d				- the index of the fourth word.
+ */
+static inline void rand_round(uint32_t x[16][RAND_WAY], int a, int b, int c,
+		int d) {
+	for (int l = 0; l < RAND_WAY; l++) {
+		x[a][l] += x[b][l];
+		x[d][l] ^= x[a][l];
+		x[d][l] = RAND_ROTL(x[d][l], 16);
+		x[c][l] += x[d][l];
+		x[b][l] ^= x[c][l];
+		x[b][l] = RAND_ROTL(x[b][l], 12);
+		x[a][l] += x[b][l];
+		x[d][l] ^= x[a][l];
+		x[d][l] = RAND_ROTL(x[d][l], 8);
+		x[c][l] += x[d][l];
+		x[b][l] ^= x[c][l];
+		x[b][l] = RAND_ROTL(x[b][l], 7);
+	}
+}
+
+/**
+ * Computes consecutive blocks of ChaCha20 keystream with a zero nonce.
+ *
+ * @param[out] out			- the buffer of RAND_WAY blocks to write.
+ * @param[in] key			- the key.
+ * @param[in] ctr			- the block counter of the first block.
+ */
+static void rand_core(uint8_t *out, const uint8_t *key, uint32_t ctr) {
+	uint32_t s[16][RAND_WAY];
+	const uint32_t c[4] = { 0x61707865, 0x3320646E, 0x79622D32, 0x6B206574 };
+	int i, j, l;
+
+	for (l = 0; l < RAND_WAY; l++) {
+		for (i = 0; i < 4; i++) {
+			s[i][l] = c[i];
+		}
+		for (i = 0; i < 8; i++) {
+			s[i + 4][l] = 0;
+			for (j = 3; j >= 0; j--) {
+				s[i + 4][l] = (s[i + 4][l] << 8) | key[4 * i + j];
+			}
+		}
+		s[12][l] = ctr + l;
+		s[13][l] = s[14][l] = s[15][l] = 0;
+	}
+
+#if defined(__SSE2__) && RAND_WAY == 4
+	__m128i t[4], v[16];
+
+	for (i = 0; i < 16; i++) {
+		v[i] = _mm_loadu_si128((const __m128i *)s[i]);
+	}
+	for (i = 0; i < 10; i++) {
+		rand_vround(v, 0, 4, 8, 12);
+		rand_vround(v, 1, 5, 9, 13);
+		rand_vround(v, 2, 6, 10, 14);
+		rand_vround(v, 3, 7, 11, 15);
+		rand_vround(v, 0, 5, 10, 15);
+		rand_vround(v, 1, 6, 11, 12);
+		rand_vround(v, 2, 7, 8, 13);
+		rand_vround(v, 3, 4, 9, 14);
+	}
+	/* Transpose groups of four words back into blocks, as x86 is little-endian. */
+	for (i = 0; i < 16; i += 4) {
+		for (j = 0; j < 4; j++) {
+			v[i + j] = _mm_add_epi32(v[i + j],
+					_mm_loadu_si128((const __m128i *)s[i + j]));
+		}
+		t[0] = _mm_unpacklo_epi32(v[i], v[i + 1]);
+		t[1] = _mm_unpacklo_epi32(v[i + 2], v[i + 3]);
+		t[2] = _mm_unpackhi_epi32(v[i], v[i + 1]);
+		t[3] = _mm_unpackhi_epi32(v[i + 2], v[i + 3]);
+		_mm_storeu_si128((__m128i *)(out + 4 * i),
+				_mm_unpacklo_epi64(t[0], t[1]));
+		_mm_storeu_si128((__m128i *)(out + RAND_BLOCK + 4 * i),
+				_mm_unpackhi_epi64(t[0], t[1]));
+		_mm_storeu_si128((__m128i *)(out + 2 * RAND_BLOCK + 4 * i),
+				_mm_unpacklo_epi64(t[2], t[3]));
+		_mm_storeu_si128((__m128i *)(out + 3 * RAND_BLOCK + 4 * i),
+				_mm_unpackhi_epi64(t[2], t[3]));
+	}
+	for (i = 0; i < 16; i++) {
+		v[i] = _mm_setzero_si128();
+	}
+#else
+	uint32_t x[16][RAND_WAY];
+
+	memcpy(x, s, sizeof(x));
+	for (i = 0; i < 10; i++) {
+		rand_round(x, 0, 4, 8, 12);
+		rand_round(x, 1, 5, 9, 13);
+		rand_round(x, 2, 6, 10, 14);
+		rand_round(x, 3, 7, 11, 15);
+		rand_round(x, 0, 5, 10, 15);
+		rand_round(x, 1, 6, 11, 12);
+		rand_round(x, 2, 7, 8, 13);
+		rand_round(x, 3, 4, 9, 14);
+	}
+	for (l = 0; l < RAND_WAY; l++) {
+		for (i = 0; i < 16; i++) {
+			x[i][l] += s[i][l];
+			for (j = 0; j < 4; j++) {
+				out[l * RAND_BLOCK + 4 * i + j] = (uint8_t)(x[i][l] >> (8 * j));
+			}
+		}
+	}
+	memset(x, 0, sizeof(x));
+#endif
+	memset(s, 0, sizeof(s));
+}
+
+/**
+ * Writes keystream to a buffer and replaces the key with fresh keystream.
+ *
+ * @param[out] out			- the buffer to write.
+ * @param[in] len			- the number of bytes to write.
+ */
+static void rand_stream(uint8_t *out, int len) {
+	uint8_t blk[RAND_WAY * RAND_BLOCK];
+	uint8_t *key = core_get()->rand;
+	uint32_t ctr = 0;
+	int l, n, first = 1;
+
+	while (len > 0 || first) {
+		rand_core(blk, key, ctr);
+		ctr += RAND_WAY;
+		/* Set aside the first block to derive the next key. */
+		n = (first ? RAND_BLOCK : 0);
+		l = RLC_MIN(len, (int)sizeof(blk) - n);
+		if (l > 0) {
+			memcpy(out, blk + n, l);
+			out += l;
+			len -= l;
+		}
+		if (first) {
+			memcpy(key, blk, RAND_KEY);
+			first = 0;
+		}
+	}
+	memset(blk, 0, sizeof(blk));
+}
+
+#endif
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+#if RAND == CHACHA
+
+void rand_bytes(uint8_t *buf, int size) {
+	ctx_t *ctx = core_get();
+	uint8_t *pool = ctx->rand + RAND_KEY;
+	int len;
+
+	while (size > 0) {
+		if (ctx->counter == RAND_BUF) {
+			if (size >= RAND_BUF) {
+				/* Serve large requests directly from the keystream. */
+				rand_stream(buf, size);
+				return;
+			}
+			rand_stream(pool, RAND_BUF);
+			ctx->counter = 0;
+		}
+		len = RLC_MIN(size, RAND_BUF - ctx->counter);
+		memcpy(buf, pool + ctx->counter, len);
+		memset(pool + ctx->counter, 0, len);
+		ctx->counter += len;
+		buf += len;
+		size -= len;
+	}
+}
+
+void rand_seed(uint8_t *buf, int size) {
+	ctx_t *ctx = core_get();
+	uint8_t *tmp;
+
+	if (size <= 0) {
+		RLC_THROW(ERR_NO_VALID);
+		return;
+	}
+
+	tmp = RLC_ALLOCA(uint8_t, RAND_KEY + size);
+	if (tmp == NULL) {
+		RLC_THROW(ERR_NO_MEMORY);
+		return;
+	}
+
+	if (ctx->seeded == 0) {
+		/* K = SHA-256(seed). */
+		md_map_sh256(ctx->rand, buf, size);
+	} else {
+		/* K = SHA-256(K || seed). */
+		memcpy(tmp, ctx->rand, RAND_KEY);
+		memcpy(tmp + RAND_KEY, buf, size);
+		md_map_sh256(ctx->rand, tmp, RAND_KEY + size);
+		memset(tmp, 0, RAND_KEY + size);
+	}
+	/* Discard any keystream computed with the previous key. */
+	memset(ctx->rand + RAND_KEY, 0, RAND_BUF);
+	ctx->counter = RAND_BUF;
+	ctx->seeded = 1;
+	RLC_FREE(tmp);
+}
+
+#endif
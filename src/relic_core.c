@@ -99,35 +99,32 @@ rlc_thread ctx_t *core_ctx = NULL;
 static ctx_t *core_ctx = NULL;
 #endif
 
-int core_init(void) {
-	if (core_ctx == NULL) {
-		core_ctx = &(first_ctx);
-	}
-
-#ifdef CHECK
-	core_ctx->reason[ERR_NO_MEMORY] = MSG_NO_MEMORY;
-	core_ctx->reason[ERR_NO_PRECI] = MSG_NO_PRECI;
-	core_ctx->reason[ERR_NO_FILE] = MSG_NO_FILE;
-	core_ctx->reason[ERR_NO_READ] = MSG_NO_READ;
-	core_ctx->reason[ERR_NO_VALID] = MSG_NO_VALID;
-	core_ctx->reason[ERR_NO_BUFFER] = MSG_NO_BUFFER;
-	core_ctx->reason[ERR_NO_FIELD] = MSG_NO_FIELD;
-	core_ctx->reason[ERR_NO_CURVE] = MSG_NO_CURVE;
-	core_ctx->reason[ERR_NO_CONFIG] = MSG_NO_CONFIG;
-	core_ctx->reason[ERR_NO_RAND] = MSG_NO_RAND;
-	core_ctx->last = NULL;
-#endif /* CHECK */
+/**
+ * Library parameters shared by all contexts.
+ */
+static params_t first_par;
 
-	core_ctx->code = RLC_OK;
+#if MULTI == PTHREAD
+/**
+ * Lock protecting the reference counts of shared parameters.
+ */
+static pthread_mutex_t core_lock = PTHREAD_MUTEX_INITIALIZER;
+#endif
 
-	RLC_TRY {
-		arch_init();
-		rand_init();
+/**
+ * Initializes a block of parameters and makes it the only one referenced by
+ * the current context.
+ *
+ * @param[out] par			- the block of parameters.
+ * @return RLC_OK if no error occurs, RLC_ERR otherwise.
+ */
+static int core_par_make(params_t *par) {
+	int result = RLC_OK;
 
-#if BENCH > 0
-		bench_init();
-#endif
+	core_ctx->params = par;
+	par->refs = 1;
 
+	RLC_TRY {
 #ifdef WITH_FP
 		fp_prime_init();
 #endif
@@ -150,13 +147,64 @@ int core_init(void) {
 		pc_core_init();
 #endif
 	} RLC_CATCH_ANY {
-		return RLC_ERR;
+		result = RLC_ERR;
+	}
+
+	if (result != RLC_OK) {
+		/* Do not let other contexts share a half-initialized block. */
+		par->refs = 0;
+		core_ctx->params = NULL;
+	}
+	return result;
+}
+
+/**
+ * Initializes the shared parameters if this is the first context referencing
+ * them, or simply takes another reference otherwise. With dynamic allocation,
+ * every later context gets its own parameters instead.
+ *
+ * @return RLC_OK if no error occurs, RLC_ERR otherwise.
+ */
+static int core_par_init(void) {
+	params_t *par = &(first_par);
+
+	if (first_par.refs > 0) {
+#if ALLOC == AUTO
+		core_ctx->params = &(first_par);
+		first_par.refs++;
+		return RLC_OK;
+#else
+		/* Parameters holding dynamic memory cannot be copied, so they are
+		 * never shared. */
+		par = (params_t *)malloc(sizeof(params_t));
+		if (par == NULL) {
+			return RLC_ERR;
+		}
+		memset(par, 0, sizeof(params_t));
+#endif
 	}
 
+	if (core_par_make(par) != RLC_OK) {
+		if (par != &(first_par)) {
+			free(par);
+		}
+		return RLC_ERR;
+	}
 	return RLC_OK;
 }
 
-int core_clean(void) {
+/**
+ * Releases a reference to the parameters of the current context and finalizes
+ * them if this was the last context referencing them.
+ */
+static void core_par_clean(void) {
+	params_t *par = core_ctx->params;
+
+	if (par == NULL || --par->refs > 0) {
+		core_ctx->params = NULL;
+		return;
+	}
+
 #ifdef WITH_FP
 	fp_prime_clean();
 #endif
@@ -179,6 +227,113 @@ int core_clean(void) {
 	pc_core_clean();
 #endif
 
+	core_ctx->params = NULL;
+	if (par != &(first_par)) {
+		free(par);
+	}
+}
+
+#if ALLOC == AUTO
+
+/**
+ * Copies a block of parameters, pointing its tables to its own storage.
+ *
+ * @param[out] c			- the copy.
+ * @param[in] a				- the block of parameters to copy.
+ */
+static void core_par_copy(params_t *c, const params_t *a) {
+	memcpy(c, a, sizeof(params_t));
+#if defined(WITH_EB) && defined(EB_PRECO)
+	for (int i = 0; i < RLC_EB_TABLE; i++) {
+		c->eb_ptr[i] = &(c->eb_pre[i]);
+	}
+#endif
+#if defined(WITH_EP) && defined(EP_PRECO)
+	for (int i = 0; i < RLC_EP_TABLE; i++) {
+		c->ep_ptr[i] = &(c->ep_pre[i]);
+	}
+#endif
+#if defined(WITH_EPX) && defined(EP_PRECO)
+	for (int i = 0; i < RLC_EP_TABLE; i++) {
+		c->ep2_ptr[i] = &(c->ep2_pre[i]);
+		c->ep4_ptr[i] = &(c->ep4_pre[i]);
+	}
+#endif
+#if defined(WITH_ED) && defined(ED_PRECO)
+	for (int i = 0; i < RLC_ED_TABLE; i++) {
+		c->ed_ptr[i] = &(c->ed_pre[i]);
+	}
+#endif
+}
+
+#endif /* ALLOC == AUTO */
+
+int core_init(void) {
+	int result = RLC_OK;
+
+	if (core_ctx == NULL) {
+		core_ctx = &(first_ctx);
+	}
+
+#ifdef CHECK
+	core_ctx->reason[ERR_NO_MEMORY] = MSG_NO_MEMORY;
+	core_ctx->reason[ERR_NO_PRECI] = MSG_NO_PRECI;
+	core_ctx->reason[ERR_NO_FILE] = MSG_NO_FILE;
+	core_ctx->reason[ERR_NO_READ] = MSG_NO_READ;
+	core_ctx->reason[ERR_NO_VALID] = MSG_NO_VALID;
+	core_ctx->reason[ERR_NO_BUFFER] = MSG_NO_BUFFER;
+	core_ctx->reason[ERR_NO_FIELD] = MSG_NO_FIELD;
+	core_ctx->reason[ERR_NO_CURVE] = MSG_NO_CURVE;
+	core_ctx->reason[ERR_NO_CONFIG] = MSG_NO_CONFIG;
+	core_ctx->reason[ERR_NO_RAND] = MSG_NO_RAND;
+	core_ctx->last = NULL;
+#endif /* CHECK */
+
+	core_ctx->code = RLC_OK;
+	core_ctx->params = NULL;
+
+	RLC_TRY {
+		arch_init();
+		rand_init();
+
+#if BENCH > 0
+		bench_init();
+#endif
+	} RLC_CATCH_ANY {
+		return RLC_ERR;
+	}
+
+	/* Only the first context pays for building parameters and tables. */
+#if MULTI == PTHREAD
+	pthread_mutex_lock(&core_lock);
+#elif MULTI == OPENMP
+#pragma omp critical (relic_core)
+#endif
+	{
+		result = core_par_init();
+	}
+#if MULTI == PTHREAD
+	pthread_mutex_unlock(&core_lock);
+#endif
+
+	return result;
+}
+
+int core_clean(void) {
+	if (core_ctx != NULL) {
+#if MULTI == PTHREAD
+		pthread_mutex_lock(&core_lock);
+#elif MULTI == OPENMP
+#pragma omp critical (relic_core)
+#endif
+		{
+			core_par_clean();
+		}
+#if MULTI == PTHREAD
+		pthread_mutex_unlock(&core_lock);
+#endif
+	}
+
 #if BENCH > 0
 		bench_clean();
 #endif
@@ -207,6 +362,46 @@ void core_set(ctx_t *ctx) {
 	core_ctx = ctx;
 }
 
+params_t *core_par_get(void) {
+	return core_get()->params;
+}
+
+params_t *core_par_own(void) {
+	ctx_t *ctx = core_get();
+#if ALLOC == AUTO
+	params_t *par = NULL;
+	int result = RLC_OK;
+
+#if MULTI == PTHREAD
+	pthread_mutex_lock(&core_lock);
+#elif MULTI == OPENMP
+#pragma omp critical (relic_core)
+#endif
+	{
+		if (ctx->params != NULL && ctx->params->refs > 1) {
+			par = (params_t *)malloc(sizeof(params_t));
+			if (par == NULL) {
+				result = RLC_ERR;
+			} else {
+				/* Other contexts keep reading the block left behind. */
+				core_par_copy(par, ctx->params);
+				par->refs = 1;
+				ctx->params->refs--;
+				ctx->params = par;
+			}
+		}
+	}
+#if MULTI == PTHREAD
+	pthread_mutex_unlock(&core_lock);
+#endif
+
+	if (result != RLC_OK) {
+		RLC_THROW(ERR_NO_MEMORY);
+	}
+#endif /* ALLOC == AUTO */
+	return ctx->params;
+}
+
 #if defined(MULTI)
 void core_set_thread_initializer(void(*init)(void *init_ptr), void* init_ptr) {
     core_thread_initializer = init;
@@ -0,0 +1,319 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+/**
+ * @file
+ *
+ * Templates for computing bounded discrete logarithms in pairing groups.
+ *
+ * The group is written additively. For a group with prefix PFX, the
+ * templates expect a function PFX_dlog_key() computing the fingerprint of an
+ * element, and take the group operations as arguments so that G_T can be
+ * handled with its multiplicative notation.
+ *
+ * @ingroup tmpl
+ */
+
+/*============================================================================*/
+/* Private definitions                                                        */
+/*============================================================================*/
+
+/**
+ * Fills the table entries for the baby steps [j]S, ..., [j + c - 1]S, where
+ * c is the size of a chunk.
+ */
+#define TMPL_DLOG_CHUNK(PFX, ADD, MUL, NORM)								\
+	static void PFX##_dlog_chunk(dlog_tab_t tab, PFX##_t s, int j) {		\
+		PFX##_t p[DLOG_CHUNK];												\
+		int i, c = RLC_MIN(DLOG_CHUNK, tab->m - j);							\
+																			\
+		RLC_TRY {															\
+			for (i = 0; i < c; i++) {										\
+				PFX##_null(p[i]);											\
+				PFX##_new(p[i]);											\
+			}																\
+																			\
+			MUL(p[0], s, j);												\
+			for (i = 1; i < c; i++) {										\
+				ADD(p[i], p[i - 1], s);										\
+			}																\
+			NORM(p, p, c);													\
+			for (i = 0; i < c; i++) {										\
+				tab->t[2 * (j + i - 1)] = PFX##_dlog_key(p[i]);				\
+				tab->t[2 * (j + i - 1) + 1] = j + i;						\
+			}																\
+		}																	\
+		RLC_CATCH_ANY {														\
+			RLC_THROW(ERR_CAUGHT);											\
+		}																	\
+		RLC_FINALLY {														\
+			for (i = 0; i < c; i++) {										\
+				PFX##_free(p[i]);											\
+			}																\
+		}																	\
+	}																		\
+
+/**
+ * Fills a table with the fingerprints of [j]S for 0 < j < m.
+ */
+#define TMPL_DLOG_BUILD(PFX)												\
+	static void PFX##_dlog_build(dlog_tab_t tab, PFX##_t s) {				\
+		int c, n = RLC_CEIL(tab->m - 1, DLOG_CHUNK);						\
+																			\
+		DLOG_PARALLEL														\
+		for (c = 0; c < n; c++) {											\
+			PFX##_dlog_chunk(tab, s, 1 + c * DLOG_CHUNK);					\
+		}																	\
+		dlog_sort(tab);														\
+	}																		\
+
+/**
+ * Finds x < b such that T = [x]S using baby steps from a table and at most g
+ * giant steps, where (g - 1) * m < b. The giant steps are normalized in chunks,
+ * so that their fingerprints do not cost one inversion each.
+ */
+#define TMPL_DLOG_BSGS(PFX, ADD, MUL, NEG, NORM, IS_ZERO)					\
+	static int PFX##_dlog_bsgs(dig_t *out, PFX##_t t, PFX##_t s,			\
+			dlog_tab_t tab, dig_t g, dig_t b) {								\
+		PFX##_t v, w, z, u[DLOG_CHUNK];										\
+		dig_t i, x;															\
+		int c, h, j, result = RLC_ERR;										\
+																			\
+		PFX##_null(v);														\
+		PFX##_null(w);														\
+		PFX##_null(z);														\
+																			\
+		RLC_TRY {															\
+			PFX##_new(v);													\
+			PFX##_new(w);													\
+			PFX##_new(z);													\
+			for (h = 0; h < DLOG_CHUNK; h++) {								\
+				PFX##_null(u[h]);											\
+				PFX##_new(u[h]);											\
+			}																\
+																			\
+			/* Compute the giant step -[m]S. */								\
+			MUL(v, s, tab->m);												\
+			NEG(v, v);														\
+			PFX##_copy(w, t);												\
+			for (i = 0; i < g && result == RLC_ERR; i += c) {				\
+				c = (int)RLC_MIN(DLOG_CHUNK, g - i);						\
+				for (h = 0; h < c; h++) {									\
+					PFX##_copy(u[h], w);									\
+					ADD(w, w, v);											\
+				}															\
+				NORM(u, u, c);												\
+				for (h = 0; h < c && result == RLC_ERR; h++) {				\
+					x = (i + h) * tab->m;									\
+					if (IS_ZERO(u[h])) {									\
+						*out = x;											\
+						result = RLC_OK;									\
+					} else {												\
+						j = dlog_find(tab, PFX##_dlog_key(u[h]));			\
+						if (j > 0 && x + j < b) {							\
+							/* Rule out collisions of the fingerprints. */	\
+							MUL(z, s, x + j);								\
+							if (PFX##_cmp(z, t) == RLC_EQ) {				\
+								*out = x + j;								\
+								result = RLC_OK;							\
+							}												\
+						}													\
+					}														\
+				}															\
+			}																\
+		}																	\
+		RLC_CATCH_ANY {														\
+			RLC_THROW(ERR_CAUGHT);											\
+		}																	\
+		RLC_FINALLY {														\
+			PFX##_free(v);													\
+			PFX##_free(w);													\
+			PFX##_free(z);													\
+			for (h = 0; h < DLOG_CHUNK; h++) {								\
+				PFX##_free(u[h]);											\
+			}																\
+		}																	\
+		return result;														\
+	}																		\
+
+/**
+ * Finds a <= x < b such that T = [x]S using Pollard's kangaroo method. The
+ * DLOG_TRIES attempts use different jumps and run W at a time in lockstep, so
+ * that kangaroos of the same kind are normalized together.
+ */
+#define TMPL_DLOG_KANG(PFX, ADD, DBL, MUL, NORM, W)							\
+	static int PFX##_dlog_kang(dig_t *out, PFX##_t t, PFX##_t s, dig_t a,	\
+			dig_t b) {														\
+		PFX##_t w, u[W], p[RLC_DIG];										\
+		dig_t d[W], e[W], y[W], n, x;										\
+		int h, i, k, l, r, f[W], result = RLC_ERR;							\
+																			\
+		PFX##_null(w);														\
+																			\
+		k = dlog_jumps(b - a, &n);											\
+																			\
+		RLC_TRY {															\
+			PFX##_new(w);													\
+			for (h = 0; h < W; h++) {										\
+				PFX##_null(u[h]);											\
+				PFX##_new(u[h]);											\
+			}																\
+			for (i = 0; i < k; i++) {										\
+				PFX##_null(p[i]);											\
+				PFX##_new(p[i]);											\
+			}																\
+																			\
+			/* Precompute the jumps [2^i]S. */								\
+			PFX##_copy(p[0], s);											\
+			for (i = 1; i < k; i++) {										\
+				DBL(p[i], p[i - 1]);										\
+			}																\
+			NORM(p + 1, p + 1, k - 1);										\
+																			\
+			for (l = 0; l < DLOG_TRIES && result == RLC_ERR; l += W) {		\
+				/* Let the tame kangaroos run from [b]S and set traps. */	\
+				MUL(w, s, b);												\
+				for (h = 0; h < W; h++) {									\
+					PFX##_copy(u[h], w);									\
+					d[h] = 0;												\
+				}															\
+				NORM(u, u, W);												\
+				for (x = 0; x < n; x++) {									\
+					for (h = 0; h < W; h++) {								\
+						i = (PFX##_dlog_key(u[h]) + l + h) % k;				\
+						ADD(u[h], u[h], p[i]);								\
+						d[h] += (dig_t)1 << i;								\
+					}														\
+					NORM(u, u, W);											\
+				}															\
+				for (h = 0; h < W; h++) {									\
+					y[h] = PFX##_dlog_key(u[h]);							\
+					PFX##_copy(u[h], t);									\
+					e[h] = 0;												\
+					f[h] = 1;												\
+				}															\
+				NORM(u, u, W);												\
+																			\
+				/* Let the wild kangaroos run from T until trapped. */		\
+				for (r = W; r > 0 && result == RLC_ERR;) {					\
+					for (h = 0; h < W && result == RLC_ERR; h++) {			\
+						if (!f[h]) {										\
+							continue;										\
+						}													\
+						x = PFX##_dlog_key(u[h]);							\
+						if (x == y[h]) {									\
+							x = b + d[h] - e[h];							\
+							if (x < b) {									\
+								MUL(w, s, x);								\
+								if (PFX##_cmp(w, t) == RLC_EQ) {			\
+									*out = x;								\
+									result = RLC_OK;						\
+								}											\
+							}												\
+							f[h] = 0;										\
+							r--;											\
+							continue;										\
+						}													\
+						i = (x + l + h) % k;								\
+						ADD(u[h], u[h], p[i]);								\
+						e[h] += (dig_t)1 << i;								\
+						if (e[h] > b + d[h] - a) {							\
+							f[h] = 0;										\
+							r--;											\
+						}													\
+					}														\
+					NORM(u, u, W);											\
+				}															\
+			}																\
+		}																	\
+		RLC_CATCH_ANY {														\
+			RLC_THROW(ERR_CAUGHT);											\
+		}																	\
+		RLC_FINALLY {														\
+			PFX##_free(w);													\
+			for (h = 0; h < W; h++) {										\
+				PFX##_free(u[h]);											\
+			}																\
+			for (i = 0; i < k; i++) {										\
+				PFX##_free(p[i]);											\
+			}																\
+		}																	\
+		return result;														\
+	}																		\
+
+/*============================================================================*/
+/* Public definitions                                                         */
+/*============================================================================*/
+
+/**
+ * Builds a table of m baby steps and computes bounded discrete logarithms.
+ */
+#define TMPL_DLOG_BOUNDED(PFX)												\
+	void PFX##_dlog_tab(dlog_tab_t tab, PFX##_t g, int m) {					\
+		if (m < 2) {														\
+			RLC_THROW(ERR_NO_VALID);										\
+			return;															\
+		}																	\
+		dlog_alloc(tab, m);													\
+		PFX##_dlog_build(tab, g);											\
+	}																		\
+																			\
+	int PFX##_dlog_bounded(dig_t *out, PFX##_t a, PFX##_t g, dig_t bound,	\
+			dlog_tab_t tab) {												\
+		dlog_tab_t t;														\
+		dig_t m;															\
+		int l, result = RLC_ERR;											\
+																			\
+		if (bound == 0) {													\
+			return RLC_ERR;													\
+		}																	\
+																			\
+		dlog_tab_null(t);													\
+																			\
+		RLC_TRY {															\
+			dlog_tab_new(t);												\
+			if (tab == NULL || tab->m < 2) {								\
+				/* Build a single table of about sqrt(bound) baby steps. */	\
+				l = (util_bits_dig(bound - 1) + 1) / 2;						\
+				l = RLC_MAX(1, RLC_MIN(l, DLOG_LOG));						\
+				dlog_alloc(t, 1 << l);										\
+				PFX##_dlog_build(t, g);										\
+				tab = t;													\
+			}																\
+			m = tab->m;														\
+			result = PFX##_dlog_bsgs(out, a, g, tab,						\
+					RLC_MIN(m, RLC_CEIL(bound, m)), bound);					\
+			/* Search the interval not covered by giant steps. */			\
+			if (result != RLC_OK && m < RLC_CEIL(bound, m)) {				\
+				result = PFX##_dlog_kang(out, a, g, m * m, bound);			\
+			}																\
+		}																	\
+		RLC_CATCH_ANY {														\
+			result = RLC_ERR;												\
+		}																	\
+		RLC_FINALLY {														\
+			dlog_tab_free(t);												\
+		}																	\
+		return result;														\
+	}																		\
+
@@ -174,11 +174,11 @@
 #define TMPL_MAP_SSWU(CUR, PFX, PTR_TY, COPY_COND)							\
 	static void CUR##_map_sswu(CUR##_t p, PFX##_t t) {						\
 		PFX##_t t0, t1, t2, t3;												\
-		ctx_t *ctx = core_get();											\
-		PTR_TY *mBoverA = ctx->CUR##_map_c[0];								\
-		PTR_TY *a = ctx->CUR##_map_c[2];									\
-		PTR_TY *b = ctx->CUR##_map_c[3];									\
-		PTR_TY *u = ctx->CUR##_map_u;										\
+		params_t *par = core_par_get();										\
+		PTR_TY *mBoverA = par->CUR##_map_c[0];								\
+		PTR_TY *a = par->CUR##_map_c[2];									\
+		PTR_TY *b = par->CUR##_map_c[3];									\
+		PTR_TY *u = par->CUR##_map_u;										\
                                                                             \
 		PFX##_null(t0);														\
 		PFX##_null(t1);														\
@@ -261,12 +261,12 @@
 			PFX##_new(t3);													\
 			PFX##_new(t4);													\
 																			\
-			ctx_t *ctx = core_get();										\
-			PTR_TY *gU = ctx->CUR##_map_c[0];								\
-			PTR_TY *mUover2 = ctx->CUR##_map_c[1];							\
-			PTR_TY *c3 = ctx->CUR##_map_c[2];								\
-			PTR_TY *c4 = ctx->CUR##_map_c[3];								\
-			PTR_TY *u = ctx->CUR##_map_u;									\
+			params_t *par = core_par_get();									\
+			PTR_TY *gU = par->CUR##_map_c[0];								\
+			PTR_TY *mUover2 = par->CUR##_map_c[1];							\
+			PTR_TY *c3 = par->CUR##_map_c[2];								\
+			PTR_TY *c4 = par->CUR##_map_c[3];								\
+			PTR_TY *u = par->CUR##_map_u;									\
                                                                             \
 			/* start computing the map */									\
 			PFX##_sqr(t1, t);												\
@@ -0,0 +1,235 @@
+/*
+ * RELIC is an Efficient LIbrary for Cryptography
+ * Copyright (c) 2024 RELIC Authors
+ *
+ * This file is part of RELIC. RELIC is legal property of its developers,
+ * whose names are not listed here. Please refer to the COPYRIGHT file
+ * for contact information.
+ *
+ * RELIC is free software; you can redistribute it and/or modify it under the
+ * terms of the version 2.1 (or later) of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; or version 2.0 of the Apache
+ * License as published by the Apache Software Foundation. See the LICENSE files
+ * for more details.
+ *
+ * RELIC is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the LICENSE files for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public or the
+ * Apache License along with RELIC. If not, see <https://www.gnu.org/licenses/>
+ * or <https://www.apache.org/licenses/>.
+ */
+
+
+/**
+ * @file
+ *
+ * Tests for block ciphers.
+ *
+ * @ingroup test
+ */
+
+#include <stdio.h>
+
+#include "relic.h"
+#include "relic_test.h"
+
+/* Test vectors from NIST SP 800-38A, F.5.1. */
+
+static uint8_t ctr_key[] = {
+	0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88,
+	0x09, 0xCF, 0x4F, 0x3C
+};
+
+static uint8_t ctr_iv[] = {
+	0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8, 0xF9, 0xFA, 0xFB,
+	0xFC, 0xFD, 0xFE, 0xFF
+};
+
+static uint8_t ctr_in[] = {
+	0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11,
+	0x73, 0x93, 0x17, 0x2A, 0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C,
+	0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51, 0x30, 0xC8, 0x1C, 0x46,
+	0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+	0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B,
+	0xE6, 0x6C, 0x37, 0x10
+};
+
+static uint8_t ctr_out[] = {
+	0x87, 0x4D, 0x61, 0x91, 0xB6, 0x20, 0xE3, 0x26, 0x1B, 0xEF, 0x68, 0x64,
+	0x99, 0x0D, 0xB6, 0xCE, 0x98, 0x06, 0xF6, 0x6B, 0x79, 0x70, 0xFD, 0xFF,
+	0x86, 0x17, 0x18, 0x7B, 0xB9, 0xFF, 0xFD, 0xFF, 0x5A, 0xE4, 0xDF, 0x3E,
+	0xDB, 0xD5, 0xD3, 0x5E, 0x5B, 0x4F, 0x09, 0x02, 0x0D, 0xB0, 0x3E, 0xAB,
+	0x1E, 0x03, 0x1D, 0xDA, 0x2F, 0xBE, 0x03, 0xD1, 0x79, 0x21, 0x70, 0xA0,
+	0xF3, 0x00, 0x9C, 0xEE
+};
+
+/* Test cases 4 and 16 from the GCM specification by McGrew and Viega. */
+
+static uint8_t gcm_key[] = {
+	0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C, 0x6D, 0x6A, 0x8F, 0x94,
+	0x67, 0x30, 0x83, 0x08, 0xFE, 0xFF, 0xE9, 0x92, 0x86, 0x65, 0x73, 0x1C,
+	0x6D, 0x6A, 0x8F, 0x94, 0x67, 0x30, 0x83, 0x08
+};
+
+static uint8_t gcm_iv[] = {
+	0xCA, 0xFE, 0xBA, 0xBE, 0xFA, 0xCE, 0xDB, 0xAD, 0xDE, 0xCA, 0xF8, 0x88
+};
+
+static uint8_t gcm_ad[] = {
+	0xFE, 0xED, 0xFA, 0xCE, 0xDE, 0xAD, 0xBE, 0xEF, 0xFE, 0xED, 0xFA, 0xCE,
+	0xDE, 0xAD, 0xBE, 0xEF, 0xAB, 0xAD, 0xDA, 0xD2
+};
+
+static uint8_t gcm_in[] = {
+	0xD9, 0x31, 0x32, 0x25, 0xF8, 0x84, 0x06, 0xE5, 0xA5, 0x59, 0x09, 0xC5,
+	0xAF, 0xF5, 0x26, 0x9A, 0x86, 0xA7, 0xA9, 0x53, 0x15, 0x34, 0xF7, 0xDA,
+	0x2E, 0x4C, 0x30, 0x3D, 0x8A, 0x31, 0x8A, 0x72, 0x1C, 0x3C, 0x0C, 0x95,
+	0x95, 0x68, 0x09, 0x53, 0x2F, 0xCF, 0x0E, 0x24, 0x49, 0xA6, 0xB5, 0x25,
+	0xB1, 0x6A, 0xED, 0xF5, 0xAA, 0x0D, 0xE6, 0x57, 0xBA, 0x63, 0x7B, 0x39
+};
+
+static uint8_t gcm_out128[] = {
+	0x42, 0x83, 0x1E, 0xC2, 0x21, 0x77, 0x74, 0x24, 0x4B, 0x72, 0x21, 0xB7,
+	0x84, 0xD0, 0xD4, 0x9C, 0xE3, 0xAA, 0x21, 0x2F, 0x2C, 0x02, 0xA4, 0xE0,
+	0x35, 0xC1, 0x7E, 0x23, 0x29, 0xAC, 0xA1, 0x2E, 0x21, 0xD5, 0x14, 0xB2,
+	0x54, 0x66, 0x93, 0x1C, 0x7D, 0x8F, 0x6A, 0x5A, 0xAC, 0x84, 0xAA, 0x05,
+	0x1B, 0xA3, 0x0B, 0x39, 0x6A, 0x0A, 0xAC, 0x97, 0x3D, 0x58, 0xE0, 0x91,
+	0x5B, 0xC9, 0x4F, 0xBC, 0x32, 0x21, 0xA5, 0xDB, 0x94, 0xFA, 0xE9, 0x5A,
+	0xE7, 0x12, 0x1A, 0x47
+};
+
+static uint8_t gcm_out256[] = {
+	0x52, 0x2D, 0xC1, 0xF0, 0x99, 0x56, 0x7D, 0x07, 0xF4, 0x7F, 0x37, 0xA3,
+	0x2A, 0x84, 0x42, 0x7D, 0x64, 0x3A, 0x8C, 0xDC, 0xBF, 0xE5, 0xC0, 0xC9,
+	0x75, 0x98, 0xA2, 0xBD, 0x25, 0x55, 0xD1, 0xAA, 0x8C, 0xB0, 0x8E, 0x48,
+	0x59, 0x0D, 0xBB, 0x3D, 0xA7, 0xB0, 0x8B, 0x10, 0x56, 0x82, 0x88, 0x38,
+	0xC5, 0xF6, 0x1E, 0x63, 0x93, 0xBA, 0x7A, 0x0A, 0xBC, 0xC9, 0xF6, 0x62,
+	0x76, 0xFC, 0x6E, 0xCE, 0x0F, 0x4E, 0x17, 0x68, 0xCD, 0xDF, 0x88, 0x53,
+	0xBB, 0x2D, 0x55, 0x1B
+};
+
+static int aes(void) {
+	int code = RLC_ERR;
+	int i, ni, len, out_len, tmp_len;
+	uint8_t key[32], iv[RLC_BC_LEN], in[1000], out[1000 + RLC_BC_TAG];
+	uint8_t tmp[1000 + RLC_BC_TAG];
+	aes_t k;
+
+	TEST_CASE("aes cbc encryption/decryption is correct") {
+		rand_bytes(key, sizeof(key));
+		rand_bytes(iv, sizeof(iv));
+		len = 100;
+		rand_bytes(in, len);
+		out_len = sizeof(out);
+		TEST_ASSERT(bc_aes_cbc_enc(out, &out_len, in, len, key, 16, iv)
+				== RLC_OK, end);
+		tmp_len = sizeof(tmp);
+		TEST_ASSERT(bc_aes_cbc_dec(tmp, &tmp_len, out, out_len, key, 16, iv)
+				== RLC_OK, end);
+		TEST_ASSERT(tmp_len == len && memcmp(in, tmp, len) == 0, end);
+	}
+	TEST_END;
+
+	TEST_ONCE("aes ctr mode satisfies test vectors") {
+		TEST_ASSERT(bc_aes_key(k, ctr_key, sizeof(ctr_key)) == RLC_OK, end);
+		/* Check every backend available in this processor. */
+		for (ni = k->ni; ni >= 0; ni--) {
+			k->ni = ni;
+			out_len = sizeof(out);
+			TEST_ASSERT(bc_aes_ctr_enc(out, &out_len, ctr_in, sizeof(ctr_in),
+					k, ctr_iv) == RLC_OK, end);
+			TEST_ASSERT(out_len == sizeof(ctr_out), end);
+			TEST_ASSERT(memcmp(out, ctr_out, sizeof(ctr_out)) == 0, end);
+			TEST_ASSERT(bc_aes_ctr_dec(out, &out_len, out, out_len, k,
+					ctr_iv) == RLC_OK, end);
+			TEST_ASSERT(memcmp(out, ctr_in, sizeof(ctr_in)) == 0, end);
+		}
+	}
+	TEST_END;
+
+	TEST_ONCE("aes gcm mode satisfies test vectors") {
+		for (i = 16; i <= 32; i += 16) {
+			TEST_ASSERT(bc_aes_key(k, gcm_key, i) == RLC_OK, end);
+			for (ni = k->ni; ni >= 0; ni--) {
+				k->ni = ni;
+				out_len = sizeof(out);
+				TEST_ASSERT(bc_aes_gcm_enc(out, &out_len, gcm_in,
+						sizeof(gcm_in), gcm_ad, sizeof(gcm_ad), k, gcm_iv)
+						== RLC_OK, end);
+				TEST_ASSERT(out_len == sizeof(gcm_out128), end);
+				TEST_ASSERT(memcmp(out, i == 16 ? gcm_out128 : gcm_out256,
+						out_len) == 0, end);
+				len = sizeof(tmp);
+				TEST_ASSERT(bc_aes_gcm_dec(tmp, &len, out, out_len, gcm_ad,
+						sizeof(gcm_ad), k, gcm_iv) == RLC_OK, end);
+				TEST_ASSERT(len == sizeof(gcm_in), end);
+				TEST_ASSERT(memcmp(tmp, gcm_in, len) == 0, end);
+			}
+		}
+	}
+	TEST_END;
+
+	TEST_CASE("aes gcm encryption/decryption is correct") {
+		rand_bytes(key, sizeof(key));
+		rand_bytes(iv, sizeof(iv));
+		rand_bytes(in, sizeof(in));
+		/* Cover full groups of blocks and a partial last block. */
+		len = sizeof(in) - 7;
+		TEST_ASSERT(bc_aes_key(k, key, 24) == RLC_OK, end);
+		out_len = sizeof(out);
+		TEST_ASSERT(bc_aes_gcm_enc(out, &out_len, in, len, iv, 8, k, iv)
+				== RLC_OK, end);
+		/* All backends must agree on long messages. */
+		for (ni = k->ni - 1; ni >= 0; ni--) {
+			k->ni = ni;
+			tmp_len = sizeof(tmp);
+			TEST_ASSERT(bc_aes_gcm_enc(tmp, &tmp_len, in, len, iv, 8, k, iv)
+					== RLC_OK, end);
+			TEST_ASSERT(tmp_len == out_len, end);
+			TEST_ASSERT(memcmp(out, tmp, tmp_len) == 0, end);
+		}
+		TEST_ASSERT(bc_aes_gcm_dec(out, &out_len, out, out_len, iv, 8, k, iv)
+				== RLC_OK, end);
+		TEST_ASSERT(out_len == len && memcmp(out, in, len) == 0, end);
+		out_len = sizeof(out);
+		TEST_ASSERT(bc_aes_gcm_enc(out, &out_len, in, len, iv, 8, k, iv)
+				== RLC_OK, end);
+		out[len / 2] ^= 1;
+		tmp_len = sizeof(tmp);
+		TEST_ASSERT(bc_aes_gcm_dec(tmp, &tmp_len, out, out_len, iv, 8, k, iv)
+				== RLC_ERR, end);
+		out[len / 2] ^= 1;
+		TEST_ASSERT(bc_aes_gcm_dec(tmp, &tmp_len, out, out_len, iv, 7, k, iv)
+				== RLC_ERR, end);
+		out_len = len;
+		TEST_ASSERT(bc_aes_gcm_enc(out, &out_len, in, len, NULL, 0, k, iv)
+				== RLC_ERR, end);
+	}
+	TEST_END;
+
+	code = RLC_OK;
+
+  end:
+	return code;
+}
+
+int main(void) {
+	if (core_init() != RLC_OK) {
+		core_clean();
+		return 1;
+	}
+
+	util_banner("Tests for the BC module:\n", 0);
+
+	if (aes() != RLC_OK) {
+		core_clean();
+		return 1;
+	}
+
+	util_banner("All tests have passed.\n", 0);
+
+	core_clean();
+	return 0;
+}
@@ -67,16 +67,22 @@ static int util(void) {
 	char str[RLC_BN_BITS + 2];
 	dig_t digit, raw[RLC_BN_DIGS];
 	uint8_t bin[RLC_CEIL(RLC_BN_BITS, 8)];
-	bn_t a, b, c;
+	bn_t a, b, c, t[RLC_TERMS];
 
 	bn_null(a);
 	bn_null(b);
 	bn_null(c);
+	for (int i = 0; i < RLC_TERMS; i++) {
+		bn_null(t[i]);
+	}
 
 	RLC_TRY {
 		bn_new(a);
 		bn_new(b);
 		bn_new(c);
+		for (int i = 0; i < RLC_TERMS; i++) {
+			bn_new(t[i]);
+		}
 
 		TEST_CASE("comparison is consistent") {
 			bn_rand(a, RLC_POS, RLC_BN_BITS);
@@ -197,6 +203,34 @@ static int util(void) {
 		}
 		TEST_END;
 
+		TEST_CASE("generating random integers simultaneously is consistent") {
+			bn_rand_sim(t, RLC_TERMS, RLC_DIG + 1);
+			for (int i = 0; i < RLC_TERMS; i++) {
+				TEST_ASSERT(bn_sign(t[i]) == RLC_POS, end);
+				TEST_ASSERT(bn_bits(t[i]) <= RLC_DIG + 1, end);
+			}
+			TEST_ASSERT(bn_cmp(t[0], t[1]) != RLC_EQ, end);
+			do {
+				bn_rand(b, RLC_POS, RLC_BN_BITS);
+			} while (bn_is_zero(b));
+			bn_rand_mod_sim(t, RLC_TERMS, b);
+			for (int i = 0; i < RLC_TERMS; i++) {
+				TEST_ASSERT(bn_sign(t[i]) == bn_sign(b), end);
+				TEST_ASSERT(bn_is_zero(t[i]) == 0, end);
+				TEST_ASSERT(bn_cmp(t[i], b) == RLC_LT, end);
+			}
+			do {
+				bn_rand(b, RLC_NEG, RLC_DIG);
+			} while (bn_bits(b) <= 1);
+			bn_rand_mod_sim(t, RLC_TERMS, b);
+			for (int i = 0; i < RLC_TERMS; i++) {
+				TEST_ASSERT(bn_sign(t[i]) == bn_sign(b), end);
+				TEST_ASSERT(bn_is_zero(t[i]) == 0, end);
+				TEST_ASSERT(bn_cmp(t[i], b) == RLC_GT, end);
+			}
+		}
+		TEST_END;
+
 		TEST_CASE("reading and writing the first digit are consistent") {
 			bn_rand(a, RLC_POS, RLC_DIG);
 			bn_rand(b, RLC_POS, RLC_DIG);
@@ -299,6 +333,9 @@ static int util(void) {
 	bn_free(a);
 	bn_free(b);
 	bn_free(c);
+	for (int i = 0; i < RLC_TERMS; i++) {
+		bn_free(t[i]);
+	}
 	return code;
 }
 
@@ -1877,6 +1914,121 @@ static int inversion(void) {
 	return code;
 }
 
+static int polynomial(void) {
+	int i, j, n, code = RLC_ERR;
+	bn_t a, b, c[601], d[601], x[600], y[600];
+
+	bn_null(a);
+	bn_null(b);
+
+	RLC_TRY {
+		bn_new(a);
+		bn_new(b);
+		for (i = 0; i < 600; i++) {
+			bn_null(c[i]);
+			bn_null(d[i]);
+			bn_null(x[i]);
+			bn_null(y[i]);
+			bn_new(c[i]);
+			bn_new(d[i]);
+			bn_new(x[i]);
+			bn_new(y[i]);
+		}
+		bn_null(c[600]);
+		bn_null(d[600]);
+		bn_new(c[600]);
+		bn_new(d[600]);
+
+		bn_gen_prime(a, RLC_DIG);
+
+		TEST_CASE("polynomial from roots is correct") {
+			for (n = 1; n <= 40; n += 13) {
+				for (j = 0; j < n; j++) {
+					bn_rand_mod(x[j], a);
+				}
+				bn_lag(c, x, a, n);
+				TEST_ASSERT(bn_cmp_dig(c[n], 1) == RLC_EQ, end);
+				for (j = 0; j < n; j++) {
+					bn_evl(b, c, x[j], a, n + 1);
+					TEST_ASSERT(bn_is_zero(b), end);
+				}
+			}
+		} TEST_END;
+
+		TEST_CASE("multipoint polynomial evaluation is correct") {
+			for (n = 1; n <= 40; n += 13) {
+				for (j = 0; j < n; j++) {
+					bn_rand_mod(c[j], a);
+				}
+				for (j = 0; j < 3 * n; j++) {
+					bn_rand_mod(x[j], a);
+				}
+				bn_evl_sim(y, c, x, a, n, 3 * n);
+				for (j = 0; j < 3 * n; j++) {
+					bn_evl(b, c, x[j], a, n);
+					TEST_ASSERT(bn_cmp(b, y[j]) == RLC_EQ, end);
+				}
+			}
+		} TEST_END;
+
+		TEST_CASE("polynomial interpolation is correct") {
+			for (n = 1; n <= 40; n += 13) {
+				for (j = 0; j < n; j++) {
+					bn_rand_mod(c[j], a);
+					bn_rand_mod(x[j], a);
+				}
+				bn_evl_sim(y, c, x, a, n, n);
+				bn_itp(d, x, y, a, n);
+				for (j = 0; j < n; j++) {
+					TEST_ASSERT(bn_cmp(c[j], d[j]) == RLC_EQ, end);
+				}
+			}
+		} TEST_END;
+
+		/* Find a prime with large two-adicity to exercise the NTT. */
+		do {
+			bn_rand(a, RLC_POS, 64);
+			bn_lsh(a, a, 32);
+			bn_add_dig(a, a, 1);
+		} while (!bn_is_prime(a));
+
+		TEST_CASE("polynomial arithmetic with the ntt is correct") {
+			n = 600;
+			for (j = 0; j < n; j++) {
+				bn_rand_mod(c[j], a);
+				bn_rand_mod(x[j], a);
+			}
+			bn_lag(d, x, a, n);
+			TEST_ASSERT(bn_cmp_dig(d[n], 1) == RLC_EQ, end);
+			bn_evl(b, d, x[n / 2], a, n + 1);
+			TEST_ASSERT(bn_is_zero(b), end);
+			bn_evl_sim(y, c, x, a, n, n);
+			bn_evl(b, c, x[n - 1], a, n);
+			TEST_ASSERT(bn_cmp(b, y[n - 1]) == RLC_EQ, end);
+			bn_itp(d, x, y, a, n);
+			for (j = 0; j < n; j++) {
+				TEST_ASSERT(bn_cmp(c[j], d[j]) == RLC_EQ, end);
+			}
+		} TEST_END;
+	}
+	RLC_CATCH_ANY {
+		RLC_ERROR(end);
+	}
+	code = RLC_OK;
+  end:
+	bn_free(a);
+	bn_free(b);
+	for (i = 0; i <= 600; i++) {
+		bn_free(c[i]);
+		bn_free(d[i]);
+	}
+	for (i = 0; i < 600; i++) {
+		bn_free(x[i]);
+		bn_free(y[i]);
+	}
+	return code;
+}
+
 static int factor(void) {
 	int code = RLC_ERR;
 	bn_t p, q, n;
@@ -2337,6 +2489,11 @@ int main(void) {
 		return 1;
 	}
 
+	if (polynomial() != RLC_OK) {
+		core_clean();
+		return 1;
+	}
+
 	if (factor() != RLC_OK) {
 		core_clean();
 		return 1;
@@ -100,6 +100,67 @@ int main(void) {
 		core_set(old_ctx);
 	} TEST_END;
 
+#if ALLOC == AUTO
+	TEST_ONCE("library parameters are shared between contexts") {
+		ctx_t new_ctx, *old_ctx;
+		params_t *par = core_par_get();
+		old_ctx = core_get();
+		core_set(&new_ctx);
+		core_init();
+		TEST_ASSERT(core_par_get() == par, end);
+		TEST_ASSERT(par->refs == 2, end);
+		core_clean();
+		core_set(old_ctx);
+		TEST_ASSERT(core_par_get() == par && par->refs == 1, end);
+	} TEST_END;
+
+#if defined(WITH_EP) && defined(EP_ENDOM)
+	TEST_ONCE("contexts sharing parameters can choose different curves") {
+		ctx_t new_ctx, *old_ctx;
+		params_t *par;
+		ep_t g, h;
+		int x, y;
+
+		ep_null(g);
+		ep_null(h);
+		ep_new(g);
+		ep_new(h);
+
+		ep_param_set_any();
+		x = ep_param_get();
+		ep_curve_get_gen(g);
+		par = core_par_get();
+		old_ctx = core_get();
+		core_set(&new_ctx);
+		core_init();
+		TEST_ASSERT(core_par_get() == par && ep_param_get() == x, end);
+		/* Changing the curve gives this context its own parameters. */
+		if (ep_param_set_any_endom() != RLC_OK || ep_param_get() == x) {
+			ep_param_set_any_pairf();
+		}
+		y = ep_param_get();
+		TEST_ASSERT(core_par_get() != par && par->refs == 1, end);
+		ep_curve_get_gen(h);
+		TEST_ASSERT(ep_on_curve(h), end);
+		core_set(old_ctx);
+		TEST_ASSERT(core_par_get() == par && ep_param_get() == x, end);
+		ep_curve_get_gen(h);
+		TEST_ASSERT(ep_cmp(g, h) == RLC_EQ && ep_on_curve(g), end);
+		/* The original context no longer shares and changes them in place. */
+		ep_param_set(y);
+		TEST_ASSERT(core_par_get() == par && ep_param_get() == y, end);
+		core_set(&new_ctx);
+		TEST_ASSERT(core_par_get() != par && ep_param_get() == y, end);
+		core_clean();
+		core_set(old_ctx);
+		TEST_ASSERT(par->refs == 1, end);
+
+		ep_free(g);
+		ep_free(h);
+	} TEST_END;
+#endif
+#endif
+
 	code = RLC_OK;
 
 #if defined(MULTI)
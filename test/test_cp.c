@@ -368,7 +368,7 @@ static int subgroup_paillier() {
 
 #if defined(WITH_EC)
 
-/* Test vectors generated by BouncyCastle. */
+/* Key pairs generated by BouncyCastle. */
 
 #if defined(EP_PLAIN) && FP_PRIME == 256
 
@@ -379,11 +379,10 @@ static int subgroup_paillier() {
 #define NIST_P256_B_X	"B8F245FC8A1C7E933D5CAD6E77102C72B0C1F393F779F3F504DA1CA776434B10"
 #define NIST_P256_B_Y	"5373FA01BC13FF5843D4A31E40833785C598C0BBC2F6AF7317C327BE09883799"
 
+/* Ciphertext computed with OpenSSL AES-128-GCM under the same derived key. */
 uint8_t result[] = {
-	0xC0, 0xEC, 0x2B, 0xAC, 0xEB, 0x3C, 0x6E, 0xE3, 0x21, 0x96, 0xD5, 0x43,
-	0x0E, 0xE6, 0xDA, 0xBB, 0x50, 0xAE, 0xEE, 0xBE, 0xBA, 0xCE, 0x6B, 0x86,
-	0x09, 0xD7, 0xEB, 0x07, 0xD6, 0x45, 0xF6, 0x34, 0xD4, 0xE0, 0xD1, 0x9A,
-	0xAB, 0xA0, 0xD2, 0x90, 0x2F, 0x4A, 0xDC, 0x20, 0x1B, 0x0F, 0x35, 0x8D
+	0x39, 0xF9, 0xEB, 0xC5, 0x78, 0x3F, 0xD1, 0x24, 0x20, 0x27, 0x55, 0x6F,
+	0x7D, 0x48, 0x58, 0x7D, 0x93, 0x96, 0x7D, 0x10, 0x0C, 0xF2, 0xF1, 0x62
 };
 
 #endif
@@ -521,10 +520,17 @@ static int ecies(void) {
 	ec_t r;
 	bn_t da, d_b;
 	ec_t qa, q_b;
-	int l, in_len, out_len;
-	uint8_t in[RLC_BC_LEN - 1], out[RLC_BC_LEN + RLC_MD_LEN];
+	int i, in_len, out_len;
+	uint8_t in[RLC_BC_LEN - 1], out[RLC_BC_LEN + RLC_BC_TAG];
+	size_t len = 2 * RLC_CP_CHUNK + 100, ct_len, pt_len, l;
+	size_t part[] = { 0, 1000, 1000 + RLC_CP_CHUNK, len };
+	uint8_t *pt = malloc(len), *ct = malloc(len + 3 * RLC_BC_TAG);
+	uint8_t *dec = malloc(len);
+	strm_iov_t iov[3];
+	strm_t s;
 
 	ec_null(r);
+	strm_null(s);
 	bn_null(da);
 	bn_null(d_b);
 	ec_null(qa);
@@ -536,24 +542,88 @@ static int ecies(void) {
 		bn_new(d_b);
 		ec_new(qa);
 		ec_new(q_b);
+		strm_new(s);
+		if (pt == NULL || ct == NULL || dec == NULL) {
+			RLC_THROW(ERR_NO_MEMORY);
+		}
 
-		l = ec_param_level();
-		if (l == 80 || l == 128 || l == 192 || l == 256) {
+		i = ec_param_level();
+		if (i == 80 || i == 128 || i == 192 || i == 256) {
 			TEST_CASE("ecies encryption/decryption is correct") {
 				TEST_ASSERT(cp_ecies_gen(da, qa) == RLC_OK, end);
 				in_len = RLC_BC_LEN - 1;
-				out_len = RLC_BC_LEN + RLC_MD_LEN;
+				out_len = RLC_BC_LEN + RLC_BC_TAG;
 				rand_bytes(in, in_len);
 				TEST_ASSERT(cp_ecies_enc(r, out, &out_len, in, in_len, qa)
 						== RLC_OK, end);
 				TEST_ASSERT(cp_ecies_dec(out, &out_len, r, out, out_len, da)
 						== RLC_OK, end);
 				TEST_ASSERT(memcmp(in, out, out_len) == 0, end);
+				out_len = RLC_BC_LEN + RLC_BC_TAG;
+				TEST_ASSERT(cp_ecies_enc(r, out, &out_len, in, in_len, qa)
+						== RLC_OK, end);
+				out[0] ^= 1;
+				TEST_ASSERT(cp_ecies_dec(out, &out_len, r, out, out_len, da)
+						== RLC_ERR, end);
+			}
+			TEST_END;
+
+			TEST_CASE("ecies streaming encryption/decryption is correct") {
+				TEST_ASSERT(cp_ecies_gen(da, qa) == RLC_OK, end);
+				for (l = 0; l < len; l += RLC_CP_CHUNK) {
+					rand_bytes(pt + l, RLC_MIN(RLC_CP_CHUNK, len - l));
+				}
+				TEST_ASSERT(cp_ecies_enc_init(r, s, qa) == RLC_OK, end);
+				/* Feed the input in uneven parts. */
+				ct_len = 0;
+				for (int j = 0; j < 3; j++) {
+					l = len + 3 * RLC_BC_TAG - ct_len;
+					pt_len = cp_strm_size(s, part[j + 1] - part[j]);
+					TEST_ASSERT(cp_strm_update(ct + ct_len, &l, pt + part[j],
+							part[j + 1] - part[j], s) == RLC_OK, end);
+					TEST_ASSERT(l == pt_len, end);
+					ct_len += l;
+				}
+				/* A short buffer leaves the stream open for a retry. */
+				l = 0;
+				TEST_ASSERT(cp_strm_final(ct + ct_len, &l, s) == RLC_ERR, end);
+				TEST_ASSERT(l == len + 3 * RLC_BC_TAG - ct_len, end);
+				TEST_ASSERT(cp_strm_final(ct + ct_len, &l, s) == RLC_OK, end);
+				ct_len += l;
+				TEST_ASSERT(ct_len == len + 3 * RLC_BC_TAG, end);
+				/* Decrypt into a list of buffers not aligned to chunks. */
+				TEST_ASSERT(cp_ecies_dec_init(s, r, da) == RLC_OK, end);
+				iov[0].buf = dec;
+				iov[0].len = 1000;
+				iov[1].buf = dec + 1000;
+				iov[1].len = RLC_CP_CHUNK;
+				iov[2].buf = dec + 1000 + RLC_CP_CHUNK;
+				iov[2].len = len - 1000 - RLC_CP_CHUNK;
+				TEST_ASSERT(cp_strm_updatev(iov, 3, &pt_len, ct, ct_len, s)
+						== RLC_OK, end);
+				TEST_ASSERT(pt_len == 2 * RLC_CP_CHUNK, end);
+				l = len - pt_len;
+				TEST_ASSERT(cp_strm_final(dec + pt_len, &l, s) == RLC_OK, end);
+				TEST_ASSERT(pt_len + l == len, end);
+				TEST_ASSERT(memcmp(pt, dec, len) == 0, end);
+				/* Dropping the last chunk must be detected. */
+				TEST_ASSERT(cp_ecies_dec_init(s, r, da) == RLC_OK, end);
+				l = len;
+				TEST_ASSERT(cp_strm_update(dec, &l, ct, ct_len - 100 -
+						RLC_BC_TAG, s) == RLC_OK, end);
+				l = len;
+				TEST_ASSERT(cp_strm_final(dec, &l, s) == RLC_ERR, end);
+				/* So must any modified byte. */
+				ct[RLC_CP_CHUNK / 2] ^= 1;
+				TEST_ASSERT(cp_ecies_dec_init(s, r, da) == RLC_OK, end);
+				l = len;
+				TEST_ASSERT(cp_strm_update(dec, &l, ct, ct_len, s) == RLC_ERR,
+						end);
 			}
 			TEST_END;
 		}
 #if MD_MAP == SH256
-		uint8_t msg[RLC_BC_LEN + RLC_MD_LEN];
+		uint8_t msg[8 + RLC_BC_TAG];
 		char str[2 * RLC_FC_BYTES + 1];
 
 		switch (ec_param_get()) {
@@ -599,6 +669,10 @@ static int ecies(void) {
 	code = RLC_OK;
 
   end:
+	strm_free(s);
+	free(pt);
+	free(ct);
+	free(dec);
 	ec_free(r);
 	bn_free(da);
 	bn_free(d_b);
@@ -609,20 +683,34 @@ static int ecies(void) {
 
 static int ecdsa(void) {
 	int code = RLC_ERR;
-	bn_t d, r, s;
-	ec_t q;
-	uint8_t m[5] = { 0, 1, 2, 3, 4 }, h[RLC_MD_LEN];
+	bn_t d, r, s, rs[4], ss[4];
+	ec_t q, qs[4];
+	ecdsa_pre_t pre[4];
+	uint8_t m[5] = { 0, 1, 2, 3, 4 }, h[RLC_MD_LEN], *ms[4];
+	int ls[4], vs[4];
 
 	bn_null(d);
 	bn_null(r);
 	bn_null(s);
 	ec_null(q);
+	for (int i = 0; i < 4; i++) {
+		bn_null(rs[i]);
+		bn_null(ss[i]);
+		ec_null(qs[i]);
+		ecdsa_pre_null(pre[i]);
+	}
 
 	RLC_TRY {
 		bn_new(d);
 		bn_new(r);
 		bn_new(s);
 		ec_new(q);
+		for (int i = 0; i < 4; i++) {
+			bn_new(rs[i]);
+			bn_new(ss[i]);
+			ec_new(qs[i]);
+			ecdsa_pre_new(pre[i]);
+		}
 
 		TEST_CASE("ecdsa signature is correct") {
 			TEST_ASSERT(cp_ecdsa_gen(d, q) == RLC_OK, end);
@@ -639,6 +727,47 @@ static int ecdsa(void) {
 			TEST_ASSERT(cp_ecdsa_ver(r, s, h, RLC_MD_LEN, 1, q) == 0, end);
 		}
 		TEST_END;
+
+		TEST_CASE("ecdsa batch verification is correct") {
+			for (int i = 0; i < 4; i++) {
+				ms[i] = m;
+				ls[i] = sizeof(m) - i;
+				TEST_ASSERT(cp_ecdsa_gen(d, qs[i]) == RLC_OK, end);
+				TEST_ASSERT(cp_ecdsa_sig_ext(rs[i], ss[i], &vs[i], ms[i], ls[i],
+						0, d) == RLC_OK, end);
+				TEST_ASSERT(cp_ecdsa_ver(rs[i], ss[i], ms[i], ls[i], 0,
+						qs[i]) == 1, end);
+			}
+			TEST_ASSERT(cp_ecdsa_ver_batch(rs, ss, vs, ms, ls, 0, qs, 4) == 1,
+					end);
+			/* Hints are only used on curves with a trivial cofactor. */
+			ec_curve_get_cof(r);
+			if (vs[0] >= 0 && bn_cmp_dig(r, 1) == RLC_EQ) {
+				vs[0] ^= 1;
+				TEST_ASSERT(cp_ecdsa_ver_batch(rs, ss, vs, ms, ls, 0, qs, 4)
+						== 0, end);
+				vs[0] ^= 1;
+			}
+			ls[3]++;
+			TEST_ASSERT(cp_ecdsa_ver_batch(rs, ss, vs, ms, ls, 0, qs, 4) == 0,
+					end);
+		}
+		TEST_END;
+
+		TEST_CASE("ecdsa signature with precomputed nonces is correct") {
+			TEST_ASSERT(cp_ecdsa_gen(d, q) == RLC_OK, end);
+			TEST_ASSERT(cp_ecdsa_pre(pre, 4) == RLC_OK, end);
+			for (int i = 0; i < 4; i++) {
+				TEST_ASSERT(cp_ecdsa_sig_fast(r, s, m, sizeof(m) - i, 0, d,
+						pre[i]) == RLC_OK, end);
+				TEST_ASSERT(cp_ecdsa_ver(r, s, m, sizeof(m) - i, 0, q) == 1,
+						end);
+				/* A nonce cannot be used twice. */
+				TEST_ASSERT(cp_ecdsa_sig_fast(r, s, m, sizeof(m), 0, d,
+						pre[i]) == RLC_ERR, end);
+			}
+		}
+		TEST_END;
 	}
 	RLC_CATCH_ANY {
 		RLC_ERROR(end);
@@ -650,23 +779,40 @@ static int ecdsa(void) {
 	bn_free(r);
 	bn_free(s);
 	ec_free(q);
+	for (int i = 0; i < 4; i++) {
+		bn_free(rs[i]);
+		bn_free(ss[i]);
+		ec_free(qs[i]);
+		ecdsa_pre_free(pre[i]);
+	}
 	return code;
 }
 
 static int ecss(void) {
 	int code = RLC_ERR;
-	bn_t d, r;
-	ec_t q;
-	uint8_t m[5] = { 0, 1, 2, 3, 4 };
+	bn_t d, r, ss[4];
+	ec_t q, qs[4], rs[4];
+	uint8_t m[5] = { 0, 1, 2, 3, 4 }, *ms[4];
+	int ls[4];
 
 	bn_null(d);
 	bn_null(r);
 	ec_null(q);
+	for (int i = 0; i < 4; i++) {
+		bn_null(ss[i]);
+		ec_null(qs[i]);
+		ec_null(rs[i]);
+	}
 
 	RLC_TRY {
 		bn_new(d);
 		bn_new(r);
 		ec_new(q);
+		for (int i = 0; i < 4; i++) {
+			bn_new(ss[i]);
+			ec_new(qs[i]);
+			ec_new(rs[i]);
+		}
 
 		TEST_CASE("ecss signature is correct") {
 			TEST_ASSERT(cp_ecss_gen(d, q) == RLC_OK, end);
@@ -674,6 +820,34 @@ static int ecss(void) {
 			TEST_ASSERT(cp_ecss_ver(r, d, m, sizeof(m), q) == 1, end);
 		}
 		TEST_END;
+
+		TEST_CASE("ecss signature with commitment is correct") {
+			TEST_ASSERT(cp_ecss_gen(d, q) == RLC_OK, end);
+			TEST_ASSERT(cp_ecss_sig_ext(rs[0], r, m, sizeof(m), d, q) == RLC_OK,
+					end);
+			TEST_ASSERT(cp_ecss_ver_ext(rs[0], r, m, sizeof(m), q) == 1, end);
+			m[0] ^= 1;
+			TEST_ASSERT(cp_ecss_ver_ext(rs[0], r, m, sizeof(m), q) == 0, end);
+			m[0] ^= 1;
+		}
+		TEST_END;
+
+		TEST_CASE("ecss batch verification is correct") {
+			for (int i = 0; i < 4; i++) {
+				ms[i] = m;
+				ls[i] = sizeof(m) - i;
+				TEST_ASSERT(cp_ecss_gen(d, qs[i]) == RLC_OK, end);
+				TEST_ASSERT(cp_ecss_sig_ext(rs[i], ss[i], ms[i], ls[i], d,
+						qs[i]) == RLC_OK, end);
+			}
+			TEST_ASSERT(cp_ecss_ver_batch(rs, ss, ms, ls, qs, 4) == 1, end);
+			ls[3]++;
+			TEST_ASSERT(cp_ecss_ver_batch(rs, ss, ms, ls, qs, 4) == 0, end);
+			ls[3]--;
+			ec_dbl(rs[1], rs[1]);
+			TEST_ASSERT(cp_ecss_ver_batch(rs, ss, ms, ls, qs, 4) == 0, end);
+		}
+		TEST_END;
 	}
 	RLC_CATCH_ANY {
 		RLC_ERROR(end);
@@ -684,6 +858,11 @@ static int ecss(void) {
 	bn_free(d);
 	bn_free(r);
 	ec_free(q);
+	for (int i = 0; i < 4; i++) {
+		bn_free(ss[i]);
+		ec_free(qs[i]);
+		ec_free(rs[i]);
+	}
 	return code;
 }
 
@@ -811,16 +990,32 @@ end:
 
 static int sok(void) {
 	int code = RLC_ERR;
-	bn_t c[2], n, r[2], x;
-	ec_t g[2], y[2];
+	bn_t c[2], n, r[2], x, cs[4][2], rs[4][2], *pc[4], *pr[4];
+	ec_t g[2], y[2], ys[8];
 	uint8_t m[5] = { 0, 1, 2, 3, 4 };
 
 	bn_null(n);
 	bn_null(x);
+	for (int i = 0; i < 4; i++) {
+		bn_null(cs[i][0]);
+		bn_null(cs[i][1]);
+		bn_null(rs[i][0]);
+		bn_null(rs[i][1]);
+		ec_null(ys[2 * i]);
+		ec_null(ys[2 * i + 1]);
+	}
 
 	RLC_TRY {
 		bn_new(n);
 		bn_new(x);
+		for (int i = 0; i < 4; i++) {
+			bn_new(cs[i][0]);
+			bn_new(cs[i][1]);
+			bn_new(rs[i][0]);
+			bn_new(rs[i][1]);
+			ec_new(ys[2 * i]);
+			ec_new(ys[2 * i + 1]);
+		}
 		for (int i = 0; i < 2; i++) {
 			bn_null(c[i]);
 			bn_null(r[i]);
@@ -886,6 +1081,34 @@ static int sok(void) {
 			ec_norm(y[0], y[0]);
 			TEST_ASSERT(cp_sokor_ver(c, r,  m, 5, y, g) == 0, end);
 		} TEST_END;
+
+		TEST_CASE("simultaneous verification of disjunctions is correct") {
+			for (int k = 0; k < 2; k++) {
+				ec_curve_get_gen(g[0]);
+				ec_rand(g[1]);
+				for (int i = 0; i < 4; i++) {
+					int j = i & 1;
+					bn_rand_mod(x, n);
+					ec_rand(ys[2 * i + 1 - j]);
+					ec_mul(ys[2 * i + j], g[j], x);
+					if (k == 0) {
+						ec_mul_gen(ys[2 * i + j], x);
+					}
+					TEST_ASSERT(cp_sokor_sig(cs[i], rs[i], m, 5, ys + 2 * i,
+						k ? g : NULL, x, 1 - j) == RLC_OK, end);
+					pc[i] = cs[i];
+					pr[i] = rs[i];
+				}
+				TEST_ASSERT(cp_sokor_ver_sim(pc, pr, m, 5, ys, k ? g : NULL, 4)
+					== 1, end);
+				TEST_ASSERT(cp_sokor_ver_sim(pc, pr, m, 4, ys, k ? g : NULL, 4)
+					== 0, end);
+				ec_dbl(ys[5], ys[5]);
+				ec_norm(ys[5], ys[5]);
+				TEST_ASSERT(cp_sokor_ver_sim(pc, pr, m, 5, ys, k ? g : NULL, 4)
+					== 0, end);
+			}
+		} TEST_END;
 	}
 	RLC_CATCH_ANY {
 		RLC_ERROR(end);
@@ -901,6 +1124,14 @@ end:
 		ec_free(g[i]);
 		ec_free(y[i]);
 	}
+	for (int i = 0; i < 4; i++) {
+		bn_free(cs[i][0]);
+		bn_free(cs[i][1]);
+		bn_free(rs[i][0]);
+		bn_free(rs[i][1]);
+		ec_free(ys[2 * i]);
+		ec_free(ys[2 * i + 1]);
+	}
 	return code;
 }
 
@@ -1085,6 +1316,117 @@ end:
 
 #endif /* WITH_EC */
 
+#if defined(WITH_ED)
+
+static int eddsa(void) {
+	int code = RLC_ERR;
+	bn_t s[4];
+	ed_t r[4], q[4];
+	uint8_t sk[RLC_FP_BYTES], *ms[4];
+	uint8_t m[5] = { 0, 1, 2, 3, 4 };
+	int ls[4];
+
+	for (int i = 0; i < 4; i++) {
+		bn_null(s[i]);
+		ed_null(r[i]);
+		ed_null(q[i]);
+	}
+
+	RLC_TRY {
+		for (int i = 0; i < 4; i++) {
+			bn_new(s[i]);
+			ed_new(r[i]);
+			ed_new(q[i]);
+		}
+
+		TEST_CASE("eddsa signature is correct") {
+			TEST_ASSERT(cp_eddsa_gen(sk, q[0]) == RLC_OK, end);
+			TEST_ASSERT(cp_eddsa_sig(r[0], s[0], m, sizeof(m), sk,
+					q[0]) == RLC_OK, end);
+			TEST_ASSERT(cp_eddsa_ver(r[0], s[0], m, sizeof(m), q[0]) == 1, end);
+			m[0] ^= 1;
+			TEST_ASSERT(cp_eddsa_ver(r[0], s[0], m, sizeof(m), q[0]) == 0, end);
+			m[0] ^= 1;
+			bn_add_dig(s[0], s[0], 1);
+			TEST_ASSERT(cp_eddsa_ver(r[0], s[0], m, sizeof(m), q[0]) == 0, end);
+		}
+		TEST_END;
+
+#if FP_PRIME == 255
+		if (ed_param_get() == CURVE_ED25519) {
+			/* Test vector TEST 1 from RFC 8032, Section 7.1. */
+			TEST_ONCE("eddsa satisfies test vectors") {
+				uint8_t key[] = {
+					0x9D, 0x61, 0xB1, 0x9D, 0xEF, 0xFD, 0x5A, 0x60, 0xBA, 0x84,
+					0x4A, 0xF4, 0x92, 0xEC, 0x2C, 0xC4, 0x44, 0x49, 0xC5, 0x69,
+					0x7B, 0x32, 0x69, 0x19, 0x70, 0x3B, 0xAC, 0x03, 0x1C, 0xAE,
+					0x7F, 0x60
+				};
+				uint8_t pub[] = {
+					0xD7, 0x5A, 0x98, 0x01, 0x82, 0xB1, 0x0A, 0xB7, 0xD5, 0x4B,
+					0xFE, 0xD3, 0xC9, 0x64, 0x07, 0x3A, 0x0E, 0xE1, 0x72, 0xF3,
+					0xDA, 0xA6, 0x23, 0x25, 0xAF, 0x02, 0x1A, 0x68, 0xF7, 0x07,
+					0x51, 0x1A
+				};
+				uint8_t sig[] = {
+					0xE5, 0x56, 0x43, 0x00, 0xC3, 0x60, 0xAC, 0x72, 0x90, 0x86,
+					0xE2, 0xCC, 0x80, 0x6E, 0x82, 0x8A, 0x84, 0x87, 0x7F, 0x1E,
+					0xB8, 0xE5, 0xD9, 0x74, 0xD8, 0x73, 0xE0, 0x65, 0x22, 0x49,
+					0x01, 0x55, 0x5F, 0xB8, 0x82, 0x15, 0x90, 0xA3, 0x3B, 0xAC,
+					0xC6, 0x1E, 0x39, 0x70, 0x1C, 0xF9, 0xB4, 0x6B, 0xD2, 0x5B,
+					0xF5, 0xF0, 0x59, 0x5B, 0xBE, 0x24, 0x65, 0x51, 0x41, 0x43,
+					0x8E, 0x7A, 0x10, 0x0B
+				};
+				uint8_t out[2 * RLC_FP_BYTES];
+
+				TEST_ASSERT(cp_eddsa_pub(q[0], key) == RLC_OK, end);
+				TEST_ASSERT(cp_eddsa_pub_write(out, RLC_FP_BYTES,
+						q[0]) == RLC_OK, end);
+				TEST_ASSERT(memcmp(out, pub, sizeof(pub)) == 0, end);
+				TEST_ASSERT(cp_eddsa_sig(r[0], s[0], m, 0, key,
+						q[0]) == RLC_OK, end);
+				TEST_ASSERT(cp_eddsa_sig_write(out, sizeof(out), r[0],
+						s[0]) == RLC_OK, end);
+				TEST_ASSERT(memcmp(out, sig, sizeof(sig)) == 0, end);
+				TEST_ASSERT(cp_eddsa_ver(r[0], s[0], m, 0, q[0]) == 1, end);
+			}
+			TEST_END;
+		}
+#endif
+
+		TEST_CASE("eddsa batch verification is correct") {
+			for (int i = 0; i < 4; i++) {
+				ms[i] = m;
+				ls[i] = sizeof(m) - i;
+				TEST_ASSERT(cp_eddsa_gen(sk, q[i]) == RLC_OK, end);
+				TEST_ASSERT(cp_eddsa_sig(r[i], s[i], ms[i], ls[i], sk,
+						q[i]) == RLC_OK, end);
+			}
+			TEST_ASSERT(cp_eddsa_ver_batch(r, s, ms, ls, q, 4) == 1, end);
+			ls[3]++;
+			TEST_ASSERT(cp_eddsa_ver_batch(r, s, ms, ls, q, 4) == 0, end);
+			ls[3]--;
+			ed_copy(r[0], r[1]);
+			TEST_ASSERT(cp_eddsa_ver_batch(r, s, ms, ls, q, 4) == 0, end);
+		}
+		TEST_END;
+	}
+	RLC_CATCH_ANY {
+		RLC_ERROR(end);
+	}
+	code = RLC_OK;
+
+  end:
+	for (int i = 0; i < 4; i++) {
+		bn_free(s[i]);
+		ed_free(r[i]);
+		ed_free(q[i]);
+	}
+	return code;
+}
+
+#endif /* WITH_ED */
+
 #if defined(WITH_PC)
 
 static int pdpub(void) {
@@ -1306,31 +1648,59 @@ static int ibe(void) {
 	bn_t s;
 	g1_t pub;
 	g2_t prv;
-	uint8_t in[10], out[10 + 2 * RLC_FP_BYTES + 1];
+	uint8_t in[10], out[10 + 2 * RLC_FP_BYTES + 1 + RLC_BC_TAG];
+	uint8_t ct[10 + RLC_BC_TAG];
 	char *id = "Alice";
 	int il, ol;
+	size_t l, cl;
 	int result;
+	strm_t t;
 
 	bn_null(s);
 	g1_null(pub);
 	g2_null(prv);
+	strm_null(t);
 
 	RLC_TRY {
 		bn_new(s);
 		g1_new(pub);
 		g2_new(prv);
+		strm_new(t);
 
 		result = cp_ibe_gen(s, pub);
 
 		TEST_CASE("boneh-franklin identity-based encryption/decryption is correct") {
 			TEST_ASSERT(result == RLC_OK, end);
 			il = 10;
-			ol = il + 2 * RLC_FP_BYTES + 1;
+			ol = il + 2 * RLC_FP_BYTES + 1 + RLC_BC_TAG;
 			rand_bytes(in, il);
 			TEST_ASSERT(cp_ibe_gen_prv(prv, id, s) == RLC_OK, end);
 			TEST_ASSERT(cp_ibe_enc(out, &ol, in, il, id, pub) == RLC_OK, end);
 			TEST_ASSERT(cp_ibe_dec(out, &il, out, ol, prv) == RLC_OK, end);
 			TEST_ASSERT(memcmp(in, out, il) == 0, end);
+			ol = il + 2 * RLC_FP_BYTES + 1 + RLC_BC_TAG;
+			TEST_ASSERT(cp_ibe_enc(out, &ol, in, il, id, pub) == RLC_OK, end);
+			out[ol - 1] ^= 1;
+			TEST_ASSERT(cp_ibe_dec(out, &il, out, ol, prv) == RLC_ERR, end);
+		} TEST_END;
+
+		TEST_CASE("boneh-franklin streaming encryption/decryption is correct") {
+			il = 10;
+			ol = 2 * RLC_FP_BYTES + 1;
+			rand_bytes(in, il);
+			TEST_ASSERT(cp_ibe_gen_prv(prv, id, s) == RLC_OK, end);
+			TEST_ASSERT(cp_ibe_enc_init(out, &ol, t, id, pub) == RLC_OK, end);
+			cl = sizeof(ct);
+			TEST_ASSERT(cp_strm_update(ct, &cl, in, il, t) == RLC_OK, end);
+			TEST_ASSERT(cl == 0, end);
+			cl = sizeof(ct);
+			TEST_ASSERT(cp_strm_final(ct, &cl, t) == RLC_OK, end);
+			TEST_ASSERT(cp_ibe_dec_init(t, out, ol, prv) == RLC_OK, end);
+			l = sizeof(out);
+			TEST_ASSERT(cp_strm_update(out, &l, ct, cl, t) == RLC_OK, end);
+			l = sizeof(out);
+			TEST_ASSERT(cp_strm_final(out, &l, t) == RLC_OK, end);
+			TEST_ASSERT(l == 10 && memcmp(in, out, l) == 0, end);
 		} TEST_END;
 	} RLC_CATCH_ANY {
 		RLC_ERROR(end);
@@ -1338,6 +1708,7 @@ static int ibe(void) {
 	code = RLC_OK;
 
   end:
+	strm_free(t);
 	bn_free(s);
 	g1_free(pub);
 	g2_free(prv);
@@ -1350,6 +1721,7 @@ static int bgn(void) {
 	g2_t e[2], f[2];
 	gt_t g[4];
 	bgn_t pub, prv;
+	dlog_tab_t tab;
 	dig_t in, out, t;
 
 	g1_null(c[0]);
@@ -1362,6 +1734,7 @@ static int bgn(void) {
 	g2_null(f[1]);
 	bgn_null(pub);
 	bgn_null(prv);
+	dlog_tab_null(tab);
 
 	RLC_TRY {
 		g1_new(c[0]);
@@ -1374,6 +1747,7 @@ static int bgn(void) {
 		g2_new(f[1]);
 		bgn_new(pub);
 		bgn_new(prv);
+		dlog_tab_new(tab);
 		for (int i = 0; i < 4; i++) {
 			gt_null(g[i]);
 			gt_new(g[i]);
@@ -1432,6 +1806,48 @@ static int bgn(void) {
 			TEST_ASSERT(in + in == t, end);
 		} TEST_END;
 
+		TEST_CASE("boneh-go-nissim decryption with tables is correct") {
+			TEST_ASSERT(cp_bgn_tab1(tab, 64, prv) == RLC_OK, end);
+			rand_bytes((unsigned char *)&in, sizeof(dig_t));
+			in = in % 4096;
+			TEST_ASSERT(cp_bgn_enc1(c, in, pub) == RLC_OK, end);
+			TEST_ASSERT(cp_bgn_dec1_tab(&out, c, 4096, tab, prv) == RLC_OK, end);
+			TEST_ASSERT(in == out, end);
+			/* Plaintexts beyond the table are found with kangaroos. */
+			in = 4096 + in * 3;
+			TEST_ASSERT(cp_bgn_enc1(c, in, pub) == RLC_OK, end);
+			TEST_ASSERT(cp_bgn_dec1_tab(&out, c, 16384, tab, prv) == RLC_OK,
+					end);
+			TEST_ASSERT(in == out, end);
+			TEST_ASSERT(cp_bgn_tab2(tab, 64, prv) == RLC_OK, end);
+			in = in % 4096;
+			TEST_ASSERT(cp_bgn_enc2(e, in, pub) == RLC_OK, end);
+			TEST_ASSERT(cp_bgn_dec2_tab(&out, e, 4096, tab, prv) == RLC_OK, end);
+			TEST_ASSERT(in == out, end);
+			TEST_ASSERT(cp_bgn_tab(tab, 64, prv) == RLC_OK, end);
+			TEST_ASSERT(cp_bgn_enc1(c, in, pub) == RLC_OK, end);
+			TEST_ASSERT(cp_bgn_enc2(e, 3, pub) == RLC_OK, end);
+			TEST_ASSERT(cp_bgn_mul(g, c, e) == RLC_OK, end);
+			TEST_ASSERT(cp_bgn_dec_tab(&out, g, 16384, tab, prv) == RLC_OK,
+					end);
+			TEST_ASSERT(3 * in == out, end);
+		} TEST_END;
+
+		TEST_CASE("boneh-go-nissim decryption tables are serializable") {
+			uint8_t bin[8 + 16 * 63];
+			TEST_ASSERT(cp_bgn_tab1(tab, 64, prv) == RLC_OK, end);
+			TEST_ASSERT(pc_dlog_size_bin(tab) == sizeof(bin), end);
+			pc_dlog_write_bin(bin, sizeof(bin), tab);
+			dlog_tab_free(tab);
+			dlog_tab_new(tab);
+			pc_dlog_read_bin(tab, bin, sizeof(bin));
+			rand_bytes((unsigned char *)&in, sizeof(dig_t));
+			in = in % 4096;
+			TEST_ASSERT(cp_bgn_enc1(c, in, pub) == RLC_OK, end);
+			TEST_ASSERT(cp_bgn_dec1_tab(&out, c, 4096, tab, prv) == RLC_OK, end);
+			TEST_ASSERT(in == out, end);
+		} TEST_END;
+
 	} RLC_CATCH_ANY {
 		RLC_ERROR(end);
 	}
@@ -1448,6 +1864,7 @@ static int bgn(void) {
 	g2_free(f[1]);
 	bgn_free(pub);
 	bgn_free(prv);
+	dlog_tab_free(tab);
 	for (int i = 0; i < 4; i++) {
 		gt_free(g[i]);
 	}
@@ -2046,6 +2463,32 @@ static int lhs(void) {
 		}
 		TEST_END;
 
+		TEST_CASE("context-hiding linear homomorphic signature is cacheable") {
+			uint8_t key[RLC_MD_LEN], bin[RLC_MD_LEN + 48 * RLC_FP_BYTES];
+			int label[L], len = cp_cmlhs_off_size(vk);
+
+			for (int l = 0; l < L; l++) {
+				label[l] = l;
+			}
+			TEST_ASSERT(len <= (int)sizeof(bin), end);
+			cp_cmlhs_off(vk, h, label, hs, f, flen, y, pk, S);
+			TEST_ASSERT(cp_cmlhs_off_key(key, label, f, flen, pk, S) == RLC_OK,
+				end);
+			TEST_ASSERT(cp_cmlhs_off_write(bin, len, vk, key) == RLC_OK, end);
+			gt_set_unity(vk);
+			TEST_ASSERT(cp_cmlhs_off_read(vk, bin, len, key) == RLC_OK, end);
+			TEST_ASSERT(cp_cmlhs_onv(_r, _s, sig, z, as, cs, m, data, h, vk,
+				y, pk, S) == 1, end);
+			/* A different function must not hit the same entry. */
+			f[0][0]++;
+			TEST_ASSERT(cp_cmlhs_off_key(bin, label, f, flen, pk, S) == RLC_OK,
+				end);
+			TEST_ASSERT(memcmp(key, bin, RLC_MD_LEN) != 0, end);
+			TEST_ASSERT(cp_cmlhs_off_read(vk, bin, len, key) == RLC_ERR, end);
+			f[0][0]--;
+		}
+		TEST_END;
+
 		char *ls[L] = { NULL };
 		dig_t ft[S];
 
@@ -2085,6 +2528,68 @@ static int lhs(void) {
 			TEST_ASSERT(cp_mklhs_onv(_r, m, d, data, id, as, ft, pk, S), end);
 		}
 		TEST_END;
+
+		TEST_CASE("linear multi-key homomorphic signature with labels is correct") {
+			char *ts[L] = { "a", "b", "c", "d" };
+			g1_t hl[S * L];
+
+			for (int j = 0; j < S * L; j++) {
+				g1_null(hl[j]);
+				g1_new(hl[j]);
+			}
+			for (int j = 0; j < S; j++) {
+				for (int l = 0; l < L; l++) {
+					bn_rand_mod(msg[j][l], n);
+					cp_mklhs_sig(a[j][l], msg[j][l], data, id[j], ts[l], sk[j]);
+				}
+				cp_mklhs_fun(d[j], msg[j], f[j], L);
+			}
+			g1_set_infty(_r);
+			bn_zero(m);
+			for (int j = 0; j < S; j++) {
+				cp_mklhs_evl(r[0][j], a[j], f[j], L);
+				g1_add(_r, _r, r[0][j]);
+				bn_add(m, m, d[j]);
+				bn_mod(m, m, n);
+			}
+			g1_norm(_r, _r);
+
+			TEST_ASSERT(cp_mklhs_lab(hl, id, ts, flen, S) == RLC_OK, end);
+			TEST_ASSERT(cp_mklhs_ver_lab(_r, m, d, data, id, hl, f, flen, pk,
+				S), end);
+			TEST_ASSERT(cp_mklhs_ver(_r, m, d, data, id, ts, f, flen, pk, S),
+				end);
+			/* Labels must be bound to their positions. */
+			g1_copy(h, hl[0]);
+			g1_copy(hl[0], hl[1]);
+			g1_copy(hl[1], h);
+			TEST_ASSERT(cp_mklhs_ver_lab(_r, m, d, data, id, hl, f, flen, pk,
+				S) == 0, end);
+			cp_mklhs_off(as, ft, id, ts, f, flen, S);
+			TEST_ASSERT(cp_mklhs_onv(_r, m, d, data, id, as, ft, pk, S), end);
+
+			/* The offline part survives a round trip through the cache. */
+			uint8_t key[RLC_MD_LEN], bin[RLC_MD_LEN + S * (2 * RLC_FP_BYTES + 9)];
+			int len = cp_mklhs_off_size(S);
+			TEST_ASSERT(len <= (int)sizeof(bin), end);
+			TEST_ASSERT(cp_mklhs_off_key(key, id, ts, f, flen, S) == RLC_OK, end);
+			TEST_ASSERT(cp_mklhs_off_write(bin, len, as, ft, key, S) == RLC_OK,
+				end);
+			for (int j = 0; j < S; j++) {
+				g1_set_infty(as[j]);
+				ft[j] = 0;
+			}
+			TEST_ASSERT(cp_mklhs_off_read(as, ft, bin, len, key, S) == RLC_OK,
+				end);
+			TEST_ASSERT(cp_mklhs_onv(_r, m, d, data, id, as, ft, pk, S), end);
+			TEST_ASSERT(cp_mklhs_off_key(key, id, ls, f, flen, S) == RLC_OK, end);
+			TEST_ASSERT(cp_mklhs_off_read(as, ft, bin, len, key, S) == RLC_ERR,
+				end);
+			for (int j = 0; j < S * L; j++) {
+				g1_free(hl[j]);
+			}
+		}
+		TEST_END;
 	}
 	RLC_CATCH_ANY {
 		RLC_ERROR(end);
@@ -2128,8 +2633,52 @@ static int lhs(void) {
 #define M	5			/* Number of server messages (larger). */
 #define N	2			/* Number of client messages. */
 
+/**
+ * In-memory channel for the streaming PSI protocol. The sender set is handed
+ * out one element at a time, so each element travels in its own chunk.
+ */
+typedef struct {
+	bn_t *y;
+	int n, pos;
+	uint8_t buf[4 * (N + 1) + N * 64 * RLC_FP_BYTES];
+	size_t len, off;
+} psi_chan_t;
+
+static int psi_get_set(bn_t *y, int n, void *arg) {
+	psi_chan_t *c = (psi_chan_t *)arg;
+
+	if (n < 1 || c->pos == c->n) {
+		return 0;
+	}
+	bn_copy(y[0], c->y[c->pos++]);
+	return 1;
+}
+
+static int psi_put(const uint8_t *buf, size_t len, void *arg) {
+	psi_chan_t *c = (psi_chan_t *)arg;
+
+	if (c->len + len > sizeof(c->buf)) {
+		return RLC_ERR;
+	}
+	memcpy(c->buf + c->len, buf, len);
+	c->len += len;
+	return RLC_OK;
+}
+
+static int psi_get(uint8_t *buf, size_t len, void *arg) {
+	psi_chan_t *c = (psi_chan_t *)arg;
+
+	if (c->off + len > c->len) {
+		return RLC_ERR;
+	}
+	memcpy(buf, c->buf + c->off, len);
+	c->off += len;
+	return RLC_OK;
+}
+
 static int psi(void) {
 	int len, result, code = RLC_ERR;
+	psi_chan_t c;
 	bn_t g, n, q, r, p[M], x[M], v[N], w[N], y[N], z[M];
 	g1_t u[M], ss;
 	g2_t d[M + 1], s[M + 1];
@@ -2240,6 +2789,36 @@ static int psi(void) {
 				TEST_ASSERT(len == k, end);
 			}
 		} TEST_END;
+
+		TEST_CASE("pairing-based laconic private set intersection is streamable") {
+			for (int k = 0; k <= N; k++) {
+				for (int j = 0; j < N; j++) {
+					bn_rand_mod(y[j], q);
+				}
+				for (int j = 0; j < k; j++) {
+					bn_copy(y[j], x[j]);
+				}
+				c.y = y;
+				c.n = N;
+				c.pos = 0;
+				c.len = c.off = 0;
+				TEST_ASSERT(cp_pbpsi_ans_strm(ss, d[0], psi_get_set, psi_put,
+						&c) == RLC_OK, end);
+				TEST_ASSERT(cp_pbpsi_int_strm(z, &len, d, x, M, psi_get,
+						&c) == RLC_OK, end);
+				TEST_ASSERT(len == k && c.off == c.len, end);
+				/* A truncated stream must be rejected. */
+				c.off = 0;
+				c.len -= 4;
+				TEST_ASSERT(cp_pbpsi_int_strm(z, &len, d, x, M, psi_get,
+						&c) == RLC_ERR, end);
+				/* So must a chunk with a count that overflows an int. */
+				c.off = 0;
+				c.buf[0] |= 0x80;
+				TEST_ASSERT(cp_pbpsi_int_strm(z, &len, d, x, M, psi_get,
+						&c) == RLC_ERR, end);
+			}
+		} TEST_END;
 	}
 	RLC_CATCH_ANY {
 		RLC_ERROR(end);
@@ -2371,6 +2950,15 @@ int main(void) {
 	}
 #endif
 
+#if defined(WITH_ED)
+	if (ed_param_set_any() == RLC_OK) {
+		if (eddsa() != RLC_OK) {
+			core_clean();
+			return 1;
+		}
+	}
+#endif
+
 #if defined(WITH_PC)
 	util_banner("Protocols based on pairings:\n", 0);
 	if (pc_param_set_any() == RLC_OK) {
@@ -62,17 +62,25 @@ static int memory(void) {
 
 static int util(void) {
 	int l, code = RLC_ERR;
-	ep_t a, b, c;
+	ep_t a, b, c, d[4], e[4];
 	uint8_t bin[2 * RLC_FP_BYTES + 1];
 
 	ep_null(a);
 	ep_null(b);
 	ep_null(c);
+	for (int i = 0; i < 4; i++) {
+		ep_null(d[i]);
+		ep_null(e[i]);
+	}
 
 	RLC_TRY {
 		ep_new(a);
 		ep_new(b);
 		ep_new(c);
+		for (int i = 0; i < 4; i++) {
+			ep_new(d[i]);
+			ep_new(e[i]);
+		}
 
 		TEST_CASE("copy and comparison are consistent") {
 			ep_rand(a);
@@ -167,6 +175,27 @@ static int util(void) {
 			}
 		}
 		TEST_END;
+
+		TEST_CASE("simultaneous normalization is correct") {
+			for (int j = 0; j < 4; j++) {
+				ep_rand(d[j]);
+				ep_dbl(d[j], d[j]);
+			}
+			/* A point at infinity must not affect its neighbors. */
+			ep_set_infty(d[2]);
+			ep_norm_sim(e, (const ep_t *)d, 4);
+			for (int j = 0; j < 4; j++) {
+				ep_norm(a, d[j]);
+				TEST_ASSERT(ep_cmp(a, e[j]) == RLC_EQ, end);
+				TEST_ASSERT(ep_is_infty(e[j]) || e[j]->coord == BASIC, end);
+			}
+			ep_norm_sim(d, (const ep_t *)d, 4);
+			for (int j = 0; j < 4; j++) {
+				TEST_ASSERT(ep_cmp(d[j], e[j]) == RLC_EQ, end);
+				TEST_ASSERT(ep_is_infty(d[j]) || d[j]->coord == BASIC, end);
+			}
+		}
+		TEST_END;
 	}
 	RLC_CATCH_ANY {
 		util_print("FATAL ERROR!\n");
@@ -177,6 +206,10 @@ static int util(void) {
 	ep_free(a);
 	ep_free(b);
 	ep_free(c);
+	for (int i = 0; i < 4; i++) {
+		ep_free(d[i]);
+		ep_free(e[i]);
+	}
 	return code;
 }
 
@@ -1338,17 +1371,26 @@ static int hashing(void) {
 	int code = RLC_ERR;
 	ep_t a;
 	ep_t b;
+	ep_t c[RLC_TERMS];
 	bn_t n;
-	uint8_t msg[5];
+	uint8_t msg[5], m[RLC_TERMS][5];
+	const uint8_t *ptr[RLC_TERMS];
+	int len[RLC_TERMS];
 
 	ep_null(a);
 	ep_null(b);
 	bn_null(n);
+	for (int i = 0; i < RLC_TERMS; i++) {
+		ep_null(c[i]);
+	}
 
 	RLC_TRY {
 		ep_new(a);
 		ep_new(b);
 		bn_new(n);
+		for (int i = 0; i < RLC_TERMS; i++) {
+			ep_new(c[i]);
+		}
 
 		ep_curve_get_ord(n);
 
@@ -1362,6 +1404,55 @@ static int hashing(void) {
 			TEST_ASSERT(ep_is_infty(a) == 1, end);
 		}
 		TEST_END;
+
+#if FP_PRIME == 381
+		if (ep_param_get() == B12_P381) {
+			/* Test vectors from RFC 9380, Appendix J.9.1. */
+			TEST_ONCE("point hashing satisfies test vectors") {
+				const char *dst =
+					"QUUX-V01-CS02-with-BLS12381G1_XMD:SHA-256_SSWU_RO_";
+				const char *x[] = {
+					"052926ADD2207B76CA4FA57A8734416C8DC95E24501772C8"
+					"14278700EED6D1E4E8CF62D9C09DB0FAC349612B759E79A1",
+					"03567BC5EF9C690C2AB2ECDF6A96EF1C139CC0B2F284DCA0"
+					"A9A7943388A49A3AEE664BA5379A7655D3C68900BE2F6903"
+				};
+				const char *y[] = {
+					"08BA738453BFED09CB546DBB0783DBB3A5F1F566ED67BB6B"
+					"E0E8C67E2E81A4CC68EE29813BB7994998F3EAE0C9C6A265",
+					"0B9C15F3FE6E5CF4211F346271D7B01C8F3B28BE689C8429"
+					"C85B67AF215533311F0B8DFAAA154FA6B88176C229F2885D"
+				};
+
+				for (int j = 0; j < 2; j++) {
+					ep_map_dst(a, (const uint8_t *)"abc", 3 * j,
+							(const uint8_t *)dst, strlen(dst));
+					fp_read_str(b->x, x[j], strlen(x[j]), 16);
+					fp_read_str(b->y, y[j], strlen(y[j]), 16);
+					fp_set_dig(b->z, 1);
+					b->coord = BASIC;
+					TEST_ASSERT(ep_cmp(a, b) == RLC_EQ, end);
+				}
+			}
+			TEST_END;
+		}
+#endif
+
+		TEST_CASE("simultaneous point hashing is correct") {
+			for (int i = 0; i < RLC_TERMS; i++) {
+				rand_bytes(m[i], sizeof(m[i]));
+				ptr[i] = m[i];
+				len[i] = i % sizeof(m[i]);
+			}
+			ep_map_sim(c, ptr, len, RLC_TERMS);
+			for (int i = 0; i < RLC_TERMS; i++) {
+				ep_map(a, m[i], len[i]);
+				TEST_ASSERT(ep_cmp(a, c[i]) == RLC_EQ, end);
+				TEST_ASSERT(c[i]->coord == BASIC, end);
+			}
+			ep_map_sim(c, ptr, len, 0);
+		}
+		TEST_END;
 	}
 	RLC_CATCH_ANY {
 		RLC_ERROR(end);
@@ -1371,6 +1462,9 @@ static int hashing(void) {
 	ep_free(a);
 	ep_free(b);
 	bn_free(n);
+	for (int i = 0; i < RLC_TERMS; i++) {
+		ep_free(c[i]);
+	}
 	return code;
 }
 
@@ -62,17 +62,25 @@ static int memory2(void) {
 
 static int util2(void) {
 	int l, code = RLC_ERR;
-	ep2_t a, b, c;
+	ep2_t a, b, c, d[4], e[4];
 	uint8_t bin[4 * RLC_FP_BYTES + 1];
 
 	ep2_null(a);
 	ep2_null(b);
 	ep2_null(c);
+	for (int i = 0; i < 4; i++) {
+		ep2_null(d[i]);
+		ep2_null(e[i]);
+	}
 
 	RLC_TRY {
 		ep2_new(a);
 		ep2_new(b);
 		ep2_new(c);
+		for (int i = 0; i < 4; i++) {
+			ep2_new(d[i]);
+			ep2_new(e[i]);
+		}
 
 		TEST_CASE("copy and comparison are consistent") {
 			ep2_rand(a);
@@ -166,6 +174,27 @@ static int util2(void) {
 			}
 		}
 		TEST_END;
+
+		TEST_CASE("simultaneous normalization is correct") {
+			for (int j = 0; j < 4; j++) {
+				ep2_rand(d[j]);
+				ep2_dbl(d[j], d[j]);
+			}
+			/* A point at infinity must not affect its neighbors. */
+			ep2_set_infty(d[2]);
+			ep2_norm_sim(e, d, 4);
+			for (int j = 0; j < 4; j++) {
+				ep2_norm(a, d[j]);
+				TEST_ASSERT(ep2_cmp(a, e[j]) == RLC_EQ, end);
+				TEST_ASSERT(ep2_is_infty(e[j]) || e[j]->coord == BASIC, end);
+			}
+			ep2_norm_sim(d, d, 4);
+			for (int j = 0; j < 4; j++) {
+				TEST_ASSERT(ep2_cmp(d[j], e[j]) == RLC_EQ, end);
+				TEST_ASSERT(ep2_is_infty(d[j]) || d[j]->coord == BASIC, end);
+			}
+		}
+		TEST_END;
 	}
 	RLC_CATCH_ANY {
 		util_print("FATAL ERROR!\n");
@@ -176,6 +205,10 @@ static int util2(void) {
 	ep2_free(a);
 	ep2_free(b);
 	ep2_free(c);
+	for (int i = 0; i < 4; i++) {
+		ep2_free(d[i]);
+		ep2_free(e[i]);
+	}
 	return code;
 }
 
@@ -171,12 +171,12 @@ static int util(void) {
 
 		TEST_CASE("converting to and from a prime field element are consistent") {
 			bn_rand(c, RLC_POS, FP_PRIME);
-			bn_mod(c, c, &core_get()->prime);
+			bn_mod(c, c, &core_par_get()->prime);
 			fp_prime_conv(a, c);
 			fp_prime_back(e, a);
 			TEST_ASSERT(bn_cmp(c, e) == RLC_EQ, end);
 			bn_rand(c, RLC_POS, FP_PRIME / 2);
-			bn_mod(c, c, &core_get()->prime);
+			bn_mod(c, c, &core_par_get()->prime);
 			fp_prime_conv(a, c);
 			fp_prime_back(e, a);
 			TEST_ASSERT(bn_cmp(c, e) == RLC_EQ, end);
@@ -1049,7 +1049,7 @@ static int exponentiation(void) {
 }
 
 static int square_root(void) {
-	int code = RLC_ERR;
+	int r, code = RLC_ERR;
 	fp_t a, b, c;
 
 	fp_null(a);
@@ -1074,6 +1074,29 @@ static int square_root(void) {
 			}
 		}
 		TEST_END;
+
+		TEST_CASE("square root of quotient is correct") {
+			fp_rand(a);
+			fp_rand(b);
+			fp_inv(c, b);
+			fp_mul(c, c, a);
+			r = fp_srt(c, c);
+			TEST_ASSERT(fp_srt_div(c, a, b) == r, end);
+			fp_sqr(c, c);
+			fp_mul(c, c, b);
+			if (!r) {
+				fp_mul_dig(c, c, -fp_prime_get_qnr());
+				fp_neg(c, c);
+			}
+			TEST_ASSERT(fp_cmp(c, a) == RLC_EQ, end);
+			fp_sqr(a, a);
+			fp_sqr(b, b);
+			TEST_ASSERT(fp_srt_div(c, a, b) == 1, end);
+			fp_sqr(c, c);
+			fp_mul(c, c, b);
+			TEST_ASSERT(fp_cmp(c, a) == RLC_EQ, end);
+		}
+		TEST_END;
 	}
 	RLC_CATCH_ANY {
 		RLC_ERROR(end);
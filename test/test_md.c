@@ -209,6 +209,39 @@ static int sha256(void) {
 	}
 	TEST_END;
 
+#if ARCH == X64
+	TEST_CASE("sha256 hash function is consistent across implementations") {
+		uint8_t other[32];
+		int ext = core_get()->ext;
+		rand_bytes(message, 1);
+		j = RLC_MIN(MSG_SIZE, 1024) - (message[0] & 0x3F);
+		rand_bytes(message, j);
+		md_map_sh256(digest, message, j);
+		core_get()->ext = 0;
+		md_map_sh256(other, message, j);
+		core_get()->ext = ext;
+		TEST_ASSERT(memcmp(digest, other, 32) == 0, end);
+	}
+	TEST_END;
+#endif
+
+	TEST_CASE("sha256 incremental hashing is correct") {
+		uint8_t other[32];
+		md_sh256_t ctx;
+		int len = RLC_MIN(MSG_SIZE, 1024);
+		rand_bytes(message, 2);
+		j = message[0] % len;
+		rand_bytes(message, len);
+		md_map_sh256(digest, message, len);
+		md_sh256_init(ctx);
+		md_sh256_update(ctx, message, j);
+		md_sh256_update(ctx, NULL, 0);
+		md_sh256_update(ctx, message + j, len - j);
+		md_sh256_final(other, ctx);
+		TEST_ASSERT(memcmp(digest, other, 32) == 0, end);
+	}
+	TEST_END;
+
 	TEST_ONCE("sha256 xmd function is correct") {
 		uint8_t buf[75] = {0,};
 		md_xmd_sh256(buf, 16, (uint8_t *)TEST1, strlen(TEST1), (uint8_t *)"", 0);
@@ -401,6 +434,39 @@ static int sha512(void) {
 	}
 	TEST_END;
 
+#if ARCH == X64
+	TEST_CASE("sha512 hash function is consistent across implementations") {
+		uint8_t other[64];
+		int ext = core_get()->ext;
+		rand_bytes(message, 1);
+		j = RLC_MIN(MSG_SIZE, 1024) - (message[0] & 0x3F);
+		rand_bytes(message, j);
+		md_map_sh512(digest, message, j);
+		core_get()->ext = 0;
+		md_map_sh512(other, message, j);
+		core_get()->ext = ext;
+		TEST_ASSERT(memcmp(digest, other, 64) == 0, end);
+	}
+	TEST_END;
+#endif
+
+	TEST_CASE("sha512 incremental hashing is correct") {
+		uint8_t other[64];
+		md_sh512_t ctx;
+		int len = RLC_MIN(MSG_SIZE, 1024);
+		rand_bytes(message, 2);
+		j = message[0] % len;
+		rand_bytes(message, len);
+		md_map_sh512(digest, message, len);
+		md_sh512_init(ctx);
+		md_sh512_update(ctx, message, j);
+		md_sh512_update(ctx, NULL, 0);
+		md_sh512_update(ctx, message + j, len - j);
+		md_sh512_final(other, ctx);
+		TEST_ASSERT(memcmp(digest, other, 64) == 0, end);
+	}
+	TEST_END;
+
 	TEST_ONCE("sha512 xmd function is correct") {
 		uint8_t buf[75] = {0,};
 		md_xmd_sh512(buf, 16, (uint8_t *)TEST1, strlen(TEST1), (uint8_t *)"", 0);
@@ -422,6 +488,259 @@ static int sha512(void) {
 
 #endif
 
+#if MD_MAP == B2B256 || MD_MAP == B2B512 || !defined(STRIP)
+
+uint8_t result_b2b256[3][32] = {
+	{0xBD, 0xDD, 0x81, 0x3C, 0x63, 0x42, 0x39, 0x72, 0x31, 0x71, 0xEF,
+	 0x3F, 0xEE, 0x98, 0x57, 0x9B, 0x94, 0x96, 0x4E, 0x3B, 0xB1, 0xCB,
+	 0x3E, 0x42, 0x72, 0x62, 0xC8, 0xC0, 0x68, 0xD5, 0x23, 0x19},
+	{0x5F, 0x7A, 0x93, 0xDA, 0x9C, 0x56, 0x21, 0x58, 0x3F, 0x22, 0xE4,
+	 0x9E, 0x8E, 0x91, 0xA4, 0x0C, 0xBB, 0xA3, 0x75, 0x36, 0x62, 0x22,
+	 0x35, 0xA3, 0x80, 0xF4, 0x34, 0xB9, 0xF6, 0x8E, 0x49, 0xC4},
+	{0x07, 0x41, 0x85, 0x0F, 0x36, 0xCB, 0xA4, 0x25, 0x96, 0x28, 0x35,
+	 0x5D, 0x10, 0x73, 0xE2, 0x4D, 0xDB, 0x9C, 0xA0, 0xE1, 0xBF, 0xAC,
+	 0x36, 0xFD, 0x39, 0xAE, 0x5D, 0xC2, 0x10, 0x1E, 0x23, 0xA4},
+};
+
+uint8_t result_b2b512[3][64] = {
+	{0xBA, 0x80, 0xA5, 0x3F, 0x98, 0x1C, 0x4D, 0x0D, 0x6A, 0x27, 0x97,
+	 0xB6, 0x9F, 0x12, 0xF6, 0xE9, 0x4C, 0x21, 0x2F, 0x14, 0x68, 0x5A,
+	 0xC4, 0xB7, 0x4B, 0x12, 0xBB, 0x6F, 0xDB, 0xFF, 0xA2, 0xD1, 0x7D,
+	 0x87, 0xC5, 0x39, 0x2A, 0xAB, 0x79, 0x2D, 0xC2, 0x52, 0xD5, 0xDE,
+	 0x45, 0x33, 0xCC, 0x95, 0x18, 0xD3, 0x8A, 0xA8, 0xDB, 0xF1, 0x92,
+	 0x5A, 0xB9, 0x23, 0x86, 0xED, 0xD4, 0x00, 0x99, 0x23},
+	{0x72, 0x85, 0xFF, 0x3E, 0x8B, 0xD7, 0x68, 0xD6, 0x9B, 0xE6, 0x2B,
+	 0x3B, 0xF1, 0x87, 0x65, 0xA3, 0x25, 0x91, 0x7F, 0xA9, 0x74, 0x4A,
+	 0xC2, 0xF5, 0x82, 0xA2, 0x08, 0x50, 0xBC, 0x2B, 0x11, 0x41, 0xED,
+	 0x1B, 0x3E, 0x45, 0x28, 0x59, 0x5A, 0xCC, 0x90, 0x77, 0x2B, 0xDF,
+	 0x2D, 0x37, 0xDC, 0x8A, 0x47, 0x13, 0x0B, 0x44, 0xF3, 0x3A, 0x02,
+	 0xE8, 0x73, 0x0E, 0x5A, 0xD8, 0xE1, 0x66, 0xE8, 0x88},
+	{0x98, 0xFB, 0x3E, 0xFB, 0x72, 0x06, 0xFD, 0x19, 0xEB, 0xF6, 0x9B,
+	 0x6F, 0x31, 0x2C, 0xF7, 0xB6, 0x4E, 0x3B, 0x94, 0xDB, 0xE1, 0xA1,
+	 0x71, 0x07, 0x91, 0x39, 0x75, 0xA7, 0x93, 0xF1, 0x77, 0xE1, 0xD0,
+	 0x77, 0x60, 0x9D, 0x7F, 0xBA, 0x36, 0x3C, 0xBB, 0xA0, 0x0D, 0x05,
+	 0xF7, 0xAA, 0x4E, 0x4F, 0xA8, 0x71, 0x5D, 0x64, 0x28, 0x10, 0x4C,
+	 0x0A, 0x75, 0x64, 0x3B, 0x0F, 0xF3, 0xFD, 0x3E, 0xAF},
+};
+
+uint8_t result_xmd_b2b512[4][75] = {
+	{0xA3, 0x67, 0x52, 0x29, 0xEC, 0x60, 0xFC, 0x16, 0x91, 0x56, 0x38,
+	 0x0B, 0xE9, 0xFB, 0x56, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	{0x36, 0xCE, 0x55, 0x6F, 0x47, 0x83, 0x59, 0xED, 0x3D, 0x8B, 0x1C,
+	 0x7D, 0x4D, 0x32, 0x91, 0x1E, 0x78, 0xAD, 0x74, 0x93, 0x07, 0x4D,
+	 0x41, 0xE9, 0x0B, 0x8A, 0xC2, 0x96, 0xC5, 0xC9, 0x68, 0x50, 0xE9,
+	 0xAA, 0xCB, 0xAF, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	{0xE0, 0x4F, 0x28, 0x94, 0x10, 0xDB, 0xFC, 0x85, 0x4B, 0xBE, 0x33,
+	 0xA9, 0xAD, 0x7D, 0xEC, 0xF0, 0xFD, 0x68, 0xB2, 0xEB, 0x92, 0xEB,
+	 0x56, 0xC9, 0x81, 0x4F, 0xC1, 0xA7, 0xEA, 0x79, 0x73, 0x8C, 0x13,
+	 0xC9, 0xE0, 0xEE, 0xE1, 0x14, 0x0E, 0xFA, 0x35, 0xC5, 0x58, 0xDF,
+	 0x61, 0x63, 0xB4, 0x75, 0x51, 0xF4, 0x46, 0xED, 0xA4, 0xB2, 0x1F,
+	 0xAB, 0x7B, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	{0xB2, 0x2C, 0xA1, 0x2E, 0x0F, 0xFC, 0x01, 0xD5, 0xD3, 0x03, 0xE1,
+	 0x7D, 0x83, 0xDB, 0xC8, 0x73, 0x32, 0x9C, 0xB9, 0xB3, 0x95, 0x10,
+	 0x94, 0x93, 0x36, 0x4B, 0x21, 0x12, 0xA8, 0x85, 0xE4, 0xB6, 0x06,
+	 0x39, 0x67, 0xE1, 0x39, 0xB7, 0x35, 0x6D, 0x27, 0x53, 0x49, 0x40,
+	 0x2C, 0x4C, 0xE6, 0xFD, 0x76, 0x31, 0xC6, 0x5C, 0x1C, 0x6A, 0x6B,
+	 0x7A, 0x05, 0x74, 0xDA, 0xB6, 0xE8, 0x54, 0xCF, 0x90, 0xF6, 0x72,
+	 0x42, 0x63, 0x63, 0x15, 0xF4, 0xFE, 0xCA, 0x6B, 0x2A},
+};
+
+static int blake2b(void) {
+	int code = RLC_ERR;
+	int i, j;
+	uint8_t message[MSG_SIZE], digest[64];
+
+#if MD_MAP == B2B256 || !defined(STRIP)
+	TEST_ONCE("b2b256 hash function is correct") {
+		for (i = 0; i < TEST_MAX; i++) {
+			memset(message, 0, MSG_SIZE);
+			for (j = 0; j < count[i]; j++) {
+				strcat((char *)message, tests[i]);
+			}
+			md_map_b2b256(digest, message, strlen((char *)message));
+			TEST_ASSERT(memcmp(digest, result_b2b256[i], 32) == 0, end);
+		}
+	}
+	TEST_END;
+#endif
+
+#if MD_MAP == B2B512 || !defined(STRIP)
+	TEST_ONCE("b2b512 hash function is correct") {
+		for (i = 0; i < TEST_MAX; i++) {
+			memset(message, 0, MSG_SIZE);
+			for (j = 0; j < count[i]; j++) {
+				strcat((char *)message, tests[i]);
+			}
+			md_map_b2b512(digest, message, strlen((char *)message));
+			TEST_ASSERT(memcmp(digest, result_b2b512[i], 64) == 0, end);
+		}
+	}
+	TEST_END;
+
+	TEST_CASE("b2b512 incremental hashing is correct") {
+		uint8_t other[64];
+		md_b2b_t ctx;
+		int len = RLC_MIN(MSG_SIZE, 1024);
+		rand_bytes(message, 2);
+		j = ((message[0] << 8) | message[1]) % len;
+		rand_bytes(message, len);
+		md_map_b2b512(digest, message, len);
+		md_b2b512_init(ctx);
+		md_b2b512_update(ctx, message, j);
+		md_b2b512_update(ctx, NULL, 0);
+		md_b2b512_update(ctx, message + j, len - j);
+		md_b2b512_final(other, ctx);
+		TEST_ASSERT(memcmp(digest, other, 64) == 0, end);
+	}
+	TEST_END;
+
+	TEST_ONCE("b2b512 xmd function is correct") {
+		uint8_t buf[75] = {0,};
+		md_xmd_b2b512(buf, 16, (uint8_t *)TEST1, strlen(TEST1), (uint8_t *)"", 0);
+		TEST_ASSERT(memcmp(buf, result_xmd_b2b512[0], 16) == 0, end);
+		md_xmd_b2b512(buf, 37, (uint8_t *)TEST2a, strlen(TEST2a), (uint8_t *)TEST2b, strlen(TEST2b));
+		TEST_ASSERT(memcmp(buf, result_xmd_b2b512[1], 37) == 0, end);
+		md_xmd_b2b512(buf, 57, (uint8_t *)TEST3a, strlen(TEST3a), (uint8_t *)TEST3b, strlen(TEST3b));
+		TEST_ASSERT(memcmp(buf, result_xmd_b2b512[2], 57) == 0, end);
+		md_xmd_b2b512(buf, 75, (uint8_t *)TEST4a, strlen(TEST4a), (uint8_t *)TEST4b, strlen(TEST4b));
+		TEST_ASSERT(memcmp(buf, result_xmd_b2b512[3], 75) == 0, end);
+	}
+	TEST_END;
+#endif
+
+	code = RLC_OK;
+
+  end:
+	return code;
+}
+
+#endif
+
+#if MD_MAP == BLAKE3 || !defined(STRIP)
+
+uint8_t result_blake3[3][32] = {
+	{0x64, 0x37, 0xB3, 0xAC, 0x38, 0x46, 0x51, 0x33, 0xFF, 0xB6, 0x3B,
+	 0x75, 0x27, 0x3A, 0x8D, 0xB5, 0x48, 0xC5, 0x58, 0x46, 0x5D, 0x79,
+	 0xDB, 0x03, 0xFD, 0x35, 0x9C, 0x6C, 0xD5, 0xBD, 0x9D, 0x85},
+	{0xC1, 0x90, 0x12, 0xCC, 0x2A, 0xAF, 0x0D, 0xC3, 0xD8, 0xE5, 0xC4,
+	 0x5A, 0x1B, 0x79, 0x11, 0x4D, 0x2D, 0xF4, 0x2A, 0xBB, 0x2A, 0x41,
+	 0x0B, 0xF5, 0x4B, 0xE0, 0x9E, 0x89, 0x1A, 0xF0, 0x6F, 0xF8},
+	{0x61, 0x6F, 0x57, 0x5A, 0x1B, 0x58, 0xD4, 0xC9, 0x79, 0x7D, 0x42,
+	 0x17, 0xB9, 0x73, 0x0A, 0xE5, 0xE6, 0xEB, 0x31, 0x9D, 0x76, 0xED,
+	 0xEF, 0x65, 0x49, 0xB4, 0x6F, 0x4E, 0xFE, 0x31, 0xFF, 0x8B},
+};
+
+uint8_t result_xmd_blake3[4][75] = {
+	{0x2F, 0x7C, 0xBE, 0x7C, 0x75, 0xD8, 0x71, 0xFF, 0x4E, 0x22, 0x46,
+	 0x57, 0xFA, 0xF1, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	{0x6B, 0x91, 0xF3, 0xD1, 0x72, 0x93, 0x6A, 0x36, 0xF0, 0xD0, 0x80,
+	 0xD6, 0x1D, 0xEA, 0xAE, 0x1C, 0x75, 0x04, 0x18, 0xF9, 0x17, 0x6B,
+	 0xBB, 0x7C, 0xC6, 0x69, 0x61, 0x34, 0x43, 0x5D, 0x6E, 0xE3, 0x83,
+	 0xC4, 0xED, 0xE6, 0x92, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	{0xF9, 0x07, 0xC2, 0x7B, 0x51, 0x9B, 0x0E, 0xFC, 0xA9, 0xFC, 0xAD,
+	 0x86, 0xE0, 0xE4, 0xD2, 0x74, 0xA0, 0xD7, 0xA3, 0x57, 0x8B, 0x22,
+	 0xFC, 0x9A, 0x91, 0xE2, 0x9B, 0xEE, 0x04, 0x3B, 0x0F, 0x5C, 0x39,
+	 0xC2, 0x9C, 0x52, 0x22, 0xB3, 0xF5, 0x1F, 0xD9, 0xF8, 0x7B, 0xFB,
+	 0x1F, 0xE7, 0x33, 0x23, 0xCC, 0xBB, 0x7B, 0x1C, 0xC3, 0xD7, 0xAF,
+	 0x38, 0xA6, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+	{0x37, 0x9D, 0x88, 0xB9, 0x10, 0x72, 0xA7, 0xD9, 0xA8, 0x8C, 0x65,
+	 0xCE, 0x1B, 0x3C, 0xE2, 0x64, 0x34, 0x59, 0x57, 0x5A, 0x14, 0xB8,
+	 0x10, 0x9B, 0x38, 0x8D, 0x18, 0xAD, 0xD3, 0x6C, 0x8F, 0x2D, 0x4C,
+	 0x6C, 0x79, 0xB5, 0x29, 0xA4, 0x16, 0xF6, 0xEF, 0x2A, 0xE5, 0xA5,
+	 0x6F, 0x96, 0x8E, 0x6E, 0x76, 0xD1, 0xB7, 0x8A, 0x00, 0xA1, 0x37,
+	 0x80, 0x1F, 0x8E, 0x58, 0xBF, 0xE8, 0x4D, 0xDD, 0xA9, 0xCF, 0x7D,
+	 0x17, 0x45, 0xBC, 0xAD, 0x2D, 0x07, 0x30, 0xFF, 0x00},
+};
+
+static int blake3(void) {
+	int code = RLC_ERR;
+	int i, j;
+	uint8_t message[MSG_SIZE], digest[32];
+
+	TEST_ONCE("blake3 hash function is correct") {
+		for (i = 0; i < TEST_MAX; i++) {
+			memset(message, 0, MSG_SIZE);
+			for (j = 0; j < count[i]; j++) {
+				strcat((char *)message, tests[i]);
+			}
+			md_map_blake3(digest, message, strlen((char *)message));
+			TEST_ASSERT(memcmp(digest, result_blake3[i], 32) == 0, end);
+		}
+	}
+	TEST_END;
+
+#if ARCH == X64
+	TEST_CASE("blake3 hash function is consistent across implementations") {
+		uint8_t other[32];
+		int ext = core_get()->ext;
+		rand_bytes(message, 1);
+		j = RLC_MIN(MSG_SIZE, 65536) - (message[0] & 0x3F);
+		rand_bytes(message, j);
+		md_map_blake3(digest, message, j);
+		core_get()->ext = 0;
+		md_map_blake3(other, message, j);
+		core_get()->ext = ext;
+		TEST_ASSERT(memcmp(digest, other, 32) == 0, end);
+	}
+	TEST_END;
+#endif
+
+	TEST_CASE("blake3 incremental hashing is correct") {
+		uint8_t other[32];
+		md_blake3_t ctx;
+		int len = RLC_MIN(MSG_SIZE, 65536);
+		rand_bytes(message, 2);
+		j = ((message[0] << 8) | message[1]) % len;
+		rand_bytes(message, len);
+		md_map_blake3(digest, message, len);
+		md_blake3_init(ctx);
+		md_blake3_update(ctx, message, j);
+		md_blake3_update(ctx, NULL, 0);
+		md_blake3_update(ctx, message + j, len - j);
+		md_blake3_final(other, ctx);
+		TEST_ASSERT(memcmp(digest, other, 32) == 0, end);
+	}
+	TEST_END;
+
+	TEST_ONCE("blake3 xmd function is correct") {
+		uint8_t buf[75] = {0,};
+		md_xmd_blake3(buf, 16, (uint8_t *)TEST1, strlen(TEST1), (uint8_t *)"", 0);
+		TEST_ASSERT(memcmp(buf, result_xmd_blake3[0], 16) == 0, end);
+		md_xmd_blake3(buf, 37, (uint8_t *)TEST2a, strlen(TEST2a), (uint8_t *)TEST2b, strlen(TEST2b));
+		TEST_ASSERT(memcmp(buf, result_xmd_blake3[1], 37) == 0, end);
+		md_xmd_blake3(buf, 57, (uint8_t *)TEST3a, strlen(TEST3a), (uint8_t *)TEST3b, strlen(TEST3b));
+		TEST_ASSERT(memcmp(buf, result_xmd_blake3[2], 57) == 0, end);
+		md_xmd_blake3(buf, 75, (uint8_t *)TEST4a, strlen(TEST4a), (uint8_t *)TEST4b, strlen(TEST4b));
+		TEST_ASSERT(memcmp(buf, result_xmd_blake3[3], 75) == 0, end);
+	}
+	TEST_END;
+
+	code = RLC_OK;
+
+  end:
+	return code;
+}
+
+#endif
+
 #if MD_MAP == SH256
 
 /* Test vector #1, ANSI X9.63 */
@@ -433,6 +752,33 @@ uint8_t key2[] = {
 
 #endif
 
+static int incremental(void) {
+	int code = RLC_ERR;
+	uint8_t digest[RLC_MD_LEN], other[RLC_MD_LEN], msg[24];
+	md_t ctx;
+
+	TEST_CASE("incremental hashing of integers is correct") {
+		uint64_t a = 0;
+		rand_bytes(msg, sizeof(msg));
+		for (int j = 4; j < 12; j++) {
+			a = (a << 8) | msg[j];
+		}
+		md_map(digest, msg, sizeof(msg));
+		md_init(ctx);
+		md_update(ctx, msg, 4);
+		md_update_int(ctx, a);
+		md_update(ctx, msg + 12, sizeof(msg) - 12);
+		md_final(other, ctx);
+		TEST_ASSERT(memcmp(digest, other, RLC_MD_LEN) == 0, end);
+	}
+	TEST_END;
+
+	code = RLC_OK;
+
+  end:
+	return code;
+}
+
 static int kdf(void) {
 	int code = RLC_ERR;
 	uint8_t message[] = { 0x96, 0xC0, 0x56, 0x19, 0xD5, 0x6C, 0x32, 0x8A, 0xB9,
@@ -568,6 +914,25 @@ int main(void) {
 	}
 #endif
 
+#if MD_MAP == B2B256 || MD_MAP == B2B512 || !defined(STRIP)
+	if (blake2b() != RLC_OK) {
+		core_clean();
+		return 1;
+	}
+#endif
+
+#if MD_MAP == BLAKE3 || !defined(STRIP)
+	if (blake3() != RLC_OK) {
+		core_clean();
+		return 1;
+	}
+#endif
+
+	if (incremental() != RLC_OK) {
+		core_clean();
+		return 1;
+	}
+
 	if (kdf() != RLC_OK) {
 		core_clean();
 		return 1;
@@ -137,7 +137,7 @@ static int triple(void) {
 
 static int shamir(void) {
 	int code = RLC_ERR;
-	bn_t q, t, s, x[10], y[10];
+	bn_t q, t, s, x[10], y[30], u[3], v[3], z[30];
 
 	bn_null(q);
 	bn_null(t);
@@ -148,11 +148,21 @@ static int shamir(void) {
 		bn_new(t);
 		bn_new(s);
 		for (int j = 0; j < 10; j++) {
-			bn_null(y[j]);
-			bn_new(y[j]);
 			bn_null(x[j]);
 			bn_new(x[j]);
 		}
+		for (int j = 0; j < 3; j++) {
+			bn_null(u[j]);
+			bn_new(u[j]);
+			bn_null(v[j]);
+			bn_new(v[j]);
+		}
+		for (int j = 0; j < 30; j++) {
+			bn_null(y[j]);
+			bn_new(y[j]);
+			bn_null(z[j]);
+			bn_new(z[j]);
+		}
 
 		bn_gen_prime(q, RLC_BN_BITS);
 
@@ -173,6 +183,34 @@ static int shamir(void) {
 				}
 			}
 		} TEST_END;
+
+		TEST_CASE("shamir secret shares are generated simultaneously") {
+			for (int i = 2; i < 10; i++) {
+				for (int j = 2; j <= i; j++) {
+					for (int l = 0; l < 3; l++) {
+						bn_rand_mod(u[l], q);
+					}
+					TEST_ASSERT(mpc_sss_gen_sim(x, z, u, q, j, i, 3) == RLC_OK,
+							end);
+					for (int l = 0; l < 3; l++) {
+						TEST_ASSERT(mpc_sss_key(t, x, z + l * i, q, j) == RLC_OK,
+								end);
+						TEST_ASSERT(bn_cmp(t, u[l]) == RLC_EQ, end);
+					}
+					/* Recover from the last j shares of each secret. */
+					for (int l = 0; l < 3; l++) {
+						for (int m = 0; m < j; m++) {
+							bn_copy(y[l * j + m], z[l * i + i - j + m]);
+						}
+					}
+					TEST_ASSERT(mpc_sss_key_sim(v, x + i - j, y, q, j, 3) ==
+							RLC_OK, end);
+					for (int l = 0; l < 3; l++) {
+						TEST_ASSERT(bn_cmp(v[l], u[l]) == RLC_EQ, end);
+					}
+				}
+			}
+		} TEST_END;
 	} RLC_CATCH_ANY {
 		util_print("FATAL ERROR!\n");
 		RLC_ERROR(end);
@@ -185,7 +223,14 @@ static int shamir(void) {
 	bn_free(s);
 	for (int j = 0; j < 10; j++) {
 		bn_free(x[j]);
+	}
+	for (int j = 0; j < 3; j++) {
+		bn_free(u[j]);
+		bn_free(v[j]);
+	}
+	for (int j = 0; j < 30; j++) {
 		bn_free(y[j]);
+		bn_free(z[j]);
 	}
 	return code;
 }
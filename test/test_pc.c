@@ -1435,8 +1435,9 @@ static int inversion(void) {
 
 int exponentiation(void) {
 	int code = RLC_ERR;
-	gt_t a, b, c;
-	bn_t n, d, e;
+	gt_t a, b, c, t[RLC_TERMS];
+	bn_t n, d, e, k[RLC_TERMS];
+	dig_t g[RLC_TERMS];
 
 	gt_null(a);
 	gt_null(b);
@@ -1452,6 +1453,12 @@ int exponentiation(void) {
 		bn_new(d);
 		bn_new(e);
 		bn_new(n);
+		for (int j = 0; j < RLC_TERMS; j++) {
+			gt_null(t[j]);
+			bn_null(k[j]);
+			gt_new(t[j]);
+			bn_new(k[j]);
+		}
 
 		gt_get_gen(a);
 		pc_get_ord(n);
@@ -1506,6 +1513,37 @@ int exponentiation(void) {
 			gt_exp_dig(c, a, d->dp[0]);
 			TEST_ASSERT(gt_cmp(b, c) == RLC_EQ, end);
 		} TEST_END;
+
+		TEST_CASE("simultaneous exponentiation is correct") {
+			for (int l = 2; l <= RLC_TERMS; l += RLC_TERMS - 2) {
+				gt_set_unity(b);
+				for (int j = 0; j < l; j++) {
+					gt_rand(t[j]);
+					bn_rand_mod(k[j], n);
+					if (j % 3 == 1) {
+						bn_neg(k[j], k[j]);
+					}
+					if (j % 5 == 4) {
+						bn_zero(k[j]);
+					}
+					gt_exp(c, t[j], k[j]);
+					gt_mul(b, b, c);
+				}
+				gt_exp_sim_lot(c, t, k, l);
+				TEST_ASSERT(gt_cmp(b, c) == RLC_EQ, end);
+				gt_set_unity(b);
+				for (int j = 0; j < l; j++) {
+					rand_bytes((uint8_t *)&g[j], sizeof(dig_t));
+					g[j] >>= (j % RLC_DIG);
+					gt_exp_dig(c, t[j], g[j]);
+					gt_mul(b, b, c);
+				}
+				gt_exp_sim_dig(c, t, g, l);
+				TEST_ASSERT(gt_cmp(b, c) == RLC_EQ, end);
+			}
+			gt_exp_sim_lot(c, t, k, 0);
+			TEST_ASSERT(gt_is_unity(c), end);
+		} TEST_END;
 	}
 	RLC_CATCH_ANY {
 		util_print("FATAL ERROR!\n");
@@ -1519,6 +1557,10 @@ int exponentiation(void) {
 	bn_free(d);
 	bn_free(e);
 	bn_free(n);
+	for (int j = 0; j < RLC_TERMS; j++) {
+		gt_free(t[j]);
+		bn_free(k[j]);
+	}
 	return code;
 }
 
@@ -1548,6 +1590,105 @@ static int validity(void) {
 	return code;
 }
 
+static int logarithm(void) {
+	int code = RLC_ERR;
+	uint64_t buf[1 + 2 * 63];
+	uint8_t *bin = (uint8_t *)buf;
+	dlog_tab_t tab;
+	gt_t a, g;
+	g1_t p, q;
+	dig_t x, y;
+
+	dlog_tab_null(tab);
+	gt_null(a);
+	gt_null(g);
+	g1_null(p);
+	g1_null(q);
+
+	RLC_TRY {
+		dlog_tab_new(tab);
+		gt_new(a);
+		gt_new(g);
+		g1_new(p);
+		g1_new(q);
+
+		TEST_CASE("bounded discrete logarithm is correct") {
+			gt_rand(g);
+			rand_bytes((uint8_t *)&x, sizeof(dig_t));
+			x %= 100000;
+			gt_exp_dig(a, g, x);
+			TEST_ASSERT(gt_dlog_bounded(&y, a, g, 100000, NULL) == RLC_OK, end);
+			TEST_ASSERT(x == y, end);
+			g1_rand(q);
+			g1_mul_dig(p, q, x);
+			TEST_ASSERT(g1_dlog_bounded(&y, p, q, 100000, NULL) == RLC_OK, end);
+			TEST_ASSERT(x == y, end);
+			/* Logarithms reached by the last giant step must be bounded. */
+			g1_mul_dig(p, q, 100001);
+			TEST_ASSERT(g1_dlog_bounded(&y, p, q, 100000, NULL) == RLC_ERR, end);
+		} TEST_END;
+
+		TEST_CASE("bounded discrete logarithm with tables is correct") {
+			gt_rand(g);
+			gt_dlog_tab(tab, g, 64);
+			rand_bytes((uint8_t *)&x, sizeof(dig_t));
+			x %= 4096;
+			gt_exp_dig(a, g, x);
+			TEST_ASSERT(gt_dlog_bounded(&y, a, g, 4096, tab) == RLC_OK, end);
+			TEST_ASSERT(x == y, end);
+			/* Logarithms beyond the table are found with kangaroos. */
+			rand_bytes((uint8_t *)&x, sizeof(dig_t));
+			x = 4096 + x % 16384;
+			gt_exp_dig(a, g, x);
+			TEST_ASSERT(gt_dlog_bounded(&y, a, g, 20480, tab) == RLC_OK, end);
+			TEST_ASSERT(x == y, end);
+			gt_exp_dig(a, g, 4096);
+			TEST_ASSERT(gt_dlog_bounded(&y, a, g, 4096, tab) == RLC_ERR, end);
+			gt_exp_dig(a, g, 4010);
+			TEST_ASSERT(gt_dlog_bounded(&y, a, g, 4000, tab) == RLC_ERR, end);
+			g1_rand(q);
+			g1_dlog_tab(tab, q, 64);
+			rand_bytes((uint8_t *)&x, sizeof(dig_t));
+			x = 4096 + x % 16384;
+			g1_mul_dig(p, q, x);
+			TEST_ASSERT(g1_dlog_bounded(&y, p, q, 20480, tab) == RLC_OK, end);
+			TEST_ASSERT(x == y, end);
+		} TEST_END;
+
+		TEST_CASE("reading and writing a table are consistent") {
+			gt_rand(g);
+			gt_dlog_tab(tab, g, 64);
+			TEST_ASSERT(pc_dlog_size_bin(tab) == sizeof(buf), end);
+			pc_dlog_write_bin(bin, sizeof(buf), tab);
+			dlog_tab_free(tab);
+			dlog_tab_new(tab);
+			pc_dlog_read_bin(tab, bin, sizeof(buf));
+			rand_bytes((uint8_t *)&x, sizeof(dig_t));
+			x %= 4096;
+			gt_exp_dig(a, g, x);
+			TEST_ASSERT(gt_dlog_bounded(&y, a, g, 4096, tab) == RLC_OK, end);
+			TEST_ASSERT(x == y, end);
+			dlog_tab_free(tab);
+			dlog_tab_new(tab);
+			pc_dlog_map_bin(tab, bin, sizeof(buf));
+			TEST_ASSERT(tab->t == buf + 1, end);
+			TEST_ASSERT(gt_dlog_bounded(&y, a, g, 4096, tab) == RLC_OK, end);
+			TEST_ASSERT(x == y, end);
+		} TEST_END;
+	}
+	RLC_CATCH_ANY {
+		RLC_ERROR(end);
+	}
+	code = RLC_OK;
+  end:
+	dlog_tab_free(tab);
+	gt_free(a);
+	gt_free(g);
+	g1_free(p);
+	g1_free(q);
+	return code;
+}
+
 static int pairing(void) {
 	int j, code = RLC_ERR;
 	g1_t p[2];
@@ -1788,6 +1929,10 @@ int test(void) {
 		return RLC_ERR;
 	}
 
+	if (logarithm() != RLC_OK) {
+		return RLC_ERR;
+	}
+
 	if (pairing() != RLC_OK) {
 		return RLC_ERR;
 	}
@@ -297,6 +297,146 @@ uint8_t result2[] = {
 	0x9D, 0x07, 0xE1, 0x64, 0xCC, 0x0B, 0x94, 0x37
 };
 
+#elif MD_MAP == B2B256
+
+#define FUNCTION "blake2b-256"
+
+uint8_t seed1[63];
+
+uint8_t result1[] = {
+	0x6B, 0x37, 0x2A, 0x19, 0x01, 0x8E, 0x69, 0x3A, 0x43, 0xAB,
+	0x1D, 0x34, 0x7C, 0x1E, 0x4B, 0xBB, 0x0C, 0x18, 0x9B, 0x6C,
+	0xF1, 0x6A, 0xD7, 0x21, 0x9F, 0x7B, 0xE7, 0xD6, 0x87, 0xB1,
+	0x16, 0xCB, 0x2A, 0xCC, 0xCE, 0xB9, 0x5E, 0x3B, 0x6C, 0x07,
+	0x53, 0x45, 0x00, 0x98, 0x4C, 0x98, 0xA8, 0x39, 0xD5, 0x32,
+	0xE5, 0xE5, 0x15, 0x9E, 0xAC, 0x71, 0x67, 0x53, 0xA3, 0xC2,
+	0x29, 0xB6, 0xD6, 0x89, 0xA4, 0x86, 0xB3, 0x56, 0xBC, 0x9A,
+	0x4F, 0x94, 0x51, 0x52, 0xBA, 0x26, 0x66, 0x67, 0xEF, 0x46,
+	0x89, 0xFE, 0xC4, 0xD4, 0x5F, 0x07, 0xD2, 0x4F, 0x07, 0xBB,
+	0xD2, 0xE5, 0x48, 0x32, 0x69, 0xB3, 0x0B, 0x03, 0x13, 0x1A,
+	0xB5, 0x9E, 0xB7, 0xFC, 0x80, 0x13, 0xC1, 0x53, 0x55, 0x1E,
+	0xCD, 0x1F, 0x3B, 0xF1, 0x57, 0xBA, 0xC6, 0x70, 0x9D, 0xAA,
+	0xAF, 0x2D, 0x7C, 0xC8, 0x95, 0xC7, 0x5B, 0x30
+};
+
+uint8_t result2[] = {
+	0x9C, 0x87, 0xA6, 0x06, 0x3B, 0xC4, 0xE7, 0x88, 0x39, 0xEF,
+	0xEA, 0xDC, 0x91, 0xD8, 0xA4, 0x1D, 0x34, 0x77, 0x0B, 0xB5,
+	0xA6, 0x47, 0x31, 0xFB, 0x1F, 0xA6, 0x43, 0x91, 0x99, 0xBA,
+	0x3D, 0xE9, 0x68, 0xA5, 0xB9, 0x4E, 0xFA, 0x8D, 0xEE, 0x29,
+	0x42, 0xA7, 0x2B, 0xE3, 0x84, 0x2F, 0x54, 0xCA, 0xC8, 0xC0,
+	0xE5, 0x13, 0xFF, 0xAF, 0x41, 0x9E, 0x39, 0x46, 0xDB, 0x12,
+	0x20, 0xED, 0x93, 0x3F, 0xA3, 0x72, 0x07, 0x53, 0x7B, 0xCA,
+	0x24, 0x5E, 0x01, 0xB4, 0x17, 0x67, 0x1E, 0x38, 0xD7, 0x34,
+	0xD1, 0x6A, 0xCA, 0x0B, 0xAA, 0x6C, 0x1F, 0xEE, 0x73, 0x8B,
+	0x65, 0xBB, 0x6F, 0xA0, 0xEF, 0xC3, 0xCC, 0x20, 0x05, 0xFC,
+	0x9D, 0x7D, 0x44, 0x87, 0x3C, 0x2B, 0x84, 0x9A, 0x69, 0xFF,
+	0x71, 0x4F, 0x9B, 0x66, 0x8D, 0x12, 0xB8, 0x1D, 0xDD, 0x88,
+	0x6F, 0xC6, 0x24, 0x50, 0x17, 0x61, 0xA7, 0x61
+};
+
+#elif MD_MAP == B2B512
+
+#define FUNCTION "blake2b-512"
+
+uint8_t seed1[127];
+
+uint8_t result1[] = {
+	0xCB, 0xC9, 0x7D, 0x89, 0x36, 0xBA, 0x91, 0x79, 0xCB, 0xDE,
+	0xDE, 0xE3, 0x99, 0x0F, 0x4D, 0x9A, 0x24, 0xB2, 0xCE, 0xF1,
+	0xFE, 0x42, 0x71, 0xFA, 0xC9, 0x69, 0x35, 0x6E, 0xC2, 0xB8,
+	0x6D, 0x63, 0x6E, 0x86, 0xDD, 0x43, 0x81, 0xB8, 0xAD, 0xBC,
+	0xBB, 0x1F, 0x2E, 0x6D, 0x3D, 0x6B, 0xBC, 0x8A, 0xC1, 0xAA,
+	0x38, 0x66, 0x21, 0xC5, 0xC9, 0x57, 0x5F, 0x3A, 0xFD, 0x46,
+	0x78, 0x83, 0xD8, 0x76, 0xD8, 0x14, 0x4F, 0x08, 0xEC, 0xFF,
+	0x9A, 0xF0, 0xC1, 0xF9, 0x1A, 0xFE, 0xB4, 0x93, 0x47, 0xA6,
+	0xAE, 0x82, 0x5C, 0xBB, 0xBB, 0x4A, 0xAA, 0xC7, 0x1D, 0xD5,
+	0x95, 0x0C, 0x48, 0xAD, 0xFB, 0xC9, 0x2D, 0x7E, 0x21, 0x95,
+	0xA7, 0x62, 0x3C, 0xA8, 0xBF, 0xA9, 0x70, 0x7B, 0x3C, 0x4E,
+	0xAD, 0xA8, 0xBC, 0xA9, 0xB6, 0x43, 0xED, 0x0F, 0x98, 0x19,
+	0xB5, 0x42, 0xB3, 0xF0, 0x8F, 0x93, 0x47, 0x73, 0x52, 0x92,
+	0x57, 0x82, 0xF9, 0xC2, 0xF3, 0x40, 0xD2, 0x7F, 0x87, 0x52,
+	0xC6, 0xFA, 0x4B, 0x05, 0xDE, 0xB2, 0x93, 0x40, 0x77, 0x98,
+	0x34, 0x3D, 0xE6, 0x2B, 0xBF, 0xD0, 0x24, 0xA7, 0x50, 0x9E,
+	0xFB, 0x54, 0x3D, 0x16, 0x9B, 0x9C, 0x78, 0x9C, 0x4E, 0xC4,
+	0xCF, 0x37, 0x7A, 0xBE, 0x42, 0x09, 0x8C, 0x3B, 0x55, 0x09,
+	0x08, 0x44, 0xCE, 0xCE, 0x22, 0x35, 0x25, 0xD3, 0x63, 0x6D,
+	0xE0, 0x22, 0x2E, 0xD3, 0xD3, 0xFE, 0xF3, 0x05, 0x99, 0x80,
+	0x3F, 0x0C, 0x76, 0xBB, 0xA4, 0x7E, 0x66, 0x78, 0x23, 0x09,
+	0x26, 0xC3, 0x18, 0x2B, 0x72, 0xB0, 0xCD, 0xF0, 0x75, 0xC8,
+	0x78, 0x45, 0xAE, 0x54, 0xA1, 0xA1, 0xA0, 0xE8, 0x88, 0xCF,
+	0xD0, 0x91, 0x41, 0xD7, 0x50, 0x17, 0x80, 0x06, 0x25, 0xC1,
+	0xCB, 0x94, 0xFC, 0x5C, 0x5B, 0xE2, 0x04, 0xA5, 0x76, 0x78,
+	0x3F, 0x13, 0x35, 0x21, 0x7B, 0x4F
+};
+
+uint8_t result2[] = {
+	0x2C, 0x5F, 0xC9, 0x18, 0x77, 0x1E, 0x2E, 0x60, 0x1A, 0x6D,
+	0x1D, 0x4D, 0xE8, 0x55, 0xF5, 0x5A, 0xCA, 0x70, 0xAC, 0x93,
+	0x33, 0xFC, 0x09, 0xAC, 0xF4, 0xE2, 0x37, 0x12, 0x8D, 0xC5,
+	0x02, 0xA3, 0xDB, 0xDA, 0x44, 0xD7, 0x91, 0xF8, 0x98, 0x82,
+	0x6E, 0xA8, 0x54, 0xE3, 0x74, 0xD1, 0xAD, 0x36, 0x88, 0x84,
+	0x2D, 0xE2, 0xA9, 0x3E, 0x4B, 0x87, 0x92, 0xAC, 0xCD, 0xF6,
+	0xF5, 0x4D, 0x8C, 0x6D, 0x21, 0xEE, 0xD3, 0x55, 0xFE, 0x62,
+	0x1E, 0x67, 0xE7, 0xCC, 0xB4, 0x0E, 0xD1, 0xE1, 0xCE, 0x86,
+	0x92, 0xB3, 0x38, 0xB8, 0x03, 0xC1, 0xA5, 0x50, 0x14, 0xFD,
+	0xA3, 0xB9, 0x0D, 0xB2, 0xD2, 0x3D, 0x79, 0xD9, 0xA0, 0xCF,
+	0xBD, 0x9F, 0x90, 0xA2, 0x34, 0xD0, 0xDA, 0xD4, 0xDC, 0x36,
+	0x45, 0x01, 0x3D, 0xDD, 0x9C, 0x3B, 0xE5, 0x48, 0x6B, 0x4C,
+	0xD3, 0xEC, 0x21, 0xD0, 0x73, 0x3B, 0x93, 0xDA, 0x6A, 0x46,
+	0xC6, 0xB3, 0x6C, 0x53, 0x91, 0x7C, 0x82, 0x6A, 0x32, 0xD4,
+	0x81, 0x6F, 0x9B, 0xCF, 0x04, 0x61, 0xCC, 0x47, 0x68, 0x0C,
+	0xAD, 0x5C, 0x4F, 0x6F, 0x67, 0xA3, 0x31, 0x49, 0xF5, 0x9F,
+	0x39, 0xDE, 0x2C, 0x5E, 0xEC, 0xAD, 0x1B, 0x96, 0xC4, 0xC2,
+	0xE8, 0x63, 0xE4, 0x79, 0x3E, 0x1F, 0x27, 0x3B, 0x24, 0x14,
+	0x8D, 0xA0, 0xD7, 0xB5, 0x59, 0x05, 0x2C, 0x16, 0x21, 0x4C,
+	0x61, 0x2C, 0x40, 0x53, 0x36, 0x8C, 0x9F, 0xA7, 0xD4, 0xD5,
+	0x79, 0x78, 0x38, 0x9A, 0xA2, 0x88, 0x7D, 0x37, 0xA1, 0xB1,
+	0xA6, 0x1B, 0x4A, 0x67, 0x36, 0xE2, 0x36, 0x46, 0x34, 0xD9,
+	0x80, 0x42, 0xEF, 0xC8, 0x7E, 0xE2, 0xA9, 0x3C, 0xE2, 0xB4,
+	0x29, 0x28, 0x55, 0x25, 0x24, 0x56, 0x22, 0x8F, 0x0B, 0x2D,
+	0xFB, 0x59, 0x14, 0x43, 0xDF, 0xB8, 0xE3, 0x05, 0x1A, 0xC0,
+	0x4C, 0x8F, 0xE1, 0xF2, 0x53, 0xAC
+};
+
+#elif MD_MAP == BLAKE3
+
+#define FUNCTION "blake3"
+
+uint8_t seed1[63];
+
+uint8_t result1[] = {
+	0x73, 0xF9, 0x92, 0x61, 0x80, 0x28, 0xD9, 0x76, 0x1F, 0xBE,
+	0x9B, 0xDF, 0x1F, 0x37, 0xC8, 0xC7, 0xCC, 0xEE, 0x80, 0x9F,
+	0xB5, 0x23, 0x36, 0x9B, 0x71, 0xAE, 0x47, 0xA1, 0x00, 0xDD,
+	0x7D, 0xC6, 0x51, 0xBC, 0x52, 0x88, 0x00, 0xCA, 0x7F, 0x10,
+	0x79, 0x9A, 0x1D, 0x8E, 0xA3, 0xAA, 0x50, 0x18, 0xEB, 0x06,
+	0x1D, 0x21, 0xFD, 0xAD, 0x92, 0x32, 0xD4, 0x90, 0x74, 0x9E,
+	0xED, 0x05, 0x85, 0x2C, 0x1E, 0xF9, 0x97, 0x4A, 0xED, 0x75,
+	0x79, 0x96, 0x97, 0x0A, 0xF3, 0xC0, 0x69, 0xD3, 0xCB, 0xC5,
+	0x3C, 0x89, 0xEC, 0x03, 0x3B, 0xCD, 0xB2, 0x22, 0x41, 0x2E,
+	0xE1, 0x4B, 0xCE, 0xB3, 0x23, 0x69, 0xCC, 0xB1, 0x6B, 0xCE,
+	0xBA, 0x5D, 0x66, 0xA3, 0xDB, 0x21, 0x0E, 0x80, 0x3A, 0x17,
+	0xF1, 0xF4, 0x4E, 0x3A, 0x43, 0x99, 0xE5, 0xE5, 0x34, 0x8C,
+	0xC8, 0x70, 0xC7, 0x4E, 0x16, 0x16, 0xF2, 0x92
+};
+
+uint8_t result2[] = {
+	0x9E, 0x0C, 0x2A, 0xC1, 0x21, 0xA0, 0x8B, 0x15, 0x0B, 0x47,
+	0x84, 0xC4, 0xEC, 0x76, 0x03, 0x33, 0xBA, 0x2A, 0x85, 0x5D,
+	0xA8, 0xF2, 0x20, 0x1A, 0x24, 0xC7, 0xE7, 0x7C, 0x66, 0xAC,
+	0xBC, 0xFB, 0x98, 0x7B, 0xF9, 0x28, 0x58, 0x2D, 0xE2, 0x91,
+	0x01, 0x0D, 0x34, 0x07, 0x8F, 0x17, 0xDD, 0x26, 0x56, 0x95,
+	0x3E, 0x45, 0xF3, 0xDE, 0x07, 0xBD, 0x77, 0x00, 0x1B, 0xBE,
+	0x0E, 0xEB, 0xC9, 0xFD, 0x75, 0x0B, 0xD4, 0x0C, 0x48, 0xBC,
+	0x94, 0xD9, 0xE0, 0xA9, 0x5D, 0x13, 0xFE, 0xCD, 0x63, 0x64,
+	0xCD, 0xD3, 0xFD, 0xFA, 0xF3, 0x40, 0x44, 0x11, 0x1D, 0x8C,
+	0x8D, 0x01, 0x9F, 0x0E, 0x98, 0xE6, 0x86, 0xEA, 0x2F, 0xBF,
+	0x6A, 0x9E, 0x3A, 0x89, 0x54, 0x36, 0x7E, 0x45, 0x84, 0x95,
+	0x36, 0x97, 0x19, 0x3F, 0x85, 0xBF, 0x6E, 0x3D, 0x03, 0x89,
+	0xCD, 0x44, 0x97, 0x27, 0xD6, 0x84, 0x78, 0x7D
+};
+
 #endif
 
 static int test(void) {
@@ -340,6 +480,69 @@ static int test(void) {
 	return code;
 }
 
+#elif RAND == CHACHA
+
+/*
+ * Test vector computed from SHA-256 and the ChaCha20 block function of
+ * RFC 8439, skipping the first keystream block reserved for the next key.
+ */
+uint8_t result[] = {
+	0x5C, 0xA8, 0x6A, 0xDE, 0x7A, 0xCF, 0x36, 0x6A, 0x0D, 0xE7,
+	0x14, 0xE5, 0x3E, 0xFF, 0xD2, 0xC3, 0x59, 0x09, 0x40, 0x44,
+	0x0A, 0xEC, 0xFE, 0xF9, 0x02, 0x09, 0x70, 0xCE, 0x5E, 0x6C,
+	0x05, 0xD7, 0xEB, 0x83, 0x5B, 0xB7, 0xA3, 0xC9, 0xE0, 0xCC,
+	0xF1, 0xA3, 0x11, 0x6E, 0x4D, 0xAD, 0x7B, 0xD5, 0x8A, 0xFB,
+	0x5B, 0xF3, 0xC2, 0xE5, 0xC9, 0x20, 0xBA, 0x5F, 0x81, 0x47,
+	0x8B, 0x77, 0xC5, 0x61
+};
+
+/* Large enough to exceed the limit of the HASH-DRBG generator. */
+uint8_t large[1 << 17];
+
+static int test(void) {
+	int i, len = sizeof(result) / 2, code = RLC_ERR;
+	uint8_t out[sizeof(result)], seed[RLC_RAND_SEED];
+
+	for (i = 0; i < RLC_RAND_SEED; i++) {
+		seed[i] = i;
+	}
+
+	TEST_ONCE("chacha20 random generator is correct") {
+		rand_clean();
+		rand_seed(seed, sizeof(seed));
+		rand_bytes(out, len);
+		TEST_ASSERT(memcmp(out, result, len) == 0, end);
+		rand_bytes(out, len);
+		TEST_ASSERT(memcmp(out, result + len, len) == 0, end);
+	}
+	TEST_END;
+
+	TEST_ONCE("chacha20 random generator supports large requests") {
+		rand_clean();
+		rand_seed(seed, sizeof(seed));
+		rand_bytes(large, sizeof(large));
+		TEST_ASSERT(memcmp(large, result, sizeof(result)) == 0, end);
+		TEST_ASSERT(rand_check(large, sizeof(large)) == RLC_OK, end);
+		rand_bytes(out, sizeof(out));
+		TEST_ASSERT(memcmp(out, result, sizeof(out)) != 0, end);
+	}
+	TEST_END;
+
+	TEST_ONCE("chacha20 reseeding is correct") {
+		rand_clean();
+		rand_seed(seed, sizeof(seed));
+		rand_seed(seed, sizeof(seed));
+		rand_bytes(out, sizeof(out));
+		TEST_ASSERT(memcmp(out, result, sizeof(out)) != 0, end);
+	}
+	TEST_END;
+
+	code = RLC_OK;
+
+  end:
+	return code;
+}
+
 #elif RAND == UDEV
 
 static int test(void) {